@@ -41,6 +41,11 @@ struct JLevelDBData
 	leveldb_readoptions_t* read_options;
 	leveldb_writeoptions_t* write_options;
 	leveldb_writeoptions_t* write_options_sync;
+
+	/**
+	 * Serializes read-modify-write operations.
+	 **/
+	GMutex update_lock;
 };
 
 typedef struct JLevelDBData JLevelDBData;
@@ -51,6 +56,21 @@ struct JLevelDBIterator
 	gboolean first;
 	gchar* prefix;
 	gsize namespace_len;
+
+	/**
+	 * The range's bounds including the namespace, NULL if unbounded.
+	 * The start is inclusive, the end is exclusive.
+	 **/
+	gchar* start;
+	gchar* end;
+
+	gboolean reverse;
+
+	/**
+	 * The maximum number of pairs, 0 if unlimited.
+	 **/
+	guint32 limit;
+	guint32 count;
 };
 
 typedef struct JLevelDBIterator JLevelDBIterator;
@@ -138,6 +158,45 @@ backend_delete(gpointer backend_data, gpointer backend_batch, gchar const* key)
 	return TRUE;
 }
 
+static gboolean
+backend_delete_by_prefix(gpointer backend_data, gpointer backend_batch, gchar const* prefix)
+{
+	JLevelDBBatch* batch = backend_batch;
+	JLevelDBData* bd = backend_data;
+	leveldb_iterator_t* it;
+	g_autofree gchar* nsprefix = NULL;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+
+	nsprefix = g_strdup_printf("%s:%s", batch->namespace, (prefix != NULL) ? prefix : "");
+	it = leveldb_create_iterator(bd->db, bd->read_options);
+
+	if (it == NULL)
+	{
+		return FALSE;
+	}
+
+	// LevelDB does not support range deletions, so add a deletion for each key to the batch.
+	for (leveldb_iter_seek(it, nsprefix, strlen(nsprefix)); leveldb_iter_valid(it); leveldb_iter_next(it))
+	{
+		gchar const* key;
+		gsize key_len;
+
+		key = leveldb_iter_key(it, &key_len);
+
+		if (!g_str_has_prefix(key, nsprefix))
+		{
+			break;
+		}
+
+		leveldb_writebatch_delete(batch->batch, key, key_len);
+	}
+
+	leveldb_iter_destroy(it);
+
+	return TRUE;
+}
+
 static gboolean
 backend_get(gpointer backend_data, gpointer backend_batch, gchar const* key, gpointer* value, guint32* len)
 {
@@ -168,6 +227,150 @@ backend_get(gpointer backend_data, gpointer backend_batch, gchar const* key, gpo
 	return (result != NULL);
 }
 
+/**
+ * Writes a value immediately instead of adding it to the batch.
+ * LevelDB cannot read values from batches, so read-modify-write operations have to bypass them to be atomic.
+ **/
+static gboolean
+jd_leveldb_put_now(JLevelDBData* bd, JLevelDBBatch* batch, gchar const* nskey, gconstpointer value, gsize len)
+{
+	g_autofree gchar* leveldb_error = NULL;
+
+	leveldb_writeoptions_t* write_options = bd->write_options;
+
+	if (j_semantics_get(batch->semantics, J_SEMANTICS_PERSISTENCY) == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		write_options = bd->write_options_sync;
+	}
+
+	leveldb_put(bd->db, write_options, nskey, strlen(nskey) + 1, value, len, &leveldb_error);
+
+	return (leveldb_error == NULL);
+}
+
+static gboolean
+backend_compare_and_swap(gpointer backend_data, gpointer backend_batch, gchar const* key, gconstpointer expected, guint32 expected_len, gconstpointer value, guint32 len)
+{
+	JLevelDBBatch* batch = backend_batch;
+	JLevelDBData* bd = backend_data;
+	g_autofree gchar* nskey = NULL;
+	g_autofree gchar* current = NULL;
+	gsize current_len;
+	gboolean ret;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	g_mutex_lock(&(bd->update_lock));
+
+	current = leveldb_get(bd->db, bd->read_options, nskey, strlen(nskey) + 1, &current_len, NULL);
+
+	if (expected == NULL)
+	{
+		ret = (current == NULL);
+	}
+	else
+	{
+		ret = (current != NULL && current_len == expected_len && memcmp(current, expected, expected_len) == 0);
+	}
+
+	if (ret)
+	{
+		ret = jd_leveldb_put_now(bd, batch, nskey, value, len);
+	}
+
+	g_mutex_unlock(&(bd->update_lock));
+
+	return ret;
+}
+
+static gboolean
+backend_add(gpointer backend_data, gpointer backend_batch, gchar const* key, gint64 delta)
+{
+	JLevelDBBatch* batch = backend_batch;
+	JLevelDBData* bd = backend_data;
+	g_autofree gchar* nskey = NULL;
+	g_autofree gchar* current = NULL;
+	gsize current_len;
+	gint64 counter = 0;
+	gboolean ret = TRUE;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	g_mutex_lock(&(bd->update_lock));
+
+	current = leveldb_get(bd->db, bd->read_options, nskey, strlen(nskey) + 1, &current_len, NULL);
+
+	if (current != NULL)
+	{
+		ret = (current_len == sizeof(counter));
+
+		if (ret)
+		{
+			memcpy(&counter, current, sizeof(counter));
+			counter = GINT64_FROM_LE(counter);
+		}
+	}
+
+	if (ret)
+	{
+		counter = GINT64_TO_LE(counter + delta);
+		ret = jd_leveldb_put_now(bd, batch, nskey, &counter, sizeof(counter));
+	}
+
+	g_mutex_unlock(&(bd->update_lock));
+
+	return ret;
+}
+
+static gboolean
+backend_append(gpointer backend_data, gpointer backend_batch, gchar const* key, gconstpointer value, guint32 len)
+{
+	JLevelDBBatch* batch = backend_batch;
+	JLevelDBData* bd = backend_data;
+	g_autofree gchar* nskey = NULL;
+	g_autofree gchar* current = NULL;
+	g_autofree gchar* appended = NULL;
+	gsize current_len = 0;
+	gboolean ret;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	g_mutex_lock(&(bd->update_lock));
+
+	current = leveldb_get(bd->db, bd->read_options, nskey, strlen(nskey) + 1, &current_len, NULL);
+
+	if (current == NULL)
+	{
+		current_len = 0;
+	}
+
+	appended = g_malloc(current_len + len);
+
+	if (current_len > 0)
+	{
+		memcpy(appended, current, current_len);
+	}
+
+	memcpy(appended + current_len, value, len);
+
+	ret = jd_leveldb_put_now(bd, batch, nskey, appended, current_len + len);
+
+	g_mutex_unlock(&(bd->update_lock));
+
+	return ret;
+}
+
 static gboolean
 backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
 {
@@ -187,6 +390,11 @@ backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend
 		iterator->first = TRUE;
 		iterator->prefix = g_strdup_printf("%s:", namespace);
 		iterator->namespace_len = strlen(namespace) + 1;
+		iterator->start = NULL;
+		iterator->end = NULL;
+		iterator->reverse = FALSE;
+		iterator->limit = 0;
+		iterator->count = 0;
 
 		*backend_iterator = iterator;
 	}
@@ -214,6 +422,11 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 		iterator->first = TRUE;
 		iterator->prefix = g_strdup_printf("%s:%s", namespace, prefix);
 		iterator->namespace_len = strlen(namespace) + 1;
+		iterator->start = NULL;
+		iterator->end = NULL;
+		iterator->reverse = FALSE;
+		iterator->limit = 0;
+		iterator->count = 0;
 
 		*backend_iterator = iterator;
 	}
@@ -221,6 +434,51 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 	return (iterator != NULL);
 }
 
+static gboolean
+backend_get_range(gpointer backend_data, gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse, gpointer* backend_iterator)
+{
+	JLevelDBData* bd = backend_data;
+	JLevelDBIterator* iterator = NULL;
+	leveldb_iterator_t* it;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	it = leveldb_create_iterator(bd->db, bd->read_options);
+
+	if (it != NULL)
+	{
+		iterator = g_slice_new(JLevelDBIterator);
+		iterator->iterator = it;
+		iterator->first = TRUE;
+		iterator->prefix = g_strdup_printf("%s:", namespace);
+		iterator->namespace_len = strlen(namespace) + 1;
+		iterator->start = (start != NULL) ? g_strdup_printf("%s:%s", namespace, start) : NULL;
+		iterator->end = (end != NULL) ? g_strdup_printf("%s:%s", namespace, end) : NULL;
+		iterator->reverse = reverse;
+		iterator->limit = limit;
+		iterator->count = 0;
+
+		*backend_iterator = iterator;
+	}
+
+	return (iterator != NULL);
+}
+
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	JLevelDBIterator* iterator = backend_iterator;
+
+	(void)backend_data;
+
+	g_free(iterator->prefix);
+	g_free(iterator->start);
+	g_free(iterator->end);
+	leveldb_iter_destroy(iterator->iterator);
+	g_slice_free(JLevelDBIterator, iterator);
+}
+
 static gboolean
 backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** key, gconstpointer* value, guint32* len)
 {
@@ -232,11 +490,53 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	g_return_val_if_fail(value != NULL, FALSE);
 	g_return_val_if_fail(len != NULL, FALSE);
 
+	if (iterator->limit > 0 && iterator->count >= iterator->limit)
+	{
+		goto out;
+	}
+
 	if (iterator->first)
 	{
-		leveldb_iter_seek(iterator->iterator, iterator->prefix, strlen(iterator->prefix));
+		if (!iterator->reverse)
+		{
+			gchar const* lower = (iterator->start != NULL) ? iterator->start : iterator->prefix;
+
+			leveldb_iter_seek(iterator->iterator, lower, strlen(lower));
+		}
+		else
+		{
+			g_autofree gchar* upper = NULL;
+
+			if (iterator->end != NULL)
+			{
+				upper = g_strdup(iterator->end);
+			}
+			else
+			{
+				// The first key that does not have the prefix anymore.
+				upper = g_strdup(iterator->prefix);
+				upper[strlen(upper) - 1]++;
+			}
+
+			// Position the iterator at the last key before the upper bound.
+			leveldb_iter_seek(iterator->iterator, upper, strlen(upper));
+
+			if (leveldb_iter_valid(iterator->iterator))
+			{
+				leveldb_iter_prev(iterator->iterator);
+			}
+			else
+			{
+				leveldb_iter_seek_to_last(iterator->iterator);
+			}
+		}
+
 		iterator->first = FALSE;
 	}
+	else if (iterator->reverse)
+	{
+		leveldb_iter_prev(iterator->iterator);
+	}
 	else
 	{
 		leveldb_iter_next(iterator->iterator);
@@ -254,6 +554,18 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 			goto out;
 		}
 
+		if (iterator->end != NULL && g_strcmp0(key_, iterator->end) >= 0)
+		{
+			goto out;
+		}
+
+		if (iterator->start != NULL && g_strcmp0(key_, iterator->start) < 0)
+		{
+			goto out;
+		}
+
+		iterator->count++;
+
 		*key = key_ + iterator->namespace_len;
 		*value = leveldb_iter_value(iterator->iterator, &tmp);
 		*len = tmp;
@@ -262,9 +574,7 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	}
 
 out:
-	g_free(iterator->prefix);
-	leveldb_iter_destroy(iterator->iterator);
-	g_slice_free(JLevelDBIterator, iterator);
+	backend_iterate_free(backend_data, backend_iterator);
 
 	return FALSE;
 }
@@ -288,6 +598,8 @@ backend_init(gchar const* path, gpointer* backend_data)
 	bd->write_options_sync = leveldb_writeoptions_create();
 	leveldb_writeoptions_set_sync(bd->write_options_sync, 1);
 
+	g_mutex_init(&(bd->update_lock));
+
 	options = leveldb_options_create();
 	leveldb_options_set_create_if_missing(options, 1);
 
@@ -325,6 +637,8 @@ backend_fini(gpointer backend_data)
 		leveldb_close(bd->db);
 	}
 
+	g_mutex_clear(&(bd->update_lock));
+
 	g_slice_free(JLevelDBData, bd);
 }
 
@@ -341,7 +655,13 @@ static JBackend leveldb_backend = {
 		.backend_get = backend_get,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_get_range = backend_get_range,
+		.backend_iterate = backend_iterate,
+		.backend_delete_by_prefix = backend_delete_by_prefix,
+		.backend_iterate_free = backend_iterate_free,
+		.backend_compare_and_swap = backend_compare_and_swap,
+		.backend_add = backend_add,
+		.backend_append = backend_append }
 };
 
 G_MODULE_EXPORT
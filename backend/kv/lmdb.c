@@ -27,7 +27,19 @@
 
 struct JLMDBBatch
 {
-	MDB_txn* txn;
+	/**
+	 * The transactions are started by the first operation that needs them.
+	 * Reads use the write transaction if there is one, so that they see the batch's own writes.
+	 **/
+	MDB_txn* read_txn;
+	MDB_txn* write_txn;
+
+	/**
+	 * The map size when the write transaction was started.
+	 **/
+	gsize map_size;
+	gboolean map_full;
+
 	gchar* namespace;
 	JSemantics* semantics;
 };
@@ -38,6 +50,28 @@ struct JLMDBData
 {
 	MDB_env* env;
 	MDB_dbi dbi;
+
+	/**
+	 * Protects the following members.
+	 * The map can only be resized while no transactions are active.
+	 **/
+	GMutex lock;
+	GCond cond;
+
+	guint transactions;
+
+	/**
+	 * The number of transactions held by iterators, which can stay open indefinitely.
+	 **/
+	guint iterators;
+
+	gboolean resizing;
+	gsize map_size;
+
+	/**
+	 * Reset read-only transactions that can be renewed.
+	 **/
+	GQueue readers;
 };
 
 typedef struct JLMDBData JLMDBData;
@@ -49,58 +83,313 @@ struct JLMDBIterator
 	gboolean first;
 	gchar* prefix;
 	gsize namespace_len;
+
+	/**
+	 * The range's bounds including the namespace, NULL if unbounded.
+	 * The start is inclusive, the end is exclusive.
+	 **/
+	gchar* start;
+	gchar* end;
+
+	gboolean reverse;
+
+	/**
+	 * The maximum number of pairs, 0 if unlimited.
+	 **/
+	guint32 limit;
+	guint32 count;
 };
 
 typedef struct JLMDBIterator JLMDBIterator;
 
+/**
+ * Doubles the map size.
+ * The map cannot be resized while iterators are open, growing it is not attempted then.
+ *
+ * \param map_size The map size observed by the caller, the map is not grown again if another thread already grew it.
+ * \param full     Whether the map is full, which is reported if it cannot be grown.
+ *
+ * \return TRUE if the map is larger than map_size afterwards, FALSE otherwise.
+ **/
 static gboolean
-backend_batch_start(gpointer backend_data, gchar const* namespace, JSemantics* semantics, gpointer* data)
+jd_lmdb_grow(JLMDBData* bd, gsize map_size, gboolean full)
 {
-	JLMDBData* bd = backend_data;
-	JLMDBBatch* batch = NULL;
+	gboolean ret = FALSE;
+
 	MDB_txn* txn;
 
-	g_return_val_if_fail(namespace != NULL, FALSE);
-	g_return_val_if_fail(data != NULL, FALSE);
+	g_mutex_lock(&(bd->lock));
 
-	if (mdb_txn_begin(bd->env, NULL, 0, &txn) == 0)
+	while (bd->resizing)
 	{
-		batch = g_slice_new(JLMDBBatch);
-		batch->txn = txn;
-		batch->namespace = g_strdup(namespace);
-		batch->semantics = j_semantics_ref(semantics);
+		g_cond_wait(&(bd->cond), &(bd->lock));
 	}
 
+	if (bd->map_size > map_size)
+	{
+		ret = TRUE;
+		goto out;
+	}
+
+	// Iterators might be kept open for a long time, waiting for them would stall all other requests.
+	if (bd->iterators > 0)
+	{
+		goto out;
+	}
+
+	// New transactions are held back until the map has been resized, the remaining ones are short-lived.
+	bd->resizing = TRUE;
+
+	while (bd->transactions > 0)
+	{
+		g_cond_wait(&(bd->cond), &(bd->lock));
+	}
+
+	// Reset transactions still refer to the old map.
+	while ((txn = g_queue_pop_head(&(bd->readers))) != NULL)
+	{
+		mdb_txn_abort(txn);
+	}
+
+	if (mdb_env_set_mapsize(bd->env, bd->map_size * 2) == 0)
+	{
+		bd->map_size *= 2;
+		ret = TRUE;
+	}
+
+	bd->resizing = FALSE;
+	g_cond_broadcast(&(bd->cond));
+
+out:
+	if (!ret && full)
+	{
+		g_warning("Could not grow LMDB map beyond %" G_GSIZE_FORMAT " bytes.", bd->map_size);
+	}
+
+	g_mutex_unlock(&(bd->lock));
+
+	return ret;
+}
+
+/**
+ * Starts a transaction.
+ * Read-only transactions are renewed from the reset ones if possible.
+ *
+ * \param grow Whether the map may be grown before starting a write transaction, which is not possible while the caller holds another transaction.
+ * \param map_size Returns the map size the transaction was started with.
+ **/
+static MDB_txn*
+jd_lmdb_txn_begin(JLMDBData* bd, gboolean write, gboolean grow, gsize* map_size)
+{
+	MDB_txn* txn = NULL;
+
+	if (write && grow)
+	{
+		MDB_envinfo info;
+		MDB_stat stat;
+
+		// A full map fails the whole transaction, so grow it as soon as it is three quarters full.
+		// If iterators prevent growing it now, the next write transaction tries again.
+		if (mdb_env_info(bd->env, &info) == 0 && mdb_env_stat(bd->env, &stat) == 0 && (info.me_last_pgno + 1) * stat.ms_psize > info.me_mapsize / 4 * 3)
+		{
+			jd_lmdb_grow(bd, info.me_mapsize, FALSE);
+		}
+	}
+
+	g_mutex_lock(&(bd->lock));
+
+	while (bd->resizing)
+	{
+		g_cond_wait(&(bd->cond), &(bd->lock));
+	}
+
+	bd->transactions++;
+
+	if (!write)
+	{
+		txn = g_queue_pop_head(&(bd->readers));
+	}
+
+	if (map_size != NULL)
+	{
+		*map_size = bd->map_size;
+	}
+
+	g_mutex_unlock(&(bd->lock));
+
+	if (txn != NULL && mdb_txn_renew(txn) != 0)
+	{
+		mdb_txn_abort(txn);
+		txn = NULL;
+	}
+
+	if (txn == NULL && mdb_txn_begin(bd->env, NULL, (write) ? 0 : MDB_RDONLY, &txn) != 0)
+	{
+		txn = NULL;
+
+		g_mutex_lock(&(bd->lock));
+
+		if (--bd->transactions == 0)
+		{
+			g_cond_broadcast(&(bd->cond));
+		}
+
+		g_mutex_unlock(&(bd->lock));
+	}
+
+	return txn;
+}
+
+/**
+ * Ends a transaction.
+ * Write transactions are committed or aborted, read-only transactions are reset for reuse.
+ *
+ * \return The result of committing the transaction.
+ **/
+static gint
+jd_lmdb_txn_end(JLMDBData* bd, MDB_txn* txn, gboolean write, gboolean commit)
+{
+	gint ret = 0;
+
+	if (!write)
+	{
+		mdb_txn_reset(txn);
+	}
+	else if (commit)
+	{
+		ret = mdb_txn_commit(txn);
+	}
+	else
+	{
+		mdb_txn_abort(txn);
+	}
+
+	g_mutex_lock(&(bd->lock));
+
+	if (!write)
+	{
+		g_queue_push_head(&(bd->readers), txn);
+	}
+
+	if (--bd->transactions == 0)
+	{
+		g_cond_broadcast(&(bd->cond));
+	}
+
+	g_mutex_unlock(&(bd->lock));
+
+	return ret;
+}
+
+static MDB_txn*
+jd_lmdb_batch_read_txn(JLMDBData* bd, JLMDBBatch* batch)
+{
+	if (batch->write_txn != NULL)
+	{
+		return batch->write_txn;
+	}
+
+	if (batch->read_txn == NULL)
+	{
+		batch->read_txn = jd_lmdb_txn_begin(bd, FALSE, FALSE, NULL);
+	}
+
+	return batch->read_txn;
+}
+
+static MDB_txn*
+jd_lmdb_batch_write_txn(JLMDBData* bd, JLMDBBatch* batch)
+{
+	if (batch->write_txn == NULL)
+	{
+		// Values returned from the read transaction have to stay valid, so it is kept open.
+		batch->write_txn = jd_lmdb_txn_begin(bd, TRUE, (batch->read_txn == NULL), &(batch->map_size));
+	}
+
+	return batch->write_txn;
+}
+
+/**
+ * Checks the result of a write operation and remembers whether the map was full.
+ **/
+static gboolean
+jd_lmdb_batch_check(JLMDBBatch* batch, gint ret)
+{
+	if (ret == MDB_MAP_FULL)
+	{
+		batch->map_full = TRUE;
+	}
+
+	return (ret == 0);
+}
+
+static gboolean
+backend_batch_start(gpointer backend_data, gchar const* namespace, JSemantics* semantics, gpointer* data)
+{
+	JLMDBBatch* batch;
+
+	(void)backend_data;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+
+	batch = g_slice_new(JLMDBBatch);
+	batch->read_txn = NULL;
+	batch->write_txn = NULL;
+	batch->map_size = 0;
+	batch->map_full = FALSE;
+	batch->namespace = g_strdup(namespace);
+	batch->semantics = j_semantics_ref(semantics);
+
 	*data = batch;
 
-	return (batch != NULL);
+	return TRUE;
 }
 
 static gboolean
 backend_batch_execute(gpointer backend_data, gpointer data)
 {
-	gboolean ret = FALSE;
+	gint ret = 0;
 
+	JLMDBData* bd = backend_data;
 	JLMDBBatch* batch = data;
 
-	(void)backend_data;
-
 	g_return_val_if_fail(data != NULL, FALSE);
 
-	/// \todo do something with batch->semantics
+	if (batch->write_txn != NULL)
+	{
+		if (batch->map_full)
+		{
+			jd_lmdb_txn_end(bd, batch->write_txn, TRUE, FALSE);
+			ret = MDB_MAP_FULL;
+		}
+		else
+		{
+			ret = jd_lmdb_txn_end(bd, batch->write_txn, TRUE, TRUE);
+		}
+	}
 
-	if (mdb_txn_commit(batch->txn) == 0)
+	if (batch->read_txn != NULL)
 	{
-		ret = TRUE;
+		jd_lmdb_txn_end(bd, batch->read_txn, FALSE, FALSE);
 	}
 
-	/// \todo free txn
+	if (ret == MDB_MAP_FULL)
+	{
+		// The batch has failed, but the following ones will fit.
+		jd_lmdb_grow(bd, batch->map_size, TRUE);
+	}
+	else if (ret == 0 && batch->write_txn != NULL && j_semantics_get(batch->semantics, J_SEMANTICS_PERSISTENCY) == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		// The environment is opened with MDB_NOSYNC, so commits only reach the page cache.
+		ret = mdb_env_sync(bd->env, 1);
+	}
 
 	j_semantics_unref(batch->semantics);
 	g_free(batch->namespace);
 	g_slice_free(JLMDBBatch, batch);
 
-	return ret;
+	return (ret == 0);
 }
 
 static gboolean
@@ -108,6 +397,7 @@ backend_put(gpointer backend_data, gpointer data, gchar const* key, gconstpointe
 {
 	JLMDBData* bd = backend_data;
 	JLMDBBatch* batch = data;
+	MDB_txn* txn;
 	MDB_val m_key;
 	MDB_val m_value;
 	g_autofree gchar* nskey = NULL;
@@ -123,7 +413,12 @@ backend_put(gpointer backend_data, gpointer data, gchar const* key, gconstpointe
 	m_value.mv_size = len;
 	m_value.mv_data = value;
 
-	return (mdb_put(batch->txn, bd->dbi, &m_key, &m_value, 0) == 0);
+	if ((txn = jd_lmdb_batch_write_txn(bd, batch)) == NULL)
+	{
+		return FALSE;
+	}
+
+	return jd_lmdb_batch_check(batch, mdb_put(txn, bd->dbi, &m_key, &m_value, 0));
 }
 
 static gboolean
@@ -131,6 +426,7 @@ backend_delete(gpointer backend_data, gpointer data, gchar const* key)
 {
 	JLMDBData* bd = backend_data;
 	JLMDBBatch* batch = data;
+	MDB_txn* txn;
 	MDB_val m_key;
 	g_autofree gchar* nskey = NULL;
 
@@ -142,7 +438,203 @@ backend_delete(gpointer backend_data, gpointer data, gchar const* key)
 	m_key.mv_size = strlen(nskey) + 1;
 	m_key.mv_data = nskey;
 
-	return (mdb_del(batch->txn, bd->dbi, &m_key, NULL) == 0);
+	if ((txn = jd_lmdb_batch_write_txn(bd, batch)) == NULL)
+	{
+		return FALSE;
+	}
+
+	return jd_lmdb_batch_check(batch, mdb_del(txn, bd->dbi, &m_key, NULL));
+}
+
+static gboolean
+backend_delete_by_prefix(gpointer backend_data, gpointer data, gchar const* prefix)
+{
+	gboolean ret = TRUE;
+
+	JLMDBData* bd = backend_data;
+	JLMDBBatch* batch = data;
+	MDB_txn* txn;
+	MDB_cursor* cursor;
+	MDB_cursor_op cursor_op = MDB_SET_RANGE;
+	MDB_val m_key;
+	MDB_val m_value;
+	g_autofree gchar* nsprefix = NULL;
+
+	g_return_val_if_fail(data != NULL, FALSE);
+
+	nsprefix = g_strdup_printf("%s:%s", batch->namespace, (prefix != NULL) ? prefix : "");
+
+	if ((txn = jd_lmdb_batch_write_txn(bd, batch)) == NULL || mdb_cursor_open(txn, bd->dbi, &cursor) != 0)
+	{
+		return FALSE;
+	}
+
+	m_key.mv_size = strlen(nsprefix);
+	m_key.mv_data = nsprefix;
+
+	// After mdb_cursor_del, MDB_NEXT returns the entry following the deleted one.
+	while (mdb_cursor_get(cursor, &m_key, &m_value, cursor_op) == 0)
+	{
+		if (!g_str_has_prefix(m_key.mv_data, nsprefix))
+		{
+			break;
+		}
+
+		if (!jd_lmdb_batch_check(batch, mdb_cursor_del(cursor, 0)))
+		{
+			ret = FALSE;
+			break;
+		}
+
+		cursor_op = MDB_NEXT;
+	}
+
+	mdb_cursor_close(cursor);
+
+	return ret;
+}
+
+static gboolean
+backend_compare_and_swap(gpointer backend_data, gpointer data, gchar const* key, gconstpointer expected, guint32 expected_len, gconstpointer value, guint32 len)
+{
+	JLMDBData* bd = backend_data;
+	JLMDBBatch* batch = data;
+	MDB_txn* txn;
+	MDB_val m_key;
+	MDB_val m_value;
+	g_autofree gchar* nskey = NULL;
+	gint ret;
+
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	m_key.mv_size = strlen(nskey) + 1;
+	m_key.mv_data = nskey;
+
+	if ((txn = jd_lmdb_batch_write_txn(bd, batch)) == NULL)
+	{
+		return FALSE;
+	}
+
+	// The batch's write transaction serializes all writers, so reading and modifying the value within it is atomic.
+	ret = mdb_get(txn, bd->dbi, &m_key, &m_value);
+
+	if (expected == NULL)
+	{
+		if (ret != MDB_NOTFOUND)
+		{
+			return FALSE;
+		}
+	}
+	else if (ret != 0 || m_value.mv_size != expected_len || memcmp(m_value.mv_data, expected, expected_len) != 0)
+	{
+		return FALSE;
+	}
+
+	m_value.mv_size = len;
+	m_value.mv_data = (gpointer)value;
+
+	return jd_lmdb_batch_check(batch, mdb_put(txn, bd->dbi, &m_key, &m_value, 0));
+}
+
+static gboolean
+backend_add(gpointer backend_data, gpointer data, gchar const* key, gint64 delta)
+{
+	JLMDBData* bd = backend_data;
+	JLMDBBatch* batch = data;
+	MDB_txn* txn;
+	MDB_val m_key;
+	MDB_val m_value;
+	g_autofree gchar* nskey = NULL;
+	gint64 counter = 0;
+
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	m_key.mv_size = strlen(nskey) + 1;
+	m_key.mv_data = nskey;
+
+	if ((txn = jd_lmdb_batch_write_txn(bd, batch)) == NULL)
+	{
+		return FALSE;
+	}
+
+	if (mdb_get(txn, bd->dbi, &m_key, &m_value) == 0)
+	{
+		if (m_value.mv_size != sizeof(counter))
+		{
+			return FALSE;
+		}
+
+		memcpy(&counter, m_value.mv_data, sizeof(counter));
+		counter = GINT64_FROM_LE(counter);
+	}
+
+	counter = GINT64_TO_LE(counter + delta);
+
+	m_value.mv_size = sizeof(counter);
+	m_value.mv_data = &counter;
+
+	return jd_lmdb_batch_check(batch, mdb_put(txn, bd->dbi, &m_key, &m_value, 0));
+}
+
+static gboolean
+backend_append(gpointer backend_data, gpointer data, gchar const* key, gconstpointer value, guint32 len)
+{
+	JLMDBData* bd = backend_data;
+	JLMDBBatch* batch = data;
+	MDB_txn* txn;
+	MDB_val m_key;
+	MDB_val m_value;
+	g_autofree gchar* nskey = NULL;
+	g_autofree gpointer current = NULL;
+	gsize current_len = 0;
+
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	m_key.mv_size = strlen(nskey) + 1;
+	m_key.mv_data = nskey;
+
+	if ((txn = jd_lmdb_batch_write_txn(bd, batch)) == NULL)
+	{
+		return FALSE;
+	}
+
+	if (mdb_get(txn, bd->dbi, &m_key, &m_value) == 0)
+	{
+		// The old value might be overwritten when reserving space for the new one.
+#if GLIB_CHECK_VERSION(2, 68, 0)
+		current = g_memdup2(m_value.mv_data, m_value.mv_size);
+#else
+		current = g_memdup(m_value.mv_data, m_value.mv_size);
+#endif
+		current_len = m_value.mv_size;
+	}
+
+	m_value.mv_size = current_len + len;
+
+	if (!jd_lmdb_batch_check(batch, mdb_put(txn, bd->dbi, &m_key, &m_value, MDB_RESERVE)))
+	{
+		return FALSE;
+	}
+
+	if (current_len > 0)
+	{
+		memcpy(m_value.mv_data, current, current_len);
+	}
+
+	memcpy((gchar*)m_value.mv_data + current_len, value, len);
+
+	return TRUE;
 }
 
 static gboolean
@@ -152,6 +644,7 @@ backend_get(gpointer backend_data, gpointer data, gchar const* key, gpointer* va
 
 	JLMDBData* bd = backend_data;
 	JLMDBBatch* batch = data;
+	MDB_txn* txn;
 	MDB_val m_key;
 	MDB_val m_value;
 	g_autofree gchar* nskey = NULL;
@@ -166,7 +659,12 @@ backend_get(gpointer backend_data, gpointer data, gchar const* key, gpointer* va
 	m_key.mv_size = strlen(nskey) + 1;
 	m_key.mv_data = nskey;
 
-	if (mdb_get(batch->txn, bd->dbi, &m_key, &m_value) == 0)
+	if ((txn = jd_lmdb_batch_read_txn(bd, batch)) == NULL)
+	{
+		return FALSE;
+	}
+
+	if (mdb_get(txn, bd->dbi, &m_key, &m_value) == 0)
 	{
 		/// \todo check whether copies can be avoided
 #if GLIB_CHECK_VERSION(2, 68, 0)
@@ -183,22 +681,93 @@ backend_get(gpointer backend_data, gpointer data, gchar const* key, gpointer* va
 }
 
 static gboolean
-backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* data)
+backend_get_view(gpointer backend_data, gpointer data, gchar const* key, gconstpointer* value, guint32* len)
 {
+	gboolean ret = FALSE;
+
 	JLMDBData* bd = backend_data;
-	JLMDBIterator* iterator = NULL;
+	JLMDBBatch* batch = data;
+	MDB_txn* txn;
+	MDB_val m_key;
+	MDB_val m_value;
+	g_autofree gchar* nskey = NULL;
 
-	g_return_val_if_fail(namespace != NULL, FALSE);
 	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+	g_return_val_if_fail(len != NULL, FALSE);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	m_key.mv_size = strlen(nskey) + 1;
+	m_key.mv_data = nskey;
+
+	if ((txn = jd_lmdb_batch_read_txn(bd, batch)) == NULL)
+	{
+		return FALSE;
+	}
+
+	// The value points into the memory map and stays valid until the transaction ends.
+	if (mdb_get(txn, bd->dbi, &m_key, &m_value) == 0)
+	{
+		*value = m_value.mv_data;
+		*len = m_value.mv_size;
+
+		ret = TRUE;
+	}
+
+	return ret;
+}
+
+static JLMDBIterator*
+jd_lmdb_iterator_new(JLMDBData* bd, gchar const* namespace, gchar* prefix, gchar const* start, gchar const* end, guint32 limit, gboolean reverse)
+{
+	JLMDBIterator* iterator;
+	MDB_txn* txn;
+
+	// Iterators are counted before starting their transactions, so that the map is never resized while waiting for them.
+	g_mutex_lock(&(bd->lock));
+	bd->iterators++;
+	g_mutex_unlock(&(bd->lock));
+
+	// Iterators only read, so they must not block writers while they are kept open.
+	if ((txn = jd_lmdb_txn_begin(bd, FALSE, FALSE, NULL)) == NULL)
+	{
+		g_mutex_lock(&(bd->lock));
+		bd->iterators--;
+		g_mutex_unlock(&(bd->lock));
+
+		g_free(prefix);
+		return NULL;
+	}
 
 	iterator = g_slice_new(JLMDBIterator);
+	iterator->txn = txn;
 	iterator->first = TRUE;
-	iterator->prefix = g_strdup_printf("%s:", namespace);
+	iterator->prefix = prefix;
 	iterator->namespace_len = strlen(namespace) + 1;
+	iterator->start = (start != NULL) ? g_strdup_printf("%s:%s", namespace, start) : NULL;
+	iterator->end = (end != NULL) ? g_strdup_printf("%s:%s", namespace, end) : NULL;
+	iterator->reverse = reverse;
+	iterator->limit = limit;
+	iterator->count = 0;
 
-	mdb_txn_begin(bd->env, NULL, 0, &(iterator->txn));
 	mdb_cursor_open(iterator->txn, bd->dbi, &(iterator->cursor));
 
+	return iterator;
+}
+
+static gboolean
+backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* data)
+{
+	JLMDBData* bd = backend_data;
+	JLMDBIterator* iterator = NULL;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+
+	iterator = jd_lmdb_iterator_new(bd, namespace, g_strdup_printf("%s:", namespace), NULL, NULL, 0, FALSE);
+
 	*data = iterator;
 
 	return (iterator != NULL);
@@ -214,26 +783,56 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 	g_return_val_if_fail(prefix != NULL, FALSE);
 	g_return_val_if_fail(data != NULL, FALSE);
 
-	iterator = g_slice_new(JLMDBIterator);
-	iterator->first = TRUE;
-	iterator->prefix = g_strdup_printf("%s:%s", namespace, prefix);
-	iterator->namespace_len = strlen(namespace) + 1;
+	iterator = jd_lmdb_iterator_new(bd, namespace, g_strdup_printf("%s:%s", namespace, prefix), NULL, NULL, 0, FALSE);
 
-	mdb_txn_begin(bd->env, NULL, 0, &(iterator->txn));
-	mdb_cursor_open(iterator->txn, bd->dbi, &(iterator->cursor));
+	*data = iterator;
+
+	return (iterator != NULL);
+}
+
+static gboolean
+backend_get_range(gpointer backend_data, gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse, gpointer* data)
+{
+	JLMDBData* bd = backend_data;
+	JLMDBIterator* iterator = NULL;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+
+	iterator = jd_lmdb_iterator_new(bd, namespace, g_strdup_printf("%s:", namespace), start, end, limit, reverse);
 
 	*data = iterator;
 
 	return (iterator != NULL);
 }
 
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	JLMDBData* bd = backend_data;
+	JLMDBIterator* iterator = backend_iterator;
+
+	mdb_cursor_close(iterator->cursor);
+	jd_lmdb_txn_end(bd, iterator->txn, FALSE, FALSE);
+
+	g_mutex_lock(&(bd->lock));
+	bd->iterators--;
+	g_mutex_unlock(&(bd->lock));
+
+	g_free(iterator->prefix);
+	g_free(iterator->start);
+	g_free(iterator->end);
+	g_slice_free(JLMDBIterator, iterator);
+}
+
 static gboolean
 backend_iterate(gpointer backend_data, gpointer data, gchar const** key, gconstpointer* value, guint32* len)
 {
 	JLMDBIterator* iterator = data;
-	MDB_cursor_op cursor_op = MDB_NEXT;
+	MDB_cursor_op cursor_op;
 	MDB_val m_key;
 	MDB_val m_value;
+	gint ret;
 
 	(void)backend_data;
 
@@ -241,18 +840,53 @@ backend_iterate(gpointer backend_data, gpointer data, gchar const** key, gconstp
 	g_return_val_if_fail(value != NULL, FALSE);
 	g_return_val_if_fail(len != NULL, FALSE);
 
+	if (iterator->limit > 0 && iterator->count >= iterator->limit)
+	{
+		goto out;
+	}
+
 	if (iterator->first)
 	{
-		/// \todo check +1
-		m_key.mv_size = strlen(iterator->prefix) + 1;
-		m_key.mv_data = iterator->prefix;
+		iterator->first = FALSE;
 
-		cursor_op = MDB_SET_RANGE;
+		if (!iterator->reverse)
+		{
+			/// \todo check +1
+			m_key.mv_data = (iterator->start != NULL) ? iterator->start : iterator->prefix;
+			m_key.mv_size = strlen(m_key.mv_data) + 1;
 
-		iterator->first = FALSE;
+			ret = mdb_cursor_get(iterator->cursor, &m_key, &m_value, MDB_SET_RANGE);
+		}
+		else
+		{
+			g_autofree gchar* upper = NULL;
+
+			if (iterator->end != NULL)
+			{
+				upper = g_strdup(iterator->end);
+			}
+			else
+			{
+				// The first key that does not have the prefix anymore.
+				upper = g_strdup(iterator->prefix);
+				upper[strlen(upper) - 1]++;
+			}
+
+			m_key.mv_data = upper;
+			m_key.mv_size = strlen(upper) + 1;
+
+			// Position the cursor at the last key before the upper bound.
+			cursor_op = (mdb_cursor_get(iterator->cursor, &m_key, &m_value, MDB_SET_RANGE) == 0) ? MDB_PREV : MDB_LAST;
+			ret = mdb_cursor_get(iterator->cursor, &m_key, &m_value, cursor_op);
+		}
+	}
+	else
+	{
+		cursor_op = (iterator->reverse) ? MDB_PREV : MDB_NEXT;
+		ret = mdb_cursor_get(iterator->cursor, &m_key, &m_value, cursor_op);
 	}
 
-	if (mdb_cursor_get(iterator->cursor, &m_key, &m_value, cursor_op) == 0)
+	if (ret == 0)
 	{
 		if (!g_str_has_prefix(m_key.mv_data, iterator->prefix))
 		{
@@ -260,6 +894,18 @@ backend_iterate(gpointer backend_data, gpointer data, gchar const** key, gconstp
 			goto out;
 		}
 
+		if (iterator->end != NULL && g_strcmp0(m_key.mv_data, iterator->end) >= 0)
+		{
+			goto out;
+		}
+
+		if (iterator->start != NULL && g_strcmp0(m_key.mv_data, iterator->start) < 0)
+		{
+			goto out;
+		}
+
+		iterator->count++;
+
 		*key = (gchar const*)m_key.mv_data + iterator->namespace_len;
 		*value = m_value.mv_data;
 		*len = m_value.mv_size;
@@ -268,10 +914,7 @@ backend_iterate(gpointer backend_data, gpointer data, gchar const** key, gconstp
 	}
 
 out:
-	mdb_txn_commit(iterator->txn);
-
-	g_free(iterator->prefix);
-	g_slice_free(JLMDBIterator, iterator);
+	backend_iterate_free(backend_data, data);
 
 	return FALSE;
 }
@@ -287,20 +930,38 @@ backend_init(gchar const* path, gpointer* backend_data)
 	g_mkdir_with_parents(path, 0700);
 
 	bd = g_slice_new(JLMDBData);
+	bd->transactions = 0;
+	bd->iterators = 0;
+	bd->resizing = FALSE;
+	g_mutex_init(&(bd->lock));
+	g_cond_init(&(bd->cond));
+	g_queue_init(&(bd->readers));
 
 	if (mdb_env_create(&(bd->env)) == 0)
 	{
-		/// \todo grow mapsize dynamically (default is 10 MiB)
+		MDB_envinfo info;
+
+		// The map is grown when it becomes full.
 		if (mdb_env_set_mapsize(bd->env, (gsize)4 * 1024 * 1024 * 1024) != 0)
 		{
 			goto error;
 		}
 
-		if (mdb_env_open(bd->env, path, 0, 0600) != 0)
+		// Iterators keep their read transactions across requests, which can be handled by different threads.
+		// Commits are only synced for batches that require it, see backend_batch_execute.
+		if (mdb_env_open(bd->env, path, MDB_NOTLS | MDB_NOSYNC, 0600) != 0)
+		{
+			goto error;
+		}
+
+		// The map size stored in the environment might be larger than the one set above.
+		if (mdb_env_info(bd->env, &info) != 0)
 		{
 			goto error;
 		}
 
+		bd->map_size = info.me_mapsize;
+
 		if (mdb_txn_begin(bd->env, NULL, 0, &txn) != 0)
 		{
 			goto error;
@@ -323,6 +984,8 @@ backend_init(gchar const* path, gpointer* backend_data)
 
 error:
 	mdb_env_close(bd->env);
+	g_cond_clear(&(bd->cond));
+	g_mutex_clear(&(bd->lock));
 	g_slice_free(JLMDBData, bd);
 
 	return FALSE;
@@ -332,12 +995,21 @@ static void
 backend_fini(gpointer backend_data)
 {
 	JLMDBData* bd = backend_data;
+	MDB_txn* txn;
+
+	while ((txn = g_queue_pop_head(&(bd->readers))) != NULL)
+	{
+		mdb_txn_abort(txn);
+	}
 
 	if (bd->env != NULL)
 	{
+		mdb_env_sync(bd->env, 1);
 		mdb_env_close(bd->env);
 	}
 
+	g_cond_clear(&(bd->cond));
+	g_mutex_clear(&(bd->lock));
 	g_slice_free(JLMDBData, bd);
 }
 
@@ -354,7 +1026,14 @@ static JBackend lmdb_backend = {
 		.backend_get = backend_get,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_get_range = backend_get_range,
+		.backend_iterate = backend_iterate,
+		.backend_delete_by_prefix = backend_delete_by_prefix,
+		.backend_iterate_free = backend_iterate_free,
+		.backend_get_view = backend_get_view,
+		.backend_compare_and_swap = backend_compare_and_swap,
+		.backend_add = backend_add,
+		.backend_append = backend_append }
 };
 
 G_MODULE_EXPORT
@@ -361,6 +361,84 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 	return ret;
 }
 
+static gboolean
+backend_get_range(gpointer backend_data, gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse, gpointer* backend_iterator)
+{
+	JMongoDBData* bd = backend_data;
+	gboolean ret = FALSE;
+
+	bson_t collation[1];
+	bson_t document[1];
+	bson_t opts[1];
+	bson_t range[1];
+	bson_t sort[1];
+	mongoc_collection_t* m_collection;
+	mongoc_cursor_t* cursor;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	bson_init(document);
+	bson_init(opts);
+
+	if (start != NULL || end != NULL)
+	{
+		bson_append_document_begin(document, "key", -1, range);
+
+		if (start != NULL)
+		{
+			bson_append_utf8(range, "$gte", -1, start, -1);
+		}
+
+		if (end != NULL)
+		{
+			bson_append_utf8(range, "$lt", -1, end, -1);
+		}
+
+		bson_append_document_end(document, range);
+	}
+
+	bson_append_document_begin(opts, "sort", -1, sort);
+	bson_append_int32(sort, "key", -1, (reverse) ? -1 : 1);
+	bson_append_document_end(opts, sort);
+
+	// Keys are compared bytewise even if the collection has a default collation, as clients expect when merging the ranges of multiple servers.
+	bson_append_document_begin(opts, "collation", -1, collation);
+	bson_append_utf8(collation, "locale", -1, "simple", -1);
+	bson_append_document_end(opts, collation);
+
+	if (limit > 0)
+	{
+		bson_append_int64(opts, "limit", -1, limit);
+	}
+
+	m_collection = mongoc_client_get_collection(bd->connection, bd->database, namespace);
+	cursor = mongoc_collection_find_with_opts(m_collection, document, opts, NULL);
+
+	if (cursor != NULL)
+	{
+		ret = TRUE;
+		*backend_iterator = cursor;
+	}
+
+	mongoc_collection_destroy(m_collection);
+
+	bson_destroy(opts);
+	bson_destroy(document);
+
+	return ret;
+}
+
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	mongoc_cursor_t* cursor = backend_iterator;
+
+	(void)backend_data;
+
+	mongoc_cursor_destroy(cursor);
+}
+
 static gboolean
 backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** key, gconstpointer* value, guint32* len)
 {
@@ -405,7 +483,7 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	}
 	else
 	{
-		mongoc_cursor_destroy(cursor);
+		backend_iterate_free(backend_data, backend_iterator);
 	}
 
 	return ret;
@@ -489,7 +567,9 @@ static JBackend mongodb_backend = {
 		.backend_get = backend_get,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_get_range = backend_get_range,
+		.backend_iterate = backend_iterate,
+		.backend_iterate_free = backend_iterate_free }
 };
 
 G_MODULE_EXPORT
@@ -41,20 +41,154 @@ struct JRocksDBData
 	rocksdb_readoptions_t* read_options;
 	rocksdb_writeoptions_t* write_options;
 	rocksdb_writeoptions_t* write_options_sync;
+
+	/**
+	 * Serializes compare-and-swap operations.
+	 **/
+	GMutex cas_lock;
 };
 
 typedef struct JRocksDBData JRocksDBData;
 
+/**
+ * The types of merge operands, which are stored in their first byte.
+ **/
+enum JRocksDBMergeType
+{
+	/**
+	 * Adds a little-endian 64-bit integer to a counter.
+	 **/
+	J_ROCKSDB_MERGE_ADD = 1,
+
+	/**
+	 * Appends data to a value.
+	 **/
+	J_ROCKSDB_MERGE_APPEND = 2
+};
+
+typedef enum JRocksDBMergeType JRocksDBMergeType;
+
 struct JRocksDBIterator
 {
 	rocksdb_iterator_t* iterator;
 	gboolean first;
 	gchar* prefix;
 	gsize namespace_len;
+
+	/**
+	 * The range's bounds including the namespace, NULL if unbounded.
+	 * The start is inclusive, the end is exclusive.
+	 **/
+	gchar* start;
+	gchar* end;
+
+	gboolean reverse;
+
+	/**
+	 * The maximum number of pairs, 0 if unlimited.
+	 **/
+	guint32 limit;
+	guint32 count;
 };
 
 typedef struct JRocksDBIterator JRocksDBIterator;
 
+static gchar*
+jd_rocksdb_merge_full(gpointer state, gchar const* key, gsize key_len, gchar const* existing_value, gsize existing_value_len, gchar const* const* operands, gsize const* operands_len, gint operands_n, guchar* success, gsize* new_value_len)
+{
+	GByteArray* value;
+
+	(void)state;
+	(void)key;
+	(void)key_len;
+
+	value = g_byte_array_new();
+
+	if (existing_value != NULL)
+	{
+		g_byte_array_append(value, (guint8 const*)existing_value, existing_value_len);
+	}
+
+	for (gint i = 0; i < operands_n; i++)
+	{
+		guint8 const* payload = (guint8 const*)operands[i] + 1;
+		gsize payload_len = operands_len[i] - 1;
+
+		switch (operands[i][0])
+		{
+			case J_ROCKSDB_MERGE_ADD:
+			{
+				gint64 counter = 0;
+				gint64 delta;
+
+				// Merges cannot fail, so values that are not counters are reset.
+				if (value->len == sizeof(counter))
+				{
+					memcpy(&counter, value->data, sizeof(counter));
+					counter = GINT64_FROM_LE(counter);
+				}
+
+				memcpy(&delta, payload, sizeof(delta));
+				counter = GINT64_TO_LE(counter + GINT64_FROM_LE(delta));
+
+				g_byte_array_set_size(value, sizeof(counter));
+				memcpy(value->data, &counter, sizeof(counter));
+			}
+			break;
+			case J_ROCKSDB_MERGE_APPEND:
+				g_byte_array_append(value, payload, payload_len);
+				break;
+			default:
+				g_warn_if_reached();
+		}
+	}
+
+	*success = 1;
+	*new_value_len = value->len;
+
+	return (gchar*)g_byte_array_free(value, FALSE);
+}
+
+static gchar*
+jd_rocksdb_merge_partial(gpointer state, gchar const* key, gsize key_len, gchar const* const* operands, gsize const* operands_len, gint operands_n, guchar* success, gsize* new_value_len)
+{
+	(void)state;
+	(void)key;
+	(void)key_len;
+	(void)operands;
+	(void)operands_len;
+	(void)operands_n;
+
+	// Operands are only combined with the existing value.
+	*success = 0;
+	*new_value_len = 0;
+
+	return NULL;
+}
+
+static void
+jd_rocksdb_merge_delete(gpointer state, gchar const* value, gsize value_len)
+{
+	(void)state;
+	(void)value_len;
+
+	g_free((gpointer)value);
+}
+
+static void
+jd_rocksdb_merge_destroy(gpointer state)
+{
+	(void)state;
+}
+
+static gchar const*
+jd_rocksdb_merge_name(gpointer state)
+{
+	(void)state;
+
+	return "julea";
+}
+
 static gboolean
 backend_batch_start(gpointer backend_data, gchar const* namespace, JSemantics* semantics, gpointer* backend_batch)
 {
@@ -138,6 +272,40 @@ backend_delete(gpointer backend_data, gpointer backend_batch, gchar const* key)
 	return TRUE;
 }
 
+static gboolean
+backend_delete_by_prefix(gpointer backend_data, gpointer backend_batch, gchar const* prefix)
+{
+	JRocksDBBatch* batch = backend_batch;
+	g_autofree gchar* start = NULL;
+	g_autofree gchar* end = NULL;
+	gsize start_len;
+	gsize end_len;
+
+	(void)backend_data;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+
+	start = g_strdup_printf("%s:%s", batch->namespace, (prefix != NULL) ? prefix : "");
+	start_len = strlen(start);
+
+	// The end key is the smallest key that does not start with the prefix anymore.
+	end = g_strdup(start);
+	end_len = start_len;
+
+	while (end_len > 0 && (guchar)end[end_len - 1] == 0xff)
+	{
+		end_len--;
+	}
+
+	g_return_val_if_fail(end_len > 0, FALSE);
+
+	end[end_len - 1]++;
+
+	rocksdb_writebatch_delete_range(batch->batch, start, start_len, end, end_len);
+
+	return TRUE;
+}
+
 static gboolean
 backend_get(gpointer backend_data, gpointer backend_batch, gchar const* key, gpointer* value, guint32* len)
 {
@@ -168,6 +336,101 @@ backend_get(gpointer backend_data, gpointer backend_batch, gchar const* key, gpo
 	return (result != NULL);
 }
 
+static gboolean
+backend_compare_and_swap(gpointer backend_data, gpointer backend_batch, gchar const* key, gconstpointer expected, guint32 expected_len, gconstpointer value, guint32 len)
+{
+	JRocksDBBatch* batch = backend_batch;
+	JRocksDBData* bd = backend_data;
+	g_autofree gchar* nskey = NULL;
+	g_autofree gchar* current = NULL;
+	g_autofree gchar* rocksdb_error = NULL;
+	gsize current_len;
+	gboolean ret;
+
+	rocksdb_writeoptions_t* write_options = bd->write_options;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	if (j_semantics_get(batch->semantics, J_SEMANTICS_PERSISTENCY) == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		write_options = bd->write_options_sync;
+	}
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+
+	// RocksDB cannot compare values within a batch, so the value is replaced immediately while holding the lock.
+	g_mutex_lock(&(bd->cas_lock));
+
+	current = rocksdb_get(bd->db, bd->read_options, nskey, strlen(nskey) + 1, &current_len, NULL);
+
+	if (expected == NULL)
+	{
+		ret = (current == NULL);
+	}
+	else
+	{
+		ret = (current != NULL && current_len == expected_len && memcmp(current, expected, expected_len) == 0);
+	}
+
+	if (ret)
+	{
+		rocksdb_put(bd->db, write_options, nskey, strlen(nskey) + 1, value, len, &rocksdb_error);
+		ret = (rocksdb_error == NULL);
+	}
+
+	g_mutex_unlock(&(bd->cas_lock));
+
+	return ret;
+}
+
+static gboolean
+backend_add(gpointer backend_data, gpointer backend_batch, gchar const* key, gint64 delta)
+{
+	JRocksDBBatch* batch = backend_batch;
+	g_autofree gchar* nskey = NULL;
+	gchar operand[1 + sizeof(delta)];
+
+	(void)backend_data;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+
+	delta = GINT64_TO_LE(delta);
+
+	operand[0] = J_ROCKSDB_MERGE_ADD;
+	memcpy(operand + 1, &delta, sizeof(delta));
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+	rocksdb_writebatch_merge(batch->batch, nskey, strlen(nskey) + 1, operand, sizeof(operand));
+
+	return TRUE;
+}
+
+static gboolean
+backend_append(gpointer backend_data, gpointer backend_batch, gchar const* key, gconstpointer value, guint32 len)
+{
+	JRocksDBBatch* batch = backend_batch;
+	g_autofree gchar* nskey = NULL;
+	g_autofree gchar* operand = NULL;
+
+	(void)backend_data;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	operand = g_malloc(1 + len);
+	operand[0] = J_ROCKSDB_MERGE_APPEND;
+	memcpy(operand + 1, value, len);
+
+	nskey = g_strdup_printf("%s:%s", batch->namespace, key);
+	rocksdb_writebatch_merge(batch->batch, nskey, strlen(nskey) + 1, operand, 1 + len);
+
+	return TRUE;
+}
+
 static gboolean
 backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
 {
@@ -187,6 +450,11 @@ backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend
 		iterator->first = TRUE;
 		iterator->prefix = g_strdup_printf("%s:", namespace);
 		iterator->namespace_len = strlen(namespace) + 1;
+		iterator->start = NULL;
+		iterator->end = NULL;
+		iterator->reverse = FALSE;
+		iterator->limit = 0;
+		iterator->count = 0;
 
 		*backend_iterator = iterator;
 	}
@@ -214,6 +482,42 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 		iterator->first = TRUE;
 		iterator->prefix = g_strdup_printf("%s:%s", namespace, prefix);
 		iterator->namespace_len = strlen(namespace) + 1;
+		iterator->start = NULL;
+		iterator->end = NULL;
+		iterator->reverse = FALSE;
+		iterator->limit = 0;
+		iterator->count = 0;
+
+		*backend_iterator = iterator;
+	}
+
+	return (iterator != NULL);
+}
+
+static gboolean
+backend_get_range(gpointer backend_data, gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse, gpointer* backend_iterator)
+{
+	JRocksDBData* bd = backend_data;
+	JRocksDBIterator* iterator = NULL;
+	rocksdb_iterator_t* it;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	it = rocksdb_create_iterator(bd->db, bd->read_options);
+
+	if (it != NULL)
+	{
+		iterator = g_slice_new(JRocksDBIterator);
+		iterator->iterator = it;
+		iterator->first = TRUE;
+		iterator->prefix = g_strdup_printf("%s:", namespace);
+		iterator->namespace_len = strlen(namespace) + 1;
+		iterator->start = (start != NULL) ? g_strdup_printf("%s:%s", namespace, start) : NULL;
+		iterator->end = (end != NULL) ? g_strdup_printf("%s:%s", namespace, end) : NULL;
+		iterator->reverse = reverse;
+		iterator->limit = limit;
+		iterator->count = 0;
 
 		*backend_iterator = iterator;
 	}
@@ -221,6 +525,20 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 	return (iterator != NULL);
 }
 
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	JRocksDBIterator* iterator = backend_iterator;
+
+	(void)backend_data;
+
+	g_free(iterator->prefix);
+	g_free(iterator->start);
+	g_free(iterator->end);
+	rocksdb_iter_destroy(iterator->iterator);
+	g_slice_free(JRocksDBIterator, iterator);
+}
+
 static gboolean
 backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** key, gconstpointer* value, guint32* len)
 {
@@ -233,11 +551,53 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	g_return_val_if_fail(value != NULL, FALSE);
 	g_return_val_if_fail(len != NULL, FALSE);
 
+	if (iterator->limit > 0 && iterator->count >= iterator->limit)
+	{
+		goto out;
+	}
+
 	if (iterator->first)
 	{
-		rocksdb_iter_seek(iterator->iterator, iterator->prefix, strlen(iterator->prefix));
+		if (!iterator->reverse)
+		{
+			gchar const* lower = (iterator->start != NULL) ? iterator->start : iterator->prefix;
+
+			rocksdb_iter_seek(iterator->iterator, lower, strlen(lower));
+		}
+		else
+		{
+			g_autofree gchar* upper = NULL;
+
+			if (iterator->end != NULL)
+			{
+				upper = g_strdup(iterator->end);
+			}
+			else
+			{
+				// The first key that does not have the prefix anymore.
+				upper = g_strdup(iterator->prefix);
+				upper[strlen(upper) - 1]++;
+			}
+
+			// Position the iterator at the last key before the upper bound.
+			rocksdb_iter_seek(iterator->iterator, upper, strlen(upper));
+
+			if (rocksdb_iter_valid(iterator->iterator))
+			{
+				rocksdb_iter_prev(iterator->iterator);
+			}
+			else
+			{
+				rocksdb_iter_seek_to_last(iterator->iterator);
+			}
+		}
+
 		iterator->first = FALSE;
 	}
+	else if (iterator->reverse)
+	{
+		rocksdb_iter_prev(iterator->iterator);
+	}
 	else
 	{
 		rocksdb_iter_next(iterator->iterator);
@@ -255,6 +615,18 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 			goto out;
 		}
 
+		if (iterator->end != NULL && g_strcmp0(key_, iterator->end) >= 0)
+		{
+			goto out;
+		}
+
+		if (iterator->start != NULL && g_strcmp0(key_, iterator->start) < 0)
+		{
+			goto out;
+		}
+
+		iterator->count++;
+
 		*key = key_ + iterator->namespace_len;
 		*value = rocksdb_iter_value(iterator->iterator, &tmp);
 		*len = tmp;
@@ -263,9 +635,7 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	}
 
 out:
-	g_free(iterator->prefix);
-	rocksdb_iter_destroy(iterator->iterator);
-	g_slice_free(JRocksDBIterator, iterator);
+	backend_iterate_free(backend_data, backend_iterator);
 
 	return FALSE;
 }
@@ -289,8 +659,12 @@ backend_init(gchar const* path, gpointer* backend_data)
 	bd->write_options_sync = rocksdb_writeoptions_create();
 	rocksdb_writeoptions_set_sync(bd->write_options_sync, 1);
 
+	g_mutex_init(&(bd->cas_lock));
+
 	options = rocksdb_options_create();
 	rocksdb_options_set_create_if_missing(options, 1);
+	// Counters and appends are resolved by the merge operator, which avoids reading the values when writing.
+	rocksdb_options_set_merge_operator(options, rocksdb_mergeoperator_create(NULL, jd_rocksdb_merge_destroy, jd_rocksdb_merge_full, jd_rocksdb_merge_partial, jd_rocksdb_merge_delete, jd_rocksdb_merge_name));
 
 	for (guint i = 0; i < G_N_ELEMENTS(compressions); i++)
 	{
@@ -326,6 +700,8 @@ backend_fini(gpointer backend_data)
 		rocksdb_close(bd->db);
 	}
 
+	g_mutex_clear(&(bd->cas_lock));
+
 	g_slice_free(JRocksDBData, bd);
 }
 
@@ -342,7 +718,13 @@ static JBackend rocksdb_backend = {
 		.backend_get = backend_get,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_get_range = backend_get_range,
+		.backend_iterate = backend_iterate,
+		.backend_delete_by_prefix = backend_delete_by_prefix,
+		.backend_iterate_free = backend_iterate_free,
+		.backend_compare_and_swap = backend_compare_and_swap,
+		.backend_add = backend_add,
+		.backend_append = backend_append }
 };
 
 G_MODULE_EXPORT
@@ -25,36 +25,238 @@
 
 #include <julea.h>
 
+/**
+ * A thread's database connection.
+ * Each thread uses its own connection, so that concurrent server threads are not serialized on one handle.
+ **/
+struct JSQLiteConnection
+{
+	sqlite3* db;
+
+	/**
+	 * The backend instance the connection belongs to.
+	 **/
+	guint generation;
+
+	/**
+	 * The current synchronous level, -1 if unknown.
+	 **/
+	gint synchronous;
+
+	/**
+	 * Prepared statements, which are compiled once and reused by all batches of the connection.
+	 **/
+	sqlite3_stmt* put;
+	sqlite3_stmt* delete;
+	sqlite3_stmt* delete_namespace;
+	sqlite3_stmt* delete_prefix;
+	sqlite3_stmt* get;
+	sqlite3_stmt* create;
+	sqlite3_stmt* swap;
+};
+
+typedef struct JSQLiteConnection JSQLiteConnection;
+
 struct JSQLiteBatch
 {
 	gchar* namespace;
 	JSemantics* semantics;
+
+	JSQLiteConnection* connection;
+
+	/**
+	 * Whether the transaction has been started.
+	 * Transactions are started by the first operation, which determines whether they are read or write transactions.
+	 **/
+	gboolean transaction;
 };
 
 typedef struct JSQLiteBatch JSQLiteBatch;
 
 struct JSQLiteData
 {
-	sqlite3* db;
+	gchar* path;
+	guint generation;
 };
 
 typedef struct JSQLiteData JSQLiteData;
 
+static void jd_sqlite_connection_free(gpointer);
+
+static GPrivate jd_sqlite_connection = G_PRIVATE_INIT(jd_sqlite_connection_free);
+static gint jd_sqlite_generation = 0;
+
+static void
+jd_sqlite_connection_free(gpointer data)
+{
+	JSQLiteConnection* connection = data;
+
+	if (connection == NULL)
+	{
+		return;
+	}
+
+	sqlite3_finalize(connection->put);
+	sqlite3_finalize(connection->delete);
+	sqlite3_finalize(connection->delete_namespace);
+	sqlite3_finalize(connection->delete_prefix);
+	sqlite3_finalize(connection->get);
+	sqlite3_finalize(connection->create);
+	sqlite3_finalize(connection->swap);
+
+	// Iterators might still use the connection, in which case it is closed when their statements are finalized.
+	sqlite3_close_v2(connection->db);
+
+	g_slice_free(JSQLiteConnection, connection);
+}
+
+/**
+ * Returns the calling thread's connection, opening it if necessary.
+ *
+ * \param bd The backend data.
+ *
+ * \return The connection, NULL on error.
+ **/
+static JSQLiteConnection*
+jd_sqlite_connection_get(JSQLiteData* bd)
+{
+	JSQLiteConnection* connection;
+
+	connection = g_private_get(&jd_sqlite_connection);
+
+	if (connection != NULL && connection->generation == bd->generation)
+	{
+		return connection;
+	}
+
+	connection = g_slice_new0(JSQLiteConnection);
+	connection->generation = bd->generation;
+	connection->synchronous = -1;
+
+	// Iterators can be continued by other threads, so the connections have to be serialized.
+	if (sqlite3_open_v2(bd->path, &(connection->db), SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX, NULL) != SQLITE_OK)
+	{
+		sqlite3_close(connection->db);
+		g_slice_free(JSQLiteConnection, connection);
+
+		return NULL;
+	}
+
+	// Writers of other connections have to be waited for.
+	sqlite3_busy_timeout(connection->db, 60 * 1000);
+
+	// This also frees a connection that belongs to a previous instance of the backend.
+	g_private_replace(&jd_sqlite_connection, connection);
+
+	return connection;
+}
+
+/**
+ * Returns a prepared statement of a connection, preparing it if necessary.
+ * The statement has to be released using jd_sqlite_statement_release.
+ *
+ * \param connection The connection.
+ * \param stmt       The connection's statement.
+ * \param sql        The statement's SQL.
+ *
+ * \return The statement, NULL on error.
+ **/
+static sqlite3_stmt*
+jd_sqlite_statement_get(JSQLiteConnection* connection, sqlite3_stmt** stmt, gchar const* sql)
+{
+	if (*stmt == NULL)
+	{
+		sqlite3_prepare_v3(connection->db, sql, -1, SQLITE_PREPARE_PERSISTENT, stmt, NULL);
+	}
+
+	return *stmt;
+}
+
+static void
+jd_sqlite_statement_release(sqlite3_stmt* stmt)
+{
+	sqlite3_reset(stmt);
+	sqlite3_clear_bindings(stmt);
+}
+
+/**
+ * Starts a batch's transaction if it has not been started yet.
+ *
+ * \param batch The batch.
+ * \param write Whether the batch writes, which acquires the write lock immediately.
+ *
+ * \return TRUE on success, FALSE otherwise.
+ **/
+static gboolean
+jd_sqlite_batch_begin(JSQLiteBatch* batch, gboolean write)
+{
+	JSQLiteConnection* connection = batch->connection;
+	gint synchronous;
+
+	if (batch->transaction)
+	{
+		return TRUE;
+	}
+
+	// With WAL, NORMAL only loses the latest transactions on power loss, FULL also syncs on every commit.
+	switch (j_semantics_get(batch->semantics, J_SEMANTICS_PERSISTENCY))
+	{
+		case J_SEMANTICS_PERSISTENCY_NONE:
+			synchronous = 0;
+			break;
+		case J_SEMANTICS_PERSISTENCY_STORAGE:
+			synchronous = 2;
+			break;
+		case J_SEMANTICS_PERSISTENCY_NETWORK:
+		default:
+			synchronous = 1;
+			break;
+	}
+
+	// The synchronous level cannot be changed within a transaction.
+	if (connection->synchronous != synchronous)
+	{
+		g_autofree gchar* pragma = NULL;
+
+		pragma = g_strdup_printf("PRAGMA synchronous = %d;", synchronous);
+
+		if (sqlite3_exec(connection->db, pragma, NULL, NULL, NULL) == SQLITE_OK)
+		{
+			connection->synchronous = synchronous;
+		}
+	}
+
+	// Read-modify-write operations would fail to upgrade a read transaction if another connection writes concurrently.
+	if (sqlite3_exec(connection->db, (write) ? "BEGIN IMMEDIATE;" : "BEGIN;", NULL, NULL, NULL) != SQLITE_OK)
+	{
+		return FALSE;
+	}
+
+	batch->transaction = TRUE;
+
+	return TRUE;
+}
+
 static gboolean
 backend_batch_start(gpointer backend_data, gchar const* namespace, JSemantics* semantics, gpointer* backend_batch)
 {
 	JSQLiteBatch* batch = NULL;
 	JSQLiteData* bd = backend_data;
+	JSQLiteConnection* connection;
 
 	g_return_val_if_fail(namespace != NULL, FALSE);
 	g_return_val_if_fail(backend_batch != NULL, FALSE);
 
-	if (sqlite3_exec(bd->db, "BEGIN TRANSACTION;", NULL, NULL, NULL) == SQLITE_OK)
+	connection = jd_sqlite_connection_get(bd);
+
+	if (connection != NULL)
 	{
 		batch = g_slice_new(JSQLiteBatch);
 
 		batch->namespace = g_strdup(namespace);
 		batch->semantics = j_semantics_ref(semantics);
+		batch->connection = connection;
+		batch->transaction = FALSE;
 	}
 
 	*backend_batch = batch;
@@ -65,18 +267,22 @@ backend_batch_start(gpointer backend_data, gchar const* namespace, JSemantics* s
 static gboolean
 backend_batch_execute(gpointer backend_data, gpointer backend_batch)
 {
-	gboolean ret = FALSE;
+	gboolean ret = TRUE;
 
 	JSQLiteBatch* batch = backend_batch;
-	JSQLiteData* bd = backend_data;
 
-	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	(void)backend_data;
 
-	/// \todo do something with batch->semantics
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
 
-	if (sqlite3_exec(bd->db, "COMMIT;", NULL, NULL, NULL) == SQLITE_OK)
+	if (batch->transaction)
 	{
-		ret = TRUE;
+		ret = (sqlite3_exec(batch->connection->db, "COMMIT;", NULL, NULL, NULL) == SQLITE_OK);
+
+		if (!ret)
+		{
+			sqlite3_exec(batch->connection->db, "ROLLBACK;", NULL, NULL, NULL);
+		}
 	}
 
 	j_semantics_unref(batch->semantics);
@@ -90,62 +296,116 @@ static gboolean
 backend_put(gpointer backend_data, gpointer backend_batch, gchar const* key, gconstpointer value, guint32 len)
 {
 	JSQLiteBatch* batch = backend_batch;
-	JSQLiteData* bd = backend_data;
 	sqlite3_stmt* stmt;
+	gint ret;
+
+	(void)backend_data;
 
 	g_return_val_if_fail(backend_batch != NULL, FALSE);
 	g_return_val_if_fail(key != NULL, FALSE);
 	g_return_val_if_fail(value != NULL, FALSE);
 
-	sqlite3_prepare_v2(bd->db, "INSERT OR REPLACE INTO julea (namespace, key, value) VALUES (?, ?, ?);", -1, &stmt, NULL);
+	if (!jd_sqlite_batch_begin(batch, TRUE))
+	{
+		return FALSE;
+	}
+
+	stmt = jd_sqlite_statement_get(batch->connection, &(batch->connection->put), "INSERT OR REPLACE INTO julea (namespace, key, value) VALUES (?, ?, ?);");
 	sqlite3_bind_text(stmt, 1, batch->namespace, -1, NULL);
 	sqlite3_bind_text(stmt, 2, key, -1, NULL);
 	sqlite3_bind_blob(stmt, 3, value, len, NULL);
 
-	sqlite3_step(stmt);
-	sqlite3_finalize(stmt);
+	ret = sqlite3_step(stmt);
+	jd_sqlite_statement_release(stmt);
 
-	/// \todo
-	return TRUE;
+	return (ret == SQLITE_DONE);
 }
 
 static gboolean
 backend_delete(gpointer backend_data, gpointer backend_batch, gchar const* key)
 {
 	JSQLiteBatch* batch = backend_batch;
-	JSQLiteData* bd = backend_data;
 	sqlite3_stmt* stmt;
+	gint ret;
+
+	(void)backend_data;
 
 	g_return_val_if_fail(backend_batch != NULL, FALSE);
 	g_return_val_if_fail(key != NULL, FALSE);
 
-	sqlite3_prepare_v2(bd->db, "DELETE FROM julea WHERE namespace = ? AND key = ?;", -1, &stmt, NULL);
+	if (!jd_sqlite_batch_begin(batch, TRUE))
+	{
+		return FALSE;
+	}
+
+	stmt = jd_sqlite_statement_get(batch->connection, &(batch->connection->delete), "DELETE FROM julea WHERE namespace = ? AND key = ?;");
 	sqlite3_bind_text(stmt, 1, batch->namespace, -1, NULL);
 	sqlite3_bind_text(stmt, 2, key, -1, NULL);
 
-	sqlite3_step(stmt);
-	sqlite3_finalize(stmt);
+	ret = sqlite3_step(stmt);
+	jd_sqlite_statement_release(stmt);
 
-	/// \todo
-	return TRUE;
+	return (ret == SQLITE_DONE);
+}
+
+static gboolean
+backend_delete_by_prefix(gpointer backend_data, gpointer backend_batch, gchar const* prefix)
+{
+	JSQLiteBatch* batch = backend_batch;
+	sqlite3_stmt* stmt;
+	gint ret;
+
+	(void)backend_data;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+
+	if (!jd_sqlite_batch_begin(batch, TRUE))
+	{
+		return FALSE;
+	}
+
+	if (prefix == NULL)
+	{
+		stmt = jd_sqlite_statement_get(batch->connection, &(batch->connection->delete_namespace), "DELETE FROM julea WHERE namespace = ?;");
+		sqlite3_bind_text(stmt, 1, batch->namespace, -1, NULL);
+	}
+	else
+	{
+		// LIKE is case-insensitive and treats % and _ as wildcards, so compare the prefix's bytes directly.
+		stmt = jd_sqlite_statement_get(batch->connection, &(batch->connection->delete_prefix), "DELETE FROM julea WHERE namespace = ? AND substr(CAST(key AS BLOB), 1, ?) = CAST(? AS BLOB);");
+		sqlite3_bind_text(stmt, 1, batch->namespace, -1, NULL);
+		sqlite3_bind_int64(stmt, 2, strlen(prefix));
+		sqlite3_bind_text(stmt, 3, prefix, -1, NULL);
+	}
+
+	ret = sqlite3_step(stmt);
+	jd_sqlite_statement_release(stmt);
+
+	return (ret == SQLITE_DONE);
 }
 
 static gboolean
 backend_get(gpointer backend_data, gpointer backend_batch, gchar const* key, gpointer* value, guint32* len)
 {
 	JSQLiteBatch* batch = backend_batch;
-	JSQLiteData* bd = backend_data;
 	sqlite3_stmt* stmt;
 	gint ret;
 	gconstpointer result = NULL;
 	gsize result_len;
 
+	(void)backend_data;
+
 	g_return_val_if_fail(backend_batch != NULL, FALSE);
 	g_return_val_if_fail(key != NULL, FALSE);
 	g_return_val_if_fail(value != NULL, FALSE);
 	g_return_val_if_fail(len != NULL, FALSE);
 
-	sqlite3_prepare_v2(bd->db, "SELECT value FROM julea WHERE namespace = ? AND key = ?;", -1, &stmt, NULL);
+	if (!jd_sqlite_batch_begin(batch, FALSE))
+	{
+		return FALSE;
+	}
+
+	stmt = jd_sqlite_statement_get(batch->connection, &(batch->connection->get), "SELECT value FROM julea WHERE namespace = ? AND key = ?;");
 	sqlite3_bind_text(stmt, 1, batch->namespace, -1, NULL);
 	sqlite3_bind_text(stmt, 2, key, -1, NULL);
 
@@ -165,23 +425,132 @@ backend_get(gpointer backend_data, gpointer backend_batch, gchar const* key, gpo
 		*len = result_len;
 	}
 
-	sqlite3_finalize(stmt);
+	jd_sqlite_statement_release(stmt);
 
 	return (result != NULL);
 }
 
+static gboolean
+backend_compare_and_swap(gpointer backend_data, gpointer backend_batch, gchar const* key, gconstpointer expected, guint32 expected_len, gconstpointer value, guint32 len)
+{
+	JSQLiteBatch* batch = backend_batch;
+	sqlite3_stmt* stmt;
+	gboolean ret;
+
+	(void)backend_data;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	if (!jd_sqlite_batch_begin(batch, TRUE))
+	{
+		return FALSE;
+	}
+
+	// Both statements only modify the row if it is in the expected state, which makes them atomic.
+	if (expected == NULL)
+	{
+		stmt = jd_sqlite_statement_get(batch->connection, &(batch->connection->create), "INSERT OR IGNORE INTO julea (namespace, key, value) VALUES (?, ?, ?);");
+		sqlite3_bind_text(stmt, 1, batch->namespace, -1, NULL);
+		sqlite3_bind_text(stmt, 2, key, -1, NULL);
+		sqlite3_bind_blob(stmt, 3, value, len, NULL);
+	}
+	else
+	{
+		stmt = jd_sqlite_statement_get(batch->connection, &(batch->connection->swap), "UPDATE julea SET value = ? WHERE namespace = ? AND key = ? AND value = ?;");
+		sqlite3_bind_blob(stmt, 1, value, len, NULL);
+		sqlite3_bind_text(stmt, 2, batch->namespace, -1, NULL);
+		sqlite3_bind_text(stmt, 3, key, -1, NULL);
+		sqlite3_bind_blob(stmt, 4, expected, expected_len, NULL);
+	}
+
+	ret = (sqlite3_step(stmt) == SQLITE_DONE && sqlite3_changes(batch->connection->db) == 1);
+	jd_sqlite_statement_release(stmt);
+
+	return ret;
+}
+
+static gboolean
+backend_add(gpointer backend_data, gpointer backend_batch, gchar const* key, gint64 delta)
+{
+	g_autofree gpointer current = NULL;
+	guint32 current_len = 0;
+	gint64 counter = 0;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+
+	if (!jd_sqlite_batch_begin(backend_batch, TRUE))
+	{
+		return FALSE;
+	}
+
+	// The batch's transaction makes reading and writing the value atomic.
+	if (backend_get(backend_data, backend_batch, key, &current, &current_len))
+	{
+		if (current_len != sizeof(counter))
+		{
+			return FALSE;
+		}
+
+		memcpy(&counter, current, sizeof(counter));
+		counter = GINT64_FROM_LE(counter);
+	}
+
+	counter = GINT64_TO_LE(counter + delta);
+
+	return backend_put(backend_data, backend_batch, key, &counter, sizeof(counter));
+}
+
+static gboolean
+backend_append(gpointer backend_data, gpointer backend_batch, gchar const* key, gconstpointer value, guint32 len)
+{
+	g_autofree gpointer current = NULL;
+	g_autofree gchar* appended = NULL;
+	guint32 current_len = 0;
+
+	g_return_val_if_fail(backend_batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	if (!jd_sqlite_batch_begin(backend_batch, TRUE))
+	{
+		return FALSE;
+	}
+
+	// The batch's transaction makes reading and writing the value atomic.
+	if (!backend_get(backend_data, backend_batch, key, &current, &current_len))
+	{
+		current_len = 0;
+	}
+
+	appended = g_malloc(current_len + len);
+
+	if (current_len > 0)
+	{
+		memcpy(appended, current, current_len);
+	}
+
+	memcpy(appended + current_len, value, len);
+
+	return backend_put(backend_data, backend_batch, key, appended, current_len + len);
+}
+
 static gboolean
 backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
 {
-	JSQLiteData* bd = backend_data;
+	JSQLiteConnection* connection;
 	sqlite3_stmt* stmt = NULL;
 
 	g_return_val_if_fail(namespace != NULL, FALSE);
 	g_return_val_if_fail(backend_iterator != NULL, FALSE);
 
-	if (sqlite3_prepare_v2(bd->db, "SELECT key, value FROM julea WHERE namespace = ?;", -1, &stmt, NULL) == SQLITE_OK)
+	connection = jd_sqlite_connection_get(backend_data);
+
+	if (connection != NULL && sqlite3_prepare_v2(connection->db, "SELECT key, value FROM julea WHERE namespace = ?;", -1, &stmt, NULL) == SQLITE_OK)
 	{
-		sqlite3_bind_text(stmt, 1, namespace, -1, NULL);
+		sqlite3_bind_text(stmt, 1, namespace, -1, SQLITE_TRANSIENT);
 	}
 
 	*backend_iterator = stmt;
@@ -192,17 +561,19 @@ backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend
 static gboolean
 backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const* prefix, gpointer* backend_iterator)
 {
-	JSQLiteData* bd = backend_data;
+	JSQLiteConnection* connection;
 	sqlite3_stmt* stmt = NULL;
 
 	g_return_val_if_fail(namespace != NULL, FALSE);
 	g_return_val_if_fail(prefix != NULL, FALSE);
 	g_return_val_if_fail(backend_iterator != NULL, FALSE);
 
-	if (sqlite3_prepare_v2(bd->db, "SELECT key, value FROM julea WHERE namespace = ? AND key LIKE ? || '%';", -1, &stmt, NULL) == SQLITE_OK)
+	connection = jd_sqlite_connection_get(backend_data);
+
+	if (connection != NULL && sqlite3_prepare_v2(connection->db, "SELECT key, value FROM julea WHERE namespace = ? AND key LIKE ? || '%';", -1, &stmt, NULL) == SQLITE_OK)
 	{
-		sqlite3_bind_text(stmt, 1, namespace, -1, NULL);
-		sqlite3_bind_text(stmt, 2, prefix, -1, NULL);
+		sqlite3_bind_text(stmt, 1, namespace, -1, SQLITE_TRANSIENT);
+		sqlite3_bind_text(stmt, 2, prefix, -1, SQLITE_TRANSIENT);
 	}
 
 	*backend_iterator = stmt;
@@ -210,6 +581,60 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 	return (stmt != NULL);
 }
 
+static gboolean
+backend_get_range(gpointer backend_data, gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse, gpointer* backend_iterator)
+{
+	JSQLiteConnection* connection;
+	sqlite3_stmt* stmt = NULL;
+	g_autofree gchar* sql = NULL;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	// Only add the bounds that are actually given, so that the index can be used for the range.
+	// Keys are compared bytewise, as clients expect when merging the ranges of multiple servers.
+	sql = g_strdup_printf("SELECT key, value FROM julea WHERE namespace = ?%s%s ORDER BY key COLLATE BINARY %s LIMIT ?;",
+	                      (start != NULL) ? " AND key >= ? COLLATE BINARY" : "",
+	                      (end != NULL) ? " AND key < ? COLLATE BINARY" : "",
+	                      (reverse) ? "DESC" : "ASC");
+
+	connection = jd_sqlite_connection_get(backend_data);
+
+	if (connection != NULL && sqlite3_prepare_v2(connection->db, sql, -1, &stmt, NULL) == SQLITE_OK)
+	{
+		gint param = 1;
+
+		sqlite3_bind_text(stmt, param++, namespace, -1, SQLITE_TRANSIENT);
+
+		if (start != NULL)
+		{
+			sqlite3_bind_text(stmt, param++, start, -1, SQLITE_TRANSIENT);
+		}
+
+		if (end != NULL)
+		{
+			sqlite3_bind_text(stmt, param++, end, -1, SQLITE_TRANSIENT);
+		}
+
+		// A negative limit means no limit.
+		sqlite3_bind_int64(stmt, param, (limit > 0) ? (gint64)limit : -1);
+	}
+
+	*backend_iterator = stmt;
+
+	return (stmt != NULL);
+}
+
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	sqlite3_stmt* stmt = backend_iterator;
+
+	(void)backend_data;
+
+	sqlite3_finalize(stmt);
+}
+
 static gboolean
 backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** key, gconstpointer* value, guint32* len)
 {
@@ -230,7 +655,7 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 		return TRUE;
 	}
 
-	sqlite3_finalize(stmt);
+	backend_iterate_free(backend_data, backend_iterator);
 
 	return FALSE;
 }
@@ -239,6 +664,7 @@ static gboolean
 backend_init(gchar const* path, gpointer* backend_data)
 {
 	JSQLiteData* bd;
+	JSQLiteConnection* connection;
 	g_autofree gchar* dirname = NULL;
 
 	g_return_val_if_fail(path != NULL, FALSE);
@@ -247,28 +673,39 @@ backend_init(gchar const* path, gpointer* backend_data)
 	g_mkdir_with_parents(dirname, 0700);
 
 	bd = g_slice_new(JSQLiteData);
+	bd->path = g_strdup(path);
+	bd->generation = (guint)g_atomic_int_add(&jd_sqlite_generation, 1) + 1;
+
+	connection = jd_sqlite_connection_get(bd);
 
-	if (sqlite3_open(path, &(bd->db)) != SQLITE_OK)
+	if (connection == NULL)
 	{
 		goto error;
 	}
 
-	if (sqlite3_exec(bd->db, "CREATE TABLE IF NOT EXISTS julea (namespace TEXT NOT NULL, key TEXT NOT NULL, value BLOB NOT NULL);", NULL, NULL, NULL) != SQLITE_OK)
+	// WAL allows readers to proceed while a writer is active and is persistent for the database file.
+	if (sqlite3_exec(connection->db, "PRAGMA journal_mode = WAL;", NULL, NULL, NULL) != SQLITE_OK)
 	{
 		goto error;
 	}
 
-	if (sqlite3_exec(bd->db, "CREATE UNIQUE INDEX IF NOT EXISTS julea_namespace_key ON julea (namespace, key);", NULL, NULL, NULL) != SQLITE_OK)
+	if (sqlite3_exec(connection->db, "CREATE TABLE IF NOT EXISTS julea (namespace TEXT NOT NULL, key TEXT NOT NULL, value BLOB NOT NULL);", NULL, NULL, NULL) != SQLITE_OK)
+	{
+		goto error;
+	}
+
+	if (sqlite3_exec(connection->db, "CREATE UNIQUE INDEX IF NOT EXISTS julea_namespace_key ON julea (namespace, key);", NULL, NULL, NULL) != SQLITE_OK)
 	{
 		goto error;
 	}
 
 	*backend_data = bd;
 
-	return (bd->db != NULL);
+	return TRUE;
 
 error:
-	sqlite3_close(bd->db);
+	g_private_replace(&jd_sqlite_connection, NULL);
+	g_free(bd->path);
 	g_slice_free(JSQLiteData, bd);
 
 	return FALSE;
@@ -279,11 +716,10 @@ backend_fini(gpointer backend_data)
 {
 	JSQLiteData* bd = backend_data;
 
-	if (bd->db != NULL)
-	{
-		sqlite3_close(bd->db);
-	}
+	// The other threads' connections are closed when the threads exit or when they notice the new generation.
+	g_private_replace(&jd_sqlite_connection, NULL);
 
+	g_free(bd->path);
 	g_slice_free(JSQLiteData, bd);
 }
 
@@ -300,7 +736,13 @@ static JBackend sqlite_backend = {
 		.backend_get = backend_get,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_get_range = backend_get_range,
+		.backend_iterate = backend_iterate,
+		.backend_delete_by_prefix = backend_delete_by_prefix,
+		.backend_iterate_free = backend_iterate_free,
+		.backend_compare_and_swap = backend_compare_and_swap,
+		.backend_add = backend_add,
+		.backend_append = backend_append }
 };
 
 G_MODULE_EXPORT
@@ -49,6 +49,18 @@ struct JBackendObject
 
 typedef struct JBackendObject JBackendObject;
 
+struct JBackendBatch
+{
+	gchar* namespace;
+
+	/**
+	 * The directories that are known to exist, so that each one is only created once per batch.
+	 **/
+	GHashTable* directories;
+};
+
+typedef struct JBackendBatch JBackendBatch;
+
 static gboolean
 backend_create(gpointer backend_data, gchar const* namespace, gchar const* path, gpointer* backend_object)
 {
@@ -282,6 +294,190 @@ backend_write(gpointer backend_data, gpointer backend_object, gconstpointer buff
 	return ret;
 }
 
+/**
+ * Moves an object's stream to an offset.
+ * Adjacent ranges do not require seeking.
+ **/
+static void
+jd_backend_seek(JBackendObject* bo, guint64 offset)
+{
+	if ((guint64)g_seekable_tell(G_SEEKABLE(bo->stream)) == offset)
+	{
+		return;
+	}
+
+	j_trace_file_begin(bo->path, J_TRACE_FILE_SEEK);
+	g_seekable_seek(G_SEEKABLE(bo->stream), offset, G_SEEK_SET, NULL, NULL);
+	j_trace_file_end(bo->path, J_TRACE_FILE_SEEK, 0, offset);
+}
+
+static gboolean
+backend_readv(gpointer backend_data, gpointer backend_object, JBackendObjectRequest* requests, guint count)
+{
+	JBackendObject* bo = backend_object;
+	gboolean ret = TRUE;
+
+	GInputStream* input;
+
+	(void)backend_data;
+
+	input = g_io_stream_get_input_stream(G_IO_STREAM(bo->stream));
+
+	for (guint i = 0; i < count; i++)
+	{
+		gsize nbytes = 0;
+
+		jd_backend_seek(bo, requests[i].offset);
+
+		j_trace_file_begin(bo->path, J_TRACE_FILE_READ);
+		ret = g_input_stream_read_all(input, requests[i].buffer, requests[i].length, &nbytes, NULL, NULL) && nbytes == requests[i].length && ret;
+		j_trace_file_end(bo->path, J_TRACE_FILE_READ, nbytes, requests[i].offset);
+
+		requests[i].bytes = nbytes;
+	}
+
+	return ret;
+}
+
+static gboolean
+backend_writev(gpointer backend_data, gpointer backend_object, JBackendObjectRequest* requests, guint count)
+{
+	JBackendObject* bo = backend_object;
+	gboolean ret = TRUE;
+
+	GOutputStream* output;
+
+	(void)backend_data;
+
+	output = g_io_stream_get_output_stream(G_IO_STREAM(bo->stream));
+
+	for (guint i = 0; i < count; i++)
+	{
+		gsize nbytes = 0;
+
+		jd_backend_seek(bo, requests[i].offset);
+
+		j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
+		ret = g_output_stream_write_all(output, requests[i].buffer, requests[i].length, &nbytes, NULL, NULL) && ret;
+		j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, nbytes, requests[i].offset);
+
+		requests[i].bytes = nbytes;
+	}
+
+	return ret;
+}
+
+static gboolean
+backend_batch_start(gpointer backend_data, gchar const* namespace, gboolean sync, gpointer* backend_batch)
+{
+	JBackendBatch* batch;
+
+	(void)backend_data;
+	// Syncing only flushes the stream, which closing it does anyway.
+	(void)sync;
+
+	batch = g_slice_new(JBackendBatch);
+	batch->namespace = g_strdup(namespace);
+	batch->directories = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+	*backend_batch = batch;
+
+	return TRUE;
+}
+
+static gboolean
+backend_batch_create(gpointer backend_data, gpointer backend_batch, gchar const* path)
+{
+	JBackendData* bd = backend_data;
+	JBackendBatch* batch = backend_batch;
+	g_autoptr(GFile) file = NULL;
+	g_autoptr(GFile) parent = NULL;
+	g_autoptr(GError) error = NULL;
+	g_autofree gchar* full_path = NULL;
+	GFileOutputStream* stream;
+	gchar* parent_path;
+	gboolean ret;
+
+	full_path = g_build_filename(bd->path, batch->namespace, path, NULL);
+	file = g_file_new_for_path(full_path);
+	parent = g_file_get_parent(file);
+	parent_path = g_file_get_path(parent);
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_CREATE);
+
+	if (!g_hash_table_contains(batch->directories, parent_path))
+	{
+		g_file_make_directory_with_parents(parent, NULL, NULL);
+		g_hash_table_add(batch->directories, parent_path);
+	}
+	else
+	{
+		g_free(parent_path);
+	}
+
+	// The object does not have to be opened for reading, so a plain output stream is sufficient.
+	stream = g_file_create(file, G_FILE_CREATE_NONE, NULL, &error);
+	ret = (stream != NULL || g_error_matches(error, G_IO_ERROR, G_IO_ERROR_EXISTS));
+
+	if (stream != NULL)
+	{
+		ret = g_output_stream_close(G_OUTPUT_STREAM(stream), NULL, NULL);
+		g_object_unref(stream);
+	}
+
+	j_trace_file_end(full_path, J_TRACE_FILE_CREATE, 0, 0);
+
+	return ret;
+}
+
+static gboolean
+backend_batch_delete(gpointer backend_data, gpointer backend_batch, gchar const* path)
+{
+	JBackendData* bd = backend_data;
+	JBackendBatch* batch = backend_batch;
+	g_autoptr(GFile) file = NULL;
+	g_autofree gchar* full_path = NULL;
+	gboolean ret;
+
+	full_path = g_build_filename(bd->path, batch->namespace, path, NULL);
+	file = g_file_new_for_path(full_path);
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_DELETE);
+	ret = g_file_delete(file, NULL, NULL);
+	j_trace_file_end(full_path, J_TRACE_FILE_DELETE, 0, 0);
+
+	return ret;
+}
+
+static gboolean
+backend_batch_execute(gpointer backend_data, gpointer backend_batch)
+{
+	JBackendBatch* batch = backend_batch;
+
+	(void)backend_data;
+
+	g_hash_table_destroy(batch->directories);
+	g_free(batch->namespace);
+	g_slice_free(JBackendBatch, batch);
+
+	return TRUE;
+}
+
+static gboolean
+backend_truncate(gpointer backend_data, gpointer backend_object, guint64 size)
+{
+	JBackendObject* bo = backend_object;
+	gboolean ret;
+
+	(void)backend_data;
+
+	j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
+	ret = g_seekable_truncate(G_SEEKABLE(bo->stream), size, NULL, NULL);
+	j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, 0, size);
+
+	return ret;
+}
+
 static gboolean
 backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
 {
@@ -341,10 +537,23 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 	return (iterator != NULL);
 }
 
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	JBackendIterator* iterator = backend_iterator;
+
+	(void)backend_data;
+
+	g_free(iterator->prefix);
+	g_object_unref(iterator->iterator);
+	g_slice_free(JBackendIterator, iterator);
+}
+
 static gboolean
-backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** name)
+backend_iterate_status(gpointer backend_data, gpointer backend_iterator, gchar const** name, gint64* modification_time, guint64* size)
 {
 	JBackendIterator* iterator = backend_iterator;
+	GFileInfo* file_info;
 	GFile* file;
 
 	(void)backend_data;
@@ -352,7 +561,7 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	g_return_val_if_fail(backend_iterator != NULL, FALSE);
 	g_return_val_if_fail(name != NULL, FALSE);
 
-	while (g_file_enumerator_iterate(iterator->iterator, NULL, &file, NULL, NULL))
+	while (g_file_enumerator_iterate(iterator->iterator, &file_info, &file, NULL, NULL))
 	{
 		gchar const* name_;
 
@@ -368,18 +577,49 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 			continue;
 		}
 
+		// The enumerator already queried the attributes, so the status does not require additional lookups.
+		if (modification_time != NULL)
+		{
+#if GLIB_CHECK_VERSION(2, 62, 0)
+			GDateTime* date_time;
+
+			*modification_time = 0;
+			date_time = g_file_info_get_modification_date_time(file_info);
+
+			if (date_time != NULL)
+			{
+				*modification_time = g_date_time_to_unix(date_time) * G_USEC_PER_SEC + g_date_time_get_microsecond(date_time);
+				g_date_time_unref(date_time);
+			}
+#else
+			GTimeVal time_val;
+
+			g_file_info_get_modification_time(file_info, &time_val);
+			*modification_time = time_val.tv_sec * G_USEC_PER_SEC + time_val.tv_usec;
+#endif
+		}
+
+		if (size != NULL)
+		{
+			*size = g_file_info_get_size(file_info);
+		}
+
 		*name = name_ + iterator->namespace_len;
 
 		return TRUE;
 	}
 
-	g_free(iterator->prefix);
-	g_object_unref(iterator->iterator);
-	g_slice_free(JBackendIterator, iterator);
+	backend_iterate_free(backend_data, backend_iterator);
 
 	return FALSE;
 }
 
+static gboolean
+backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** name)
+{
+	return backend_iterate_status(backend_data, backend_iterator, name, NULL, NULL);
+}
+
 static gboolean
 backend_init(gchar const* path, gpointer* backend_data)
 {
@@ -423,7 +663,16 @@ static JBackend gio_backend = {
 		.backend_write = backend_write,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_iterate = backend_iterate,
+		.backend_readv = backend_readv,
+		.backend_writev = backend_writev,
+		.backend_batch_start = backend_batch_start,
+		.backend_batch_create = backend_batch_create,
+		.backend_batch_delete = backend_batch_delete,
+		.backend_batch_execute = backend_batch_execute,
+		.backend_truncate = backend_truncate,
+		.backend_iterate_status = backend_iterate_status,
+		.backend_iterate_free = backend_iterate_free }
 };
 
 G_MODULE_EXPORT
@@ -0,0 +1,967 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * This backend stores objects in LMDB, which avoids the metadata overhead of file systems for tiny objects.
+ *
+ * Each object has a header record containing its size and modification time.
+ * Its data is split into fixed-size chunks, which are keyed by the object's namespace, name and chunk number.
+ * Missing chunks are read as zeros, so sparse objects do not use space.
+ */
+
+#include <julea-config.h>
+
+#include <glib.h>
+#include <gmodule.h>
+
+#include <string.h>
+
+#include <lmdb.h>
+
+#include <julea.h>
+
+/**
+ * The default chunk size.
+ **/
+#define J_CHUNK_DEFAULT_SIZE 4096
+
+/**
+ * An object's header.
+ * The chunk size is stored per object, so that changing the configured chunk size does not affect existing objects.
+ **/
+struct JChunkHeader
+{
+	guint64 size;
+	gint64 modification_time;
+	guint32 chunk_size;
+	guint32 reserved;
+};
+
+typedef struct JChunkHeader JChunkHeader;
+
+struct JChunkData
+{
+	MDB_env* env;
+
+	/**
+	 * The database containing the headers, keyed by namespace and name.
+	 **/
+	MDB_dbi headers;
+
+	/**
+	 * The database containing the chunks, keyed by namespace, name and chunk number.
+	 **/
+	MDB_dbi chunks;
+
+	guint32 chunk_size;
+};
+
+typedef struct JChunkData JChunkData;
+
+struct JChunkObject
+{
+	/**
+	 * The header key, that is, the namespace and the name, each terminated by a null byte.
+	 **/
+	gchar* key;
+	gsize key_length;
+
+	/**
+	 * The offset of the name within the key.
+	 **/
+	gsize name_offset;
+};
+
+typedef struct JChunkObject JChunkObject;
+
+struct JChunkIterator
+{
+	MDB_txn* txn;
+	MDB_cursor* cursor;
+	gboolean first;
+
+	/**
+	 * The namespace and the prefix, the namespace is terminated by a null byte.
+	 **/
+	gchar* prefix;
+	gsize prefix_length;
+	gsize namespace_length;
+};
+
+typedef struct JChunkIterator JChunkIterator;
+
+static JChunkObject*
+jd_chunk_object_new(gchar const* namespace, gchar const* path)
+{
+	JChunkObject* object;
+	gsize namespace_length;
+	gsize path_length;
+
+	namespace_length = strlen(namespace) + 1;
+	path_length = strlen(path) + 1;
+
+	object = g_slice_new(JChunkObject);
+	object->key_length = namespace_length + path_length;
+	object->key = g_malloc(object->key_length);
+	object->name_offset = namespace_length;
+
+	memcpy(object->key, namespace, namespace_length);
+	memcpy(object->key + namespace_length, path, path_length);
+
+	return object;
+}
+
+static void
+jd_chunk_object_free(JChunkObject* object)
+{
+	g_free(object->key);
+	g_slice_free(JChunkObject, object);
+}
+
+/**
+ * Builds a chunk's key.
+ * The chunk number is stored in big endian, so that an object's chunks are sorted.
+ **/
+static void
+jd_chunk_key(JChunkObject* object, guint64 chunk, gchar* key)
+{
+	guint64 chunk_be;
+
+	chunk_be = GUINT64_TO_BE(chunk);
+
+	memcpy(key, object->key, object->key_length);
+	memcpy(key + object->key_length, &chunk_be, sizeof(chunk_be));
+}
+
+static gboolean
+jd_chunk_get_header(JChunkData* bd, MDB_txn* txn, JChunkObject* object, JChunkHeader* header)
+{
+	MDB_val m_key;
+	MDB_val m_value;
+
+	m_key.mv_size = object->key_length;
+	m_key.mv_data = object->key;
+
+	if (mdb_get(txn, bd->headers, &m_key, &m_value) != 0 || m_value.mv_size != sizeof(*header))
+	{
+		return FALSE;
+	}
+
+	// LMDB does not guarantee any alignment.
+	memcpy(header, m_value.mv_data, sizeof(*header));
+
+	return TRUE;
+}
+
+static gboolean
+jd_chunk_put_header(JChunkData* bd, MDB_txn* txn, JChunkObject* object, JChunkHeader const* header, guint flags)
+{
+	MDB_val m_key;
+	MDB_val m_value;
+
+	m_key.mv_size = object->key_length;
+	m_key.mv_data = object->key;
+	m_value.mv_size = sizeof(*header);
+	m_value.mv_data = (gpointer)header;
+
+	return (mdb_put(txn, bd->headers, &m_key, &m_value, flags) == 0);
+}
+
+static gboolean
+backend_create(gpointer backend_data, gchar const* namespace, gchar const* path, gpointer* backend_object)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object;
+	JChunkHeader header;
+	MDB_txn* txn;
+	gboolean ret = FALSE;
+
+	object = jd_chunk_object_new(namespace, path);
+
+	header.size = 0;
+	header.modification_time = g_get_real_time();
+	header.chunk_size = bd->chunk_size;
+	header.reserved = 0;
+
+	j_trace_file_begin(path, J_TRACE_FILE_CREATE);
+
+	if (mdb_txn_begin(bd->env, NULL, 0, &txn) == 0)
+	{
+		MDB_val m_key;
+		MDB_val m_value;
+		gint err;
+
+		m_key.mv_size = object->key_length;
+		m_key.mv_data = object->key;
+		m_value.mv_size = sizeof(header);
+		m_value.mv_data = &header;
+
+		// Creating an existing object opens it.
+		err = mdb_put(txn, bd->headers, &m_key, &m_value, MDB_NOOVERWRITE);
+
+		if (err == 0)
+		{
+			ret = (mdb_txn_commit(txn) == 0);
+		}
+		else
+		{
+			ret = (err == MDB_KEYEXIST);
+			mdb_txn_abort(txn);
+		}
+	}
+
+	j_trace_file_end(path, J_TRACE_FILE_CREATE, 0, 0);
+
+	if (!ret)
+	{
+		jd_chunk_object_free(object);
+		object = NULL;
+	}
+
+	*backend_object = object;
+
+	return ret;
+}
+
+static gboolean
+backend_open(gpointer backend_data, gchar const* namespace, gchar const* path, gpointer* backend_object)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object;
+	JChunkHeader header;
+	MDB_txn* txn;
+	gboolean ret = FALSE;
+
+	object = jd_chunk_object_new(namespace, path);
+
+	j_trace_file_begin(path, J_TRACE_FILE_OPEN);
+
+	if (mdb_txn_begin(bd->env, NULL, MDB_RDONLY, &txn) == 0)
+	{
+		ret = jd_chunk_get_header(bd, txn, object, &header);
+		mdb_txn_abort(txn);
+	}
+
+	j_trace_file_end(path, J_TRACE_FILE_OPEN, 0, 0);
+
+	if (!ret)
+	{
+		jd_chunk_object_free(object);
+		object = NULL;
+	}
+
+	*backend_object = object;
+
+	return ret;
+}
+
+static gboolean
+backend_delete(gpointer backend_data, gpointer backend_object)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object = backend_object;
+	MDB_txn* txn;
+	MDB_cursor* cursor;
+	MDB_cursor_op cursor_op = MDB_SET_RANGE;
+	MDB_val m_key;
+	MDB_val m_value;
+	gboolean ret = FALSE;
+
+	j_trace_file_begin(object->key + object->name_offset, J_TRACE_FILE_DELETE);
+
+	if (mdb_txn_begin(bd->env, NULL, 0, &txn) != 0)
+	{
+		goto end;
+	}
+
+	m_key.mv_size = object->key_length;
+	m_key.mv_data = object->key;
+
+	if (mdb_del(txn, bd->headers, &m_key, NULL) != 0 || mdb_cursor_open(txn, bd->chunks, &cursor) != 0)
+	{
+		mdb_txn_abort(txn);
+		goto end;
+	}
+
+	ret = TRUE;
+
+	// After mdb_cursor_del, MDB_NEXT returns the entry following the deleted one.
+	while (mdb_cursor_get(cursor, &m_key, &m_value, cursor_op) == 0)
+	{
+		if (m_key.mv_size != object->key_length + sizeof(guint64) || memcmp(m_key.mv_data, object->key, object->key_length) != 0)
+		{
+			break;
+		}
+
+		if (mdb_cursor_del(cursor, 0) != 0)
+		{
+			ret = FALSE;
+			break;
+		}
+
+		cursor_op = MDB_NEXT;
+	}
+
+	mdb_cursor_close(cursor);
+
+	if (ret)
+	{
+		ret = (mdb_txn_commit(txn) == 0);
+	}
+	else
+	{
+		mdb_txn_abort(txn);
+	}
+
+end:
+	j_trace_file_end(object->key + object->name_offset, J_TRACE_FILE_DELETE, 0, 0);
+
+	jd_chunk_object_free(object);
+
+	return ret;
+}
+
+static gboolean
+backend_close(gpointer backend_data, gpointer backend_object)
+{
+	JChunkObject* object = backend_object;
+
+	(void)backend_data;
+
+	jd_chunk_object_free(object);
+
+	return TRUE;
+}
+
+static gboolean
+backend_status(gpointer backend_data, gpointer backend_object, gint64* modification_time, guint64* size)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object = backend_object;
+	JChunkHeader header;
+	MDB_txn* txn;
+	gboolean ret = FALSE;
+
+	if (mdb_txn_begin(bd->env, NULL, MDB_RDONLY, &txn) == 0)
+	{
+		ret = jd_chunk_get_header(bd, txn, object, &header);
+		mdb_txn_abort(txn);
+	}
+
+	if (ret)
+	{
+		if (modification_time != NULL)
+		{
+			*modification_time = header.modification_time;
+		}
+
+		if (size != NULL)
+		{
+			*size = header.size;
+		}
+	}
+
+	return ret;
+}
+
+static gboolean
+backend_sync(gpointer backend_data, gpointer backend_object)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object = backend_object;
+	gboolean ret;
+
+	// Transactions are durable by default, this only matters if syncing has been disabled.
+	j_trace_file_begin(object->key + object->name_offset, J_TRACE_FILE_SYNC);
+	ret = (mdb_env_sync(bd->env, 1) == 0);
+	j_trace_file_end(object->key + object->name_offset, J_TRACE_FILE_SYNC, 0, 0);
+
+	return ret;
+}
+
+static gboolean
+backend_read(gpointer backend_data, gpointer backend_object, gpointer buffer, guint64 length, guint64 offset, guint64* bytes_read)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object = backend_object;
+	JChunkHeader header;
+	MDB_txn* txn;
+	g_autofree gchar* key = NULL;
+	guint64 nbytes = 0;
+	gboolean ret = FALSE;
+
+	j_trace_file_begin(object->key + object->name_offset, J_TRACE_FILE_READ);
+
+	if (mdb_txn_begin(bd->env, NULL, MDB_RDONLY, &txn) != 0)
+	{
+		goto end;
+	}
+
+	if (!jd_chunk_get_header(bd, txn, object, &header))
+	{
+		mdb_txn_abort(txn);
+		goto end;
+	}
+
+	key = g_malloc(object->key_length + sizeof(guint64));
+
+	if (offset < header.size)
+	{
+		nbytes = MIN(length, header.size - offset);
+	}
+
+	for (guint64 position = 0; position < nbytes;)
+	{
+		MDB_val m_key;
+		MDB_val m_value;
+		guint64 chunk;
+		guint64 chunk_offset;
+		guint64 chunk_length;
+
+		chunk = (offset + position) / header.chunk_size;
+		chunk_offset = (offset + position) % header.chunk_size;
+		chunk_length = MIN(header.chunk_size - chunk_offset, nbytes - position);
+
+		jd_chunk_key(object, chunk, key);
+
+		m_key.mv_size = object->key_length + sizeof(guint64);
+		m_key.mv_data = key;
+
+		// Missing chunks and the parts beyond a chunk's end have not been written yet.
+		if (mdb_get(txn, bd->chunks, &m_key, &m_value) == 0 && m_value.mv_size > chunk_offset)
+		{
+			guint64 available;
+
+			available = MIN(chunk_length, m_value.mv_size - chunk_offset);
+
+			memcpy((gchar*)buffer + position, (gchar const*)m_value.mv_data + chunk_offset, available);
+			memset((gchar*)buffer + position + available, 0, chunk_length - available);
+		}
+		else
+		{
+			memset((gchar*)buffer + position, 0, chunk_length);
+		}
+
+		position += chunk_length;
+	}
+
+	mdb_txn_abort(txn);
+
+	ret = (nbytes == length);
+
+end:
+	j_trace_file_end(object->key + object->name_offset, J_TRACE_FILE_READ, nbytes, offset);
+
+	if (bytes_read != NULL)
+	{
+		*bytes_read = nbytes;
+	}
+
+	return ret;
+}
+
+static gboolean
+backend_write(gpointer backend_data, gpointer backend_object, gconstpointer buffer, guint64 length, guint64 offset, guint64* bytes_written)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object = backend_object;
+	JChunkHeader header;
+	MDB_txn* txn;
+	g_autofree gchar* key = NULL;
+	g_autofree gchar* chunk_data = NULL;
+	gboolean ret = FALSE;
+
+	j_trace_file_begin(object->key + object->name_offset, J_TRACE_FILE_WRITE);
+
+	if (mdb_txn_begin(bd->env, NULL, 0, &txn) != 0)
+	{
+		goto end;
+	}
+
+	if (!jd_chunk_get_header(bd, txn, object, &header))
+	{
+		mdb_txn_abort(txn);
+		goto end;
+	}
+
+	key = g_malloc(object->key_length + sizeof(guint64));
+	chunk_data = g_malloc(header.chunk_size);
+
+	ret = TRUE;
+
+	for (guint64 position = 0; position < length;)
+	{
+		MDB_val m_key;
+		MDB_val m_value;
+		guint64 chunk;
+		guint64 chunk_offset;
+		guint64 chunk_length;
+		guint64 existing = 0;
+		guint64 new_length;
+
+		chunk = (offset + position) / header.chunk_size;
+		chunk_offset = (offset + position) % header.chunk_size;
+		chunk_length = MIN(header.chunk_size - chunk_offset, length - position);
+
+		jd_chunk_key(object, chunk, key);
+
+		m_key.mv_size = object->key_length + sizeof(guint64);
+		m_key.mv_data = key;
+
+		// Partially overwritten chunks have to keep their remaining contents.
+		if ((chunk_offset > 0 || chunk_length < header.chunk_size) && mdb_get(txn, bd->chunks, &m_key, &m_value) == 0)
+		{
+			existing = MIN(m_value.mv_size, header.chunk_size);
+			memcpy(chunk_data, m_value.mv_data, existing);
+		}
+
+		new_length = MAX(existing, chunk_offset + chunk_length);
+
+		if (chunk_offset > existing)
+		{
+			memset(chunk_data + existing, 0, chunk_offset - existing);
+		}
+
+		memcpy(chunk_data + chunk_offset, (gchar const*)buffer + position, chunk_length);
+
+		m_value.mv_size = new_length;
+		m_value.mv_data = chunk_data;
+
+		if (mdb_put(txn, bd->chunks, &m_key, &m_value, 0) != 0)
+		{
+			ret = FALSE;
+			break;
+		}
+
+		position += chunk_length;
+	}
+
+	if (ret)
+	{
+		header.size = MAX(header.size, offset + length);
+		header.modification_time = g_get_real_time();
+
+		ret = jd_chunk_put_header(bd, txn, object, &header, 0);
+	}
+
+	if (ret)
+	{
+		ret = (mdb_txn_commit(txn) == 0);
+	}
+	else
+	{
+		mdb_txn_abort(txn);
+	}
+
+end:
+	j_trace_file_end(object->key + object->name_offset, J_TRACE_FILE_WRITE, (ret) ? length : 0, offset);
+
+	if (bytes_written != NULL)
+	{
+		*bytes_written = (ret) ? length : 0;
+	}
+
+	return ret;
+}
+
+static gboolean
+backend_truncate(gpointer backend_data, gpointer backend_object, guint64 size)
+{
+	JChunkData* bd = backend_data;
+	JChunkObject* object = backend_object;
+	JChunkHeader header;
+	MDB_txn* txn;
+	MDB_cursor* cursor;
+	MDB_cursor_op cursor_op = MDB_SET_RANGE;
+	MDB_val m_key;
+	MDB_val m_value;
+	g_autofree gchar* key = NULL;
+	guint64 chunk_count;
+	gboolean ret = FALSE;
+
+	j_trace_file_begin(object->key + object->name_offset, J_TRACE_FILE_WRITE);
+
+	if (mdb_txn_begin(bd->env, NULL, 0, &txn) != 0)
+	{
+		goto end;
+	}
+
+	if (!jd_chunk_get_header(bd, txn, object, &header) || mdb_cursor_open(txn, bd->chunks, &cursor) != 0)
+	{
+		mdb_txn_abort(txn);
+		goto end;
+	}
+
+	key = g_malloc(object->key_length + sizeof(guint64));
+	chunk_count = (size + header.chunk_size - 1) / header.chunk_size;
+
+	ret = TRUE;
+
+	// Reads return zeros for missing chunks, so only shrinking has to remove data.
+	if (size < header.size)
+	{
+		jd_chunk_key(object, chunk_count, key);
+
+		m_key.mv_size = object->key_length + sizeof(guint64);
+		m_key.mv_data = key;
+
+		// After mdb_cursor_del, MDB_NEXT returns the entry following the deleted one.
+		while (mdb_cursor_get(cursor, &m_key, &m_value, cursor_op) == 0)
+		{
+			if (m_key.mv_size != object->key_length + sizeof(guint64) || memcmp(m_key.mv_data, object->key, object->key_length) != 0)
+			{
+				break;
+			}
+
+			if (mdb_cursor_del(cursor, 0) != 0)
+			{
+				ret = FALSE;
+				break;
+			}
+
+			cursor_op = MDB_NEXT;
+		}
+
+		// The last chunk might extend beyond the new end.
+		if (ret && chunk_count > 0)
+		{
+			guint64 last_length;
+
+			last_length = size - ((chunk_count - 1) * header.chunk_size);
+
+			jd_chunk_key(object, chunk_count - 1, key);
+
+			m_key.mv_size = object->key_length + sizeof(guint64);
+			m_key.mv_data = key;
+
+			if (mdb_get(txn, bd->chunks, &m_key, &m_value) == 0 && m_value.mv_size > last_length)
+			{
+				g_autofree gchar* chunk_data = NULL;
+
+				chunk_data = g_malloc(last_length);
+				memcpy(chunk_data, m_value.mv_data, last_length);
+
+				m_value.mv_size = last_length;
+				m_value.mv_data = chunk_data;
+
+				ret = (mdb_put(txn, bd->chunks, &m_key, &m_value, 0) == 0);
+			}
+		}
+	}
+
+	mdb_cursor_close(cursor);
+
+	if (ret)
+	{
+		header.size = size;
+		header.modification_time = g_get_real_time();
+
+		ret = jd_chunk_put_header(bd, txn, object, &header, 0);
+	}
+
+	if (ret)
+	{
+		ret = (mdb_txn_commit(txn) == 0);
+	}
+	else
+	{
+		mdb_txn_abort(txn);
+	}
+
+end:
+	j_trace_file_end(object->key + object->name_offset, J_TRACE_FILE_WRITE, 0, size);
+
+	return ret;
+}
+
+static gboolean
+jd_chunk_iterator_new(JChunkData* bd, gchar const* namespace, gchar const* prefix, gpointer* backend_iterator)
+{
+	JChunkIterator* iterator;
+	MDB_txn* txn;
+	MDB_cursor* cursor;
+	gsize namespace_length;
+	gsize prefix_length;
+
+	if (mdb_txn_begin(bd->env, NULL, MDB_RDONLY, &txn) != 0)
+	{
+		return FALSE;
+	}
+
+	if (mdb_cursor_open(txn, bd->headers, &cursor) != 0)
+	{
+		mdb_txn_abort(txn);
+		return FALSE;
+	}
+
+	namespace_length = strlen(namespace) + 1;
+	prefix_length = (prefix != NULL) ? strlen(prefix) : 0;
+
+	iterator = g_slice_new(JChunkIterator);
+	iterator->txn = txn;
+	iterator->cursor = cursor;
+	iterator->first = TRUE;
+	iterator->namespace_length = namespace_length;
+	iterator->prefix_length = namespace_length + prefix_length;
+	iterator->prefix = g_malloc(iterator->prefix_length + 1);
+
+	memcpy(iterator->prefix, namespace, namespace_length);
+	memcpy(iterator->prefix + namespace_length, (prefix != NULL) ? prefix : "", prefix_length + 1);
+
+	*backend_iterator = iterator;
+
+	return TRUE;
+}
+
+static gboolean
+backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
+{
+	JChunkData* bd = backend_data;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	return jd_chunk_iterator_new(bd, namespace, NULL, backend_iterator);
+}
+
+static gboolean
+backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const* prefix, gpointer* backend_iterator)
+{
+	JChunkData* bd = backend_data;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(prefix != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	return jd_chunk_iterator_new(bd, namespace, prefix, backend_iterator);
+}
+
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	JChunkIterator* iterator = backend_iterator;
+
+	(void)backend_data;
+
+	mdb_cursor_close(iterator->cursor);
+	mdb_txn_abort(iterator->txn);
+
+	g_free(iterator->prefix);
+	g_slice_free(JChunkIterator, iterator);
+}
+
+static gboolean
+backend_iterate_status(gpointer backend_data, gpointer backend_iterator, gchar const** name, gint64* modification_time, guint64* size)
+{
+	JChunkIterator* iterator = backend_iterator;
+	MDB_cursor_op cursor_op = MDB_NEXT;
+	MDB_val m_key;
+	MDB_val m_value;
+
+	(void)backend_data;
+
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+	g_return_val_if_fail(name != NULL, FALSE);
+
+	if (iterator->first)
+	{
+		m_key.mv_size = iterator->prefix_length;
+		m_key.mv_data = iterator->prefix;
+
+		cursor_op = MDB_SET_RANGE;
+
+		iterator->first = FALSE;
+	}
+
+	// Keys are sorted, so the first key without the prefix ends the iteration.
+	if (mdb_cursor_get(iterator->cursor, &m_key, &m_value, cursor_op) == 0
+	    && m_key.mv_size >= iterator->prefix_length
+	    && memcmp(m_key.mv_data, iterator->prefix, iterator->prefix_length) == 0)
+	{
+		// The headers are stored alongside the names, so the status does not require additional lookups.
+		if (modification_time != NULL || size != NULL)
+		{
+			JChunkHeader header;
+
+			memcpy(&header, m_value.mv_data, sizeof(header));
+
+			if (modification_time != NULL)
+			{
+				*modification_time = header.modification_time;
+			}
+
+			if (size != NULL)
+			{
+				*size = header.size;
+			}
+		}
+
+		*name = (gchar const*)m_key.mv_data + iterator->namespace_length;
+
+		return TRUE;
+	}
+
+	backend_iterate_free(backend_data, backend_iterator);
+
+	return FALSE;
+}
+
+static gboolean
+backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** name)
+{
+	return backend_iterate_status(backend_data, backend_iterator, name, NULL, NULL);
+}
+
+static gboolean
+backend_init(gchar const* path, gpointer* backend_data)
+{
+	JChunkData* bd;
+	MDB_txn* txn;
+	guint64 map_size = (guint64)4 * 1024 * 1024 * 1024;
+
+	g_auto(GStrv) split = NULL;
+
+	g_return_val_if_fail(path != NULL, FALSE);
+
+	// The path can be followed by options, for example, /var/storage/lmdb:chunk-size=4096
+	split = g_strsplit(path, ":", 0);
+
+	g_mkdir_with_parents(split[0], 0700);
+
+	bd = g_slice_new(JChunkData);
+	bd->env = NULL;
+	bd->chunk_size = J_CHUNK_DEFAULT_SIZE;
+
+	for (guint i = 1; split[i] != NULL; i++)
+	{
+		gchar const* value;
+
+		value = strchr(split[i], '=');
+
+		if (value == NULL)
+		{
+			g_warning("Ignoring invalid option %s.", split[i]);
+			continue;
+		}
+
+		value++;
+
+		if (g_str_has_prefix(split[i], "chunk-size="))
+		{
+			bd->chunk_size = CLAMP(g_ascii_strtoull(value, NULL, 10), 1, G_MAXUINT32);
+		}
+		else if (g_str_has_prefix(split[i], "map-size="))
+		{
+			map_size = g_ascii_strtoull(value, NULL, 10);
+		}
+		else
+		{
+			g_warning("Ignoring unknown option %s.", split[i]);
+		}
+	}
+
+	if (mdb_env_create(&(bd->env)) != 0)
+	{
+		goto error;
+	}
+
+	if (mdb_env_set_mapsize(bd->env, map_size) != 0)
+	{
+		goto error;
+	}
+
+	if (mdb_env_set_maxdbs(bd->env, 2) != 0)
+	{
+		goto error;
+	}
+
+	// Iterators keep their read transactions across requests, which can be handled by different threads.
+	if (mdb_env_open(bd->env, split[0], MDB_NOTLS, 0600) != 0)
+	{
+		goto error;
+	}
+
+	if (mdb_txn_begin(bd->env, NULL, 0, &txn) != 0)
+	{
+		goto error;
+	}
+
+	if (mdb_dbi_open(txn, "headers", MDB_CREATE, &(bd->headers)) != 0 || mdb_dbi_open(txn, "chunks", MDB_CREATE, &(bd->chunks)) != 0)
+	{
+		mdb_txn_abort(txn);
+		goto error;
+	}
+
+	if (mdb_txn_commit(txn) != 0)
+	{
+		goto error;
+	}
+
+	*backend_data = bd;
+
+	return TRUE;
+
+error:
+	if (bd->env != NULL)
+	{
+		mdb_env_close(bd->env);
+	}
+
+	g_slice_free(JChunkData, bd);
+
+	return FALSE;
+}
+
+static void
+backend_fini(gpointer backend_data)
+{
+	JChunkData* bd = backend_data;
+
+	mdb_env_close(bd->env);
+
+	g_slice_free(JChunkData, bd);
+}
+
+static JBackend lmdb_backend = {
+	.type = J_BACKEND_TYPE_OBJECT,
+	.component = J_BACKEND_COMPONENT_SERVER,
+	.object = {
+		.backend_init = backend_init,
+		.backend_fini = backend_fini,
+		.backend_create = backend_create,
+		.backend_delete = backend_delete,
+		.backend_open = backend_open,
+		.backend_close = backend_close,
+		.backend_status = backend_status,
+		.backend_sync = backend_sync,
+		.backend_read = backend_read,
+		.backend_write = backend_write,
+		.backend_truncate = backend_truncate,
+		.backend_get_all = backend_get_all,
+		.backend_get_by_prefix = backend_get_by_prefix,
+		.backend_iterate = backend_iterate,
+		.backend_iterate_status = backend_iterate_status,
+		.backend_iterate_free = backend_iterate_free }
+};
+
+G_MODULE_EXPORT
+JBackend*
+backend_info(void)
+{
+	return &lmdb_backend;
+}
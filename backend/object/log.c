@@ -0,0 +1,1686 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * This backend packs small objects into large append-only segment files.
+ *
+ * Every modification of a small object appends a record containing the object's complete contents to the active segment.
+ * An in-memory index maps objects to the location of their latest record.
+ * It is checkpointed to an index file, segments are replayed from the checkpoint when the backend is initialized.
+ * Objects that grow beyond a threshold are promoted to standalone files.
+ * A background thread compacts segments that consist mostly of superseded records.
+ */
+
+#include <julea-config.h>
+
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <gmodule.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <julea.h>
+
+#define J_LOG_RECORD_MAGIC 0x4a4c4f47
+#define J_LOG_INDEX_MAGIC G_GUINT64_CONSTANT(0x4a4c4f47494e4458)
+
+/**
+ * The default size up to which objects are stored in segments.
+ **/
+#define J_LOG_DEFAULT_THRESHOLD (64 * 1024)
+
+/**
+ * The default size after which a new segment is started.
+ **/
+#define J_LOG_DEFAULT_SEGMENT_SIZE (64 * 1024 * 1024)
+
+/**
+ * The interval between compaction runs in seconds.
+ **/
+#define J_LOG_COMPACTION_INTERVAL 10
+
+enum JLogRecordType
+{
+	J_LOG_RECORD_PUT,
+	J_LOG_RECORD_DELETE,
+	J_LOG_RECORD_PROMOTE
+};
+
+typedef enum JLogRecordType JLogRecordType;
+
+/**
+ * A record's header, followed by the namespace, the path and the data.
+ **/
+struct JLogRecordHeader
+{
+	guint32 magic;
+	guint32 type;
+	guint32 namespace_length;
+	guint32 path_length;
+	guint64 data_length;
+	gint64 modification_time;
+};
+
+typedef struct JLogRecordHeader JLogRecordHeader;
+
+/**
+ * An entry of the index file, followed by the namespace and the path.
+ **/
+struct JLogIndexEntry
+{
+	guint32 namespace_length;
+	guint32 path_length;
+	guint32 segment;
+	guint32 promoted;
+	guint64 offset;
+	guint64 length;
+	guint64 record_length;
+	gint64 modification_time;
+};
+
+typedef struct JLogIndexEntry JLogIndexEntry;
+
+struct JLogSegment
+{
+	guint32 id;
+	gint fd;
+
+	/**
+	 * The segment's size.
+	 **/
+	guint64 size;
+
+	/**
+	 * The number of bytes belonging to current records.
+	 **/
+	guint64 live;
+};
+
+typedef struct JLogSegment JLogSegment;
+
+/**
+ * An object's location.
+ * Entries are protected by the backend's mutex, except for the descriptor of promoted objects.
+ **/
+struct JLogEntry
+{
+	/**
+	 * The segment and the offset of the object's data within it.
+	 **/
+	guint32 segment;
+	guint64 offset;
+
+	/**
+	 * The object's length.
+	 **/
+	guint64 length;
+
+	/**
+	 * The length of the object's record, including the header.
+	 **/
+	guint64 record_length;
+
+	gint64 modification_time;
+
+	/**
+	 * Whether the object has been promoted to a standalone file.
+	 **/
+	gboolean promoted;
+
+	/**
+	 * The standalone file's descriptor, opened on demand.
+	 **/
+	gint fd;
+
+	gboolean deleted;
+
+	guint ref_count;
+};
+
+typedef struct JLogEntry JLogEntry;
+
+struct JBackendData
+{
+	gchar* path;
+
+	guint64 threshold;
+	guint64 segment_size;
+
+	GMutex mutex;
+
+	/**
+	 * Maps namespaces to hash tables, which map paths to entries.
+	 **/
+	GHashTable* namespaces;
+
+	/**
+	 * Maps segment IDs to segments.
+	 **/
+	GHashTable* segments;
+
+	JLogSegment* active;
+
+	GThread* compactor;
+	GCond compactor_cond;
+	gboolean compactor_stop;
+};
+
+typedef struct JBackendData JBackendData;
+
+/**
+ * An object's status at the time its name was listed.
+ **/
+struct JLogStatus
+{
+	gint64 modification_time;
+	guint64 size;
+	gboolean promoted;
+};
+
+typedef struct JLogStatus JLogStatus;
+
+struct JBackendIterator
+{
+	gchar* namespace;
+	GPtrArray* names;
+	GArray* statuses;
+	guint index;
+};
+
+typedef struct JBackendIterator JBackendIterator;
+
+struct JBackendObject
+{
+	gchar* namespace;
+	gchar* path;
+	JLogEntry* entry;
+};
+
+typedef struct JBackendObject JBackendObject;
+
+static JLogEntry*
+jd_log_entry_new(void)
+{
+	JLogEntry* entry;
+
+	entry = g_slice_new0(JLogEntry);
+	entry->fd = -1;
+	entry->ref_count = 1;
+
+	return entry;
+}
+
+static JLogEntry*
+jd_log_entry_ref(JLogEntry* entry)
+{
+	g_atomic_int_inc(&(entry->ref_count));
+
+	return entry;
+}
+
+static void
+jd_log_entry_unref(gpointer data)
+{
+	JLogEntry* entry = data;
+
+	if (g_atomic_int_dec_and_test(&(entry->ref_count)))
+	{
+		if (entry->fd != -1)
+		{
+			close(entry->fd);
+		}
+
+		g_slice_free(JLogEntry, entry);
+	}
+}
+
+static void
+jd_log_segment_free(gpointer data)
+{
+	JLogSegment* segment = data;
+
+	close(segment->fd);
+	g_slice_free(JLogSegment, segment);
+}
+
+static gchar*
+jd_log_segment_path(JBackendData* bd, guint32 id)
+{
+	g_autofree gchar* name = NULL;
+
+	name = g_strdup_printf("%08x", id);
+
+	return g_build_filename(bd->path, "segments", name, NULL);
+}
+
+static gchar*
+jd_log_file_path(JBackendData* bd, gchar const* namespace, gchar const* path)
+{
+	return g_build_filename(bd->path, "objects", namespace, path, NULL);
+}
+
+static JLogSegment*
+jd_log_segment_open(JBackendData* bd, guint32 id, gboolean create)
+{
+	JLogSegment* segment;
+	g_autofree gchar* path = NULL;
+	struct stat buf;
+	gint fd;
+
+	path = jd_log_segment_path(bd, id);
+
+	if ((fd = open(path, O_RDWR | ((create) ? O_CREAT | O_EXCL : 0), 0600)) == -1)
+	{
+		return NULL;
+	}
+
+	if (fstat(fd, &buf) != 0)
+	{
+		close(fd);
+		return NULL;
+	}
+
+	segment = g_slice_new(JLogSegment);
+	segment->id = id;
+	segment->fd = fd;
+	segment->size = buf.st_size;
+	segment->live = 0;
+
+	g_hash_table_insert(bd->segments, GUINT_TO_POINTER(id), segment);
+
+	return segment;
+}
+
+static JLogSegment*
+jd_log_segment_get(JBackendData* bd, guint32 id)
+{
+	return g_hash_table_lookup(bd->segments, GUINT_TO_POINTER(id));
+}
+
+static GHashTable*
+jd_log_namespace_get(JBackendData* bd, gchar const* namespace, gboolean create)
+{
+	GHashTable* entries;
+
+	entries = g_hash_table_lookup(bd->namespaces, namespace);
+
+	if (entries == NULL && create)
+	{
+		entries = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, jd_log_entry_unref);
+		g_hash_table_insert(bd->namespaces, g_strdup(namespace), entries);
+	}
+
+	return entries;
+}
+
+/**
+ * Marks an entry's current record as superseded.
+ **/
+static void
+jd_log_entry_release(JBackendData* bd, JLogEntry* entry)
+{
+	JLogSegment* segment;
+
+	if (entry->promoted || entry->record_length == 0)
+	{
+		return;
+	}
+
+	if ((segment = jd_log_segment_get(bd, entry->segment)) != NULL)
+	{
+		segment->live -= MIN(segment->live, entry->record_length);
+	}
+
+	entry->record_length = 0;
+}
+
+static gsize
+jd_log_pread(gint fd, gpointer buffer, gsize length, guint64 offset)
+{
+	gsize nbytes_total = 0;
+
+	while (nbytes_total < length)
+	{
+		gssize nbytes;
+
+		nbytes = pread(fd, (gchar*)buffer + nbytes_total, length - nbytes_total, offset + nbytes_total);
+
+		if (nbytes == 0)
+		{
+			break;
+		}
+		else if (nbytes < 0)
+		{
+			if (errno != EINTR)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		nbytes_total += nbytes;
+	}
+
+	return nbytes_total;
+}
+
+static gsize
+jd_log_pwrite(gint fd, gconstpointer buffer, gsize length, guint64 offset)
+{
+	gsize nbytes_total = 0;
+
+	while (nbytes_total < length)
+	{
+		gssize nbytes;
+
+		nbytes = pwrite(fd, (gchar const*)buffer + nbytes_total, length - nbytes_total, offset + nbytes_total);
+
+		if (nbytes <= 0)
+		{
+			if (errno != EINTR)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		nbytes_total += nbytes;
+	}
+
+	return nbytes_total;
+}
+
+/**
+ * Starts a new active segment.
+ * The previous one is synced, since it will not be written to anymore.
+ **/
+static gboolean
+jd_log_segment_roll(JBackendData* bd)
+{
+	JLogSegment* segment;
+	guint32 id = 1;
+
+	if (bd->active != NULL)
+	{
+		fsync(bd->active->fd);
+		id = bd->active->id + 1;
+	}
+
+	if ((segment = jd_log_segment_open(bd, id, TRUE)) == NULL)
+	{
+		g_critical("Can not create segment %u in %s: %s", id, bd->path, g_strerror(errno));
+		return FALSE;
+	}
+
+	bd->active = segment;
+
+	return TRUE;
+}
+
+/**
+ * Appends a record to the active segment.
+ * Must be called with the mutex held.
+ *
+ * \return TRUE on success, FALSE otherwise.
+ **/
+static gboolean
+jd_log_append(JBackendData* bd, JLogRecordType type, gchar const* namespace, gchar const* path, gconstpointer data, guint64 length, gint64 modification_time, JLogEntry* entry)
+{
+	JLogRecordHeader header;
+	g_autofree gchar* record = NULL;
+	gsize namespace_length;
+	gsize path_length;
+	gsize record_length;
+	guint64 offset;
+
+	if (bd->active->size >= bd->segment_size && !jd_log_segment_roll(bd))
+	{
+		return FALSE;
+	}
+
+	namespace_length = strlen(namespace);
+	path_length = strlen(path);
+	record_length = sizeof(header) + namespace_length + path_length + length;
+
+	header.magic = J_LOG_RECORD_MAGIC;
+	header.type = type;
+	header.namespace_length = namespace_length;
+	header.path_length = path_length;
+	header.data_length = length;
+	header.modification_time = modification_time;
+
+	// Records are small, so they are assembled and written at once.
+	record = g_malloc(record_length);
+	memcpy(record, &header, sizeof(header));
+	memcpy(record + sizeof(header), namespace, namespace_length);
+	memcpy(record + sizeof(header) + namespace_length, path, path_length);
+
+	if (length > 0)
+	{
+		memcpy(record + sizeof(header) + namespace_length + path_length, data, length);
+	}
+
+	offset = bd->active->size;
+
+	j_trace_file_begin(bd->path, J_TRACE_FILE_WRITE);
+
+	if (jd_log_pwrite(bd->active->fd, record, record_length, offset) != record_length)
+	{
+		j_trace_file_end(bd->path, J_TRACE_FILE_WRITE, 0, offset);
+		return FALSE;
+	}
+
+	j_trace_file_end(bd->path, J_TRACE_FILE_WRITE, record_length, offset);
+
+	bd->active->size += record_length;
+
+	if (entry != NULL && type == J_LOG_RECORD_PUT)
+	{
+		jd_log_entry_release(bd, entry);
+
+		entry->segment = bd->active->id;
+		entry->offset = offset + record_length - length;
+		entry->length = length;
+		entry->record_length = record_length;
+		entry->modification_time = modification_time;
+
+		bd->active->live += record_length;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Applies the records of a segment to the index.
+ *
+ * \return The end of the last valid record.
+ **/
+static guint64
+jd_log_replay(JBackendData* bd, JLogSegment* segment, guint64 offset)
+{
+	while (offset + sizeof(JLogRecordHeader) <= segment->size)
+	{
+		JLogRecordHeader header;
+		GHashTable* entries;
+		JLogEntry* entry;
+		g_autofree gchar* namespace = NULL;
+		g_autofree gchar* path = NULL;
+		guint64 record_length;
+
+		if (jd_log_pread(segment->fd, &header, sizeof(header), offset) != sizeof(header) || header.magic != J_LOG_RECORD_MAGIC)
+		{
+			break;
+		}
+
+		record_length = sizeof(header) + header.namespace_length + header.path_length + header.data_length;
+
+		// The record has not been written completely.
+		if (offset + record_length > segment->size)
+		{
+			break;
+		}
+
+		namespace = g_malloc0(header.namespace_length + 1);
+		path = g_malloc0(header.path_length + 1);
+
+		jd_log_pread(segment->fd, namespace, header.namespace_length, offset + sizeof(header));
+		jd_log_pread(segment->fd, path, header.path_length, offset + sizeof(header) + header.namespace_length);
+
+		entries = jd_log_namespace_get(bd, namespace, TRUE);
+		entry = g_hash_table_lookup(entries, path);
+
+		switch (header.type)
+		{
+			case J_LOG_RECORD_PUT:
+				if (entry == NULL)
+				{
+					entry = jd_log_entry_new();
+					g_hash_table_insert(entries, g_strdup(path), entry);
+				}
+
+				jd_log_entry_release(bd, entry);
+
+				entry->segment = segment->id;
+				entry->offset = offset + record_length - header.data_length;
+				entry->length = header.data_length;
+				entry->record_length = record_length;
+				entry->modification_time = header.modification_time;
+				entry->promoted = FALSE;
+
+				segment->live += record_length;
+				break;
+			case J_LOG_RECORD_PROMOTE:
+				if (entry != NULL)
+				{
+					jd_log_entry_release(bd, entry);
+					entry->promoted = TRUE;
+				}
+				break;
+			case J_LOG_RECORD_DELETE:
+				if (entry != NULL)
+				{
+					jd_log_entry_release(bd, entry);
+					g_hash_table_remove(entries, path);
+				}
+				break;
+			default:
+				g_warning("Ignoring unknown record type %u in segment %u.", header.type, segment->id);
+		}
+
+		offset += record_length;
+	}
+
+	return offset;
+}
+
+/**
+ * Writes the index to the index file.
+ * Must be called with the mutex held.
+ **/
+static gboolean
+jd_log_checkpoint(JBackendData* bd)
+{
+	g_autoptr(GByteArray) index_data = NULL;
+	g_autofree gchar* index_path = NULL;
+	GHashTableIter namespace_iter;
+	gpointer namespace;
+	gpointer entries;
+	guint64 magic = J_LOG_INDEX_MAGIC;
+	guint32 active = bd->active->id;
+	guint64 active_size = bd->active->size;
+
+	// The index must not refer to data that has not reached the storage yet.
+	if (fsync(bd->active->fd) != 0)
+	{
+		return FALSE;
+	}
+
+	index_data = g_byte_array_new();
+	g_byte_array_append(index_data, (guint8 const*)&magic, sizeof(magic));
+	g_byte_array_append(index_data, (guint8 const*)&active, sizeof(active));
+	g_byte_array_append(index_data, (guint8 const*)&active_size, sizeof(active_size));
+
+	g_hash_table_iter_init(&namespace_iter, bd->namespaces);
+
+	while (g_hash_table_iter_next(&namespace_iter, &namespace, &entries))
+	{
+		GHashTableIter entry_iter;
+		gpointer path;
+		gpointer value;
+
+		g_hash_table_iter_init(&entry_iter, entries);
+
+		while (g_hash_table_iter_next(&entry_iter, &path, &value))
+		{
+			JLogEntry* entry = value;
+			JLogIndexEntry index_entry;
+
+			index_entry.namespace_length = strlen(namespace);
+			index_entry.path_length = strlen(path);
+			index_entry.segment = entry->segment;
+			index_entry.promoted = entry->promoted;
+			index_entry.offset = entry->offset;
+			index_entry.length = entry->length;
+			index_entry.record_length = entry->record_length;
+			index_entry.modification_time = entry->modification_time;
+
+			g_byte_array_append(index_data, (guint8 const*)&index_entry, sizeof(index_entry));
+			g_byte_array_append(index_data, namespace, index_entry.namespace_length);
+			g_byte_array_append(index_data, path, index_entry.path_length);
+		}
+	}
+
+	index_path = g_build_filename(bd->path, "index", NULL);
+
+	return g_file_set_contents(index_path, (gchar const*)index_data->data, index_data->len, NULL);
+}
+
+/**
+ * Loads the index file.
+ *
+ * \return TRUE if the index could be loaded, FALSE if all segments have to be replayed.
+ **/
+static gboolean
+jd_log_load_index(JBackendData* bd, guint32* active, guint64* active_size)
+{
+	g_autofree gchar* index_path = NULL;
+	g_autofree gchar* contents = NULL;
+	gsize length;
+	gsize position;
+	guint64 magic;
+
+	index_path = g_build_filename(bd->path, "index", NULL);
+
+	if (!g_file_get_contents(index_path, &contents, &length, NULL))
+	{
+		return FALSE;
+	}
+
+	position = sizeof(magic) + sizeof(*active) + sizeof(*active_size);
+
+	if (length < position)
+	{
+		return FALSE;
+	}
+
+	memcpy(&magic, contents, sizeof(magic));
+	memcpy(active, contents + sizeof(magic), sizeof(*active));
+	memcpy(active_size, contents + sizeof(magic) + sizeof(*active), sizeof(*active_size));
+
+	if (magic != J_LOG_INDEX_MAGIC)
+	{
+		return FALSE;
+	}
+
+	while (position + sizeof(JLogIndexEntry) <= length)
+	{
+		JLogIndexEntry index_entry;
+		JLogSegment* segment;
+		JLogEntry* entry;
+		g_autofree gchar* namespace = NULL;
+		gchar* path;
+
+		memcpy(&index_entry, contents + position, sizeof(index_entry));
+		position += sizeof(index_entry);
+
+		if (position + index_entry.namespace_length + index_entry.path_length > length)
+		{
+			g_warning("Index of %s is truncated.", bd->path);
+			break;
+		}
+
+		namespace = g_strndup(contents + position, index_entry.namespace_length);
+		path = g_strndup(contents + position + index_entry.namespace_length, index_entry.path_length);
+		position += index_entry.namespace_length + index_entry.path_length;
+
+		segment = jd_log_segment_get(bd, index_entry.segment);
+
+		if (!index_entry.promoted && segment == NULL)
+		{
+			g_warning("Dropping %s/%s, its segment %u is missing.", namespace, path, index_entry.segment);
+			g_free(path);
+			continue;
+		}
+
+		entry = jd_log_entry_new();
+		entry->segment = index_entry.segment;
+		entry->offset = index_entry.offset;
+		entry->length = index_entry.length;
+		entry->record_length = index_entry.record_length;
+		entry->modification_time = index_entry.modification_time;
+		entry->promoted = index_entry.promoted;
+
+		if (!entry->promoted)
+		{
+			segment->live += entry->record_length;
+		}
+
+		g_hash_table_insert(jd_log_namespace_get(bd, namespace, TRUE), path, entry);
+	}
+
+	return TRUE;
+}
+
+static gint
+jd_log_compare_segments(gconstpointer a, gconstpointer b)
+{
+	guint32 id_a = GPOINTER_TO_UINT(*(gconstpointer const*)a);
+	guint32 id_b = GPOINTER_TO_UINT(*(gconstpointer const*)b);
+
+	return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * Opens all segments and rebuilds the index.
+ **/
+static gboolean
+jd_log_recover(JBackendData* bd)
+{
+	g_autoptr(GPtrArray) ids = NULL;
+	g_autofree gchar* segments_path = NULL;
+	GDir* dir;
+	gchar const* name;
+	gboolean have_index;
+	guint32 index_active = 0;
+	guint64 index_active_size = 0;
+
+	segments_path = g_build_filename(bd->path, "segments", NULL);
+	ids = g_ptr_array_new();
+
+	if ((dir = g_dir_open(segments_path, 0, NULL)) == NULL)
+	{
+		return FALSE;
+	}
+
+	while ((name = g_dir_read_name(dir)) != NULL)
+	{
+		guint64 id;
+
+		if (g_ascii_string_to_unsigned(name, 16, 1, G_MAXUINT32, &id, NULL))
+		{
+			g_ptr_array_add(ids, GUINT_TO_POINTER(id));
+		}
+	}
+
+	g_dir_close(dir);
+
+	g_ptr_array_sort(ids, jd_log_compare_segments);
+
+	for (guint i = 0; i < ids->len; i++)
+	{
+		if (jd_log_segment_open(bd, GPOINTER_TO_UINT(g_ptr_array_index(ids, i)), FALSE) == NULL)
+		{
+			g_critical("Can not open segment %u in %s: %s", GPOINTER_TO_UINT(g_ptr_array_index(ids, i)), bd->path, g_strerror(errno));
+			return FALSE;
+		}
+	}
+
+	have_index = jd_log_load_index(bd, &index_active, &index_active_size);
+
+	if (!have_index)
+	{
+		// Start over with an empty index.
+		g_hash_table_remove_all(bd->namespaces);
+		index_active = 0;
+		index_active_size = 0;
+	}
+
+	for (guint i = 0; i < ids->len; i++)
+	{
+		JLogSegment* segment;
+		guint32 id;
+		guint64 end;
+
+		id = GPOINTER_TO_UINT(g_ptr_array_index(ids, i));
+		segment = jd_log_segment_get(bd, id);
+
+		if (id < index_active)
+		{
+			continue;
+		}
+
+		end = jd_log_replay(bd, segment, (id == index_active) ? index_active_size : 0);
+
+		// Drop incomplete records at the end of the last segment, they will be overwritten.
+		if (i == ids->len - 1)
+		{
+			segment->size = end;
+			bd->active = segment;
+		}
+	}
+
+	if (bd->active == NULL && !jd_log_segment_roll(bd))
+	{
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * Moves the current records of a segment to the active segment and removes it.
+ * Must be called with the mutex held.
+ **/
+static gboolean
+jd_log_compact_segment(JBackendData* bd, JLogSegment* segment)
+{
+	GHashTableIter namespace_iter;
+	gpointer namespace;
+	gpointer entries;
+	g_autofree gchar* segment_path = NULL;
+	gboolean ret = TRUE;
+
+	g_hash_table_iter_init(&namespace_iter, bd->namespaces);
+
+	while (g_hash_table_iter_next(&namespace_iter, &namespace, &entries))
+	{
+		GHashTableIter entry_iter;
+		gpointer path;
+		gpointer value;
+
+		g_hash_table_iter_init(&entry_iter, entries);
+
+		while (g_hash_table_iter_next(&entry_iter, &path, &value))
+		{
+			JLogEntry* entry = value;
+			g_autofree gchar* data = NULL;
+
+			if (entry->promoted || entry->segment != segment->id)
+			{
+				continue;
+			}
+
+			data = g_malloc(MAX(entry->length, 1));
+
+			if (jd_log_pread(segment->fd, data, entry->length, entry->offset) != entry->length || !jd_log_append(bd, J_LOG_RECORD_PUT, namespace, path, data, entry->length, entry->modification_time, entry))
+			{
+				ret = FALSE;
+			}
+		}
+	}
+
+	// The segment has to stay if not all records could be moved or the index could not be updated.
+	if (!ret || !jd_log_checkpoint(bd))
+	{
+		return FALSE;
+	}
+
+	segment_path = jd_log_segment_path(bd, segment->id);
+	g_unlink(segment_path);
+
+	g_hash_table_remove(bd->segments, GUINT_TO_POINTER(segment->id));
+
+	return TRUE;
+}
+
+/**
+ * Compacts segments that consist mostly of superseded records.
+ **/
+static gpointer
+jd_log_compactor(gpointer data)
+{
+	JBackendData* bd = data;
+
+	g_mutex_lock(&(bd->mutex));
+
+	while (!bd->compactor_stop)
+	{
+		g_autoptr(GPtrArray) candidates = NULL;
+		GHashTableIter iter;
+		gpointer value;
+		gint64 end_time;
+
+		candidates = g_ptr_array_new();
+		g_hash_table_iter_init(&iter, bd->segments);
+
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+		{
+			JLogSegment* segment = value;
+
+			if (segment != bd->active && segment->live < segment->size / 2)
+			{
+				g_ptr_array_add(candidates, segment);
+			}
+		}
+
+		for (guint i = 0; i < candidates->len && !bd->compactor_stop; i++)
+		{
+			JLogSegment* segment = g_ptr_array_index(candidates, i);
+
+			if (!jd_log_compact_segment(bd, segment))
+			{
+				g_warning("Compacting segment %u in %s failed.", segment->id, bd->path);
+				break;
+			}
+
+			// Let waiting requests proceed between segments, only the compactor removes segments.
+			g_mutex_unlock(&(bd->mutex));
+			g_mutex_lock(&(bd->mutex));
+		}
+
+		end_time = g_get_monotonic_time() + J_LOG_COMPACTION_INTERVAL * G_TIME_SPAN_SECOND;
+
+		while (!bd->compactor_stop && g_cond_wait_until(&(bd->compactor_cond), &(bd->mutex), end_time))
+		{
+		}
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	return NULL;
+}
+
+/**
+ * Returns the descriptor of a promoted object.
+ * Must be called with the mutex held.
+ **/
+static gint
+jd_log_entry_get_fd(JBackendData* bd, JBackendObject* bo)
+{
+	JLogEntry* entry = bo->entry;
+
+	if (entry->fd == -1)
+	{
+		g_autofree gchar* file_path = NULL;
+
+		file_path = jd_log_file_path(bd, bo->namespace, bo->path);
+		entry->fd = open(file_path, O_RDWR);
+	}
+
+	return entry->fd;
+}
+
+/**
+ * Moves an object from its segment to a standalone file.
+ * Must be called with the mutex held.
+ **/
+static gboolean
+jd_log_promote(JBackendData* bd, JBackendObject* bo)
+{
+	JLogEntry* entry = bo->entry;
+	JLogSegment* segment;
+	g_autofree gchar* file_path = NULL;
+	g_autofree gchar* parent = NULL;
+	g_autofree gchar* data = NULL;
+	gint fd;
+
+	segment = jd_log_segment_get(bd, entry->segment);
+	data = g_malloc(MAX(entry->length, 1));
+
+	if (segment == NULL || jd_log_pread(segment->fd, data, entry->length, entry->offset) != entry->length)
+	{
+		return FALSE;
+	}
+
+	file_path = jd_log_file_path(bd, bo->namespace, bo->path);
+	parent = g_path_get_dirname(file_path);
+	g_mkdir_with_parents(parent, 0700);
+
+	j_trace_file_begin(file_path, J_TRACE_FILE_CREATE);
+	fd = open(file_path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	j_trace_file_end(file_path, J_TRACE_FILE_CREATE, 0, 0);
+
+	if (fd == -1)
+	{
+		return FALSE;
+	}
+
+	// The file has to be complete before the record makes it visible after a restart.
+	if (jd_log_pwrite(fd, data, entry->length, 0) != entry->length || fsync(fd) != 0)
+	{
+		close(fd);
+		g_unlink(file_path);
+		return FALSE;
+	}
+
+	if (!jd_log_append(bd, J_LOG_RECORD_PROMOTE, bo->namespace, bo->path, NULL, 0, g_get_real_time(), entry))
+	{
+		close(fd);
+		g_unlink(file_path);
+		return FALSE;
+	}
+
+	jd_log_entry_release(bd, entry);
+	entry->promoted = TRUE;
+	entry->fd = fd;
+
+	return TRUE;
+}
+
+static JBackendObject*
+jd_log_object_new(gchar const* namespace, gchar const* path, JLogEntry* entry)
+{
+	JBackendObject* bo;
+
+	bo = g_slice_new(JBackendObject);
+	bo->namespace = g_strdup(namespace);
+	bo->path = g_strdup(path);
+	bo->entry = jd_log_entry_ref(entry);
+
+	return bo;
+}
+
+static void
+jd_log_object_free(JBackendObject* bo)
+{
+	jd_log_entry_unref(bo->entry);
+	g_free(bo->namespace);
+	g_free(bo->path);
+	g_slice_free(JBackendObject, bo);
+}
+
+static gboolean
+backend_create(gpointer backend_data, gchar const* namespace, gchar const* path, gpointer* backend_object)
+{
+	JBackendData* bd = backend_data;
+	GHashTable* entries;
+	JLogEntry* entry;
+	gboolean ret = TRUE;
+
+	g_mutex_lock(&(bd->mutex));
+
+	entries = jd_log_namespace_get(bd, namespace, TRUE);
+
+	// Creating an existing object opens it.
+	if ((entry = g_hash_table_lookup(entries, path)) == NULL)
+	{
+		entry = jd_log_entry_new();
+
+		if ((ret = jd_log_append(bd, J_LOG_RECORD_PUT, namespace, path, NULL, 0, g_get_real_time(), entry)))
+		{
+			g_hash_table_insert(entries, g_strdup(path), entry);
+		}
+		else
+		{
+			jd_log_entry_unref(entry);
+		}
+	}
+
+	if (ret)
+	{
+		*backend_object = jd_log_object_new(namespace, path, entry);
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	return ret;
+}
+
+static gboolean
+backend_open(gpointer backend_data, gchar const* namespace, gchar const* path, gpointer* backend_object)
+{
+	JBackendData* bd = backend_data;
+	GHashTable* entries;
+	JLogEntry* entry = NULL;
+
+	g_mutex_lock(&(bd->mutex));
+
+	if ((entries = jd_log_namespace_get(bd, namespace, FALSE)) != NULL)
+	{
+		entry = g_hash_table_lookup(entries, path);
+	}
+
+	if (entry != NULL)
+	{
+		*backend_object = jd_log_object_new(namespace, path, entry);
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	return (entry != NULL);
+}
+
+static gboolean
+backend_delete(gpointer backend_data, gpointer backend_object)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	GHashTable* entries;
+	gboolean ret = FALSE;
+
+	g_mutex_lock(&(bd->mutex));
+
+	if (!bo->entry->deleted && (ret = jd_log_append(bd, J_LOG_RECORD_DELETE, bo->namespace, bo->path, NULL, 0, g_get_real_time(), NULL)))
+	{
+		if (bo->entry->promoted)
+		{
+			g_autofree gchar* file_path = NULL;
+
+			file_path = jd_log_file_path(bd, bo->namespace, bo->path);
+
+			j_trace_file_begin(file_path, J_TRACE_FILE_DELETE);
+			g_unlink(file_path);
+			j_trace_file_end(file_path, J_TRACE_FILE_DELETE, 0, 0);
+		}
+
+		jd_log_entry_release(bd, bo->entry);
+		bo->entry->deleted = TRUE;
+
+		if ((entries = jd_log_namespace_get(bd, bo->namespace, FALSE)) != NULL)
+		{
+			g_hash_table_remove(entries, bo->path);
+		}
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	jd_log_object_free(bo);
+
+	return ret;
+}
+
+static gboolean
+backend_close(gpointer backend_data, gpointer backend_object)
+{
+	JBackendObject* bo = backend_object;
+
+	(void)backend_data;
+
+	jd_log_object_free(bo);
+
+	return TRUE;
+}
+
+static gboolean
+backend_status(gpointer backend_data, gpointer backend_object, gint64* modification_time, guint64* size)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	gboolean ret = TRUE;
+
+	g_mutex_lock(&(bd->mutex));
+
+	if (bo->entry->deleted)
+	{
+		ret = FALSE;
+	}
+	else if (bo->entry->promoted)
+	{
+		struct stat buf;
+		gint fd;
+
+		if ((fd = jd_log_entry_get_fd(bd, bo)) != -1 && fstat(fd, &buf) == 0)
+		{
+			if (modification_time != NULL)
+			{
+				*modification_time = buf.st_mtime * G_USEC_PER_SEC;
+			}
+
+			if (size != NULL)
+			{
+				*size = buf.st_size;
+			}
+		}
+		else
+		{
+			ret = FALSE;
+		}
+	}
+	else
+	{
+		if (modification_time != NULL)
+		{
+			*modification_time = bo->entry->modification_time;
+		}
+
+		if (size != NULL)
+		{
+			*size = bo->entry->length;
+		}
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	return ret;
+}
+
+static gboolean
+backend_sync(gpointer backend_data, gpointer backend_object)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	gboolean ret;
+	gint fd;
+
+	g_mutex_lock(&(bd->mutex));
+
+	fd = (bo->entry->promoted) ? jd_log_entry_get_fd(bd, bo) : bd->active->fd;
+
+	// Sealed segments have already been synced.
+	j_trace_file_begin(bd->path, J_TRACE_FILE_SYNC);
+	ret = (fd != -1 && fsync(fd) == 0);
+	j_trace_file_end(bd->path, J_TRACE_FILE_SYNC, 0, 0);
+
+	g_mutex_unlock(&(bd->mutex));
+
+	return ret;
+}
+
+static gboolean
+backend_read(gpointer backend_data, gpointer backend_object, gpointer buffer, guint64 length, guint64 offset, guint64* bytes_read)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	JLogEntry* entry = bo->entry;
+	gsize nbytes = 0;
+	gint fd = -1;
+
+	g_mutex_lock(&(bd->mutex));
+
+	if (entry->deleted)
+	{
+		g_mutex_unlock(&(bd->mutex));
+		return FALSE;
+	}
+
+	if (entry->promoted)
+	{
+		fd = jd_log_entry_get_fd(bd, bo);
+	}
+	else if (offset < entry->length)
+	{
+		JLogSegment* segment;
+
+		if ((segment = jd_log_segment_get(bd, entry->segment)) != NULL)
+		{
+			nbytes = jd_log_pread(segment->fd, buffer, MIN(length, entry->length - offset), entry->offset + offset);
+		}
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	// Promoted objects are read without holding the mutex, the descriptor stays valid as long as the entry is referenced.
+	if (fd != -1)
+	{
+		j_trace_file_begin(bo->path, J_TRACE_FILE_READ);
+		nbytes = jd_log_pread(fd, buffer, length, offset);
+		j_trace_file_end(bo->path, J_TRACE_FILE_READ, nbytes, offset);
+	}
+
+	if (bytes_read != NULL)
+	{
+		*bytes_read = nbytes;
+	}
+
+	return (nbytes == length);
+}
+
+static gboolean
+backend_write(gpointer backend_data, gpointer backend_object, gconstpointer buffer, guint64 length, guint64 offset, guint64* bytes_written)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	JLogEntry* entry = bo->entry;
+	gsize nbytes = 0;
+	gint fd = -1;
+
+	g_mutex_lock(&(bd->mutex));
+
+	if (entry->deleted)
+	{
+		g_mutex_unlock(&(bd->mutex));
+		return FALSE;
+	}
+
+	if (!entry->promoted && offset + length > bd->threshold && !jd_log_promote(bd, bo))
+	{
+		g_mutex_unlock(&(bd->mutex));
+		return FALSE;
+	}
+
+	if (entry->promoted)
+	{
+		fd = jd_log_entry_get_fd(bd, bo);
+	}
+	else
+	{
+		JLogSegment* segment;
+		g_autofree gchar* data = NULL;
+		guint64 new_length;
+
+		// Small objects are rewritten completely, the old record becomes garbage.
+		new_length = MAX(entry->length, offset + length);
+		data = g_malloc0(MAX(new_length, 1));
+
+		segment = jd_log_segment_get(bd, entry->segment);
+
+		if (segment != NULL && jd_log_pread(segment->fd, data, entry->length, entry->offset) == entry->length)
+		{
+			memcpy(data + offset, buffer, length);
+
+			if (jd_log_append(bd, J_LOG_RECORD_PUT, bo->namespace, bo->path, data, new_length, g_get_real_time(), entry))
+			{
+				nbytes = length;
+			}
+		}
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	if (fd != -1)
+	{
+		j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
+		nbytes = jd_log_pwrite(fd, buffer, length, offset);
+		j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, nbytes, offset);
+	}
+
+	if (bytes_written != NULL)
+	{
+		*bytes_written = nbytes;
+	}
+
+	return (nbytes == length);
+}
+
+static gboolean
+backend_truncate(gpointer backend_data, gpointer backend_object, guint64 size)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	JLogEntry* entry = bo->entry;
+	gboolean ret = FALSE;
+
+	g_mutex_lock(&(bd->mutex));
+
+	if (entry->deleted)
+	{
+		g_mutex_unlock(&(bd->mutex));
+		return FALSE;
+	}
+
+	if (!entry->promoted && size > bd->threshold && !jd_log_promote(bd, bo))
+	{
+		g_mutex_unlock(&(bd->mutex));
+		return FALSE;
+	}
+
+	if (entry->promoted)
+	{
+		gint fd;
+
+		if ((fd = jd_log_entry_get_fd(bd, bo)) != -1)
+		{
+			j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
+			ret = (ftruncate(fd, size) == 0);
+			j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, 0, size);
+		}
+	}
+	else
+	{
+		JLogSegment* segment;
+		g_autofree gchar* data = NULL;
+		guint64 length;
+
+		// Like writes, truncating a small object rewrites it completely.
+		length = MIN(entry->length, size);
+		data = g_malloc0(MAX(size, 1));
+
+		segment = jd_log_segment_get(bd, entry->segment);
+
+		if (segment != NULL && jd_log_pread(segment->fd, data, length, entry->offset) == length)
+		{
+			ret = jd_log_append(bd, J_LOG_RECORD_PUT, bo->namespace, bo->path, data, size, g_get_real_time(), entry);
+		}
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	return ret;
+}
+
+static gboolean
+jd_log_get_names(JBackendData* bd, gchar const* namespace, gchar const* prefix, gpointer* backend_iterator)
+{
+	JBackendIterator* iterator;
+	GHashTable* entries;
+
+	iterator = g_slice_new(JBackendIterator);
+	iterator->namespace = g_strdup(namespace);
+	iterator->names = g_ptr_array_new_with_free_func(g_free);
+	iterator->statuses = g_array_new(FALSE, FALSE, sizeof(JLogStatus));
+	iterator->index = 0;
+
+	// The names and statuses are copied, so the index can change while iterating.
+	g_mutex_lock(&(bd->mutex));
+
+	if ((entries = jd_log_namespace_get(bd, namespace, FALSE)) != NULL)
+	{
+		GHashTableIter iter;
+		gpointer path;
+		gpointer value;
+
+		g_hash_table_iter_init(&iter, entries);
+
+		while (g_hash_table_iter_next(&iter, &path, &value))
+		{
+			JLogEntry* entry = value;
+
+			if (prefix == NULL || g_str_has_prefix(path, prefix))
+			{
+				JLogStatus status;
+
+				status.modification_time = entry->modification_time;
+				status.size = entry->length;
+				status.promoted = entry->promoted;
+
+				g_ptr_array_add(iterator->names, g_strdup(path));
+				g_array_append_val(iterator->statuses, status);
+			}
+		}
+	}
+
+	g_mutex_unlock(&(bd->mutex));
+
+	*backend_iterator = iterator;
+
+	return TRUE;
+}
+
+static gboolean
+backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
+{
+	JBackendData* bd = backend_data;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	return jd_log_get_names(bd, namespace, NULL, backend_iterator);
+}
+
+static gboolean
+backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const* prefix, gpointer* backend_iterator)
+{
+	JBackendData* bd = backend_data;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(prefix != NULL, FALSE);
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+
+	return jd_log_get_names(bd, namespace, prefix, backend_iterator);
+}
+
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	JBackendIterator* iterator = backend_iterator;
+
+	(void)backend_data;
+
+	g_free(iterator->namespace);
+	g_ptr_array_unref(iterator->names);
+	g_array_unref(iterator->statuses);
+	g_slice_free(JBackendIterator, iterator);
+}
+
+static gboolean
+backend_iterate_status(gpointer backend_data, gpointer backend_iterator, gchar const** name, gint64* modification_time, guint64* size)
+{
+	JBackendData* bd = backend_data;
+	JBackendIterator* iterator = backend_iterator;
+
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+	g_return_val_if_fail(name != NULL, FALSE);
+
+	while (iterator->index < iterator->names->len)
+	{
+		JLogStatus* status = &g_array_index(iterator->statuses, JLogStatus, iterator->index);
+		gchar const* path = g_ptr_array_index(iterator->names, iterator->index);
+
+		iterator->index++;
+
+		// Promoted objects are stored in standalone files, which have to be checked for their current status.
+		if (status->promoted && (modification_time != NULL || size != NULL))
+		{
+			g_autofree gchar* file_path = NULL;
+			struct stat buf;
+
+			file_path = jd_log_file_path(bd, iterator->namespace, path);
+
+			if (stat(file_path, &buf) != 0)
+			{
+				continue;
+			}
+
+			status->modification_time = buf.st_mtime * G_USEC_PER_SEC;
+			status->size = buf.st_size;
+		}
+
+		if (modification_time != NULL)
+		{
+			*modification_time = status->modification_time;
+		}
+
+		if (size != NULL)
+		{
+			*size = status->size;
+		}
+
+		*name = path;
+
+		return TRUE;
+	}
+
+	backend_iterate_free(backend_data, backend_iterator);
+
+	return FALSE;
+}
+
+static gboolean
+backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** name)
+{
+	return backend_iterate_status(backend_data, backend_iterator, name, NULL, NULL);
+}
+
+static void
+jd_log_free(JBackendData* bd)
+{
+	g_hash_table_destroy(bd->namespaces);
+	g_hash_table_destroy(bd->segments);
+	g_mutex_clear(&(bd->mutex));
+	g_cond_clear(&(bd->compactor_cond));
+	g_free(bd->path);
+	g_slice_free(JBackendData, bd);
+}
+
+static gboolean
+backend_init(gchar const* path, gpointer* backend_data)
+{
+	JBackendData* bd;
+	g_autofree gchar* segments_path = NULL;
+
+	g_auto(GStrv) split = NULL;
+
+	g_return_val_if_fail(path != NULL, FALSE);
+
+	// The path can be followed by options, for example, /var/storage/log:threshold=65536:segment-size=67108864
+	split = g_strsplit(path, ":", 0);
+
+	bd = g_slice_new(JBackendData);
+	bd->path = g_strdup(split[0]);
+	bd->threshold = J_LOG_DEFAULT_THRESHOLD;
+	bd->segment_size = J_LOG_DEFAULT_SEGMENT_SIZE;
+	bd->namespaces = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, (GDestroyNotify)g_hash_table_unref);
+	bd->segments = g_hash_table_new_full(NULL, NULL, NULL, jd_log_segment_free);
+	bd->active = NULL;
+	bd->compactor = NULL;
+	bd->compactor_stop = FALSE;
+
+	g_mutex_init(&(bd->mutex));
+	g_cond_init(&(bd->compactor_cond));
+
+	for (guint i = 1; split[i] != NULL; i++)
+	{
+		gchar const* value;
+
+		value = strchr(split[i], '=');
+
+		if (value == NULL)
+		{
+			g_warning("Ignoring invalid option %s.", split[i]);
+			continue;
+		}
+
+		value++;
+
+		if (g_str_has_prefix(split[i], "threshold="))
+		{
+			bd->threshold = g_ascii_strtoull(value, NULL, 10);
+		}
+		else if (g_str_has_prefix(split[i], "segment-size="))
+		{
+			bd->segment_size = MAX(g_ascii_strtoull(value, NULL, 10), 1);
+		}
+		else
+		{
+			g_warning("Ignoring unknown option %s.", split[i]);
+		}
+	}
+
+	segments_path = g_build_filename(bd->path, "segments", NULL);
+	g_mkdir_with_parents(segments_path, 0700);
+
+	if (!jd_log_recover(bd))
+	{
+		jd_log_free(bd);
+		return FALSE;
+	}
+
+	bd->compactor = g_thread_new("log-compactor", jd_log_compactor, bd);
+
+	*backend_data = bd;
+
+	return TRUE;
+}
+
+static void
+backend_fini(gpointer backend_data)
+{
+	JBackendData* bd = backend_data;
+
+	g_mutex_lock(&(bd->mutex));
+	bd->compactor_stop = TRUE;
+	g_cond_signal(&(bd->compactor_cond));
+	g_mutex_unlock(&(bd->mutex));
+
+	g_thread_join(bd->compactor);
+
+	// Speed up the next initialization.
+	if (!jd_log_checkpoint(bd))
+	{
+		g_warning("Can not write index of %s.", bd->path);
+	}
+
+	jd_log_free(bd);
+}
+
+static JBackend log_backend = {
+	.type = J_BACKEND_TYPE_OBJECT,
+	.component = J_BACKEND_COMPONENT_SERVER,
+	.object = {
+		.backend_init = backend_init,
+		.backend_fini = backend_fini,
+		.backend_create = backend_create,
+		.backend_delete = backend_delete,
+		.backend_open = backend_open,
+		.backend_close = backend_close,
+		.backend_status = backend_status,
+		.backend_sync = backend_sync,
+		.backend_read = backend_read,
+		.backend_write = backend_write,
+		.backend_truncate = backend_truncate,
+		.backend_get_all = backend_get_all,
+		.backend_get_by_prefix = backend_get_by_prefix,
+		.backend_iterate = backend_iterate,
+		.backend_iterate_status = backend_iterate_status,
+		.backend_iterate_free = backend_iterate_free }
+};
+
+G_MODULE_EXPORT
+JBackend*
+backend_info(void)
+{
+	return &log_backend;
+}
@@ -161,6 +161,122 @@ backend_write(gpointer backend_data, gpointer backend_object, gconstpointer buff
 	return TRUE;
 }
 
+static gboolean
+backend_readv(gpointer backend_data, gpointer backend_object, JBackendObjectRequest* requests, guint count)
+{
+	gchar const* full_path = backend_object;
+
+	(void)backend_data;
+
+	for (guint i = 0; i < count; i++)
+	{
+		j_trace_file_begin(full_path, J_TRACE_FILE_READ);
+		j_trace_file_end(full_path, J_TRACE_FILE_READ, requests[i].length, requests[i].offset);
+
+		requests[i].bytes = requests[i].length;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+backend_writev(gpointer backend_data, gpointer backend_object, JBackendObjectRequest* requests, guint count)
+{
+	gchar const* full_path = backend_object;
+
+	(void)backend_data;
+
+	for (guint i = 0; i < count; i++)
+	{
+		j_trace_file_begin(full_path, J_TRACE_FILE_WRITE);
+		j_trace_file_end(full_path, J_TRACE_FILE_WRITE, requests[i].length, requests[i].offset);
+
+		requests[i].bytes = requests[i].length;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+backend_batch_start(gpointer backend_data, gchar const* namespace, gboolean sync, gpointer* backend_batch)
+{
+	(void)backend_data;
+	(void)sync;
+
+	*backend_batch = g_strdup(namespace);
+
+	return TRUE;
+}
+
+static gboolean
+backend_batch_create(gpointer backend_data, gpointer backend_batch, gchar const* path)
+{
+	gchar const* namespace = backend_batch;
+	g_autofree gchar* full_path = NULL;
+
+	(void)backend_data;
+
+	full_path = g_build_filename(namespace, path, NULL);
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_CREATE);
+	j_trace_file_end(full_path, J_TRACE_FILE_CREATE, 0, 0);
+
+	return TRUE;
+}
+
+static gboolean
+backend_batch_delete(gpointer backend_data, gpointer backend_batch, gchar const* path)
+{
+	gchar const* namespace = backend_batch;
+	g_autofree gchar* full_path = NULL;
+
+	(void)backend_data;
+
+	full_path = g_build_filename(namespace, path, NULL);
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_DELETE);
+	j_trace_file_end(full_path, J_TRACE_FILE_DELETE, 0, 0);
+
+	return TRUE;
+}
+
+static gboolean
+backend_batch_execute(gpointer backend_data, gpointer backend_batch)
+{
+	(void)backend_data;
+
+	g_free(backend_batch);
+
+	return TRUE;
+}
+
+static gboolean
+backend_preallocate(gpointer backend_data, gpointer backend_object, guint64 length, guint64 offset)
+{
+	gchar const* full_path = backend_object;
+
+	(void)backend_data;
+	(void)length;
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_WRITE);
+	j_trace_file_end(full_path, J_TRACE_FILE_WRITE, 0, offset);
+
+	return TRUE;
+}
+
+static gboolean
+backend_truncate(gpointer backend_data, gpointer backend_object, guint64 size)
+{
+	gchar const* full_path = backend_object;
+
+	(void)backend_data;
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_WRITE);
+	j_trace_file_end(full_path, J_TRACE_FILE_WRITE, 0, size);
+
+	return TRUE;
+}
+
 static gboolean
 backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
 {
@@ -199,6 +315,19 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	return FALSE;
 }
 
+static gboolean
+backend_iterate_status(gpointer backend_data, gpointer backend_iterator, gchar const** name, gint64* modification_time, guint64* size)
+{
+	(void)backend_data;
+	(void)modification_time;
+	(void)size;
+
+	g_return_val_if_fail(backend_iterator != NULL, FALSE);
+	g_return_val_if_fail(name != NULL, FALSE);
+
+	return FALSE;
+}
+
 static gboolean
 backend_init(gchar const* path, gpointer* backend_data)
 {
@@ -230,7 +359,16 @@ static JBackend null_backend = {
 		.backend_write = backend_write,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_iterate = backend_iterate,
+		.backend_readv = backend_readv,
+		.backend_writev = backend_writev,
+		.backend_batch_start = backend_batch_start,
+		.backend_batch_create = backend_batch_create,
+		.backend_batch_delete = backend_batch_delete,
+		.backend_batch_execute = backend_batch_execute,
+		.backend_preallocate = backend_preallocate,
+		.backend_truncate = backend_truncate,
+		.backend_iterate_status = backend_iterate_status }
 };
 
 G_MODULE_EXPORT
@@ -16,23 +16,70 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+// Required for copy_file_range()
+#define _GNU_SOURCE
+
 #include <julea-config.h>
 
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <gmodule.h>
 
+#include <errno.h>
 #include <fcntl.h>
+#include <ftw.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#ifdef HAVE_LIBURING
+#include <liburing.h>
+#endif
+
 #include <julea.h>
 
 struct JBackendData
 {
 	gchar* path;
 	/// \todo check whether hash tables can stay global
+
+	/**
+	 * The minimum request size for direct I/O, 0 if direct I/O is disabled.
+	 **/
+	guint64 direct_threshold;
+
+	/**
+	 * The namespaces that use direct I/O, NULL for all namespaces.
+	 **/
+	gchar** direct_namespaces;
+
+	/**
+	 * The number of hashed subdirectory levels below each namespace, 0 for a flat layout.
+	 **/
+	guint shard_levels;
+
+	/**
+	 * The maximum number of bytes mapped for reads, 0 if mapping is disabled.
+	 **/
+	guint64 map_cache_size;
+
+	/**
+	 * The namespaces whose objects are mapped, NULL for all namespaces.
+	 **/
+	gchar** map_namespaces;
+
+	/**
+	 * The mapping cache, protected by map_mutex.
+	 * Maps paths to mappings, the queue contains the mappings in least recently used order.
+	 **/
+	GMutex map_mutex;
+	GHashTable* mappings;
+	GQueue map_lru;
+	guint64 mapped;
 };
 
 typedef struct JBackendData JBackendData;
@@ -41,19 +88,93 @@ struct JBackendIterator
 {
 	JDirIterator* iterator;
 	gchar* prefix;
+	guint shard_levels;
 };
 
 typedef struct JBackendIterator JBackendIterator;
 
+/**
+ * A batch of metadata operations on a namespace.
+ **/
+struct JBackendBatch
+{
+	gchar* namespace;
+	gboolean sync;
+
+	/**
+	 * The directories that are known to exist, so that each one is only created once per batch.
+	 **/
+	GHashTable* directories;
+};
+
+typedef struct JBackendBatch JBackendBatch;
+
 struct JBackendObject
 {
 	gchar* path;
 	gint fd;
+
+	/**
+	 * A second descriptor opened with O_DIRECT, -1 if direct I/O is not used for this object.
+	 **/
+	gint direct_fd;
+
+	/**
+	 * Whether reads may be served from a mapping.
+	 **/
+	gboolean map;
+
 	guint ref_count;
 };
 
 typedef struct JBackendObject JBackendObject;
 
+/**
+ * A read-only mapping of a whole object.
+ * The cache holds one reference, readers hold one each until their reply has been sent.
+ **/
+struct JBackendMapping
+{
+	gchar* path;
+	gchar* data;
+	gsize length;
+	GList link;
+	guint ref_count;
+};
+
+typedef struct JBackendMapping JBackendMapping;
+
+/**
+ * The alignment required for direct I/O.
+ * This matches the memory chunks used by the server, so that their large segments can be used directly.
+ **/
+#define J_BACKEND_DIRECT_ALIGNMENT J_MEMORY_CHUNK_ALIGNMENT
+
+/**
+ * The size of the bounce buffer used for unaligned buffers.
+ **/
+#define J_BACKEND_DIRECT_BOUNCE_SIZE (4 * 1024 * 1024)
+
+/**
+ * The maximum number of adjacent ranges combined into one vectored call.
+ **/
+#define J_BACKEND_IOV_MAX 64
+
+/**
+ * The maximum number of shard levels, each level uses one byte of the hash.
+ **/
+#define J_BACKEND_SHARD_LEVELS_MAX 4
+
+/**
+ * The file recording the layout of the storage directory.
+ **/
+#define J_BACKEND_LAYOUT_FILE ".layout"
+
+/**
+ * The suffix of namespace directories that are being migrated to a new layout.
+ **/
+#define J_BACKEND_MIGRATE_SUFFIX ".migrate"
+
 static guint jd_num_backends = 0;
 
 static GHashTable* jd_backend_file_cache = NULL;
@@ -82,10 +203,20 @@ backend_file_unref(gpointer data)
 
 	if (g_atomic_int_dec_and_test(&(bo->ref_count)))
 	{
-		g_hash_table_remove(jd_backend_file_cache, bo->path);
+		// The object might have been purged from the cache and replaced by a newer one with the same path.
+		if (g_hash_table_lookup(jd_backend_file_cache, bo->path) == bo)
+		{
+			g_hash_table_remove(jd_backend_file_cache, bo->path);
+		}
 
 		j_trace_file_begin(bo->path, J_TRACE_FILE_CLOSE);
 		close(bo->fd);
+
+		if (bo->direct_fd != -1)
+		{
+			close(bo->direct_fd);
+		}
+
 		j_trace_file_end(bo->path, J_TRACE_FILE_CLOSE, 0, 0);
 
 		g_free(bo->path);
@@ -148,6 +279,315 @@ backend_file_add(GHashTable* files, JBackendObject* object)
 	G_UNLOCK(jd_backend_file_cache);
 }
 
+static void
+jd_backend_mapping_unref(JBackendMapping* mapping)
+{
+	if (g_atomic_int_dec_and_test(&(mapping->ref_count)))
+	{
+		munmap(mapping->data, mapping->length);
+		g_free(mapping->path);
+		g_slice_free(JBackendMapping, mapping);
+	}
+}
+
+/**
+ * Removes a mapping from the cache.
+ * Must be called with map_mutex held.
+ **/
+static void
+jd_backend_mapping_evict(JBackendData* bd, JBackendMapping* mapping)
+{
+	g_hash_table_remove(bd->mappings, mapping->path);
+	g_queue_unlink(&(bd->map_lru), &(mapping->link));
+	bd->mapped -= mapping->length;
+
+	// Readers still sending from the mapping keep it alive.
+	jd_backend_mapping_unref(mapping);
+}
+
+/**
+ * Drops the mapping of the object at path, so that later reads map its current contents.
+ **/
+static void
+jd_backend_mapping_invalidate_path(JBackendData* bd, gchar const* path)
+{
+	JBackendMapping* mapping;
+
+	g_mutex_lock(&(bd->map_mutex));
+
+	if ((mapping = g_hash_table_lookup(bd->mappings, path)) != NULL)
+	{
+		jd_backend_mapping_evict(bd, mapping);
+	}
+
+	g_mutex_unlock(&(bd->map_mutex));
+}
+
+/**
+ * Drops an object's mapping, so that later reads map its current contents.
+ **/
+static void
+jd_backend_mapping_invalidate(JBackendData* bd, JBackendObject* bo)
+{
+	if (!bo->map)
+	{
+		return;
+	}
+
+	jd_backend_mapping_invalidate_path(bd, bo->path);
+}
+
+/**
+ * Builds an object's path.
+ * With sharding, objects are spread across subdirectories named after bytes of the hash of their name, for example, namespace/3f/a0/name.
+ *
+ * \return The path. Should be freed with g_free().
+ **/
+static gchar*
+jd_backend_build_path(gchar const* root, guint shard_levels, gchar const* namespace, gchar const* path)
+{
+	gchar shard[3 * J_BACKEND_SHARD_LEVELS_MAX + 1];
+	guint32 hash;
+
+	if (shard_levels == 0)
+	{
+		return g_build_filename(root, namespace, path, NULL);
+	}
+
+	hash = j_helper_hash(path);
+
+	for (guint i = 0; i < shard_levels; i++)
+	{
+		g_snprintf(shard + (3 * i), 4, "%02x/", (hash >> (8 * i)) & 0xff);
+	}
+
+	return g_build_filename(root, namespace, shard, path, NULL);
+}
+
+/**
+ * Removes the shard directories from a path relative to the namespace.
+ *
+ * \return The object's name, NULL if the path does not belong to the layout.
+ **/
+static gchar const*
+jd_backend_strip_shard(gchar const* name, guint shard_levels)
+{
+	for (guint i = 0; i < shard_levels; i++)
+	{
+		if (!g_ascii_isxdigit(name[0]) || !g_ascii_isxdigit(name[1]) || name[2] != '/')
+		{
+			return NULL;
+		}
+
+		name += 3;
+	}
+
+	return name;
+}
+
+/**
+ * Opens a second descriptor for direct I/O if it is enabled for the namespace.
+ *
+ * \return The descriptor, -1 if direct I/O is disabled or not supported by the file system.
+ **/
+static gint
+jd_backend_open_direct(JBackendData* bd, gchar const* namespace, gchar const* path)
+{
+	if (bd->direct_threshold == 0)
+	{
+		return -1;
+	}
+
+	if (bd->direct_namespaces != NULL && !g_strv_contains((gchar const* const*)bd->direct_namespaces, namespace))
+	{
+		return -1;
+	}
+
+	// Some file systems, for example tmpfs, do not support O_DIRECT.
+	return open(path, O_RDWR | O_DIRECT);
+}
+
+/**
+ * Checks whether a request should use direct I/O.
+ **/
+static gboolean
+jd_backend_use_direct(JBackendData* bd, JBackendObject* bo, guint64 length)
+{
+	return (bo->direct_fd != -1 && length >= bd->direct_threshold);
+}
+
+/**
+ * Checks whether a buffer, length and offset satisfy the alignment required for direct I/O.
+ **/
+static gboolean
+jd_backend_is_aligned(gconstpointer buffer, guint64 length, guint64 offset)
+{
+	return (GPOINTER_TO_SIZE(buffer) % J_BACKEND_DIRECT_ALIGNMENT == 0 && length % J_BACKEND_DIRECT_ALIGNMENT == 0 && offset % J_BACKEND_DIRECT_ALIGNMENT == 0);
+}
+
+static gsize
+jd_backend_pread(gint fd, gchar* buffer, guint64 length, guint64 offset)
+{
+	gsize nbytes_total = 0;
+
+	while (nbytes_total < length)
+	{
+		gssize nbytes;
+
+		nbytes = pread(fd, buffer + nbytes_total, length - nbytes_total, offset + nbytes_total);
+
+		if (nbytes == 0)
+		{
+			break;
+		}
+		else if (nbytes < 0)
+		{
+			if (errno != EINTR)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		nbytes_total += nbytes;
+	}
+
+	return nbytes_total;
+}
+
+static gsize
+jd_backend_pwrite(gint fd, gchar const* buffer, guint64 length, guint64 offset)
+{
+	gsize nbytes_total = 0;
+
+	while (nbytes_total < length)
+	{
+		gssize nbytes;
+
+		nbytes = pwrite(fd, buffer + nbytes_total, length - nbytes_total, offset + nbytes_total);
+
+		if (nbytes <= 0)
+		{
+			if (errno != EINTR)
+			{
+				break;
+			}
+
+			continue;
+		}
+
+		nbytes_total += nbytes;
+	}
+
+	return nbytes_total;
+}
+
+/**
+ * Reads or writes the aligned part of a request with direct I/O.
+ * The buffer is bounced through an aligned one if necessary.
+ *
+ * \return The number of bytes read or written.
+ **/
+static gsize
+jd_backend_direct_io(JBackendObject* bo, gboolean write, gchar* buffer, guint64 length, guint64 offset)
+{
+	gchar* bounce;
+	gsize nbytes_total = 0;
+
+	if (GPOINTER_TO_SIZE(buffer) % J_BACKEND_DIRECT_ALIGNMENT == 0)
+	{
+		return (write) ? jd_backend_pwrite(bo->direct_fd, buffer, length, offset) : jd_backend_pread(bo->direct_fd, buffer, length, offset);
+	}
+
+	bounce = j_helper_alloc_aligned(J_BACKEND_DIRECT_ALIGNMENT, MIN(length, J_BACKEND_DIRECT_BOUNCE_SIZE));
+
+	while (nbytes_total < length)
+	{
+		guint64 bounce_length;
+		gsize nbytes;
+
+		bounce_length = MIN(length - nbytes_total, J_BACKEND_DIRECT_BOUNCE_SIZE);
+
+		if (write)
+		{
+			memcpy(bounce, buffer + nbytes_total, bounce_length);
+			nbytes = jd_backend_pwrite(bo->direct_fd, bounce, bounce_length, offset + nbytes_total);
+		}
+		else
+		{
+			nbytes = jd_backend_pread(bo->direct_fd, bounce, bounce_length, offset + nbytes_total);
+			memcpy(buffer + nbytes_total, bounce, nbytes);
+		}
+
+		nbytes_total += nbytes;
+
+		if (nbytes < bounce_length)
+		{
+			break;
+		}
+	}
+
+	free(bounce);
+
+	return nbytes_total;
+}
+
+/**
+ * Reads or writes a request, using direct I/O for its aligned part.
+ * The unaligned head and tail go through the page cache, which avoids read-modify-write cycles for partial blocks.
+ *
+ * \return The number of bytes read or written.
+ **/
+static gsize
+jd_backend_io(JBackendData* bd, JBackendObject* bo, gboolean write, gchar* buffer, guint64 length, guint64 offset)
+{
+	guint64 head;
+	guint64 middle;
+	guint64 tail;
+	gsize nbytes;
+	gsize nbytes_total = 0;
+
+	if (!jd_backend_use_direct(bd, bo, length))
+	{
+		return (write) ? jd_backend_pwrite(bo->fd, buffer, length, offset) : jd_backend_pread(bo->fd, buffer, length, offset);
+	}
+
+	head = MIN(length, (J_BACKEND_DIRECT_ALIGNMENT - (offset % J_BACKEND_DIRECT_ALIGNMENT)) % J_BACKEND_DIRECT_ALIGNMENT);
+	tail = (length - head) % J_BACKEND_DIRECT_ALIGNMENT;
+	middle = length - head - tail;
+
+	if (head > 0)
+	{
+		nbytes = (write) ? jd_backend_pwrite(bo->fd, buffer, head, offset) : jd_backend_pread(bo->fd, buffer, head, offset);
+		nbytes_total += nbytes;
+
+		if (nbytes < head)
+		{
+			return nbytes_total;
+		}
+	}
+
+	if (middle > 0)
+	{
+		nbytes = jd_backend_direct_io(bo, write, buffer + head, middle, offset + head);
+		nbytes_total += nbytes;
+
+		if (nbytes < middle)
+		{
+			return nbytes_total;
+		}
+	}
+
+	if (tail > 0)
+	{
+		nbytes = (write) ? jd_backend_pwrite(bo->fd, buffer + head + middle, tail, offset + head + middle) : jd_backend_pread(bo->fd, buffer + head + middle, tail, offset + head + middle);
+		nbytes_total += nbytes;
+	}
+
+	return nbytes_total;
+}
+
 static gboolean
 backend_create(gpointer backend_data, gchar const* namespace, gchar const* path, gpointer* backend_object)
 {
@@ -159,7 +599,7 @@ backend_create(gpointer backend_data, gchar const* namespace, gchar const* path,
 	gchar* full_path;
 	gint fd;
 
-	full_path = g_build_filename(bd->path, namespace, path, NULL);
+	full_path = jd_backend_build_path(bd->path, bd->shard_levels, namespace, path);
 
 	if ((bo = backend_file_get(files, full_path)) != NULL)
 	{
@@ -189,6 +629,8 @@ backend_create(gpointer backend_data, gchar const* namespace, gchar const* path,
 	bo = g_slice_new(JBackendObject);
 	bo->path = full_path;
 	bo->fd = fd;
+	bo->direct_fd = jd_backend_open_direct(bd, namespace, full_path);
+	bo->map = (bd->map_cache_size > 0 && (bd->map_namespaces == NULL || g_strv_contains((gchar const* const*)bd->map_namespaces, namespace)));
 	bo->ref_count = 1;
 
 	backend_file_add(files, bo);
@@ -209,7 +651,7 @@ backend_open(gpointer backend_data, gchar const* namespace, gchar const* path, g
 	gchar* full_path;
 	gint fd;
 
-	full_path = g_build_filename(bd->path, namespace, path, NULL);
+	full_path = jd_backend_build_path(bd->path, bd->shard_levels, namespace, path);
 
 	if ((bo = backend_file_get(files, full_path)) != NULL)
 	{
@@ -234,6 +676,8 @@ backend_open(gpointer backend_data, gchar const* namespace, gchar const* path, g
 	bo = g_slice_new(JBackendObject);
 	bo->path = full_path;
 	bo->fd = fd;
+	bo->direct_fd = jd_backend_open_direct(bd, namespace, full_path);
+	bo->map = (bd->map_cache_size > 0 && (bd->map_namespaces == NULL || g_strv_contains((gchar const* const*)bd->map_namespaces, namespace)));
 	bo->ref_count = 1;
 
 	backend_file_add(files, bo);
@@ -247,11 +691,12 @@ end:
 static gboolean
 backend_delete(gpointer backend_data, gpointer backend_object)
 {
+	JBackendData* bd = backend_data;
 	JBackendObject* bo = backend_object;
 	GHashTable* files = jd_backend_files_get_thread();
 	gboolean ret;
 
-	(void)backend_data;
+	jd_backend_mapping_invalidate(bd, bo);
 
 	j_trace_file_begin(bo->path, J_TRACE_FILE_DELETE);
 	ret = (g_unlink(bo->path) == 0);
@@ -327,35 +772,13 @@ backend_sync(gpointer backend_data, gpointer backend_object)
 static gboolean
 backend_read(gpointer backend_data, gpointer backend_object, gpointer buffer, guint64 length, guint64 offset, guint64* bytes_read)
 {
+	JBackendData* bd = backend_data;
 	JBackendObject* bo = backend_object;
 
-	gsize nbytes_total = 0;
-
-	(void)backend_data;
+	gsize nbytes_total;
 
 	j_trace_file_begin(bo->path, J_TRACE_FILE_READ);
-
-	while (nbytes_total < length)
-	{
-		gssize nbytes;
-
-		nbytes = pread(bo->fd, (gchar*)buffer + nbytes_total, length - nbytes_total, offset + nbytes_total);
-
-		if (nbytes == 0)
-		{
-			break;
-		}
-		else if (nbytes < 0)
-		{
-			if (errno != EINTR)
-			{
-				break;
-			}
-		}
-
-		nbytes_total += nbytes;
-	}
-
+	nbytes_total = jd_backend_io(bd, bo, FALSE, buffer, length, offset);
 	j_trace_file_end(bo->path, J_TRACE_FILE_READ, nbytes_total, offset);
 
 	if (bytes_read != NULL)
@@ -369,31 +792,16 @@ backend_read(gpointer backend_data, gpointer backend_object, gpointer buffer, gu
 static gboolean
 backend_write(gpointer backend_data, gpointer backend_object, gconstpointer buffer, guint64 length, guint64 offset, guint64* bytes_written)
 {
+	JBackendData* bd = backend_data;
 	JBackendObject* bo = backend_object;
 
-	gsize nbytes_total = 0;
+	gsize nbytes_total;
 
-	(void)backend_data;
+	jd_backend_mapping_invalidate(bd, bo);
 
 	j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
-
-	while (nbytes_total < length)
-	{
-		gssize nbytes;
-
-		nbytes = pwrite(bo->fd, (gchar const*)buffer + nbytes_total, length - nbytes_total, offset + nbytes_total);
-
-		if (nbytes <= 0)
-		{
-			if (errno != EINTR)
-			{
-				break;
-			}
-		}
-
-		nbytes_total += nbytes;
-	}
-
+	// The buffer is only read from.
+	nbytes_total = jd_backend_io(bd, bo, TRUE, (gchar*)buffer, length, offset);
 	j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, nbytes_total, offset);
 
 	if (bytes_written != NULL)
@@ -404,13 +812,908 @@ backend_write(gpointer backend_data, gpointer backend_object, gconstpointer buff
 	return (nbytes_total == length);
 }
 
-static gboolean
-backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
+/**
+ * Reads or writes multiple ranges.
+ * Adjacent ranges are combined into a single preadv() or pwritev() call.
+ *
+ * \return The number of bytes read or written.
+ **/
+static guint64
+jd_backend_iov(JBackendData* bd, JBackendObject* bo, gboolean write, JBackendObjectRequest* requests, guint count)
 {
-	JBackendData* bd = backend_data;
-	JBackendIterator* iterator = NULL;
-	JDirIterator* it;
-	g_autofree gchar* full_path = NULL;
+	guint64 nbytes_total = 0;
+
+	for (guint i = 0; i < count;)
+	{
+		struct iovec iov[J_BACKEND_IOV_MAX];
+		guint64 run_length = requests[i].length;
+		guint64 remaining;
+		gssize nbytes = -1;
+		guint j = i + 1;
+
+		while (j < count && j - i < J_BACKEND_IOV_MAX && requests[j].offset == requests[j - 1].offset + requests[j - 1].length)
+		{
+			run_length += requests[j].length;
+			j++;
+		}
+
+		// Combined ranges do not necessarily satisfy the alignment required for direct I/O.
+		if (j - i > 1 && !jd_backend_use_direct(bd, bo, run_length))
+		{
+			for (guint k = i; k < j; k++)
+			{
+				iov[k - i].iov_base = requests[k].buffer;
+				iov[k - i].iov_len = requests[k].length;
+			}
+
+			do
+			{
+				nbytes = (write) ? pwritev(bo->fd, iov, j - i, requests[i].offset) : preadv(bo->fd, iov, j - i, requests[i].offset);
+			} while (nbytes < 0 && errno == EINTR);
+		}
+
+		remaining = (nbytes > 0) ? (guint64)nbytes : 0;
+
+		for (guint k = i; k < j; k++)
+		{
+			requests[k].bytes = MIN(remaining, requests[k].length);
+			remaining -= requests[k].bytes;
+
+			// Single ranges, failed calls and short writes are handled one range at a time, short reads mean that the end of the object has been reached.
+			if (nbytes < 0 || (write && requests[k].bytes < requests[k].length))
+			{
+				requests[k].bytes += jd_backend_io(bd, bo, write, (gchar*)requests[k].buffer + requests[k].bytes, requests[k].length - requests[k].bytes, requests[k].offset + requests[k].bytes);
+			}
+
+			nbytes_total += requests[k].bytes;
+		}
+
+		i = j;
+	}
+
+	return nbytes_total;
+}
+
+static gboolean
+backend_readv(gpointer backend_data, gpointer backend_object, JBackendObjectRequest* requests, guint count)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+
+	guint64 length = 0;
+	guint64 nbytes_total;
+
+	for (guint i = 0; i < count; i++)
+	{
+		length += requests[i].length;
+	}
+
+	j_trace_file_begin(bo->path, J_TRACE_FILE_READ);
+	nbytes_total = jd_backend_iov(bd, bo, FALSE, requests, count);
+	j_trace_file_end(bo->path, J_TRACE_FILE_READ, nbytes_total, (count > 0) ? requests[0].offset : 0);
+
+	return (nbytes_total == length);
+}
+
+static gboolean
+backend_writev(gpointer backend_data, gpointer backend_object, JBackendObjectRequest* requests, guint count)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+
+	guint64 length = 0;
+	guint64 nbytes_total;
+
+	for (guint i = 0; i < count; i++)
+	{
+		length += requests[i].length;
+	}
+
+	jd_backend_mapping_invalidate(bd, bo);
+
+	j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
+	nbytes_total = jd_backend_iov(bd, bo, TRUE, requests, count);
+	j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, nbytes_total, (count > 0) ? requests[0].offset : 0);
+
+	return (nbytes_total == length);
+}
+
+#ifdef HAVE_LIBURING
+
+/**
+ * A thread's io_uring.
+ * Each thread submits and completes its own requests, so no locking is required.
+ **/
+struct JBackendRing
+{
+	struct io_uring ring;
+
+	/**
+	 * Whether a file slot has been registered.
+	 * The object of the current submission is registered in it, so the kernel does not have to look up its descriptor for every request.
+	 **/
+	gboolean files_registered;
+
+	/**
+	 * The registered buffer, NULL if none has been registered.
+	 **/
+	gchar* buffer;
+	guint64 buffer_length;
+
+	/**
+	 * The backend and object of the current submission.
+	 **/
+	JBackendData* data;
+	JBackendObject* object;
+	JTraceFileOperation operation;
+	guint64 bytes;
+
+	/**
+	 * The number of submitted requests that have not been completed yet.
+	 **/
+	guint pending;
+
+	/**
+	 * Whether a sync has been requested and writes had to be resubmitted after it.
+	 **/
+	gboolean sync;
+	gboolean resync;
+
+	gboolean ret;
+};
+
+typedef struct JBackendRing JBackendRing;
+
+/**
+ * The number of submission queue entries per thread.
+ **/
+#define J_BACKEND_RING_ENTRIES 256
+
+/**
+ * Whether io_uring is supported by the kernel.
+ **/
+static gboolean jd_backend_ring_supported = FALSE;
+
+static void
+jd_backend_ring_free(gpointer data)
+{
+	JBackendRing* ring = data;
+
+	io_uring_queue_exit(&(ring->ring));
+	g_slice_free(JBackendRing, ring);
+}
+
+static GPrivate jd_backend_rings = G_PRIVATE_INIT(jd_backend_ring_free);
+
+static JBackendRing*
+jd_backend_ring_get_thread(void)
+{
+	JBackendRing* ring;
+
+	if (!jd_backend_ring_supported)
+	{
+		return NULL;
+	}
+
+	ring = g_private_get(&jd_backend_rings);
+
+	if (G_UNLIKELY(ring == NULL))
+	{
+		gint fd = -1;
+
+		ring = g_slice_new0(JBackendRing);
+
+		if (io_uring_queue_init(J_BACKEND_RING_ENTRIES, &(ring->ring), 0) < 0)
+		{
+			g_slice_free(JBackendRing, ring);
+			return NULL;
+		}
+
+		ring->files_registered = (io_uring_register_files(&(ring->ring), &fd, 1) == 0);
+		ring->ret = TRUE;
+
+		g_private_replace(&jd_backend_rings, ring);
+	}
+
+	return ring;
+}
+
+static struct io_uring_sqe*
+jd_backend_ring_get_sqe(JBackendRing* ring)
+{
+	struct io_uring_sqe* sqe;
+
+	// The submission queue is full, hand the requests to the kernel to make room.
+	while ((sqe = io_uring_get_sqe(&(ring->ring))) == NULL)
+	{
+		io_uring_submit(&(ring->ring));
+	}
+
+	return sqe;
+}
+
+static void
+jd_backend_ring_set_file(JBackendRing* ring, struct io_uring_sqe* sqe)
+{
+	if (ring->files_registered)
+	{
+		sqe->fd = 0;
+		sqe->flags |= IOSQE_FIXED_FILE;
+	}
+}
+
+/**
+ * Queues the remaining part of a request.
+ **/
+static void
+jd_backend_ring_queue(JBackendRing* ring, JBackendObjectRequest* request)
+{
+	struct io_uring_sqe* sqe;
+	gchar* buffer;
+	guint length;
+	guint64 offset;
+	gint fd;
+	gboolean direct;
+
+	buffer = (gchar*)request->buffer + request->bytes;
+	// Keep the length aligned if it has to be split.
+	length = MIN(request->length - request->bytes, G_MAXINT32 - (J_BACKEND_DIRECT_ALIGNMENT - 1));
+	offset = request->offset + request->bytes;
+
+	// Only completely aligned requests are submitted with direct I/O, see backend_submit().
+	direct = jd_backend_use_direct(ring->data, ring->object, request->length) && jd_backend_is_aligned(buffer, length, offset);
+	fd = (direct) ? ring->object->direct_fd : ring->object->fd;
+
+	sqe = jd_backend_ring_get_sqe(ring);
+
+	if (ring->buffer != NULL && buffer >= ring->buffer && buffer + length <= ring->buffer + ring->buffer_length)
+	{
+		if (request->write)
+		{
+			io_uring_prep_write_fixed(sqe, fd, buffer, length, offset, 0);
+		}
+		else
+		{
+			io_uring_prep_read_fixed(sqe, fd, buffer, length, offset, 0);
+		}
+	}
+	else if (request->write)
+	{
+		io_uring_prep_write(sqe, fd, buffer, length, offset);
+	}
+	else
+	{
+		io_uring_prep_read(sqe, fd, buffer, length, offset);
+	}
+
+	if (!direct)
+	{
+		jd_backend_ring_set_file(ring, sqe);
+	}
+
+	io_uring_sqe_set_data(sqe, request);
+
+	ring->pending++;
+}
+
+static gboolean
+backend_submit(gpointer backend_data, gpointer backend_object, JBackendObjectRequest* requests, guint count, gboolean sync)
+{
+	JBackendObject* bo = backend_object;
+	JBackendRing* ring;
+
+	ring = jd_backend_ring_get_thread();
+
+	// Fall back to synchronous vectored I/O if io_uring is not available.
+	if (ring == NULL)
+	{
+		gboolean ret = TRUE;
+
+		for (guint i = 0; i < count;)
+		{
+			guint j = i + 1;
+
+			while (j < count && requests[j].write == requests[i].write)
+			{
+				j++;
+			}
+
+			if (requests[i].write)
+			{
+				ret = backend_writev(backend_data, bo, &(requests[i]), j - i) && ret;
+			}
+			else
+			{
+				ret = backend_readv(backend_data, bo, &(requests[i]), j - i) && ret;
+			}
+
+			i = j;
+		}
+
+		if (sync)
+		{
+			ret = backend_sync(backend_data, bo) && ret;
+		}
+
+		return ret;
+	}
+
+	g_return_val_if_fail(ring->pending == 0, FALSE);
+
+	ring->data = backend_data;
+	ring->object = bo;
+	ring->sync = sync;
+	ring->resync = FALSE;
+	ring->ret = TRUE;
+	ring->operation = (count > 0 && requests[0].write) ? J_TRACE_FILE_WRITE : J_TRACE_FILE_READ;
+	ring->bytes = 0;
+
+	if (ring->operation == J_TRACE_FILE_WRITE)
+	{
+		jd_backend_mapping_invalidate(backend_data, bo);
+	}
+
+	if (ring->files_registered && io_uring_register_files_update(&(ring->ring), 0, &(bo->fd), 1) != 1)
+	{
+		ring->files_registered = FALSE;
+	}
+
+	j_trace_file_begin(bo->path, ring->operation);
+
+	for (guint i = 0; i < count; i++)
+	{
+		requests[i].bytes = 0;
+
+		if (requests[i].length == 0)
+		{
+			continue;
+		}
+
+		// Unaligned direct I/O requests have to be split, which is done synchronously.
+		if (jd_backend_use_direct(backend_data, bo, requests[i].length) && !jd_backend_is_aligned(requests[i].buffer, requests[i].length, requests[i].offset))
+		{
+			requests[i].bytes = jd_backend_io(backend_data, bo, requests[i].write, requests[i].buffer, requests[i].length, requests[i].offset);
+			ring->bytes += requests[i].bytes;
+			ring->ret = (requests[i].bytes == requests[i].length) && ring->ret;
+
+			continue;
+		}
+
+		jd_backend_ring_queue(ring, &(requests[i]));
+	}
+
+	if (sync)
+	{
+		struct io_uring_sqe* sqe;
+
+		// The sync is drained, that is, it only starts once all previous requests have finished.
+		sqe = jd_backend_ring_get_sqe(ring);
+		io_uring_prep_fsync(sqe, bo->fd, 0);
+		jd_backend_ring_set_file(ring, sqe);
+		sqe->flags |= IOSQE_IO_DRAIN;
+		io_uring_sqe_set_data(sqe, NULL);
+
+		ring->pending++;
+	}
+
+	io_uring_submit(&(ring->ring));
+
+	return TRUE;
+}
+
+static gboolean
+backend_complete(gpointer backend_data, gpointer backend_object)
+{
+	JBackendObject* bo = backend_object;
+	JBackendRing* ring;
+	gboolean ret;
+
+	ring = jd_backend_ring_get_thread();
+
+	// Requests have been executed synchronously.
+	if (ring == NULL)
+	{
+		return TRUE;
+	}
+
+	while (ring->pending > 0)
+	{
+		struct io_uring_cqe* cqe;
+		gint err;
+
+		err = io_uring_submit_and_wait(&(ring->ring), 1);
+
+		if (err < 0 && err != -EINTR && err != -EAGAIN && err != -EBUSY)
+		{
+			/// \todo the kernel might still access the buffers
+			g_warning("Waiting for io_uring requests failed: %s", g_strerror(-err));
+			ring->pending = 0;
+			ring->ret = FALSE;
+			break;
+		}
+
+		while (io_uring_peek_cqe(&(ring->ring), &cqe) == 0)
+		{
+			JBackendObjectRequest* request;
+			gint res;
+
+			request = io_uring_cqe_get_data(cqe);
+			res = cqe->res;
+
+			io_uring_cqe_seen(&(ring->ring), cqe);
+			ring->pending--;
+
+			// The sync does not have a request.
+			if (request == NULL)
+			{
+				ring->ret = (res == 0) && ring->ret;
+				continue;
+			}
+
+			if (res == -EINTR || res == -EAGAIN)
+			{
+				jd_backend_ring_queue(ring, request);
+			}
+			else if (res < 0)
+			{
+				ring->ret = FALSE;
+			}
+			else
+			{
+				request->bytes += res;
+				ring->bytes += res;
+
+				// Short reads and writes are continued, except at the end of the file.
+				if (request->bytes < request->length)
+				{
+					if (res > 0)
+					{
+						ring->resync = ring->sync && request->write;
+						jd_backend_ring_queue(ring, request);
+					}
+					else
+					{
+						ring->ret = FALSE;
+					}
+				}
+			}
+		}
+	}
+
+	j_trace_file_end(bo->path, ring->operation, ring->bytes, 0);
+
+	// The sync might have overtaken continued writes.
+	if (ring->resync)
+	{
+		ring->ret = backend_sync(backend_data, bo) && ring->ret;
+	}
+
+	ret = ring->ret;
+	ring->data = NULL;
+	ring->object = NULL;
+
+	return ret;
+}
+
+static gboolean
+backend_register_buffer(gpointer backend_data, gpointer buffer, guint64 length)
+{
+	JBackendRing* ring;
+	struct iovec iov;
+
+	(void)backend_data;
+
+	ring = jd_backend_ring_get_thread();
+
+	if (ring == NULL)
+	{
+		return FALSE;
+	}
+
+	if (ring->buffer != NULL)
+	{
+		io_uring_unregister_buffers(&(ring->ring));
+		ring->buffer = NULL;
+		ring->buffer_length = 0;
+	}
+
+	if (buffer == NULL)
+	{
+		return TRUE;
+	}
+
+	iov.iov_base = buffer;
+	iov.iov_len = length;
+
+	// Registering might fail because of the locked memory limit, requests then use regular buffers.
+	if (io_uring_register_buffers(&(ring->ring), &iov, 1) != 0)
+	{
+		return FALSE;
+	}
+
+	ring->buffer = buffer;
+	ring->buffer_length = length;
+
+	return TRUE;
+}
+
+#endif
+
+static gboolean
+backend_map(gpointer backend_data, gpointer backend_object, guint64 length, guint64 offset, gconstpointer* data, guint64* bytes, gpointer* backend_mapping)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	JBackendMapping* mapping;
+
+	if (!bo->map)
+	{
+		return FALSE;
+	}
+
+	g_mutex_lock(&(bd->map_mutex));
+
+	if ((mapping = g_hash_table_lookup(bd->mappings, bo->path)) == NULL)
+	{
+		struct stat buf;
+		gchar* addr;
+
+		// Empty objects can not be mapped and large ones would evict everything else.
+		if (fstat(bo->fd, &buf) != 0 || buf.st_size == 0 || (guint64)buf.st_size > bd->map_cache_size)
+		{
+			g_mutex_unlock(&(bd->map_mutex));
+			return FALSE;
+		}
+
+		j_trace_file_begin(bo->path, J_TRACE_FILE_OPEN);
+		addr = mmap(NULL, buf.st_size, PROT_READ, MAP_SHARED, bo->fd, 0);
+		j_trace_file_end(bo->path, J_TRACE_FILE_OPEN, 0, 0);
+
+		if (addr == MAP_FAILED)
+		{
+			g_mutex_unlock(&(bd->map_mutex));
+			return FALSE;
+		}
+
+		mapping = g_slice_new(JBackendMapping);
+		mapping->path = g_strdup(bo->path);
+		mapping->data = addr;
+		mapping->length = buf.st_size;
+		mapping->link.data = mapping;
+		mapping->link.prev = NULL;
+		mapping->link.next = NULL;
+		mapping->ref_count = 1;
+
+		while (bd->mapped + mapping->length > bd->map_cache_size && !g_queue_is_empty(&(bd->map_lru)))
+		{
+			jd_backend_mapping_evict(bd, g_queue_peek_tail(&(bd->map_lru)));
+		}
+
+		g_hash_table_insert(bd->mappings, mapping->path, mapping);
+		g_queue_push_head_link(&(bd->map_lru), &(mapping->link));
+		bd->mapped += mapping->length;
+	}
+	else
+	{
+		g_queue_unlink(&(bd->map_lru), &(mapping->link));
+		g_queue_push_head_link(&(bd->map_lru), &(mapping->link));
+	}
+
+	g_atomic_int_inc(&(mapping->ref_count));
+
+	g_mutex_unlock(&(bd->map_mutex));
+
+	*data = mapping->data + MIN(offset, mapping->length);
+	*bytes = (offset < mapping->length) ? MIN(length, mapping->length - offset) : 0;
+	*backend_mapping = mapping;
+
+	j_trace_file_begin(bo->path, J_TRACE_FILE_READ);
+	j_trace_file_end(bo->path, J_TRACE_FILE_READ, *bytes, offset);
+
+	return TRUE;
+}
+
+static void
+backend_unmap(gpointer backend_data, gpointer backend_mapping)
+{
+	JBackendMapping* mapping = backend_mapping;
+
+	(void)backend_data;
+
+	jd_backend_mapping_unref(mapping);
+}
+
+static gboolean
+backend_batch_start(gpointer backend_data, gchar const* namespace, gboolean sync, gpointer* backend_batch)
+{
+	JBackendBatch* batch;
+
+	(void)backend_data;
+
+	batch = g_slice_new(JBackendBatch);
+	batch->namespace = g_strdup(namespace);
+	batch->sync = sync;
+	batch->directories = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+
+	*backend_batch = batch;
+
+	return TRUE;
+}
+
+static gboolean
+backend_batch_create(gpointer backend_data, gpointer backend_batch, gchar const* path)
+{
+	JBackendData* bd = backend_data;
+	JBackendBatch* batch = backend_batch;
+
+	g_autofree gchar* full_path = NULL;
+	gchar* parent;
+	gboolean ret = TRUE;
+	gint fd;
+
+	full_path = jd_backend_build_path(bd->path, bd->shard_levels, batch->namespace, path);
+	parent = g_path_get_dirname(full_path);
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_CREATE);
+
+	if (!g_hash_table_contains(batch->directories, parent))
+	{
+		g_mkdir_with_parents(parent, 0700);
+		g_hash_table_add(batch->directories, parent);
+	}
+	else
+	{
+		g_free(parent);
+	}
+
+	// The object does not have to be opened, so it is not added to the file cache.
+	fd = open(full_path, O_WRONLY | O_CREAT, 0600);
+
+	j_trace_file_end(full_path, J_TRACE_FILE_CREATE, 0, 0);
+
+	if (fd == -1)
+	{
+		return FALSE;
+	}
+
+#ifndef HAVE_SYNCFS
+	if (batch->sync)
+	{
+		j_trace_file_begin(full_path, J_TRACE_FILE_SYNC);
+		ret = (fsync(fd) == 0);
+		j_trace_file_end(full_path, J_TRACE_FILE_SYNC, 0, 0);
+	}
+#endif
+
+	close(fd);
+
+	return ret;
+}
+
+static gboolean
+backend_batch_delete(gpointer backend_data, gpointer backend_batch, gchar const* path)
+{
+	JBackendData* bd = backend_data;
+	JBackendBatch* batch = backend_batch;
+	GHashTable* files = jd_backend_files_get_thread();
+
+	g_autofree gchar* full_path = NULL;
+	gboolean ret;
+
+	full_path = jd_backend_build_path(bd->path, bd->shard_levels, batch->namespace, path);
+
+	if (bd->map_cache_size > 0)
+	{
+		jd_backend_mapping_invalidate_path(bd, full_path);
+	}
+
+	j_trace_file_begin(full_path, J_TRACE_FILE_DELETE);
+	ret = (g_unlink(full_path) == 0);
+	j_trace_file_end(full_path, J_TRACE_FILE_DELETE, 0, 0);
+
+	g_hash_table_remove(files, full_path);
+
+	return ret;
+}
+
+static gboolean
+backend_batch_execute(gpointer backend_data, gpointer backend_batch)
+{
+	JBackendData* bd = backend_data;
+	JBackendBatch* batch = backend_batch;
+	gboolean ret = TRUE;
+
+#ifdef HAVE_SYNCFS
+	// Syncing the file system once is much cheaper than syncing each new object.
+	if (batch->sync)
+	{
+		gint fd;
+
+		j_trace_file_begin(bd->path, J_TRACE_FILE_SYNC);
+
+		if ((fd = open(bd->path, O_RDONLY | O_DIRECTORY)) != -1)
+		{
+			ret = (syncfs(fd) == 0);
+			close(fd);
+		}
+		else
+		{
+			ret = FALSE;
+		}
+
+		j_trace_file_end(bd->path, J_TRACE_FILE_SYNC, 0, 0);
+	}
+#else
+	(void)bd;
+#endif
+
+	g_hash_table_destroy(batch->directories);
+	g_free(batch->namespace);
+	g_slice_free(JBackendBatch, batch);
+
+	return ret;
+}
+
+static gboolean
+backend_preallocate(gpointer backend_data, gpointer backend_object, guint64 length, guint64 offset)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	gboolean ret;
+
+	// Existing mappings do not reflect the object's new size.
+	jd_backend_mapping_invalidate(bd, bo);
+
+	j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
+	ret = (posix_fallocate(bo->fd, offset, length) == 0);
+	j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, 0, offset);
+
+	return ret;
+}
+
+static gboolean
+backend_truncate(gpointer backend_data, gpointer backend_object, guint64 size)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* bo = backend_object;
+	JBackendMapping* mapping = NULL;
+	gboolean ret;
+
+	if (bo->map)
+	{
+		// The mutex prevents the object from being mapped again while it is truncated.
+		g_mutex_lock(&(bd->map_mutex));
+
+		if ((mapping = g_hash_table_lookup(bd->mappings, bo->path)) != NULL)
+		{
+			// Replies still being sent from the mapping would fault on pages beyond the new end of the object.
+			if (size < mapping->length && g_atomic_int_get(&(mapping->ref_count)) > 1)
+			{
+				g_mutex_unlock(&(bd->map_mutex));
+				return FALSE;
+			}
+
+			jd_backend_mapping_evict(bd, mapping);
+		}
+	}
+
+	j_trace_file_begin(bo->path, J_TRACE_FILE_WRITE);
+	ret = (ftruncate(bo->fd, size) == 0);
+	j_trace_file_end(bo->path, J_TRACE_FILE_WRITE, 0, size);
+
+	if (bo->map)
+	{
+		g_mutex_unlock(&(bd->map_mutex));
+	}
+
+	return ret;
+}
+
+static gboolean
+backend_copy(gpointer backend_data, gpointer backend_src, gpointer backend_dst, guint64* bytes_copied)
+{
+	JBackendData* bd = backend_data;
+	JBackendObject* src = backend_src;
+	JBackendObject* dst = backend_dst;
+
+	gboolean ret;
+	guint64 nbytes_total = 0;
+	guint64 size;
+	struct stat buf;
+
+	j_trace_file_begin(src->path, J_TRACE_FILE_STATUS);
+	ret = (fstat(src->fd, &buf) == 0);
+	j_trace_file_end(src->path, J_TRACE_FILE_STATUS, 0, 0);
+
+	if (!ret)
+	{
+		return FALSE;
+	}
+
+	size = buf.st_size;
+
+	jd_backend_mapping_invalidate(bd, dst);
+
+	j_trace_file_begin(dst->path, J_TRACE_FILE_WRITE);
+
+#ifdef HAVE_COPY_FILE_RANGE
+	// Let the kernel copy the data, file systems supporting reflinks will share extents instead of copying them.
+	while (nbytes_total < size)
+	{
+		loff_t offset_in = nbytes_total;
+		loff_t offset_out = nbytes_total;
+		gssize nbytes;
+
+		nbytes = copy_file_range(src->fd, &offset_in, dst->fd, &offset_out, size - nbytes_total, 0);
+
+		if (nbytes == 0)
+		{
+			break;
+		}
+		else if (nbytes < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+
+			break;
+		}
+
+		nbytes_total += nbytes;
+	}
+#endif
+
+	// Fall back to reading and writing if copy_file_range() is not available or not supported by the file system
+	if (nbytes_total < size)
+	{
+		guint64 const buffer_size = 4 * 1024 * 1024;
+		g_autofree gchar* buffer = NULL;
+
+		buffer = g_malloc(MIN(size - nbytes_total, buffer_size));
+
+		while (nbytes_total < size)
+		{
+			guint64 nbytes_read = 0;
+			guint64 nbytes_written = 0;
+
+			backend_read(backend_data, src, buffer, MIN(size - nbytes_total, buffer_size), nbytes_total, &nbytes_read);
+
+			if (nbytes_read == 0)
+			{
+				break;
+			}
+
+			backend_write(backend_data, dst, buffer, nbytes_read, nbytes_total, &nbytes_written);
+			nbytes_total += nbytes_written;
+
+			if (nbytes_written != nbytes_read)
+			{
+				break;
+			}
+		}
+	}
+
+	j_trace_file_end(dst->path, J_TRACE_FILE_WRITE, nbytes_total, 0);
+
+	*bytes_copied = nbytes_total;
+
+	if (nbytes_total != size)
+	{
+		return FALSE;
+	}
+
+	// The destination might have existed before and been larger than the source.
+	return backend_truncate(backend_data, dst, size);
+}
+
+static gboolean
+backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend_iterator)
+{
+	JBackendData* bd = backend_data;
+	JBackendIterator* iterator = NULL;
+	JDirIterator* it;
+	g_autofree gchar* full_path = NULL;
 
 	g_return_val_if_fail(namespace != NULL, FALSE);
 	g_return_val_if_fail(backend_iterator != NULL, FALSE);
@@ -423,6 +1726,7 @@ backend_get_all(gpointer backend_data, gchar const* namespace, gpointer* backend
 		iterator = g_slice_new(JBackendIterator);
 		iterator->iterator = it;
 		iterator->prefix = NULL;
+		iterator->shard_levels = bd->shard_levels;
 
 		*backend_iterator = iterator;
 	}
@@ -450,6 +1754,7 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 		iterator = g_slice_new(JBackendIterator);
 		iterator->iterator = it;
 		iterator->prefix = g_strdup(prefix);
+		iterator->shard_levels = bd->shard_levels;
 
 		*backend_iterator = iterator;
 	}
@@ -457,8 +1762,20 @@ backend_get_by_prefix(gpointer backend_data, gchar const* namespace, gchar const
 	return (iterator != NULL);
 }
 
+static void
+backend_iterate_free(gpointer backend_data, gpointer backend_iterator)
+{
+	JBackendIterator* iterator = backend_iterator;
+
+	(void)backend_data;
+
+	g_free(iterator->prefix);
+	j_dir_iterator_free(iterator->iterator);
+	g_slice_free(JBackendIterator, iterator);
+}
+
 static gboolean
-backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** name)
+backend_iterate_status(gpointer backend_data, gpointer backend_iterator, gchar const** name, gint64* modification_time, guint64* size)
 {
 	JBackendIterator* iterator = backend_iterator;
 
@@ -471,36 +1788,447 @@ backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const**
 	{
 		gchar const* name_;
 
-		name_ = j_dir_iterator_get(iterator->iterator);
+		name_ = jd_backend_strip_shard(j_dir_iterator_get(iterator->iterator), iterator->shard_levels);
+
+		if (name_ == NULL)
+		{
+			continue;
+		}
 
 		if (iterator->prefix != NULL && !g_str_has_prefix(name_, iterator->prefix))
 		{
 			continue;
 		}
 
+		// Objects deleted in the meantime are skipped.
+		if ((modification_time != NULL || size != NULL) && !j_dir_iterator_get_status(iterator->iterator, modification_time, size))
+		{
+			continue;
+		}
+
 		*name = name_;
 
 		return TRUE;
 	}
 
-	g_free(iterator->prefix);
-	j_dir_iterator_free(iterator->iterator);
-	g_slice_free(JBackendIterator, iterator);
+	backend_iterate_free(backend_data, backend_iterator);
 
 	return FALSE;
 }
 
+static gboolean
+backend_iterate(gpointer backend_data, gpointer backend_iterator, gchar const** name)
+{
+	return backend_iterate_status(backend_data, backend_iterator, name, NULL, NULL);
+}
+
+struct JBackendPrefix
+{
+	/**
+	 * The namespace's directory, including a trailing separator.
+	 **/
+	gchar const* namespace_path;
+	gchar const* prefix;
+	guint shard_levels;
+};
+
+typedef struct JBackendPrefix JBackendPrefix;
+
+static gboolean
+backend_file_matches_prefix(gpointer key, gpointer value, gpointer data)
+{
+	gchar const* path = key;
+	JBackendPrefix const* prefix = data;
+
+	(void)value;
+
+	if (!g_str_has_prefix(path, prefix->namespace_path))
+	{
+		return FALSE;
+	}
+
+	path = jd_backend_strip_shard(path + strlen(prefix->namespace_path), prefix->shard_levels);
+
+	return (path != NULL && g_str_has_prefix(path, prefix->prefix));
+}
+
+static gint
+backend_remove_entry(gchar const* path, struct stat const* buf, gint type, struct FTW* ftw)
+{
+	(void)buf;
+	(void)type;
+	(void)ftw;
+
+	return g_remove(path);
+}
+
+static gboolean
+backend_delete_by_prefix(gpointer backend_data, gchar const* namespace, gchar const* prefix)
+{
+	JBackendData* bd = backend_data;
+	GHashTable* files = jd_backend_files_get_thread();
+	gboolean ret = TRUE;
+	JBackendPrefix matches;
+	g_autofree gchar* full_path = NULL;
+	g_autofree gchar* namespace_path = NULL;
+	g_autofree gchar* full_prefix = NULL;
+
+	g_return_val_if_fail(namespace != NULL, FALSE);
+
+	full_path = g_build_filename(bd->path, namespace, NULL);
+
+	if (!g_file_test(full_path, G_FILE_TEST_IS_DIR))
+	{
+		return TRUE;
+	}
+
+	namespace_path = g_strconcat(full_path, G_DIR_SEPARATOR_S, NULL);
+	full_prefix = g_build_filename(full_path, (prefix != NULL) ? prefix : "", NULL);
+
+	matches.namespace_path = namespace_path;
+	matches.prefix = (prefix != NULL) ? prefix : "";
+	matches.shard_levels = bd->shard_levels;
+	g_hash_table_foreach_remove(files, backend_file_matches_prefix, &matches);
+
+	// Other threads might still use the deleted objects, but they must not be handed out again.
+	G_LOCK(jd_backend_file_cache);
+	g_hash_table_foreach_remove(jd_backend_file_cache, backend_file_matches_prefix, &matches);
+	G_UNLOCK(jd_backend_file_cache);
+
+	if (bd->map_cache_size > 0)
+	{
+		GList* link;
+
+		g_mutex_lock(&(bd->map_mutex));
+
+		link = bd->map_lru.head;
+
+		while (link != NULL)
+		{
+			JBackendMapping* mapping = link->data;
+
+			link = link->next;
+
+			if (backend_file_matches_prefix(mapping->path, mapping, &matches))
+			{
+				jd_backend_mapping_evict(bd, mapping);
+			}
+		}
+
+		g_mutex_unlock(&(bd->map_mutex));
+	}
+
+	j_trace_file_begin(full_prefix, J_TRACE_FILE_DELETE);
+
+	if (prefix == NULL)
+	{
+		// The whole namespace is a single directory, remove it bottom-up.
+		ret = (nftw(full_path, backend_remove_entry, 64, FTW_DEPTH | FTW_PHYS) == 0);
+	}
+	else
+	{
+		g_autoptr(GPtrArray) paths = NULL;
+		JDirIterator* it;
+
+		paths = g_ptr_array_new_with_free_func(g_free);
+		it = j_dir_iterator_new(full_path);
+
+		if (it != NULL)
+		{
+			while (j_dir_iterator_next(it))
+			{
+				gchar const* name;
+				gchar const* object_name;
+
+				name = j_dir_iterator_get(it);
+				object_name = jd_backend_strip_shard(name, bd->shard_levels);
+
+				if (object_name != NULL && g_str_has_prefix(object_name, prefix))
+				{
+					g_ptr_array_add(paths, g_build_filename(full_path, name, NULL));
+				}
+			}
+
+			j_dir_iterator_free(it);
+		}
+
+		for (guint i = 0; i < paths->len; i++)
+		{
+			ret = (g_unlink(g_ptr_array_index(paths, i)) == 0) && ret;
+		}
+	}
+
+	j_trace_file_end(full_prefix, J_TRACE_FILE_DELETE, 0, 0);
+
+	return ret;
+}
+
+static guint
+jd_backend_read_layout(gchar const* root)
+{
+	g_autofree gchar* path = NULL;
+	g_autofree gchar* contents = NULL;
+
+	path = g_build_filename(root, J_BACKEND_LAYOUT_FILE, NULL);
+
+	// Storage directories without a layout file use the flat layout.
+	if (!g_file_get_contents(path, &contents, NULL, NULL))
+	{
+		return 0;
+	}
+
+	return g_ascii_strtoull(contents, NULL, 10);
+}
+
+static gboolean
+jd_backend_write_layout(gchar const* root, guint shard_levels)
+{
+	g_autofree gchar* path = NULL;
+	g_autofree gchar* contents = NULL;
+
+	path = g_build_filename(root, J_BACKEND_LAYOUT_FILE, NULL);
+	contents = g_strdup_printf("%u\n", shard_levels);
+
+	return g_file_set_contents(path, contents, -1, NULL);
+}
+
+/**
+ * Moves all objects of a namespace from \p old_path to their location in the new layout.
+ * \p old_path is removed if all objects could be moved.
+ **/
+static gboolean
+jd_backend_migrate_namespace(JBackendData* bd, gchar const* namespace, gchar const* old_path, guint old_shard_levels)
+{
+	JDirIterator* it;
+	gboolean ret = TRUE;
+
+	it = j_dir_iterator_new(old_path);
+
+	if (it == NULL)
+	{
+		return FALSE;
+	}
+
+	while (j_dir_iterator_next(it))
+	{
+		gchar const* name;
+		gchar const* object_name;
+		g_autofree gchar* src = NULL;
+		g_autofree gchar* dst = NULL;
+		g_autofree gchar* parent = NULL;
+
+		name = j_dir_iterator_get(it);
+		object_name = jd_backend_strip_shard(name, old_shard_levels);
+
+		if (object_name == NULL)
+		{
+			g_warning("Can not migrate %s in namespace %s, it does not belong to the old layout.", name, namespace);
+			ret = FALSE;
+			continue;
+		}
+
+		src = g_build_filename(old_path, name, NULL);
+		dst = jd_backend_build_path(bd->path, bd->shard_levels, namespace, object_name);
+
+		parent = g_path_get_dirname(dst);
+		g_mkdir_with_parents(parent, 0700);
+
+		if (g_rename(src, dst) != 0)
+		{
+			g_warning("Can not migrate %s to %s: %s", src, dst, g_strerror(errno));
+			ret = FALSE;
+		}
+	}
+
+	j_dir_iterator_free(it);
+
+	// Only empty directories are left.
+	if (ret)
+	{
+		ret = (nftw(old_path, backend_remove_entry, 64, FTW_DEPTH | FTW_PHYS) == 0);
+	}
+
+	return ret;
+}
+
+/**
+ * Migrates all namespaces to the configured layout.
+ * Each namespace directory is first renamed, so an interrupted migration can be resumed when the backend is initialized again.
+ **/
+static gboolean
+jd_backend_migrate(JBackendData* bd, guint old_shard_levels)
+{
+	g_autoptr(GPtrArray) names = NULL;
+	GDir* dir;
+	gchar const* name;
+	gboolean ret = TRUE;
+
+	names = g_ptr_array_new_with_free_func(g_free);
+
+	if ((dir = g_dir_open(bd->path, 0, NULL)) == NULL)
+	{
+		return FALSE;
+	}
+
+	// Collect the names first, the directory is modified below.
+	while ((name = g_dir_read_name(dir)) != NULL)
+	{
+		g_ptr_array_add(names, g_strdup(name));
+	}
+
+	g_dir_close(dir);
+
+	g_message("Migrating %s from %u to %u shard levels.", bd->path, old_shard_levels, bd->shard_levels);
+
+	for (guint i = 0; i < names->len; i++)
+	{
+		g_autofree gchar* namespace = NULL;
+		g_autofree gchar* namespace_path = NULL;
+		g_autofree gchar* old_path = NULL;
+
+		name = g_ptr_array_index(names, i);
+
+		if (name[0] == '.' && g_str_has_suffix(name, J_BACKEND_MIGRATE_SUFFIX))
+		{
+			// Resume an interrupted migration, the namespace directory already uses the new layout.
+			namespace = g_strndup(name + 1, strlen(name) - 1 - strlen(J_BACKEND_MIGRATE_SUFFIX));
+			old_path = g_build_filename(bd->path, name, NULL);
+		}
+		else if (name[0] != '.')
+		{
+			g_autofree gchar* migrate_name = NULL;
+
+			namespace = g_strdup(name);
+			namespace_path = g_build_filename(bd->path, name, NULL);
+			migrate_name = g_strconcat(".", name, J_BACKEND_MIGRATE_SUFFIX, NULL);
+			old_path = g_build_filename(bd->path, migrate_name, NULL);
+
+			if (!g_file_test(namespace_path, G_FILE_TEST_IS_DIR) || g_file_test(old_path, G_FILE_TEST_EXISTS))
+			{
+				continue;
+			}
+
+			if (g_rename(namespace_path, old_path) != 0)
+			{
+				ret = FALSE;
+				continue;
+			}
+		}
+		else
+		{
+			continue;
+		}
+
+		ret = jd_backend_migrate_namespace(bd, namespace, old_path, old_shard_levels) && ret;
+	}
+
+	if (ret)
+	{
+		ret = jd_backend_write_layout(bd->path, bd->shard_levels);
+	}
+
+	return ret;
+}
+
 static gboolean
 backend_init(gchar const* path, gpointer* backend_data)
 {
 	JBackendData* bd;
+	guint old_shard_levels;
+
+	g_auto(GStrv) split = NULL;
+
+	g_return_val_if_fail(path != NULL, FALSE);
+
+	// The path can be followed by options, for example, /var/storage/posix:direct=1048576:direct-namespaces=checkpoints
+	split = g_strsplit(path, ":", 0);
 
 	bd = g_slice_new(JBackendData);
-	bd->path = g_strdup(path);
+	bd->path = g_strdup(split[0]);
+	bd->direct_threshold = 0;
+	bd->direct_namespaces = NULL;
+	bd->shard_levels = 0;
+	bd->map_cache_size = 0;
+	bd->map_namespaces = NULL;
+
+	for (guint i = 1; split[i] != NULL; i++)
+	{
+		gchar const* value;
+
+		value = strchr(split[i], '=');
+
+		if (value == NULL)
+		{
+			g_warning("Ignoring invalid option %s.", split[i]);
+			continue;
+		}
+
+		value++;
+
+		if (g_str_has_prefix(split[i], "direct="))
+		{
+			bd->direct_threshold = g_ascii_strtoull(value, NULL, 10);
+		}
+		else if (g_str_has_prefix(split[i], "direct-namespaces="))
+		{
+			g_strfreev(bd->direct_namespaces);
+			bd->direct_namespaces = g_strsplit(value, ",", 0);
+		}
+		else if (g_str_has_prefix(split[i], "map="))
+		{
+			bd->map_cache_size = g_ascii_strtoull(value, NULL, 10);
+		}
+		else if (g_str_has_prefix(split[i], "map-namespaces="))
+		{
+			g_strfreev(bd->map_namespaces);
+			bd->map_namespaces = g_strsplit(value, ",", 0);
+		}
+		else if (g_str_has_prefix(split[i], "shard="))
+		{
+			bd->shard_levels = MIN(g_ascii_strtoull(value, NULL, 10), J_BACKEND_SHARD_LEVELS_MAX);
+		}
+		else
+		{
+			g_warning("Ignoring unknown option %s.", split[i]);
+		}
+	}
+
+	g_mkdir_with_parents(bd->path, 0700);
+
+	if ((old_shard_levels = jd_backend_read_layout(bd->path)) != bd->shard_levels)
+	{
+		if (!jd_backend_migrate(bd, old_shard_levels))
+		{
+			g_critical("Migrating %s to %u shard levels failed, restart to resume the migration.", bd->path, bd->shard_levels);
+
+			g_strfreev(bd->map_namespaces);
+			g_strfreev(bd->direct_namespaces);
+			g_free(bd->path);
+			g_slice_free(JBackendData, bd);
+
+			return FALSE;
+		}
+	}
 
 	jd_backend_file_cache = g_hash_table_new_full(g_str_hash, g_str_equal, NULL, NULL);
 
-	g_mkdir_with_parents(path, 0700);
+	g_mutex_init(&(bd->map_mutex));
+	bd->mappings = g_hash_table_new(g_str_hash, g_str_equal);
+	g_queue_init(&(bd->map_lru));
+	bd->mapped = 0;
+
+#ifdef HAVE_LIBURING
+	{
+		struct io_uring ring;
+
+		// Check whether io_uring is available, it might be disabled or restricted.
+		if (io_uring_queue_init(1, &ring, 0) == 0)
+		{
+			io_uring_queue_exit(&ring);
+			jd_backend_ring_supported = TRUE;
+		}
+	}
+#endif
 
 	g_atomic_int_inc(&jd_num_backends);
 
@@ -520,6 +2248,16 @@ backend_fini(gpointer backend_data)
 		g_hash_table_destroy(jd_backend_file_cache);
 	}
 
+	while (!g_queue_is_empty(&(bd->map_lru)))
+	{
+		jd_backend_mapping_evict(bd, g_queue_peek_tail(&(bd->map_lru)));
+	}
+
+	g_hash_table_destroy(bd->mappings);
+	g_mutex_clear(&(bd->map_mutex));
+
+	g_strfreev(bd->map_namespaces);
+	g_strfreev(bd->direct_namespaces);
 	g_free(bd->path);
 	g_slice_free(JBackendData, bd);
 }
@@ -540,7 +2278,27 @@ static JBackend posix_backend = {
 		.backend_write = backend_write,
 		.backend_get_all = backend_get_all,
 		.backend_get_by_prefix = backend_get_by_prefix,
-		.backend_iterate = backend_iterate }
+		.backend_iterate = backend_iterate,
+		.backend_copy = backend_copy,
+		.backend_delete_by_prefix = backend_delete_by_prefix,
+		.backend_map = backend_map,
+		.backend_unmap = backend_unmap,
+		.backend_readv = backend_readv,
+		.backend_writev = backend_writev,
+		.backend_batch_start = backend_batch_start,
+		.backend_batch_create = backend_batch_create,
+		.backend_batch_delete = backend_batch_delete,
+		.backend_batch_execute = backend_batch_execute,
+		.backend_preallocate = backend_preallocate,
+		.backend_truncate = backend_truncate,
+		.backend_iterate_status = backend_iterate_status,
+		.backend_iterate_free = backend_iterate_free,
+#ifdef HAVE_LIBURING
+		.backend_submit = backend_submit,
+		.backend_complete = backend_complete,
+		.backend_register_buffer = backend_register_buffer,
+#endif
+	}
 };
 
 G_MODULE_EXPORT
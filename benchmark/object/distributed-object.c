@@ -235,7 +235,7 @@ benchmark_distributed_object_status_batch(BenchmarkRun* run)
 }
 
 static void
-_benchmark_distributed_object_read(BenchmarkRun* run, gboolean use_batch, guint block_size)
+_benchmark_distributed_object_read(BenchmarkRun* run, gboolean use_batch, guint block_size, JDistributionType type)
 {
 	guint const n = (use_batch) ? 10000 : 1000;
 
@@ -249,7 +249,7 @@ _benchmark_distributed_object_read(BenchmarkRun* run, gboolean use_batch, guint
 
 	dummy = g_malloc0(block_size);
 
-	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	distribution = j_distribution_new(type);
 	semantics = j_benchmark_get_semantics();
 	batch = j_batch_new(semantics);
 
@@ -302,17 +302,29 @@ _benchmark_distributed_object_read(BenchmarkRun* run, gboolean use_batch, guint
 static void
 benchmark_distributed_object_read(BenchmarkRun* run)
 {
-	_benchmark_distributed_object_read(run, FALSE, 4 * 1024);
+	_benchmark_distributed_object_read(run, FALSE, 4 * 1024, J_DISTRIBUTION_ROUND_ROBIN);
 }
 
 static void
 benchmark_distributed_object_read_batch(BenchmarkRun* run)
 {
-	_benchmark_distributed_object_read(run, TRUE, 4 * 1024);
+	_benchmark_distributed_object_read(run, TRUE, 4 * 1024, J_DISTRIBUTION_ROUND_ROBIN);
+}
+
+static void
+benchmark_distributed_object_read_large(BenchmarkRun* run)
+{
+	_benchmark_distributed_object_read(run, FALSE, 1024 * 1024, J_DISTRIBUTION_ROUND_ROBIN);
+}
+
+static void
+benchmark_distributed_object_read_large_erasure(BenchmarkRun* run)
+{
+	_benchmark_distributed_object_read(run, FALSE, 1024 * 1024, J_DISTRIBUTION_ERASURE);
 }
 
 static void
-_benchmark_distributed_object_write(BenchmarkRun* run, gboolean use_batch, guint block_size)
+_benchmark_distributed_object_write(BenchmarkRun* run, gboolean use_batch, guint block_size, JDistributionType type)
 {
 	guint const n = (use_batch) ? 10000 : 1000;
 
@@ -326,7 +338,7 @@ _benchmark_distributed_object_write(BenchmarkRun* run, gboolean use_batch, guint
 
 	dummy = g_malloc0(block_size);
 
-	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	distribution = j_distribution_new(type);
 	semantics = j_benchmark_get_semantics();
 	batch = j_batch_new(semantics);
 
@@ -372,13 +384,25 @@ _benchmark_distributed_object_write(BenchmarkRun* run, gboolean use_batch, guint
 static void
 benchmark_distributed_object_write(BenchmarkRun* run)
 {
-	_benchmark_distributed_object_write(run, FALSE, 4 * 1024);
+	_benchmark_distributed_object_write(run, FALSE, 4 * 1024, J_DISTRIBUTION_ROUND_ROBIN);
 }
 
 static void
 benchmark_distributed_object_write_batch(BenchmarkRun* run)
 {
-	_benchmark_distributed_object_write(run, TRUE, 4 * 1024);
+	_benchmark_distributed_object_write(run, TRUE, 4 * 1024, J_DISTRIBUTION_ROUND_ROBIN);
+}
+
+static void
+benchmark_distributed_object_write_large(BenchmarkRun* run)
+{
+	_benchmark_distributed_object_write(run, FALSE, 1024 * 1024, J_DISTRIBUTION_ROUND_ROBIN);
+}
+
+static void
+benchmark_distributed_object_write_large_erasure(BenchmarkRun* run)
+{
+	_benchmark_distributed_object_write(run, FALSE, 1024 * 1024, J_DISTRIBUTION_ERASURE);
 }
 
 static void
@@ -452,8 +476,12 @@ benchmark_distributed_object(void)
 	/// \todo get
 	j_benchmark_add("/object/distributed-object/read", benchmark_distributed_object_read);
 	j_benchmark_add("/object/distributed-object/read-batch", benchmark_distributed_object_read_batch);
+	j_benchmark_add("/object/distributed-object/read-large", benchmark_distributed_object_read_large);
+	j_benchmark_add("/object/distributed-object/read-large-erasure", benchmark_distributed_object_read_large_erasure);
 	j_benchmark_add("/object/distributed-object/write", benchmark_distributed_object_write);
 	j_benchmark_add("/object/distributed-object/write-batch", benchmark_distributed_object_write_batch);
+	j_benchmark_add("/object/distributed-object/write-large", benchmark_distributed_object_write_large);
+	j_benchmark_add("/object/distributed-object/write-large-erasure", benchmark_distributed_object_write_large_erasure);
 	j_benchmark_add("/object/distributed-object/unordered-create-delete", benchmark_distributed_object_unordered_create_delete);
 	j_benchmark_add("/object/distributed-object/unordered-create-delete-batch", benchmark_distributed_object_unordered_create_delete_batch);
 }
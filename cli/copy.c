@@ -113,6 +113,12 @@ j_cmd_copy(gchar const** arguments)
 					g_error_free(error);
 				}
 
+				// Copying an item creates the destination with the source's distribution, see below.
+				if (uri[0] != NULL)
+				{
+					continue;
+				}
+
 				batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
 				item = j_item_create(j_uri_get_collection(uri[i]), j_uri_get_item_name(uri[i]), NULL, batch);
 
@@ -157,6 +163,41 @@ j_cmd_copy(gchar const** arguments)
 		}
 	}
 
+	if (ouri[0] != NULL && ouri[1] != NULL)
+	{
+		g_autoptr(JBatch) batch = NULL;
+		guint64 bytes_copied;
+
+		// Let the servers copy the data without sending it through the client
+		batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+		j_object_copy(j_object_uri_get_object(ouri[0]), j_object_uri_get_object(ouri[1]), &bytes_copied, batch);
+
+		if (!j_batch_execute(batch))
+		{
+			ret = FALSE;
+		}
+
+		goto end;
+	}
+
+	if (uri[0] != NULL && uri[1] != NULL)
+	{
+		g_autoptr(JBatch) batch = NULL;
+		g_autoptr(JItem) item = NULL;
+		guint64 bytes_copied;
+
+		// Let the servers copy the data without sending it through the client
+		batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+		item = j_item_copy(j_uri_get_item(uri[0]), j_uri_get_collection(uri[1]), j_uri_get_item_name(uri[1]), &bytes_copied, batch);
+
+		if (item == NULL || !j_batch_execute(batch))
+		{
+			ret = FALSE;
+		}
+
+		goto end;
+	}
+
 	offset = 0;
 	buffer = g_new(gchar, 1024 * 1024);
 
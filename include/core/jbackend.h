@@ -121,6 +121,28 @@ enum JBackendComponent
 
 typedef enum JBackendComponent JBackendComponent;
 
+/**
+ * A read or write request for the asynchronous object interface.
+ **/
+struct JBackendObjectRequest
+{
+	/**
+	 * Whether the request writes the buffer's contents or reads into the buffer.
+	 **/
+	gboolean write;
+
+	gpointer buffer;
+	guint64 length;
+	guint64 offset;
+
+	/**
+	 * The number of bytes read or written, set once the request has been completed.
+	 **/
+	guint64 bytes;
+};
+
+typedef struct JBackendObjectRequest JBackendObjectRequest;
+
 struct JBackend
 {
 	JBackendType type;
@@ -150,6 +172,201 @@ struct JBackend
 			gboolean (*backend_get_all)(gpointer, gchar const*, gpointer*);
 			gboolean (*backend_get_by_prefix)(gpointer, gchar const*, gchar const*, gpointer*);
 			gboolean (*backend_iterate)(gpointer, gpointer, gchar const**);
+
+			/**
+			 * Copies an object's contents to another object of the same backend instance.
+			 * Optional, the server falls back to reading and writing if it is not implemented.
+			 *
+			 * \param[in]  src          The source object.
+			 * \param[in]  dst          The destination object.
+			 * \param[out] bytes_copied The number of bytes copied.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_copy)(gpointer, gpointer, gpointer, guint64*);
+
+			/**
+			 * Deletes all objects of a namespace whose names start with a prefix.
+			 * Optional, the server falls back to iterating and deleting the objects one by one if it is not implemented.
+			 *
+			 * \param[in] namespace The namespace.
+			 * \param[in] prefix    The prefix, NULL deletes the whole namespace.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_delete_by_prefix)(gpointer, gchar const*, gchar const*);
+
+			/**
+			 * Submits multiple reads or writes of an object without waiting for them to finish.
+			 * Optional, the server falls back to executing the requests one by one using backend_read and backend_write if it is not implemented.
+			 * The requests and their buffers have to stay valid until backend_complete has been called.
+			 * Requests are tracked per thread, so each thread has to complete its requests before submitting requests for another object.
+			 *
+			 * \param[in] object   The object.
+			 * \param[in] requests The requests.
+			 * \param[in] count    The number of requests.
+			 * \param[in] sync     Whether to sync the object once all requests have finished.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_submit)(gpointer, gpointer, JBackendObjectRequest*, guint, gboolean);
+
+			/**
+			 * Waits for all requests submitted by the current thread.
+			 * Required if backend_submit is implemented.
+			 *
+			 * \param[in] object The object.
+			 *
+			 * \return TRUE if all requests succeeded, FALSE otherwise.
+			 **/
+			gboolean (*backend_complete)(gpointer, gpointer);
+
+			/**
+			 * Registers a buffer that the current thread will use for requests, allowing the backend to map it only once.
+			 * Optional, requests can use arbitrary buffers even if a buffer has been registered.
+			 *
+			 * \param[in] buffer The buffer, NULL to unregister the current buffer.
+			 * \param[in] length The buffer's length.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_register_buffer)(gpointer, gpointer, guint64);
+
+			/**
+			 * Provides direct access to an object's data, for example, by mapping it into memory.
+			 * Optional, the server falls back to backend_read if it is not implemented or returns FALSE.
+			 * The data stays valid until the mapping is released with backend_unmap, even if the object is closed.
+			 *
+			 * \param[in]  object  The object.
+			 * \param[in]  length  The number of bytes to access.
+			 * \param[in]  offset  The offset to start at.
+			 * \param[out] data    The data.
+			 * \param[out] bytes   The number of bytes available, which is less than length at the end of the object.
+			 * \param[out] mapping A handle to release the data with.
+			 *
+			 * \return TRUE on success, FALSE if the data can not be accessed directly.
+			 **/
+			gboolean (*backend_map)(gpointer, gpointer, guint64, guint64, gconstpointer*, guint64*, gpointer*);
+
+			/**
+			 * Releases data provided by backend_map.
+			 * Required if backend_map is implemented.
+			 *
+			 * \param[in] mapping The handle returned by backend_map.
+			 **/
+			void (*backend_unmap)(gpointer, gpointer);
+
+			/**
+			 * Reads multiple ranges of an object.
+			 * Optional, the server falls back to calling backend_read for each range if it is not implemented.
+			 *
+			 * \param[in]     object   The object.
+			 * \param[in,out] requests The requests, their bytes are set to the number of bytes read.
+			 * \param[in]     count    The number of requests.
+			 *
+			 * \return TRUE if all ranges have been read completely, FALSE otherwise.
+			 **/
+			gboolean (*backend_readv)(gpointer, gpointer, JBackendObjectRequest*, guint);
+
+			/**
+			 * Writes multiple ranges of an object.
+			 * Optional, the server falls back to calling backend_write for each range if it is not implemented.
+			 *
+			 * \param[in]     object   The object.
+			 * \param[in,out] requests The requests, their bytes are set to the number of bytes written.
+			 * \param[in]     count    The number of requests.
+			 *
+			 * \return TRUE if all ranges have been written completely, FALSE otherwise.
+			 **/
+			gboolean (*backend_writev)(gpointer, gpointer, JBackendObjectRequest*, guint);
+
+			/**
+			 * Starts a batch of metadata operations on objects of a namespace.
+			 * Optional, the server falls back to creating, deleting and closing the objects one by one if it is not implemented.
+			 * Requires backend_batch_create, backend_batch_delete and backend_batch_execute.
+			 *
+			 * \param[in]  namespace The namespace.
+			 * \param[in]  sync      Whether the changes have to be on stable storage once the batch has been executed.
+			 * \param[out] batch     The batch.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_batch_start)(gpointer, gchar const*, gboolean, gpointer*);
+
+			/**
+			 * Creates an object as part of a batch without opening it.
+			 * Creating an existing object succeeds.
+			 *
+			 * \param[in] batch The batch.
+			 * \param[in] path  The object's path.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_batch_create)(gpointer, gpointer, gchar const*);
+
+			/**
+			 * Deletes an object as part of a batch without opening it.
+			 *
+			 * \param[in] batch The batch.
+			 * \param[in] path  The object's path.
+			 *
+			 * \return TRUE if the object has been deleted, FALSE otherwise.
+			 **/
+			gboolean (*backend_batch_delete)(gpointer, gpointer, gchar const*);
+
+			/**
+			 * Finishes a batch and frees it.
+			 *
+			 * \param[in] batch The batch.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_batch_execute)(gpointer, gpointer);
+
+			/**
+			 * Allocates storage for a range of an object, which extends the object if necessary.
+			 * Optional, nothing is allocated in advance if it is not implemented.
+			 *
+			 * \param[in] object The object.
+			 * \param[in] length The range's length.
+			 * \param[in] offset The range's offset.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_preallocate)(gpointer, gpointer, guint64, guint64);
+
+			/**
+			 * Sets an object's size, which discards data beyond the new size or extends the object with zeros.
+			 * Optional, the server falls back to writing a zero byte for extending objects if it is not implemented.
+			 *
+			 * \param[in] object The object.
+			 * \param[in] size   The new size.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_truncate)(gpointer, gpointer, guint64);
+
+			/**
+			 * Returns the next object of an iterator together with its modification time and size.
+			 * Optional, the server falls back to backend_iterate and opening each object to get its status if it is not implemented.
+			 * Like backend_iterate, the iterator is freed once FALSE is returned.
+			 *
+			 * \param[in]  iterator          The iterator.
+			 * \param[out] name              The object's name.
+			 * \param[out] modification_time The object's modification time.
+			 * \param[out] size              The object's size.
+			 *
+			 * \return TRUE if an object has been returned, FALSE if the end of the iterator has been reached.
+			 **/
+			gboolean (*backend_iterate_status)(gpointer, gpointer, gchar const**, gint64*, guint64*);
+
+			/**
+			 * Frees an iterator that has not reached its end.
+			 * Optional, the server falls back to calling backend_iterate until it returns FALSE if it is not implemented.
+			 *
+			 * \param[in] iterator The iterator.
+			 **/
+			void (*backend_iterate_free)(gpointer, gpointer);
 		} object;
 
 		struct
@@ -167,6 +384,97 @@ struct JBackend
 			gboolean (*backend_get_all)(gpointer, gchar const*, gpointer*);
 			gboolean (*backend_get_by_prefix)(gpointer, gchar const*, gchar const*, gpointer*);
 			gboolean (*backend_iterate)(gpointer, gpointer, gchar const**, gconstpointer*, guint32*);
+
+			/**
+			 * Deletes all key-value pairs of the batch's namespace whose keys start with a prefix.
+			 * Optional, the server falls back to iterating and deleting the pairs one by one if it is not implemented.
+			 *
+			 * \param[in] batch  The batch.
+			 * \param[in] prefix The prefix, NULL deletes the whole namespace.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_delete_by_prefix)(gpointer, gpointer, gchar const*);
+
+			/**
+			 * Frees an iterator that has not reached its end.
+			 * Optional, the server falls back to calling backend_iterate until it returns FALSE if it is not implemented.
+			 *
+			 * \param[in] iterator The iterator.
+			 **/
+			void (*backend_iterate_free)(gpointer, gpointer);
+
+			/**
+			 * Gets a key-value pair without copying its value.
+			 * Optional, the server falls back to backend_get if it is not implemented.
+			 *
+			 * \param[in]  batch The batch.
+			 * \param[in]  key   The key.
+			 * \param[out] value The value, which is owned by the backend and valid until the batch is executed.
+			 * \param[out] len   The value's length.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_get_view)(gpointer, gpointer, gchar const*, gconstpointer*, guint32*);
+
+			/**
+			 * Gets all key-value pairs of a namespace within a range of keys, ordered by their keys.
+			 * Keys have to be compared bytewise like strcmp() does, because clients merge the ranges of multiple servers.
+			 * The returned iterator is used with backend_iterate.
+			 * Optional, range scans fail if it is not implemented.
+			 *
+			 * \param[in]  namespace The namespace.
+			 * \param[in]  start     The first key (inclusive), NULL for no lower bound.
+			 * \param[in]  end       The last key (exclusive), NULL for no upper bound.
+			 * \param[in]  limit     The maximum number of pairs, 0 for no limit.
+			 * \param[in]  reverse   Whether to return the pairs in descending order.
+			 * \param[out] iterator  The iterator.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_get_range)(gpointer, gchar const*, gchar const*, gchar const*, guint32, gboolean, gpointer*);
+
+			/**
+			 * Atomically replaces a value if it matches an expected value.
+			 * Optional, the server falls back to backend_get and backend_put if it is not implemented, which is not atomic.
+			 *
+			 * \param[in] batch        The batch.
+			 * \param[in] key          The key.
+			 * \param[in] expected     The expected value, NULL if the key must not exist.
+			 * \param[in] expected_len The expected value's length.
+			 * \param[in] value        The new value.
+			 * \param[in] len          The new value's length.
+			 *
+			 * \return TRUE if the value has been replaced, FALSE otherwise.
+			 **/
+			gboolean (*backend_compare_and_swap)(gpointer, gpointer, gchar const*, gconstpointer, guint32, gconstpointer, guint32);
+
+			/**
+			 * Atomically adds to a 64-bit counter, which is stored as a little-endian value of 8 bytes.
+			 * Keys that do not exist are treated as 0.
+			 * Optional, the server falls back to backend_get and backend_put if it is not implemented, which is not atomic.
+			 *
+			 * \param[in] batch The batch.
+			 * \param[in] key   The key.
+			 * \param[in] delta The value to add.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_add)(gpointer, gpointer, gchar const*, gint64);
+
+			/**
+			 * Atomically appends to a value.
+			 * Keys that do not exist are created.
+			 * Optional, the server falls back to backend_get and backend_put if it is not implemented, which is not atomic.
+			 *
+			 * \param[in] batch The batch.
+			 * \param[in] key   The key.
+			 * \param[in] value The data to append.
+			 * \param[in] len   The data's length.
+			 *
+			 * \return TRUE on success, FALSE otherwise.
+			 **/
+			gboolean (*backend_append)(gpointer, gpointer, gchar const*, gconstpointer, guint32);
 		} kv;
 
 		struct
@@ -406,6 +714,30 @@ gboolean j_backend_object_write(JBackend*, gpointer, gconstpointer, guint64, gui
 gboolean j_backend_object_get_all(JBackend*, gchar const*, gpointer*);
 gboolean j_backend_object_get_by_prefix(JBackend*, gchar const*, gchar const*, gpointer*);
 gboolean j_backend_object_iterate(JBackend*, gpointer, gchar const**);
+gboolean j_backend_object_iterate_status(JBackend*, gchar const*, gpointer, gchar const**, gint64*, guint64*);
+void j_backend_object_iterate_free(JBackend*, gpointer);
+
+gboolean j_backend_object_copy(JBackend*, gpointer, gpointer, guint64*);
+gboolean j_backend_object_delete_by_prefix(JBackend*, gchar const*, gchar const*);
+
+gboolean j_backend_object_submit(JBackend*, gpointer, JBackendObjectRequest*, guint, gboolean);
+gboolean j_backend_object_complete(JBackend*, gpointer);
+gboolean j_backend_object_register_buffer(JBackend*, gpointer, guint64);
+gboolean j_backend_object_map(JBackend*, gpointer, guint64, guint64, gconstpointer*, guint64*, gpointer*);
+void j_backend_object_unmap(JBackend*, gpointer);
+
+gboolean j_backend_object_readv(JBackend*, gpointer, JBackendObjectRequest*, guint);
+gboolean j_backend_object_writev(JBackend*, gpointer, JBackendObjectRequest*, guint);
+
+gboolean j_backend_object_batch_start(JBackend*, gchar const*, gboolean, gpointer*);
+gboolean j_backend_object_batch_create(JBackend*, gpointer, gchar const*);
+gboolean j_backend_object_batch_delete(JBackend*, gpointer, gchar const*);
+gboolean j_backend_object_batch_execute(JBackend*, gpointer);
+
+gboolean j_backend_object_preallocate(JBackend*, gpointer, guint64, guint64);
+gboolean j_backend_object_truncate(JBackend*, gpointer, guint64);
+
+GMutex* j_backend_object_get_append_lock(gchar const*, gchar const*);
 
 gboolean j_backend_kv_init(JBackend*, gchar const*);
 void j_backend_kv_fini(JBackend*);
@@ -416,10 +748,19 @@ gboolean j_backend_kv_batch_execute(JBackend*, gpointer);
 gboolean j_backend_kv_put(JBackend*, gpointer, gchar const*, gconstpointer, guint32);
 gboolean j_backend_kv_delete(JBackend*, gpointer, gchar const*);
 gboolean j_backend_kv_get(JBackend*, gpointer, gchar const*, gpointer*, guint32*);
+gboolean j_backend_kv_get_view(JBackend*, gpointer, gchar const*, gconstpointer*, guint32*, GDestroyNotify*);
 
 gboolean j_backend_kv_get_all(JBackend*, gchar const*, gpointer*);
 gboolean j_backend_kv_get_by_prefix(JBackend*, gchar const*, gchar const*, gpointer*);
+gboolean j_backend_kv_get_range(JBackend*, gchar const*, gchar const*, gchar const*, guint32, gboolean, gpointer*);
 gboolean j_backend_kv_iterate(JBackend*, gpointer, gchar const**, gconstpointer*, guint32*);
+void j_backend_kv_iterate_free(JBackend*, gpointer);
+
+gboolean j_backend_kv_delete_by_prefix(JBackend*, gpointer, gchar const*, gchar const*);
+
+gboolean j_backend_kv_compare_and_swap(JBackend*, gpointer, gchar const*, gconstpointer, guint32, gconstpointer, guint32);
+gboolean j_backend_kv_add(JBackend*, gpointer, gchar const*, gint64);
+gboolean j_backend_kv_append(JBackend*, gpointer, gchar const*, gconstpointer, guint32);
 
 gboolean j_backend_db_init(JBackend*, gchar const*);
 void j_backend_db_fini(JBackend*);
@@ -103,6 +103,38 @@ G_DEFINE_AUTOPTR_CLEANUP_FUNC(JConfiguration, j_configuration_unref)
 gchar const* j_configuration_get_server(JConfiguration*, JBackendType, guint32);
 guint32 j_configuration_get_server_count(JConfiguration*, JBackendType);
 
+/**
+ * Returns a server's weight.
+ *
+ * \code
+ * \endcode
+ *
+ * \param configuration A configuration.
+ * \param backend       A backend type.
+ * \param index         A server index.
+ *
+ * \return The weight, 1 if no weights have been configured.
+ **/
+guint32 j_configuration_get_server_weight(JConfiguration* configuration, JBackendType backend, guint32 index);
+
+/**
+ * Returns the index of the server responsible for a key.
+ * Depending on the configured placement, either the key's hash modulo the number of servers or a consistent hash ring is used.
+ *
+ * \code
+ * guint32 index;
+ *
+ * index = j_configuration_get_server_index(j_configuration(), J_BACKEND_TYPE_KV, "key");
+ * \endcode
+ *
+ * \param configuration A configuration.
+ * \param backend       A backend type.
+ * \param key           A key.
+ *
+ * \return The server index.
+ **/
+guint32 j_configuration_get_server_index(JConfiguration* configuration, JBackendType backend, gchar const* key);
+
 gchar const* j_configuration_get_backend(JConfiguration*, JBackendType);
 gchar const* j_configuration_get_backend_component(JConfiguration*, JBackendType);
 gchar const* j_configuration_get_backend_path(JConfiguration*, JBackendType);
@@ -113,6 +145,20 @@ guint16 j_configuration_get_port(JConfiguration*);
 
 guint32 j_configuration_get_max_connections(JConfiguration*);
 guint64 j_configuration_get_stripe_size(JConfiguration*);
+guint32 j_configuration_get_virtual_nodes(JConfiguration*);
+
+/**
+ * Returns the latency percentile after which reads of replicated objects are hedged.
+ * If a read takes longer than this percentile of recent reads, it is also sent to another replica.
+ *
+ * \code
+ * \endcode
+ *
+ * \param configuration A configuration.
+ *
+ * \return The percentile, 0 if hedging is disabled.
+ **/
+guint32 j_configuration_get_hedge_percentile(JConfiguration* configuration);
 
 gchar const* j_configuration_get_checksum(JConfiguration*);
 
@@ -44,6 +44,7 @@ G_BEGIN_DECLS
 
 gpointer j_connection_pool_pop(JBackendType, guint32);
 void j_connection_pool_push(JBackendType, guint32, gpointer);
+void j_connection_pool_discard(JBackendType, guint32, gpointer);
 
 /**
  * @}
@@ -95,6 +95,20 @@ gboolean j_dir_iterator_next(JDirIterator* iterator);
  **/
 gchar const* j_dir_iterator_get(JDirIterator* iterator);
 
+/**
+ * Returns the current file's modification time and size.
+ *
+ * \code
+ * \endcode
+ *
+ * \param iterator          A directory iterator.
+ * \param modification_time A pointer to the modification time, can be NULL.
+ * \param size              A pointer to the size, can be NULL.
+ *
+ * \return TRUE on success, FALSE otherwise.
+ **/
+gboolean j_dir_iterator_get_status(JDirIterator* iterator, gint64* modification_time, guint64* size);
+
 /**
  * @}
  **/
@@ -45,15 +45,76 @@ enum JDistributionType
 {
 	J_DISTRIBUTION_ROUND_ROBIN,
 	J_DISTRIBUTION_SINGLE_SERVER,
-	J_DISTRIBUTION_WEIGHTED
+	J_DISTRIBUTION_WEIGHTED,
+	/**
+	 * Like #J_DISTRIBUTION_WEIGHTED but the weights are derived from the servers' free capacity and load when the distribution is first used.
+	 * The weights are serialized, so that the data can still be found when the servers' load changes.
+	 **/
+	J_DISTRIBUTION_ADAPTIVE,
+	/**
+	 * Splits the blocks into groups of \c data blocks and protects each group with \c parity blocks.
+	 * The parity blocks are computed by the client, so that data can still be read when up to \c parity servers of a group fail.
+	 **/
+	J_DISTRIBUTION_ERASURE
 };
 
 typedef enum JDistributionType JDistributionType;
 
+/**
+ * The expected access pattern of an object, see j_distribution_new_for_hint().
+ **/
+enum JDistributionAccess
+{
+	J_DISTRIBUTION_ACCESS_UNKNOWN,
+	/**
+	 * The object is mostly read and written in large sequential requests.
+	 **/
+	J_DISTRIBUTION_ACCESS_SEQUENTIAL,
+	/**
+	 * The object is mostly accessed in small requests at random offsets.
+	 **/
+	J_DISTRIBUTION_ACCESS_RANDOM
+};
+
+typedef enum JDistributionAccess JDistributionAccess;
+
 struct JDistribution;
 
 typedef struct JDistribution JDistribution;
 
+/**
+ * A chunk of a distributed range.
+ **/
+struct JDistributionChunk
+{
+	/**
+	 * The server index.
+	 **/
+	guint32 index;
+
+	/**
+	 * The chunk's length.
+	 **/
+	guint64 length;
+
+	/**
+	 * The chunk's offset on the server.
+	 **/
+	guint64 offset;
+
+	/**
+	 * The block ID.
+	 **/
+	guint64 block_id;
+
+	/**
+	 * The chunk's offset relative to the start of the range.
+	 **/
+	guint64 range_offset;
+};
+
+typedef struct JDistributionChunk JDistributionChunk;
+
 G_END_DECLS
 
 #include <core/jconfiguration.h>
@@ -103,6 +164,27 @@ JDistribution* j_distribution_new_for_configuration(JDistributionType type, JCon
  **/
 JDistribution* j_distribution_new_from_bson(bson_t const* b);
 
+/**
+ * Creates a new distribution suited for an object's expected size and access pattern.
+ *
+ * Objects that fit into a single stripe are stored on a single server.
+ * Larger objects are only spread across as many servers as they have stripes.
+ * Sequentially accessed objects use larger stripes, so that each server receives fewer but larger requests.
+ * The chosen parameters are part of the serialized distribution.
+ *
+ * \code
+ * JDistribution* d;
+ *
+ * d = j_distribution_new_for_hint(1024 * 1024 * 1024, J_DISTRIBUTION_ACCESS_SEQUENTIAL);
+ * \endcode
+ *
+ * \param size   The expected size, 0 if unknown.
+ * \param access The expected access pattern.
+ *
+ * \return A new distribution. Should be freed with \ref j_distribution_unref().
+ **/
+JDistribution* j_distribution_new_for_hint(guint64 size, JDistributionAccess access);
+
 /**
  * Increases a distribution's reference count.
  *
@@ -126,6 +208,63 @@ void j_distribution_unref(JDistribution* distribution);
 
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(JDistribution, j_distribution_unref)
 
+/**
+ * Returns the number of copies of each block.
+ * It can be changed by setting the \c replicas key with j_distribution_set().
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution A distribution.
+ *
+ * \return The number of copies, 1 if the distribution is not replicated.
+ **/
+guint32 j_distribution_get_replicas(JDistribution* distribution);
+
+/**
+ * Returns the server storing a copy of a block.
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution A distribution.
+ * \param index        The index of the server storing the block.
+ * \param replica      The copy, 0 for the block itself.
+ *
+ * \return The server index.
+ **/
+guint32 j_distribution_get_replica_index(JDistribution* distribution, guint32 index, guint32 replica);
+
+/**
+ * Returns the erasure coding parameters of a distribution.
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution  A distribution.
+ * \param data_blocks   Returns the number of data blocks per group.
+ * \param parity_blocks Returns the number of parity blocks per group.
+ * \param block_size    Returns the block size.
+ *
+ * \return TRUE if the distribution stores parity blocks, FALSE otherwise.
+ **/
+gboolean j_distribution_get_erasure(JDistribution* distribution, guint32* data_blocks, guint32* parity_blocks, guint64* block_size);
+
+/**
+ * Returns the server storing a block of a group.
+ * All blocks of a group are stored at the same offset, which is the group multiplied by the block size.
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution An erasure coded distribution.
+ * \param group        The group.
+ * \param position     The block's position, data blocks come first, followed by parity blocks.
+ *
+ * \return The server index.
+ **/
+guint32 j_distribution_get_group_index(JDistribution* distribution, guint64 group, guint32 position);
+
 /**
  * Serializes distribution.
  *
@@ -162,6 +301,7 @@ void j_distribution_set_block_size(JDistribution* distribution, guint64 block_si
 
 /**
  * Set a property of the distribution. Settings depend on the distribution type.
+ * The \c replicas key is supported by all distributions and sets the number of copies of each block.
  *
  * \code
  * \endcode
@@ -185,6 +325,22 @@ void j_distribution_set(JDistribution* distribution, gchar const* key, guint64 v
  */
 void j_distribution_set2(JDistribution* distribution, gchar const* key, guint64 value1, guint64 value2);
 
+/**
+ * Places a single server distribution on the server responsible for a key.
+ * The server is chosen using the configured placement, see j_configuration_get_server_index().
+ *
+ * \code
+ * JDistribution* d;
+ *
+ * d = j_distribution_new(J_DISTRIBUTION_SINGLE_SERVER);
+ * j_distribution_set_placement_key(d, "name");
+ * \endcode
+ *
+ * \param distribution A single server distribution.
+ * \param key          A key.
+ */
+void j_distribution_set_placement_key(JDistribution* distribution, gchar const* key);
+
 /**
  * Resets a distribution.
  *
@@ -218,6 +374,32 @@ void j_distribution_reset(JDistribution* distribution, guint64 length, guint64 o
  **/
 gboolean j_distribution_distribute(JDistribution* distribution, guint* index, guint64* new_length, guint64* new_offset, guint64* block_id);
 
+/**
+ * Distributes a whole range at once.
+ * The chunks are appended in the same order j_distribution_distribute() would return them.
+ * In contrast to j_distribution_reset() and j_distribution_distribute(), this does not modify the distribution and can therefore be used concurrently.
+ *
+ * \code
+ * g_autoptr(GArray) chunks = NULL;
+ *
+ * chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+ * j_distribution_distribute_range(d, length, offset, chunks);
+ *
+ * for (guint i = 0; i < chunks->len; i++)
+ * {
+ *   JDistributionChunk* chunk = &g_array_index(chunks, JDistributionChunk, i);
+ * }
+ * \endcode
+ *
+ * \param distribution A distribution.
+ * \param length       A length.
+ * \param offset       An offset.
+ * \param chunks       An array of #JDistributionChunk elements.
+ *
+ * \return The number of chunks appended.
+ **/
+guint j_distribution_distribute_range(JDistribution* distribution, guint64 length, guint64 offset, GArray* chunks);
+
 /**
  * @}
  **/
@@ -0,0 +1,125 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ **/
+
+#ifndef JULEA_ERASURE_H
+#define JULEA_ERASURE_H
+
+#if !defined(JULEA_H) && !defined(JULEA_COMPILATION)
+#error "Only <julea.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * \defgroup JErasure Erasure Code
+ *
+ * A systematic Reed-Solomon code over GF(2^8).
+ * A group of data blocks is protected by a number of parity blocks.
+ * Any combination of lost blocks can be reconstructed as long as at least as many blocks as there are data blocks remain.
+ *
+ * @{
+ **/
+
+struct JErasure;
+
+typedef struct JErasure JErasure;
+
+/**
+ * Creates a new erasure code.
+ *
+ * \code
+ * JErasure* erasure;
+ *
+ * erasure = j_erasure_new(4, 2);
+ * \endcode
+ *
+ * \param data_blocks   The number of data blocks.
+ * \param parity_blocks The number of parity blocks.
+ *
+ * \return A new erasure code. Should be freed with j_erasure_unref().
+ **/
+JErasure* j_erasure_new(guint32 data_blocks, guint32 parity_blocks);
+
+/**
+ * Increases an erasure code's reference count.
+ *
+ * \code
+ * \endcode
+ *
+ * \param erasure An erasure code.
+ *
+ * \return \p erasure.
+ **/
+JErasure* j_erasure_ref(JErasure* erasure);
+
+/**
+ * Decreases an erasure code's reference count.
+ * When the reference count reaches zero, frees the memory allocated for the erasure code.
+ *
+ * \code
+ * \endcode
+ *
+ * \param erasure An erasure code.
+ **/
+void j_erasure_unref(JErasure* erasure);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(JErasure, j_erasure_unref)
+
+/**
+ * Computes the parity blocks for a group of data blocks.
+ *
+ * \code
+ * \endcode
+ *
+ * \param erasure An erasure code.
+ * \param data    The data blocks.
+ * \param parity  The parity blocks.
+ * \param length  The length of each block.
+ **/
+void j_erasure_encode(JErasure* erasure, gconstpointer const* data, gpointer* parity, gsize length);
+
+/**
+ * Reconstructs the missing blocks of a group.
+ * The data blocks come first, followed by the parity blocks.
+ * Missing blocks are overwritten with their reconstructed contents.
+ *
+ * \code
+ * \endcode
+ *
+ * \param erasure An erasure code.
+ * \param blocks  The data and parity blocks.
+ * \param present Whether the blocks are present.
+ * \param length  The length of each block.
+ *
+ * \return TRUE on success, FALSE if too many blocks are missing.
+ **/
+gboolean j_erasure_decode(JErasure* erasure, gpointer* blocks, gboolean const* present, gsize length);
+
+/**
+ * @}
+ **/
+
+G_END_DECLS
+
+#endif
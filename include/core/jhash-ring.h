@@ -0,0 +1,144 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ **/
+
+#ifndef JULEA_HASH_RING_H
+#define JULEA_HASH_RING_H
+
+#if !defined(JULEA_H) && !defined(JULEA_COMPILATION)
+#error "Only <julea.h> can be included directly."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * \defgroup JHashRing Hash Ring
+ *
+ * A consistent hash ring that maps keys to servers.
+ * Each server is represented by a number of virtual nodes, which is proportional to its weight.
+ * Adding or removing a server only moves the keys that are mapped to its virtual nodes.
+ *
+ * @{
+ **/
+
+struct JHashRing;
+
+typedef struct JHashRing JHashRing;
+
+G_END_DECLS
+
+#include <core/jbackend.h>
+#include <core/jconfiguration.h>
+
+G_BEGIN_DECLS
+
+/**
+ * Creates a new hash ring.
+ *
+ * \code
+ * JHashRing* ring;
+ *
+ * ring = j_hash_ring_new(128);
+ * j_hash_ring_add(ring, "server1", 0, 1);
+ * j_hash_ring_add(ring, "server2", 1, 2);
+ * \endcode
+ *
+ * \param virtual_nodes The number of virtual nodes per unit of weight.
+ *
+ * \return A new hash ring. Should be freed with j_hash_ring_unref().
+ **/
+JHashRing* j_hash_ring_new(guint32 virtual_nodes);
+
+/**
+ * Creates a new hash ring for the servers of a configuration.
+ *
+ * \code
+ * \endcode
+ *
+ * \param configuration A configuration.
+ * \param backend       A backend type.
+ *
+ * \return A new hash ring. Should be freed with j_hash_ring_unref().
+ **/
+JHashRing* j_hash_ring_new_for_configuration(JConfiguration* configuration, JBackendType backend);
+
+/**
+ * Increases a hash ring's reference count.
+ *
+ * \code
+ * \endcode
+ *
+ * \param ring A hash ring.
+ *
+ * \return \p ring.
+ **/
+JHashRing* j_hash_ring_ref(JHashRing* ring);
+
+/**
+ * Decreases a hash ring's reference count.
+ * When the reference count reaches zero, frees the memory allocated for the hash ring.
+ *
+ * \code
+ * \endcode
+ *
+ * \param ring A hash ring.
+ **/
+void j_hash_ring_unref(JHashRing* ring);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(JHashRing, j_hash_ring_unref)
+
+/**
+ * Adds a server to a hash ring.
+ * The virtual nodes are derived from the server's name, which should therefore be unique and stable.
+ *
+ * \code
+ * \endcode
+ *
+ * \param ring   A hash ring.
+ * \param name   The server's name.
+ * \param index  The server's index.
+ * \param weight The server's weight, 0 to not map any keys to the server.
+ **/
+void j_hash_ring_add(JHashRing* ring, gchar const* name, guint32 index, guint32 weight);
+
+/**
+ * Returns the index of the server responsible for a key.
+ * The ring must contain at least one server with a non-zero weight.
+ *
+ * \code
+ * \endcode
+ *
+ * \param ring A hash ring.
+ * \param key  A key.
+ *
+ * \return The server index.
+ **/
+guint32 j_hash_ring_get(JHashRing* ring, gchar const* key);
+
+/**
+ * @}
+ **/
+
+G_END_DECLS
+
+#endif
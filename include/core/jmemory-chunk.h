@@ -39,6 +39,11 @@ G_BEGIN_DECLS
  * @{
  **/
 
+/**
+ * The alignment of the chunk and of segments that are at least as large.
+ **/
+#define J_MEMORY_CHUNK_ALIGNMENT 4096
+
 struct JMemoryChunk;
 
 typedef struct JMemoryChunk JMemoryChunk;
@@ -87,6 +92,8 @@ void j_memory_chunk_free(JMemoryChunk* chunk);
  * \param chunk  A chunk.
  * \param length A length.
  *
+ * Segments of at least #J_MEMORY_CHUNK_ALIGNMENT bytes are aligned to it, smaller ones are packed.
+ *
  * \return A pointer to a segment of the chunk, NULL if not enough space is available.
  **/
 gpointer j_memory_chunk_get(JMemoryChunk* chunk, guint64 length);
@@ -62,11 +62,109 @@ enum JMessageType
 	J_MESSAGE_DB_INSERT,
 	J_MESSAGE_DB_UPDATE,
 	J_MESSAGE_DB_DELETE,
-	J_MESSAGE_DB_QUERY
+	J_MESSAGE_DB_QUERY,
+	J_MESSAGE_OBJECT_COPY,
+	J_MESSAGE_OBJECT_COMPOUND,
+	J_MESSAGE_OBJECT_APPEND,
+	J_MESSAGE_OBJECT_RESERVE,
+	J_MESSAGE_OBJECT_DELETE_PREFIX,
+	J_MESSAGE_KV_DELETE_PREFIX,
+	J_MESSAGE_OBJECT_LIST,
+	J_MESSAGE_CURSOR_NEXT,
+	J_MESSAGE_CURSOR_CLOSE,
+	J_MESSAGE_KV_GET_RANGE,
+	J_MESSAGE_KV_UPDATE
 };
 
 typedef enum JMessageType JMessageType;
 
+/**
+ * Flags for J_MESSAGE_OBJECT_COMPOUND.
+ **/
+enum JMessageObjectCompoundFlags
+{
+	/**
+	 * Create the object if it does not exist before writing.
+	 **/
+	J_MESSAGE_OBJECT_COMPOUND_CREATE = 1 << 0,
+
+	/**
+	 * Sync the object after writing.
+	 **/
+	J_MESSAGE_OBJECT_COMPOUND_SYNC = 1 << 1
+};
+
+typedef enum JMessageObjectCompoundFlags JMessageObjectCompoundFlags;
+
+/**
+ * Flags for J_MESSAGE_OBJECT_COPY.
+ **/
+enum JMessageObjectCopyFlags
+{
+	/**
+	 * The destination is stored on another server.
+	 **/
+	J_MESSAGE_OBJECT_COPY_REMOTE = 1 << 0,
+
+	/**
+	 * A missing source is treated as empty, which is used for lazily created stripes.
+	 **/
+	J_MESSAGE_OBJECT_COPY_SPARSE = 1 << 1
+};
+
+typedef enum JMessageObjectCopyFlags JMessageObjectCopyFlags;
+
+/**
+ * Flags for J_MESSAGE_KV_GET_RANGE.
+ **/
+enum JMessageKVRangeFlags
+{
+	/**
+	 * The message contains a start key.
+	 **/
+	J_MESSAGE_KV_RANGE_START = 1 << 0,
+
+	/**
+	 * The message contains an end key.
+	 **/
+	J_MESSAGE_KV_RANGE_END = 1 << 1,
+
+	/**
+	 * Return the pairs in descending order.
+	 **/
+	J_MESSAGE_KV_RANGE_REVERSE = 1 << 2
+};
+
+typedef enum JMessageKVRangeFlags JMessageKVRangeFlags;
+
+/**
+ * Operations of J_MESSAGE_KV_UPDATE.
+ **/
+enum JMessageKVUpdateType
+{
+	/**
+	 * Replace the value if it matches the expected value.
+	 **/
+	J_MESSAGE_KV_UPDATE_COMPARE_AND_SWAP,
+
+	/**
+	 * Replace the value if the key does not exist.
+	 **/
+	J_MESSAGE_KV_UPDATE_CREATE,
+
+	/**
+	 * Add to a 64-bit counter.
+	 **/
+	J_MESSAGE_KV_UPDATE_ADD,
+
+	/**
+	 * Append to the value.
+	 **/
+	J_MESSAGE_KV_UPDATE_APPEND
+};
+
+typedef enum JMessageKVUpdateType JMessageKVUpdateType;
+
 struct JMessage;
 
 typedef struct JMessage JMessage;
@@ -355,6 +453,21 @@ gboolean j_message_write(JMessage* message, GOutputStream* stream);
  **/
 void j_message_add_send(JMessage* message, gconstpointer data, guint64 length);
 
+/**
+ * Adds new data to send to a message and transfers its ownership to the message.
+ * \p free_func is called with \p free_data when the message is freed, that is, after it has been sent.
+ *
+ * \code
+ * \endcode
+ *
+ * \param message   A message.
+ * \param data      Data.
+ * \param length    A length.
+ * \param free_func A function to release the data.
+ * \param free_data The argument for \p free_func.
+ **/
+void j_message_add_send_full(JMessage* message, gconstpointer data, guint64 length, GDestroyNotify free_func, gpointer free_data);
+
 /**
  * Adds a new operation to a message.
  *
@@ -53,6 +53,19 @@ struct JOperation
 
 	JOperationExecFunc exec_func;
 	JOperationFreeFunc free_func;
+
+	/**
+	 * An optional function that executes a sequence of different operations on the same key at once.
+	 * Consecutive operations with the same key and compound function are combined even if their exec functions differ.
+	 * In contrast to exec_func, the compound function is passed a list of #JOperation elements.
+	 **/
+	JOperationExecFunc compound_exec_func;
+
+	/**
+	 * The operation's position within a compound sequence.
+	 * Operations are only combined if their positions do not decrease, so that the compound function can execute them in a fixed order.
+	 **/
+	guint compound_position;
 };
 
 typedef struct JOperation JOperation;
@@ -120,6 +120,40 @@ JCredentials* j_item_get_credentials(JItem* item);
  **/
 JItem* j_item_create(JCollection* collection, gchar const* name, JDistribution* distribution, JBatch* batch);
 
+/**
+ * Creates an item in a collection, choosing its distribution based on its expected size and access pattern.
+ * See j_distribution_new_for_hint() for details.
+ *
+ * \code
+ * \endcode
+ *
+ * \param collection A collection.
+ * \param name       A name.
+ * \param size       The expected size, 0 if unknown.
+ * \param access     The expected access pattern.
+ * \param batch      A batch.
+ *
+ * \return A new item. Should be freed with \ref j_item_unref().
+ **/
+JItem* j_item_create_for_hint(JCollection* collection, gchar const* name, guint64 size, JDistributionAccess access, JBatch* batch);
+
+/**
+ * Copies an item to a new item in a collection.
+ * The new item uses the same distribution, which allows the servers to copy the data without sending it through the client.
+ *
+ * \code
+ * \endcode
+ *
+ * \param item         An item.
+ * \param collection   A collection.
+ * \param name         A name.
+ * \param bytes_copied Number of bytes copied.
+ * \param batch        A batch.
+ *
+ * \return A new item. Should be freed with \ref j_item_unref().
+ **/
+JItem* j_item_copy(JItem* item, JCollection* collection, gchar const* name, guint64* bytes_copied, JBatch* batch);
+
 /**
  * Deletes an item from a collection.
  *
@@ -40,6 +40,8 @@
 #include <core/jcredentials.h>
 #include <core/jdir-iterator.h>
 #include <core/jdistribution.h>
+#include <core/jerasure.h>
+#include <core/jhash-ring.h>
 #include <core/jhelper.h>
 #include <core/jlist.h>
 #include <core/jlist-iterator.h>
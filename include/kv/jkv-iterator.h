@@ -70,6 +70,27 @@ JKVIterator* j_kv_iterator_new(gchar const* namespace, gchar const* prefix);
  **/
 JKVIterator* j_kv_iterator_new_for_index(guint32 index, gchar const* namespace, gchar const* prefix);
 
+/**
+ * Creates a new JKVIterator over a range of keys.
+ * The key-value pairs are returned ordered bytewise by their keys, even if they are stored on multiple servers.
+ *
+ * \code
+ * g_autoptr(JKVIterator) iterator = NULL;
+ *
+ * // The ten largest keys from "a" up to, but not including, "b".
+ * iterator = j_kv_iterator_new_range("namespace", "a", "b", 10, TRUE);
+ * \endcode
+ *
+ * \param namespace JKV namespace to iterate over.
+ * \param start First key to return (inclusive). Set to NULL for no lower bound.
+ * \param end Key to stop at (exclusive). Set to NULL for no upper bound.
+ * \param limit Maximum number of KVs to return. Set to 0 for no limit.
+ * \param reverse Whether to return the KVs in descending order.
+ *
+ * \return A new JKVIterator.
+ **/
+JKVIterator* j_kv_iterator_new_range(gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse);
+
 /**
  * Frees the memory allocated by the JKVIterator.
  *
@@ -138,6 +138,19 @@ void j_kv_put(JKV* kv, gpointer value, guint32 value_len, GDestroyNotify value_d
  **/
 void j_kv_delete(JKV* kv, JBatch* batch);
 
+/**
+ * Deletes all key-value pairs of a namespace whose keys start with a prefix.
+ * The deletion is executed by the servers, the key-value pairs do not have to be listed by the client.
+ *
+ * \code
+ * \endcode
+ *
+ * \param namespace  The namespace.
+ * \param prefix     A prefix or NULL to delete the whole namespace.
+ * \param batch      A batch.
+ **/
+void j_kv_delete_by_prefix(gchar const* namespace, gchar const* prefix, JBatch* batch);
+
 /**
  * Get a key-value pair.
  *
@@ -164,6 +177,78 @@ void j_kv_get(JKV* kv, gpointer* value, guint32* value_len, JBatch* batch);
  **/
 void j_kv_get_callback(JKV* kv, JKVGetFunc func, gpointer data, JBatch* batch);
 
+/**
+ * Get a key-value pair without copying its value.
+ * The values of all views received in one reply share a single buffer, which is freed once all views have been unreferenced.
+ *
+ * \code
+ * GBytes* value;
+ * gconstpointer data;
+ * gsize len;
+ *
+ * j_kv_get_view(kv, &value, batch);
+ * j_batch_execute(batch);
+ *
+ * data = g_bytes_get_data(value, &len);
+ * g_bytes_unref(value);
+ * \endcode
+ *
+ * \param kv    A key-value pair.
+ * \param value A pointer for the returned value, which has to be freed with g_bytes_unref().
+ * \param batch A batch.
+ **/
+void j_kv_get_view(JKV* kv, GBytes** value, JBatch* batch);
+
+/**
+ * Atomically replaces a key-value pair's value if it matches an expected value.
+ * The comparison is executed by the server, so no lock is needed to update a value that is shared by multiple clients.
+ *
+ * \code
+ * gboolean swapped;
+ *
+ * j_kv_compare_and_swap(kv, "running", 8, g_strdup("done"), 5, g_free, &swapped, batch);
+ * j_batch_execute(batch);
+ * \endcode
+ *
+ * \param kv            A key-value pair.
+ * \param expected      The expected value, which has to be valid until the batch has been executed. NULL if the key-value pair must not exist.
+ * \param expected_len  Length of the expected value.
+ * \param value         The new value.
+ * \param value_len     Length of the new value.
+ * \param value_destroy A function to correctly free the new value.
+ * \param swapped       A pointer to be set to whether the value has been replaced, or NULL.
+ * \param batch         A batch.
+ **/
+void j_kv_compare_and_swap(JKV* kv, gconstpointer expected, guint32 expected_len, gpointer value, guint32 value_len, GDestroyNotify value_destroy, gboolean* swapped, JBatch* batch);
+
+/**
+ * Atomically adds to a 64-bit counter.
+ * Counters are stored as little-endian values of 8 bytes, key-value pairs that do not exist are treated as 0.
+ *
+ * \code
+ * \endcode
+ *
+ * \param kv    A key-value pair.
+ * \param delta The value to add, which may be negative.
+ * \param batch A batch.
+ **/
+void j_kv_add(JKV* kv, gint64 delta, JBatch* batch);
+
+/**
+ * Atomically appends to a key-value pair's value.
+ * Key-value pairs that do not exist are created.
+ *
+ * \code
+ * \endcode
+ *
+ * \param kv            A key-value pair.
+ * \param value         The data to append.
+ * \param value_len     Length of the data.
+ * \param value_destroy A function to correctly free the data.
+ * \param batch         A batch.
+ **/
+void j_kv_append(JKV* kv, gpointer value, guint32 value_len, GDestroyNotify value_destroy, JBatch* batch);
+
 /**
  * @}
  **/
@@ -63,6 +63,25 @@ typedef struct JDistributedObject JDistributedObject;
  **/
 JDistributedObject* j_distributed_object_new(gchar const* namespace, gchar const* name, JDistribution* distribution);
 
+/**
+ * Creates a new object whose distribution is chosen based on its expected size and access pattern.
+ * See j_distribution_new_for_hint() for details.
+ *
+ * \code
+ * JDistributedObject* i;
+ *
+ * i = j_distributed_object_new_for_hint("JULEA", "JULEA", 4096, J_DISTRIBUTION_ACCESS_UNKNOWN);
+ * \endcode
+ *
+ * \param namespace A namespace.
+ * \param name      An object name.
+ * \param size      The expected size, 0 if unknown.
+ * \param access    The expected access pattern.
+ *
+ * \return A new object. Should be freed with j_distributed_object_unref().
+ **/
+JDistributedObject* j_distributed_object_new_for_hint(gchar const* namespace, gchar const* name, guint64 size, JDistributionAccess access);
+
 /**
  * Increases an object's reference count.
  *
@@ -148,6 +167,24 @@ void j_distributed_object_read(JDistributedObject* object, gpointer data, guint6
  **/
 void j_distributed_object_write(JDistributedObject* object, gconstpointer data, guint64 length, guint64 offset, guint64* bytes_written, JBatch* batch);
 
+/**
+ * Append data to an object.
+ *
+ * The offset is reserved atomically by the server storing the object's first block.
+ * Concurrent appends to the same object are serialized and never overlap.
+ *
+ * \code
+ * \endcode
+ *
+ * \param object        An object.
+ * \param data          A buffer holding the data to append.
+ * \param length        Number of bytes to append.
+ * \param offset        Returns the offset the data has been written to.
+ * \param bytes_written Number of bytes written.
+ * \param batch         A batch.
+ **/
+void j_distributed_object_append(JDistributedObject* object, gconstpointer data, guint64 length, guint64* offset, guint64* bytes_written, JBatch* batch);
+
 /**
  * Get the status of an object.
  *
@@ -172,6 +209,22 @@ void j_distributed_object_status(JDistributedObject* object, gint64* modificatio
  **/
 void j_distributed_object_sync(JDistributedObject* object, JBatch* batch);
 
+/**
+ * Copy an object.
+ *
+ * Both objects must use the same distribution, that is, the same type and parameters.
+ * Each server then copies its part of the object locally without involving the client.
+ *
+ * \code
+ * \endcode
+ *
+ * \param object       An object.
+ * \param destination  The destination object.
+ * \param bytes_copied Number of bytes copied.
+ * \param batch        A batch.
+ **/
+void j_distributed_object_copy(JDistributedObject* object, JDistributedObject* destination, guint64* bytes_copied, JBatch* batch);
+
 /**
  * @}
  **/
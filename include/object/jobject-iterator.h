@@ -64,6 +64,28 @@ JObjectIterator* j_object_iterator_new(gchar const* namespace, gchar const* pref
  **/
 JObjectIterator* j_object_iterator_new_for_index(guint32 index, gchar const* namespace, gchar const* prefix);
 
+/**
+ * Creates a new JObjectIterator that also returns the objects' modification time and size.
+ * The status is sent together with the names, so no additional requests are necessary.
+ *
+ * \param namespace The namespace to iterate over.
+ * \param prefix Prefix of names to iterate over. Set to NULL to iterate over all objects in the namespace.
+ *
+ * \return A new JObjectIterator.
+ **/
+JObjectIterator* j_object_iterator_new_with_status(gchar const* namespace, gchar const* prefix);
+
+/**
+ * Creates a new JObjectIterator on a specific object server that also returns the objects' modification time and size.
+ *
+ * \param index Server to query.
+ * \param namespace The namespace to iterate over.
+ * \param prefix Prefix of names to iterate over. Set to NULL to iterate over all objects in the namespace.
+ *
+ * \return A new JObjectIterator.
+ **/
+JObjectIterator* j_object_iterator_new_for_index_with_status(guint32 index, gchar const* namespace, gchar const* prefix);
+
 /**
  * Frees the memory allocated by the JObjectIterator.
  *
@@ -97,6 +119,21 @@ gboolean j_object_iterator_next(JObjectIterator* iterator);
  **/
 gchar const* j_object_iterator_get(JObjectIterator* iterator);
 
+/**
+ * Returns the current object's status.
+ * Only available for iterators created with j_object_iterator_new_with_status() or j_object_iterator_new_for_index_with_status().
+ *
+ * \code
+ * \endcode
+ *
+ * \param iterator          A store iterator.
+ * \param modification_time A pointer to the modification time, can be NULL.
+ * \param size              A pointer to the size, can be NULL.
+ *
+ * \return TRUE on success, FALSE if the iterator does not provide the status.
+ **/
+gboolean j_object_iterator_get_status(JObjectIterator* iterator, gint64* modification_time, guint64* size);
+
 /**
  * @}
  **/
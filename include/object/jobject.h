@@ -129,6 +129,23 @@ void j_object_create(JObject* object, JBatch* batch);
  **/
 void j_object_delete(JObject* object, JBatch* batch);
 
+/**
+ * Deletes all objects of a namespace whose names start with a prefix.
+ * The deletion is executed by the servers, the objects do not have to be listed by the client.
+ *
+ * \code
+ * JBatch* batch;
+ *
+ * j_object_delete_by_prefix("JULEA", "run-1/", batch);
+ * j_batch_execute(batch);
+ * \endcode
+ *
+ * \param namespace  The namespace.
+ * \param prefix     A prefix or NULL to delete the whole namespace.
+ * \param batch      A batch.
+ **/
+void j_object_delete_by_prefix(gchar const* namespace, gchar const* prefix, JBatch* batch);
+
 /**
  * Reads an object.
  *
@@ -162,6 +179,24 @@ void j_object_read(JObject* object, gpointer data, guint64 length, guint64 offse
  **/
 void j_object_write(JObject* object, gconstpointer data, guint64 length, guint64 offset, guint64* bytes_written, JBatch* batch);
 
+/**
+ * Append data to an object.
+ *
+ * In contrast to j_object_write(), the offset is chosen by the server.
+ * Concurrent appends to the same object are serialized and never overlap.
+ *
+ * \code
+ * \endcode
+ *
+ * \param object        An object.
+ * \param data          A buffer holding the data to append.
+ * \param length        Number of bytes to append. Must not exceed the maximum operation size.
+ * \param offset        Returns the offset the data has been written to.
+ * \param bytes_written Number of bytes written.
+ * \param batch         A batch.
+ **/
+void j_object_append(JObject* object, gconstpointer data, guint64 length, guint64* offset, guint64* bytes_written, JBatch* batch);
+
 /**
  * Get the status of an object.
  *
@@ -186,6 +221,24 @@ void j_object_status(JObject* object, gint64* modification_time, guint64* size,
  **/
 void j_object_sync(JObject* object, JBatch* batch);
 
+/**
+ * Copy an object.
+ *
+ * The copy is performed by the server storing the source object.
+ * If both objects reside on the same server, the data does not leave it.
+ * Otherwise, the source server streams the data directly to the destination server.
+ * The destination object is created if it does not exist.
+ *
+ * \code
+ * \endcode
+ *
+ * \param object       An object.
+ * \param destination  The destination object.
+ * \param bytes_copied Number of bytes copied.
+ * \param batch        A batch.
+ **/
+void j_object_copy(JObject* object, JObject* destination, guint64* bytes_copied, JBatch* batch);
+
 /**
  * @}
  **/
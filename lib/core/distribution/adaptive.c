@@ -0,0 +1,578 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ **/
+
+#include <julea-config.h>
+
+#include <glib.h>
+
+#include <bson.h>
+
+#include <jbackend.h>
+#include <jconfiguration.h>
+#include <jconnection-pool.h>
+#include <jmessage.h>
+#include <jtrace.h>
+
+#include "distribution.h"
+
+/**
+ * \addtogroup JDistribution
+ *
+ * @{
+ **/
+
+/**
+ * The maximum weight of a server.
+ * The weights' sum determines the length of a round, so it should be kept small.
+ **/
+#define J_DISTRIBUTION_ADAPTIVE_MAX_WEIGHT 16
+
+/**
+ * How long the servers' metrics are cached, in microseconds.
+ **/
+#define J_DISTRIBUTION_ADAPTIVE_INTERVAL G_USEC_PER_SEC
+
+/**
+ * A distribution.
+ **/
+struct JDistributionAdaptive
+{
+	/**
+	 * The server count.
+	 **/
+	guint server_count;
+
+	/**
+	 * The weighted distribution that is used once the weights have been determined.
+	 **/
+	gpointer weighted;
+
+	/**
+	 * Whether the weights have been determined.
+	 **/
+	gsize initialized;
+};
+
+typedef struct JDistributionAdaptive JDistributionAdaptive;
+
+/**
+ * A server's metrics.
+ **/
+struct JDistributionAdaptiveMetrics
+{
+	/**
+	 * The free capacity in bytes.
+	 **/
+	guint64 capacity_free;
+
+	/**
+	 * The total capacity in bytes, 0 if unknown.
+	 **/
+	guint64 capacity_total;
+
+	/**
+	 * The number of bytes written since the server was started.
+	 **/
+	guint64 bytes_written;
+
+	/**
+	 * The number of operations currently being handled.
+	 **/
+	guint64 operations;
+
+	/**
+	 * The number of bytes written per second since the last update.
+	 **/
+	gdouble write_rate;
+
+	/**
+	 * The time of the last update, 0 if the server has not been queried successfully yet.
+	 **/
+	gint64 time;
+};
+
+typedef struct JDistributionAdaptiveMetrics JDistributionAdaptiveMetrics;
+
+static JDistributionVTable j_distribution_adaptive_weighted_vtable;
+
+// The metrics are shared by all adaptive distributions, so that creating many objects does not query the servers every time.
+static GMutex j_distribution_adaptive_mutex;
+static JDistributionAdaptiveMetrics* j_distribution_adaptive_metrics = NULL;
+static guint j_distribution_adaptive_metrics_len = 0;
+static gint64 j_distribution_adaptive_metrics_time = 0;
+static gboolean j_distribution_adaptive_metrics_updating = FALSE;
+
+/**
+ * Queries a server's metrics.
+ *
+ * \private
+ *
+ * \param index   The server's index.
+ * \param metrics The metrics, only the values reported by the server are set.
+ *
+ * \return TRUE if the server replied, FALSE otherwise.
+ **/
+static gboolean
+j_distribution_adaptive_query_metrics(guint index, JDistributionAdaptiveMetrics* metrics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autoptr(JMessage) message = NULL;
+	g_autoptr(JMessage) reply = NULL;
+	gpointer connection;
+	gchar get_all = 0;
+	gboolean ret;
+
+	connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, index);
+
+	if (connection == NULL)
+	{
+		return FALSE;
+	}
+
+	message = j_message_new(J_MESSAGE_STATISTICS, sizeof(gchar));
+	j_message_add_operation(message, 0);
+	j_message_append_1(message, &get_all);
+
+	reply = j_message_new_reply(message);
+
+	ret = j_message_send(message, connection) && j_message_receive(reply, connection);
+
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, index, connection);
+
+	if (!ret || j_message_get_count(reply) < 1)
+	{
+		return FALSE;
+	}
+
+	// The first operation contains the statistics.
+	for (guint j = 0; j < 8; j++)
+	{
+		j_message_get_8(reply);
+	}
+
+	// Older servers do not report their load.
+	if (j_message_get_count(reply) < 2)
+	{
+		metrics->capacity_free = 0;
+		metrics->capacity_total = 0;
+		metrics->bytes_written = 0;
+		metrics->operations = 0;
+
+		return TRUE;
+	}
+
+	metrics->capacity_free = j_message_get_8(reply);
+	metrics->capacity_total = j_message_get_8(reply);
+	metrics->bytes_written = j_message_get_8(reply);
+	metrics->operations = j_message_get_8(reply);
+
+	return TRUE;
+}
+
+/**
+ * Queries the servers' metrics.
+ *
+ * \private
+ *
+ * The mutex must not be held, the servers are queried without it so that other distributions do not have to wait.
+ * Servers that can not be queried keep their previous metrics.
+ *
+ * \param server_count The server count.
+ * \param now          The current time.
+ **/
+static void
+j_distribution_adaptive_update_metrics(guint server_count, gint64 now)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autofree JDistributionAdaptiveMetrics* samples = NULL;
+	g_autofree gboolean* valid = NULL;
+
+	samples = g_new0(JDistributionAdaptiveMetrics, server_count);
+	valid = g_new0(gboolean, server_count);
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		valid[i] = j_distribution_adaptive_query_metrics(i, &(samples[i]));
+	}
+
+	g_mutex_lock(&j_distribution_adaptive_mutex);
+
+	// The metrics might have been reset for a different server count in the meantime.
+	if (j_distribution_adaptive_metrics_len == server_count)
+	{
+		for (guint i = 0; i < server_count; i++)
+		{
+			JDistributionAdaptiveMetrics* metrics = &(j_distribution_adaptive_metrics[i]);
+			gdouble elapsed;
+
+			if (!valid[i])
+			{
+				continue;
+			}
+
+			elapsed = (gdouble)(now - metrics->time) / G_USEC_PER_SEC;
+
+			if (metrics->time > 0 && elapsed > 0.0 && samples[i].bytes_written >= metrics->bytes_written)
+			{
+				metrics->write_rate = (gdouble)(samples[i].bytes_written - metrics->bytes_written) / elapsed;
+			}
+			else
+			{
+				metrics->write_rate = 0.0;
+			}
+
+			metrics->capacity_free = samples[i].capacity_free;
+			metrics->capacity_total = samples[i].capacity_total;
+			metrics->bytes_written = samples[i].bytes_written;
+			metrics->operations = samples[i].operations;
+			metrics->time = now;
+		}
+
+		j_distribution_adaptive_metrics_time = now;
+	}
+
+	j_distribution_adaptive_metrics_updating = FALSE;
+
+	g_mutex_unlock(&j_distribution_adaptive_mutex);
+}
+
+/**
+ * Derives the servers' weights from their metrics.
+ *
+ * \private
+ *
+ * A server's weight is proportional to its free capacity.
+ * It is reduced for servers with many outstanding operations and for servers that have recently received many writes.
+ * If the metrics are not available, all servers get the same weight.
+ *
+ * \param server_count The server count.
+ * \param weights      An array of \p server_count weights.
+ **/
+static void
+j_distribution_adaptive_get_weights(guint server_count, guint* weights)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JConfiguration* configuration = j_configuration();
+	g_autofree gdouble* scores = NULL;
+	gboolean capacity_known = TRUE;
+	gdouble max_rate = 0.0;
+	gdouble max_score = 0.0;
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		weights[i] = 1;
+	}
+
+	// The metrics can only be queried for the servers of the global configuration and not for client-side backends.
+	if (server_count != j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT)
+	    || g_strcmp0(j_configuration_get_backend_component(configuration, J_BACKEND_TYPE_OBJECT), "client") == 0)
+	{
+		return;
+	}
+
+	scores = g_new(gdouble, server_count);
+
+	g_mutex_lock(&j_distribution_adaptive_mutex);
+
+	if (j_distribution_adaptive_metrics_len != server_count)
+	{
+		g_free(j_distribution_adaptive_metrics);
+
+		j_distribution_adaptive_metrics = g_new0(JDistributionAdaptiveMetrics, server_count);
+		j_distribution_adaptive_metrics_len = server_count;
+		j_distribution_adaptive_metrics_time = 0;
+	}
+
+	{
+		gint64 now;
+
+		now = g_get_monotonic_time();
+
+		// Only one thread updates the metrics, all others use the previous ones in the meantime.
+		if (!j_distribution_adaptive_metrics_updating && (j_distribution_adaptive_metrics_time == 0 || now - j_distribution_adaptive_metrics_time >= J_DISTRIBUTION_ADAPTIVE_INTERVAL))
+		{
+			j_distribution_adaptive_metrics_updating = TRUE;
+
+			g_mutex_unlock(&j_distribution_adaptive_mutex);
+			j_distribution_adaptive_update_metrics(server_count, now);
+			g_mutex_lock(&j_distribution_adaptive_mutex);
+		}
+	}
+
+	// The metrics might have been reset for a different server count while the mutex was not held.
+	if (j_distribution_adaptive_metrics_len != server_count)
+	{
+		g_mutex_unlock(&j_distribution_adaptive_mutex);
+		return;
+	}
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		capacity_known = capacity_known && j_distribution_adaptive_metrics[i].capacity_total > 0;
+		max_rate = MAX(max_rate, j_distribution_adaptive_metrics[i].write_rate);
+	}
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		JDistributionAdaptiveMetrics const* metrics = &(j_distribution_adaptive_metrics[i]);
+
+		scores[i] = (capacity_known) ? (gdouble)metrics->capacity_free : 1.0;
+		scores[i] /= 1.0 + metrics->operations;
+
+		if (max_rate > 0.0)
+		{
+			scores[i] /= 1.0 + (metrics->write_rate / max_rate);
+		}
+
+		max_score = MAX(max_score, scores[i]);
+	}
+
+	g_mutex_unlock(&j_distribution_adaptive_mutex);
+
+	// All servers are full, keep the equal weights.
+	if (max_score <= 0.0)
+	{
+		return;
+	}
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		weights[i] = (scores[i] * J_DISTRIBUTION_ADAPTIVE_MAX_WEIGHT / max_score) + 0.5;
+
+		// Full servers do not get any data, all others get at least some.
+		if (scores[i] > 0.0 && weights[i] == 0)
+		{
+			weights[i] = 1;
+		}
+	}
+}
+
+/**
+ * Determines the weights if they have not been set or deserialized.
+ *
+ * \private
+ *
+ * \param distribution A distribution.
+ **/
+static void
+distribution_initialize(JDistributionAdaptive* distribution)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	if (g_once_init_enter(&(distribution->initialized)))
+	{
+		g_autofree guint* weights = NULL;
+
+		weights = g_new(guint, distribution->server_count);
+		j_distribution_adaptive_get_weights(distribution->server_count, weights);
+
+		for (guint i = 0; i < distribution->server_count; i++)
+		{
+			// All weights start at 0, setting them to 0 again would fail for the first server.
+			if (weights[i] > 0)
+			{
+				j_distribution_adaptive_weighted_vtable.distribution_set2(distribution->weighted, "weight", i, weights[i]);
+			}
+		}
+
+		g_once_init_leave(&(distribution->initialized), 1);
+	}
+}
+
+static gboolean
+distribution_distribute(gpointer data, guint* index, guint64* new_length, guint64* new_offset, guint64* block_id)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	distribution_initialize(distribution);
+
+	return j_distribution_adaptive_weighted_vtable.distribution_distribute(distribution->weighted, index, new_length, new_offset, block_id);
+}
+
+static guint
+distribution_distribute_range(gpointer data, guint64 length, guint64 offset, GArray* chunks)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	distribution_initialize(distribution);
+
+	return j_distribution_adaptive_weighted_vtable.distribution_distribute_range(distribution->weighted, length, offset, chunks);
+}
+
+static gpointer
+distribution_new(guint server_count, guint64 stripe_size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution;
+
+	distribution = g_slice_new(JDistributionAdaptive);
+	distribution->server_count = server_count;
+	distribution->weighted = j_distribution_adaptive_weighted_vtable.distribution_new(server_count, stripe_size);
+	distribution->initialized = 0;
+
+	return distribution;
+}
+
+static void
+distribution_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	j_distribution_adaptive_weighted_vtable.distribution_free(distribution->weighted);
+
+	g_slice_free(JDistributionAdaptive, distribution);
+}
+
+static void
+distribution_set(gpointer data, gchar const* key, guint64 value)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	j_distribution_adaptive_weighted_vtable.distribution_set(distribution->weighted, key, value);
+}
+
+/**
+ * Sets a server's weight explicitly.
+ * Afterwards, the weights are not derived from the servers' metrics anymore.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param data   A distribution.
+ * \param key    A key.
+ * \param value1 A server index.
+ * \param value2 A weight.
+ **/
+static void
+distribution_set2(gpointer data, gchar const* key, guint64 value1, guint64 value2)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	if (g_strcmp0(key, "weight") == 0 && g_once_init_enter(&(distribution->initialized)))
+	{
+		g_once_init_leave(&(distribution->initialized), 1);
+	}
+
+	j_distribution_adaptive_weighted_vtable.distribution_set2(distribution->weighted, key, value1, value2);
+}
+
+/**
+ * Serializes distribution.
+ * The weights are stored, so that the object's data can be found even if the servers' metrics change.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param data A distribution.
+ * \param b    A BSON object.
+ **/
+static void
+distribution_serialize(gpointer data, bson_t* b)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	distribution_initialize(distribution);
+
+	j_distribution_adaptive_weighted_vtable.distribution_serialize(distribution->weighted, b);
+}
+
+static void
+distribution_deserialize(gpointer data, bson_t const* b)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+	g_return_if_fail(b != NULL);
+
+	j_distribution_adaptive_weighted_vtable.distribution_deserialize(distribution->weighted, b);
+
+	if (g_once_init_enter(&(distribution->initialized)))
+	{
+		g_once_init_leave(&(distribution->initialized), 1);
+	}
+}
+
+static void
+distribution_reset(gpointer data, guint64 length, guint64 offset)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionAdaptive* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	j_distribution_adaptive_weighted_vtable.distribution_reset(distribution->weighted, length, offset);
+}
+
+void
+j_distribution_adaptive_get_vtable(JDistributionVTable* vtable)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	j_distribution_weighted_get_vtable(&j_distribution_adaptive_weighted_vtable);
+
+	vtable->distribution_new = distribution_new;
+	vtable->distribution_free = distribution_free;
+	vtable->distribution_set = distribution_set;
+	vtable->distribution_set2 = distribution_set2;
+	vtable->distribution_serialize = distribution_serialize;
+	vtable->distribution_deserialize = distribution_deserialize;
+	vtable->distribution_reset = distribution_reset;
+	vtable->distribution_distribute = distribution_distribute;
+	vtable->distribution_distribute_range = distribution_distribute_range;
+	vtable->distribution_get_erasure = NULL;
+	vtable->distribution_get_group_index = NULL;
+}
+
+/**
+ * @}
+ **/
@@ -46,10 +46,30 @@ struct JDistributionVTable
 
 	void (*distribution_reset)(gpointer, guint64, guint64);
 	gboolean (*distribution_distribute)(gpointer, guint*, guint64*, guint64*, guint64*);
+
+	/**
+	 * Distributes a whole range into an array of #JDistributionChunk elements.
+	 * This is optional, the generic implementation resets the distribution and calls distribution_distribute repeatedly.
+	 */
+	guint (*distribution_distribute_range)(gpointer, guint64, guint64, GArray*);
+
+	/**
+	 * Returns the erasure coding parameters.
+	 * This is optional and only implemented by distributions that store parity blocks.
+	 */
+	gboolean (*distribution_get_erasure)(gpointer, guint32*, guint32*, guint64*);
+
+	/**
+	 * Returns the server storing a block of a group, data blocks come first, followed by parity blocks.
+	 * This is required if distribution_get_erasure is implemented.
+	 */
+	guint32 (*distribution_get_group_index)(gpointer, guint64, guint32);
 };
 
 typedef struct JDistributionVTable JDistributionVTable;
 
+void j_distribution_adaptive_get_vtable(JDistributionVTable*);
+void j_distribution_erasure_get_vtable(JDistributionVTable*);
 void j_distribution_round_robin_get_vtable(JDistributionVTable*);
 void j_distribution_single_server_get_vtable(JDistributionVTable*);
 void j_distribution_weighted_get_vtable(JDistributionVTable*);
@@ -0,0 +1,370 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ **/
+
+#include <julea-config.h>
+
+#include <glib.h>
+
+#include <bson.h>
+
+#include <jconfiguration.h>
+#include <jtrace.h>
+
+#include "distribution.h"
+
+/**
+ * \addtogroup JDistribution
+ *
+ * @{
+ **/
+
+/**
+ * A distribution.
+ *
+ * The blocks are split into groups of data_blocks blocks, which are protected by parity_blocks parity blocks.
+ * The blocks of a group are stored on consecutive servers, each server stores at most one block per group.
+ * Consecutive groups start on consecutive servers, so that the parity blocks are spread across all servers.
+ **/
+struct JDistributionErasure
+{
+	/**
+	 * The server count.
+	 **/
+	guint server_count;
+
+	/**
+	 * The length.
+	 **/
+	guint64 length;
+
+	/**
+	 * The offset.
+	 **/
+	guint64 offset;
+
+	/**
+	 * The block size.
+	 */
+	guint64 block_size;
+
+	/**
+	 * The number of data blocks per group.
+	 */
+	guint32 data_blocks;
+
+	/**
+	 * The number of parity blocks per group.
+	 */
+	guint32 parity_blocks;
+
+	guint start_index;
+};
+
+typedef struct JDistributionErasure JDistributionErasure;
+
+/**
+ * Distributes data blocks to the servers of their groups.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution A distribution.
+ * \param index        A server index.
+ * \param new_length   A new length.
+ * \param new_offset   A new offset.
+ *
+ * \return TRUE on success, FALSE if the distribution is finished.
+ **/
+static gboolean
+distribution_distribute(gpointer data, guint* index, guint64* new_length, guint64* new_offset, guint64* block_id)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	guint64 block;
+	guint64 displacement;
+	guint64 group;
+
+	if (distribution->length == 0)
+	{
+		return FALSE;
+	}
+
+	block = distribution->offset / distribution->block_size;
+	group = block / distribution->data_blocks;
+	displacement = distribution->offset % distribution->block_size;
+
+	*index = (distribution->start_index + group + (block % distribution->data_blocks)) % distribution->server_count;
+	*new_length = MIN(distribution->length, distribution->block_size - displacement);
+	*new_offset = (group * distribution->block_size) + displacement;
+	*block_id = block;
+
+	distribution->length -= *new_length;
+	distribution->offset += *new_length;
+
+	return TRUE;
+}
+
+static gpointer
+distribution_new(guint server_count, guint64 stripe_size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution;
+
+	distribution = g_slice_new(JDistributionErasure);
+	distribution->server_count = server_count;
+	distribution->length = 0;
+	distribution->offset = 0;
+	distribution->block_size = stripe_size;
+
+	// By default, one server may fail.
+	distribution->parity_blocks = (server_count > 1) ? 1 : 0;
+	distribution->data_blocks = server_count - distribution->parity_blocks;
+
+	distribution->start_index = g_random_int_range(0, distribution->server_count);
+
+	return distribution;
+}
+
+/**
+ * Decreases a distribution's reference count.
+ * When the reference count reaches zero, frees the memory allocated for the distribution.
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution A distribution.
+ **/
+static void
+distribution_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	g_slice_free(JDistributionErasure, distribution);
+}
+
+/**
+ * Sets a property of the erasure distribution.
+ * Setting the number of parity blocks reduces the number of data blocks if necessary, so it should be set first.
+ *
+ * \code
+ * \endcode
+ *
+ * \param data  A distribution.
+ * \param key   The property to change (block-size, start-index, data or parity).
+ * \param value The value to be set for the property.
+ */
+static void
+distribution_set(gpointer data, gchar const* key, guint64 value)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	if (g_strcmp0(key, "block-size") == 0)
+	{
+		distribution->block_size = value;
+	}
+	else if (g_strcmp0(key, "start-index") == 0)
+	{
+		g_return_if_fail(value < distribution->server_count);
+
+		distribution->start_index = value;
+	}
+	else if (g_strcmp0(key, "data") == 0)
+	{
+		g_return_if_fail(value > 0 && value + distribution->parity_blocks <= distribution->server_count);
+
+		distribution->data_blocks = value;
+	}
+	else if (g_strcmp0(key, "parity") == 0)
+	{
+		g_return_if_fail(value < distribution->server_count);
+
+		distribution->parity_blocks = value;
+		distribution->data_blocks = MIN(distribution->data_blocks, distribution->server_count - value);
+	}
+}
+
+/**
+ * Serializes distribution.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution Credentials.
+ *
+ * \return A new BSON object. Should be freed with g_slice_free().
+ **/
+static void
+distribution_serialize(gpointer data, bson_t* b)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	bson_append_int64(b, "block_size", -1, distribution->block_size);
+	bson_append_int32(b, "start_index", -1, distribution->start_index);
+	bson_append_int32(b, "data_blocks", -1, distribution->data_blocks);
+	bson_append_int32(b, "parity_blocks", -1, distribution->parity_blocks);
+}
+
+/**
+ * Deserializes distribution.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param distribution distribution.
+ * \param b           A BSON object.
+ **/
+static void
+distribution_deserialize(gpointer data, bson_t const* b)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	bson_iter_t iterator;
+
+	g_return_if_fail(distribution != NULL);
+	g_return_if_fail(b != NULL);
+
+	bson_iter_init(&iterator, b);
+
+	while (bson_iter_next(&iterator))
+	{
+		gchar const* key;
+
+		key = bson_iter_key(&iterator);
+
+		if (g_strcmp0(key, "block_size") == 0)
+		{
+			distribution->block_size = bson_iter_int64(&iterator);
+		}
+		else if (g_strcmp0(key, "start_index") == 0)
+		{
+			distribution->start_index = bson_iter_int32(&iterator);
+		}
+		else if (g_strcmp0(key, "data_blocks") == 0)
+		{
+			distribution->data_blocks = bson_iter_int32(&iterator);
+		}
+		else if (g_strcmp0(key, "parity_blocks") == 0)
+		{
+			distribution->parity_blocks = bson_iter_int32(&iterator);
+		}
+	}
+}
+
+/**
+ * Initializes a distribution.
+ *
+ * \code
+ * JDistribution* d;
+ *
+ * j_distribution_init(d, 0, 0);
+ * \endcode
+ *
+ * \param length A length.
+ * \param offset An offset.
+ *
+ * \return A new distribution. Should be freed with j_distribution_unref().
+ **/
+static void
+distribution_reset(gpointer data, guint64 length, guint64 offset)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	g_return_if_fail(distribution != NULL);
+
+	distribution->length = length;
+	distribution->offset = offset;
+}
+
+static gboolean
+distribution_get_erasure(gpointer data, guint32* data_blocks, guint32* parity_blocks, guint64* block_size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	g_return_val_if_fail(distribution != NULL, FALSE);
+
+	*data_blocks = distribution->data_blocks;
+	*parity_blocks = distribution->parity_blocks;
+	*block_size = distribution->block_size;
+
+	return TRUE;
+}
+
+static guint32
+distribution_get_group_index(gpointer data, guint64 group, guint32 position)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionErasure* distribution = data;
+
+	g_return_val_if_fail(distribution != NULL, 0);
+
+	return (distribution->start_index + group + position) % distribution->server_count;
+}
+
+void
+j_distribution_erasure_get_vtable(JDistributionVTable* vtable)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	vtable->distribution_new = distribution_new;
+	vtable->distribution_free = distribution_free;
+	vtable->distribution_set = distribution_set;
+	vtable->distribution_set2 = NULL;
+	vtable->distribution_serialize = distribution_serialize;
+	vtable->distribution_deserialize = distribution_deserialize;
+	vtable->distribution_reset = distribution_reset;
+	vtable->distribution_distribute = distribution_distribute;
+	vtable->distribution_distribute_range = NULL;
+	vtable->distribution_get_erasure = distribution_get_erasure;
+	vtable->distribution_get_group_index = distribution_get_group_index;
+}
+
+/**
+ * @}
+ **/
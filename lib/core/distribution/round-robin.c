@@ -62,6 +62,11 @@ struct JDistributionRoundRobin
 	 */
 	guint64 block_size;
 
+	/**
+	 * The number of servers the blocks are spread across, starting at the start index.
+	 */
+	guint stripe_count;
+
 	guint start_index;
 };
 
@@ -99,10 +104,10 @@ distribution_distribute(gpointer data, guint* index, guint64* new_length, guint6
 	}
 
 	block = distribution->offset / distribution->block_size;
-	round = block / distribution->server_count;
+	round = block / distribution->stripe_count;
 	displacement = distribution->offset % distribution->block_size;
 
-	*index = (distribution->start_index + block) % distribution->server_count;
+	*index = (distribution->start_index + (block % distribution->stripe_count)) % distribution->server_count;
 	*new_length = MIN(distribution->length, distribution->block_size - displacement);
 	*new_offset = (round * distribution->block_size) + displacement;
 	*block_id = block;
@@ -113,6 +118,77 @@ distribution_distribute(gpointer data, guint* index, guint64* new_length, guint6
 	return TRUE;
 }
 
+/**
+ * Distributes a whole range in a round robin fashion.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param data   A distribution.
+ * \param length A length.
+ * \param offset An offset.
+ * \param chunks An array of #JDistributionChunk elements.
+ *
+ * \return The number of chunks appended.
+ **/
+static guint
+distribution_distribute_range(gpointer data, guint64 length, guint64 offset, GArray* chunks)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionRoundRobin* distribution = data;
+
+	JDistributionChunk* chunk;
+	guint64 block;
+	guint64 count;
+	guint64 displacement;
+	guint64 range_offset = 0;
+	guint64 round;
+	guint first;
+	guint position;
+
+	if (length == 0)
+	{
+		return 0;
+	}
+
+	block = offset / distribution->block_size;
+	round = block / distribution->stripe_count;
+	displacement = offset % distribution->block_size;
+	position = block % distribution->stripe_count;
+	count = ((offset + length - 1) / distribution->block_size) - block + 1;
+
+	first = chunks->len;
+	g_array_set_size(chunks, first + count);
+	chunk = &g_array_index(chunks, JDistributionChunk, first);
+
+	// Only the first chunk can start within a block, so everything else can be derived incrementally.
+	for (guint64 i = 0; i < count; i++, chunk++)
+	{
+		chunk->index = (distribution->start_index + position) % distribution->server_count;
+		chunk->length = MIN(length, distribution->block_size - displacement);
+		chunk->offset = (round * distribution->block_size) + displacement;
+		chunk->block_id = block;
+		chunk->range_offset = range_offset;
+
+		length -= chunk->length;
+		range_offset += chunk->length;
+		displacement = 0;
+		block++;
+		position++;
+
+		if (position == distribution->stripe_count)
+		{
+			position = 0;
+			round++;
+		}
+	}
+
+	return count;
+}
+
 static gpointer
 distribution_new(guint server_count, guint64 stripe_size)
 {
@@ -125,6 +201,7 @@ distribution_new(guint server_count, guint64 stripe_size)
 	distribution->length = 0;
 	distribution->offset = 0;
 	distribution->block_size = stripe_size;
+	distribution->stripe_count = server_count;
 
 	distribution->start_index = g_random_int_range(0, distribution->server_count);
 
@@ -159,7 +236,7 @@ distribution_free(gpointer data)
  * \endcode
  *
  * \param data  A distribution.
- * \param key   The property to change (e.g. block-size or start-index).
+ * \param key   The property to change (e.g. block-size, start-index or stripe-count).
  * \param value The value to be set for the property.
  */
 static void
@@ -181,6 +258,12 @@ distribution_set(gpointer data, gchar const* key, guint64 value)
 
 		distribution->start_index = value;
 	}
+	else if (g_strcmp0(key, "stripe-count") == 0)
+	{
+		g_return_if_fail(value > 0 && value <= distribution->server_count);
+
+		distribution->stripe_count = value;
+	}
 }
 
 /**
@@ -206,6 +289,12 @@ distribution_serialize(gpointer data, bson_t* b)
 
 	bson_append_int64(b, "block_size", -1, distribution->block_size);
 	bson_append_int32(b, "start_index", -1, distribution->start_index);
+
+	// Distributions spanning all servers are serialized as before.
+	if (distribution->stripe_count < distribution->server_count)
+	{
+		bson_append_int32(b, "stripe_count", -1, distribution->stripe_count);
+	}
 }
 
 /**
@@ -247,6 +336,10 @@ distribution_deserialize(gpointer data, bson_t const* b)
 		{
 			distribution->start_index = bson_iter_int32(&iterator);
 		}
+		else if (g_strcmp0(key, "stripe_count") == 0)
+		{
+			distribution->stripe_count = MIN((guint)bson_iter_int32(&iterator), distribution->server_count);
+		}
 	}
 }
 
@@ -290,6 +383,9 @@ j_distribution_round_robin_get_vtable(JDistributionVTable* vtable)
 	vtable->distribution_deserialize = distribution_deserialize;
 	vtable->distribution_reset = distribution_reset;
 	vtable->distribution_distribute = distribution_distribute;
+	vtable->distribution_distribute_range = distribution_distribute_range;
+	vtable->distribution_get_erasure = NULL;
+	vtable->distribution_get_group_index = NULL;
 }
 
 /**
@@ -111,6 +111,63 @@ distribution_distribute(gpointer data, guint* index, guint64* new_length, guint6
 	return TRUE;
 }
 
+/**
+ * Distributes a whole range to a single server.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param data   A distribution.
+ * \param length A length.
+ * \param offset An offset.
+ * \param chunks An array of #JDistributionChunk elements.
+ *
+ * \return The number of chunks appended.
+ **/
+static guint
+distribution_distribute_range(gpointer data, guint64 length, guint64 offset, GArray* chunks)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionSingleServer* distribution = data;
+
+	JDistributionChunk* chunk;
+	guint64 block;
+	guint64 count;
+	guint64 range_offset = 0;
+	guint first;
+
+	if (length == 0)
+	{
+		return 0;
+	}
+
+	block = offset / distribution->block_size;
+	count = ((offset + length - 1) / distribution->block_size) - block + 1;
+
+	first = chunks->len;
+	g_array_set_size(chunks, first + count);
+	chunk = &g_array_index(chunks, JDistributionChunk, first);
+
+	for (guint64 i = 0; i < count; i++, chunk++)
+	{
+		chunk->index = distribution->index;
+		chunk->length = MIN(length, distribution->block_size - (offset % distribution->block_size));
+		chunk->offset = offset;
+		chunk->block_id = block;
+		chunk->range_offset = range_offset;
+
+		length -= chunk->length;
+		offset += chunk->length;
+		range_offset += chunk->length;
+		block++;
+	}
+
+	return count;
+}
+
 static gpointer
 distribution_new(guint server_count, guint64 stripe_size)
 {
@@ -287,6 +344,9 @@ j_distribution_single_server_get_vtable(JDistributionVTable* vtable)
 	vtable->distribution_deserialize = distribution_deserialize;
 	vtable->distribution_reset = distribution_reset;
 	vtable->distribution_distribute = distribution_distribute;
+	vtable->distribution_distribute_range = distribution_distribute_range;
+	vtable->distribution_get_erasure = NULL;
+	vtable->distribution_get_group_index = NULL;
 }
 
 /**
@@ -130,6 +130,97 @@ distribution_distribute(gpointer data, guint* index, guint64* new_length, guint6
 	return TRUE;
 }
 
+/**
+ * Distributes a whole range to a weighted list of servers.
+ *
+ * \private
+ *
+ * \code
+ * \endcode
+ *
+ * \param data   A distribution.
+ * \param length A length.
+ * \param offset An offset.
+ * \param chunks An array of #JDistributionChunk elements.
+ *
+ * \return The number of chunks appended.
+ **/
+static guint
+distribution_distribute_range(gpointer data, guint64 length, guint64 offset, GArray* chunks)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionWeighted* distribution = data;
+
+	JDistributionChunk* chunk;
+	guint64 block;
+	guint64 count;
+	guint64 displacement;
+	guint64 range_offset = 0;
+	guint64 round;
+	guint block_offset;
+	guint first;
+	guint index = 0;
+
+	if (length == 0)
+	{
+		return 0;
+	}
+
+	block = offset / distribution->block_size;
+	round = block / distribution->sum;
+	displacement = offset % distribution->block_size;
+	count = ((offset + length - 1) / distribution->block_size) - block + 1;
+
+	// Determine the server of the first block, afterwards the servers can be advanced incrementally.
+	block_offset = block % distribution->sum;
+
+	for (guint i = 0; i < distribution->server_count; i++)
+	{
+		if (block_offset < distribution->weights[i])
+		{
+			index = i;
+			break;
+		}
+
+		block_offset -= distribution->weights[i];
+	}
+
+	first = chunks->len;
+	g_array_set_size(chunks, first + count);
+	chunk = &g_array_index(chunks, JDistributionChunk, first);
+
+	for (guint64 i = 0; i < count; i++, chunk++)
+	{
+		chunk->index = index;
+		chunk->length = MIN(length, distribution->block_size - displacement);
+		chunk->offset = (((round * distribution->weights[index]) + block_offset) * distribution->block_size) + displacement;
+		chunk->block_id = block;
+		chunk->range_offset = range_offset;
+
+		length -= chunk->length;
+		range_offset += chunk->length;
+		displacement = 0;
+		block++;
+		block_offset++;
+
+		// Skip to the next server with a non-zero weight, starting a new round after the last one.
+		while (block_offset >= distribution->weights[index])
+		{
+			block_offset = 0;
+			index++;
+
+			if (index == distribution->server_count)
+			{
+				index = 0;
+				round++;
+			}
+		}
+	}
+
+	return count;
+}
+
 static gpointer
 distribution_new(guint server_count, guint64 stripe_size)
 {
@@ -350,6 +441,9 @@ j_distribution_weighted_get_vtable(JDistributionVTable* vtable)
 	vtable->distribution_deserialize = distribution_deserialize;
 	vtable->distribution_reset = distribution_reset;
 	vtable->distribution_distribute = distribution_distribute;
+	vtable->distribution_distribute_range = distribution_distribute_range;
+	vtable->distribution_get_erasure = NULL;
+	vtable->distribution_get_group_index = NULL;
 }
 
 /**
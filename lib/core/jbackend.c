@@ -25,6 +25,8 @@
 #include <glib.h>
 #include <gmodule.h>
 
+#include <string.h>
+
 #include <jbackend.h>
 
 #include <jtrace.h>
@@ -172,7 +174,10 @@ j_backend_load(gchar const* name, JBackendComponent component, JBackendType type
 		    || tmp_backend->object.backend_write == NULL
 		    || tmp_backend->object.backend_get_all == NULL
 		    || tmp_backend->object.backend_get_by_prefix == NULL
-		    || tmp_backend->object.backend_iterate == NULL)
+		    || tmp_backend->object.backend_iterate == NULL
+		    || (tmp_backend->object.backend_submit != NULL && tmp_backend->object.backend_complete == NULL)
+		    || (tmp_backend->object.backend_map != NULL && tmp_backend->object.backend_unmap == NULL)
+		    || (tmp_backend->object.backend_batch_start != NULL && (tmp_backend->object.backend_batch_create == NULL || tmp_backend->object.backend_batch_delete == NULL || tmp_backend->object.backend_batch_execute == NULL)))
 		{
 			goto error;
 		}
@@ -431,6 +436,74 @@ j_backend_object_iterate(JBackend* backend, gpointer iterator, gchar const** nam
 	return ret;
 }
 
+gboolean
+j_backend_object_iterate_status(JBackend* backend, gchar const* namespace, gpointer iterator, gchar const** name, gint64* modification_time, guint64* size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = FALSE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(iterator != NULL, FALSE);
+	g_return_val_if_fail(name != NULL, FALSE);
+	g_return_val_if_fail(modification_time != NULL, FALSE);
+	g_return_val_if_fail(size != NULL, FALSE);
+
+	if (backend->object.backend_iterate_status != NULL)
+	{
+		J_TRACE("backend_iterate_status", "%p, %p, %p, %p", iterator, (gpointer)name, (gpointer)modification_time, (gpointer)size);
+		ret = backend->object.backend_iterate_status(backend->data, iterator, name, modification_time, size);
+	}
+	else
+	{
+		// Fall back to getting each object's status, objects deleted in the meantime are skipped.
+		while (j_backend_object_iterate(backend, iterator, name))
+		{
+			gpointer object;
+
+			if (j_backend_object_open(backend, namespace, *name, &object))
+			{
+				ret = j_backend_object_status(backend, object, modification_time, size);
+				j_backend_object_close(backend, object);
+			}
+
+			if (ret)
+			{
+				break;
+			}
+		}
+	}
+
+	return ret;
+}
+
+void
+j_backend_object_iterate_free(JBackend* backend, gpointer iterator)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(backend != NULL);
+	g_return_if_fail(backend->type == J_BACKEND_TYPE_OBJECT);
+	g_return_if_fail(iterator != NULL);
+
+	if (backend->object.backend_iterate_free != NULL)
+	{
+		J_TRACE("backend_iterate_free", "%p", iterator);
+		backend->object.backend_iterate_free(backend->data, iterator);
+	}
+	else
+	{
+		gchar const* name;
+
+		// Fall back to draining the iterator, which frees it once its end has been reached.
+		while (j_backend_object_iterate(backend, iterator, &name))
+		{
+		}
+	}
+}
+
 gboolean
 j_backend_object_close(JBackend* backend, gpointer data)
 {
@@ -533,198 +606,1020 @@ j_backend_object_write(JBackend* backend, gpointer data, gconstpointer buffer, g
 }
 
 gboolean
-j_backend_kv_init(JBackend* backend, gchar const* path)
+j_backend_object_copy(JBackend* backend, gpointer src, gpointer dst, guint64* bytes_copied)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gboolean ret;
+	gboolean ret = FALSE;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(path != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(src != NULL, FALSE);
+	g_return_val_if_fail(dst != NULL, FALSE);
+	g_return_val_if_fail(bytes_copied != NULL, FALSE);
+
+	*bytes_copied = 0;
 
+	if (backend->object.backend_copy != NULL)
 	{
-		J_TRACE("backend_init", "%s", path);
-		ret = backend->kv.backend_init(path, &(backend->data));
+		J_TRACE("backend_copy", "%p, %p, %p", src, dst, (gpointer)bytes_copied);
+		ret = backend->object.backend_copy(backend->data, src, dst, bytes_copied);
+	}
+	else
+	{
+		// Fall back to copying the data via an intermediate buffer.
+		guint64 const buffer_size = 4 * 1024 * 1024;
+		g_autofree gchar* buffer = NULL;
+		gint64 modification_time = 0;
+		guint64 size = 0;
+		guint64 offset = 0;
+
+		if (!j_backend_object_status(backend, src, &modification_time, &size))
+		{
+			return FALSE;
+		}
+
+		// Allocating the destination's storage up front avoids fragmenting it while it grows.
+		if (size > 0)
+		{
+			j_backend_object_preallocate(backend, dst, size, 0);
+		}
+
+		buffer = g_malloc(MIN(MAX(size, 1), buffer_size));
+		ret = TRUE;
+
+		while (offset < size)
+		{
+			guint64 nbytes_read = 0;
+			guint64 nbytes_written = 0;
+
+			if (!j_backend_object_read(backend, src, buffer, MIN(size - offset, buffer_size), offset, &nbytes_read) || nbytes_read == 0)
+			{
+				ret = FALSE;
+				break;
+			}
+
+			if (!j_backend_object_write(backend, dst, buffer, nbytes_read, offset, &nbytes_written) || nbytes_written != nbytes_read)
+			{
+				ret = FALSE;
+				break;
+			}
+
+			offset += nbytes_written;
+		}
+
+		*bytes_copied = offset;
+
+		// The destination might have existed before and been larger than the source.
+		ret = ret && j_backend_object_truncate(backend, dst, size);
 	}
 
 	return ret;
 }
 
-void
-j_backend_kv_fini(JBackend* backend)
+gboolean
+j_backend_object_delete_by_prefix(JBackend* backend, gchar const* namespace, gchar const* prefix)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	g_return_if_fail(backend != NULL);
-	g_return_if_fail(backend->type == J_BACKEND_TYPE_KV);
+	gboolean ret = TRUE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(namespace != NULL, FALSE);
 
+	if (backend->object.backend_delete_by_prefix != NULL)
 	{
-		J_TRACE("backend_fini", NULL);
-		backend->kv.backend_fini(backend->data);
+		J_TRACE("backend_delete_by_prefix", "%s, %s", namespace, (prefix != NULL) ? prefix : "(null)");
+		ret = backend->object.backend_delete_by_prefix(backend->data, namespace, prefix);
+	}
+	else if (backend->object.backend_get_all != NULL && backend->object.backend_iterate != NULL)
+	{
+		// Fall back to deleting the objects one by one.
+		g_autoptr(GPtrArray) names = NULL;
+		gpointer iterator = NULL;
+		gboolean iterator_ret;
+		gchar const* name;
+
+		names = g_ptr_array_new_with_free_func(g_free);
+
+		if (prefix == NULL)
+		{
+			iterator_ret = j_backend_object_get_all(backend, namespace, &iterator);
+		}
+		else
+		{
+			iterator_ret = j_backend_object_get_by_prefix(backend, namespace, prefix, &iterator);
+		}
+
+		// A namespace that cannot be listed does not contain anything to delete.
+		if (!iterator_ret)
+		{
+			return TRUE;
+		}
+
+		// Collect the names first, deleting while iterating is not supported by all backends.
+		while (j_backend_object_iterate(backend, iterator, &name))
+		{
+			g_ptr_array_add(names, g_strdup(name));
+		}
+
+		for (guint i = 0; i < names->len; i++)
+		{
+			gpointer object;
+
+			if (j_backend_object_open(backend, namespace, g_ptr_array_index(names, i), &object))
+			{
+				ret = j_backend_object_delete(backend, object) && ret;
+			}
+			else
+			{
+				ret = FALSE;
+			}
+		}
+	}
+	else
+	{
+		ret = FALSE;
 	}
+
+	return ret;
 }
 
 gboolean
-j_backend_kv_batch_start(JBackend* backend, gchar const* namespace, JSemantics* semantics, gpointer* batch)
+j_backend_object_submit(JBackend* backend, gpointer data, JBackendObjectRequest* requests, guint count, gboolean sync)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gboolean ret;
+	gboolean ret = TRUE;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(namespace != NULL, FALSE);
-	g_return_val_if_fail(semantics != NULL, FALSE);
-	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(requests != NULL || count == 0, FALSE);
 
+	if (backend->object.backend_submit != NULL)
 	{
-		J_TRACE("backend_batch_start", "%s, %p, %p", namespace, (gpointer)semantics, (gpointer)batch);
-		ret = backend->kv.backend_batch_start(backend->data, namespace, semantics, batch);
+		J_TRACE("backend_submit", "%p, %p, %u, %d", data, (gpointer)requests, count, sync);
+		ret = backend->object.backend_submit(backend->data, data, requests, count, sync);
+	}
+	else
+	{
+		// Fall back to executing the requests synchronously, they are complete once this returns.
+		// Consecutive requests of the same kind are passed on together, so that vectored I/O can be used.
+		for (guint i = 0; i < count;)
+		{
+			guint j = i + 1;
+
+			while (j < count && requests[j].write == requests[i].write)
+			{
+				j++;
+			}
+
+			if (requests[i].write)
+			{
+				ret = j_backend_object_writev(backend, data, &(requests[i]), j - i) && ret;
+			}
+			else
+			{
+				ret = j_backend_object_readv(backend, data, &(requests[i]), j - i) && ret;
+			}
+
+			i = j;
+		}
+
+		if (sync)
+		{
+			ret = j_backend_object_sync(backend, data) && ret;
+		}
 	}
 
 	return ret;
 }
 
 gboolean
-j_backend_kv_batch_execute(JBackend* backend, gpointer batch)
+j_backend_object_complete(JBackend* backend, gpointer data)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gboolean ret;
+	gboolean ret = TRUE;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
 
+	if (backend->object.backend_complete != NULL)
 	{
-		J_TRACE("backend_batch_execute", "%p", batch);
-		ret = backend->kv.backend_batch_execute(backend->data, batch);
+		J_TRACE("backend_complete", "%p", data);
+		ret = backend->object.backend_complete(backend->data, data);
 	}
 
 	return ret;
 }
 
 gboolean
-j_backend_kv_put(JBackend* backend, gpointer batch, gchar const* key, gconstpointer value, guint32 value_len)
+j_backend_object_register_buffer(JBackend* backend, gpointer buffer, guint64 length)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gboolean ret;
+	gboolean ret = FALSE;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(batch != NULL, FALSE);
-	g_return_val_if_fail(key != NULL, FALSE);
-	g_return_val_if_fail(value != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
 
+	if (backend->object.backend_register_buffer != NULL)
 	{
-		J_TRACE("backend_put", "%p, %s, %p, %u", batch, key, (gconstpointer)value, value_len);
-		ret = backend->kv.backend_put(backend->data, batch, key, value, value_len);
+		J_TRACE("backend_register_buffer", "%p, %" G_GUINT64_FORMAT, buffer, length);
+		ret = backend->object.backend_register_buffer(backend->data, buffer, length);
 	}
 
 	return ret;
 }
 
 gboolean
-j_backend_kv_delete(JBackend* backend, gpointer batch, gchar const* key)
+j_backend_object_map(JBackend* backend, gpointer data, guint64 length, guint64 offset, gconstpointer* buffer, guint64* bytes, gpointer* mapping)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gboolean ret;
+	gboolean ret = FALSE;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(batch != NULL, FALSE);
-	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(buffer != NULL, FALSE);
+	g_return_val_if_fail(bytes != NULL, FALSE);
+	g_return_val_if_fail(mapping != NULL, FALSE);
 
+	if (backend->object.backend_map != NULL)
 	{
-		J_TRACE("backend_delete", "%p, %s", batch, key);
-		ret = backend->kv.backend_delete(backend->data, batch, key);
+		J_TRACE("backend_map", "%p, %" G_GUINT64_FORMAT ", %" G_GUINT64_FORMAT, data, length, offset);
+		ret = backend->object.backend_map(backend->data, data, length, offset, buffer, bytes, mapping);
 	}
 
 	return ret;
 }
 
+void
+j_backend_object_unmap(JBackend* backend, gpointer mapping)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(backend != NULL);
+	g_return_if_fail(backend->type == J_BACKEND_TYPE_OBJECT);
+	g_return_if_fail(backend->object.backend_unmap != NULL);
+
+	{
+		J_TRACE("backend_unmap", "%p", mapping);
+		backend->object.backend_unmap(backend->data, mapping);
+	}
+}
+
 gboolean
-j_backend_kv_get(JBackend* backend, gpointer batch, gchar const* key, gpointer* value, guint32* value_len)
+j_backend_object_readv(JBackend* backend, gpointer data, JBackendObjectRequest* requests, guint count)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gboolean ret;
+	gboolean ret = TRUE;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(batch != NULL, FALSE);
-	g_return_val_if_fail(key != NULL, FALSE);
-	g_return_val_if_fail(value != NULL, FALSE);
-	g_return_val_if_fail(value_len != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(requests != NULL || count == 0, FALSE);
 
+	if (backend->object.backend_readv != NULL)
 	{
-		J_TRACE("backend_get", "%p, %s, %p, %p", batch, key, (gpointer)value, (gpointer)value_len);
-		ret = backend->kv.backend_get(backend->data, batch, key, value, value_len);
+		J_TRACE("backend_readv", "%p, %p, %u", data, (gpointer)requests, count);
+		ret = backend->object.backend_readv(backend->data, data, requests, count);
+	}
+	else
+	{
+		for (guint i = 0; i < count; i++)
+		{
+			requests[i].bytes = 0;
+			ret = j_backend_object_read(backend, data, requests[i].buffer, requests[i].length, requests[i].offset, &(requests[i].bytes)) && ret;
+		}
 	}
 
 	return ret;
 }
 
 gboolean
-j_backend_kv_get_all(JBackend* backend, gchar const* namespace, gpointer* iterator)
+j_backend_object_writev(JBackend* backend, gpointer data, JBackendObjectRequest* requests, guint count)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gboolean ret;
+	gboolean ret = TRUE;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+	g_return_val_if_fail(requests != NULL || count == 0, FALSE);
+
+	if (backend->object.backend_writev != NULL)
+	{
+		J_TRACE("backend_writev", "%p, %p, %u", data, (gpointer)requests, count);
+		ret = backend->object.backend_writev(backend->data, data, requests, count);
+	}
+	else
+	{
+		for (guint i = 0; i < count; i++)
+		{
+			requests[i].bytes = 0;
+			ret = j_backend_object_write(backend, data, requests[i].buffer, requests[i].length, requests[i].offset, &(requests[i].bytes)) && ret;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * A batch for backends that do not support batches themselves.
+ **/
+struct JBackendObjectBatch
+{
+	gchar* namespace;
+	gboolean sync;
+};
+
+typedef struct JBackendObjectBatch JBackendObjectBatch;
+
+gboolean
+j_backend_object_batch_start(JBackend* backend, gchar const* namespace, gboolean sync, gpointer* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
 	g_return_val_if_fail(namespace != NULL, FALSE);
-	g_return_val_if_fail(iterator != NULL, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
 
+	if (backend->object.backend_batch_start != NULL)
 	{
-		J_TRACE("backend_get_all", "%s, %p", namespace, (gpointer)iterator);
-		ret = backend->kv.backend_get_all(backend->data, namespace, iterator);
+		J_TRACE("backend_batch_start", "%s, %d, %p", namespace, sync, (gpointer)batch);
+		ret = backend->object.backend_batch_start(backend->data, namespace, sync, batch);
+	}
+	else
+	{
+		JBackendObjectBatch* fallback;
+
+		fallback = g_slice_new(JBackendObjectBatch);
+		fallback->namespace = g_strdup(namespace);
+		fallback->sync = sync;
+
+		*batch = fallback;
 	}
 
 	return ret;
 }
 
 gboolean
-j_backend_kv_get_by_prefix(JBackend* backend, gchar const* namespace, gchar const* prefix, gpointer* iterator)
+j_backend_object_batch_create(JBackend* backend, gpointer batch, gchar const* path)
 {
 	J_TRACE_FUNCTION(NULL);
 
 	gboolean ret;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(namespace != NULL, FALSE);
-	g_return_val_if_fail(prefix != NULL, FALSE);
-	g_return_val_if_fail(iterator != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(path != NULL, FALSE);
 
+	if (backend->object.backend_batch_create != NULL)
 	{
-		J_TRACE("backend_get_by_prefix", "%s, %s, %p", namespace, prefix, (gpointer)iterator);
-		ret = backend->kv.backend_get_by_prefix(backend->data, namespace, prefix, iterator);
+		J_TRACE("backend_batch_create", "%p, %s", batch, path);
+		ret = backend->object.backend_batch_create(backend->data, batch, path);
+	}
+	else
+	{
+		JBackendObjectBatch* fallback = batch;
+		gpointer object;
+
+		ret = j_backend_object_create(backend, fallback->namespace, path, &object);
+
+		if (ret)
+		{
+			if (fallback->sync)
+			{
+				ret = j_backend_object_sync(backend, object);
+			}
+
+			ret = j_backend_object_close(backend, object) && ret;
+		}
 	}
 
 	return ret;
 }
+
 gboolean
-j_backend_kv_iterate(JBackend* backend, gpointer iterator, gchar const** key, gconstpointer* value, guint32* value_len)
+j_backend_object_batch_delete(JBackend* backend, gpointer batch, gchar const* path)
 {
 	J_TRACE_FUNCTION(NULL);
 
 	gboolean ret;
 
 	g_return_val_if_fail(backend != NULL, FALSE);
-	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
-	g_return_val_if_fail(iterator != NULL, FALSE);
-	g_return_val_if_fail(key != NULL, FALSE);
-	g_return_val_if_fail(value != NULL, FALSE);
-	g_return_val_if_fail(value_len != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(path != NULL, FALSE);
 
+	if (backend->object.backend_batch_delete != NULL)
 	{
-		J_TRACE("backend_iterate", "%p, %p, %p, %p", iterator, (gpointer)key, (gpointer)value, (gpointer)value_len);
-		ret = backend->kv.backend_iterate(backend->data, iterator, key, value, value_len);
+		J_TRACE("backend_batch_delete", "%p, %s", batch, path);
+		ret = backend->object.backend_batch_delete(backend->data, batch, path);
+	}
+	else
+	{
+		JBackendObjectBatch* fallback = batch;
+		gpointer object;
+
+		ret = j_backend_object_open(backend, fallback->namespace, path, &object)
+		      && j_backend_object_delete(backend, object);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_object_batch_execute(JBackend* backend, gpointer batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+
+	if (backend->object.backend_batch_execute != NULL)
+	{
+		J_TRACE("backend_batch_execute", "%p", batch);
+		ret = backend->object.backend_batch_execute(backend->data, batch);
+	}
+	else
+	{
+		JBackendObjectBatch* fallback = batch;
+
+		g_free(fallback->namespace);
+		g_slice_free(JBackendObjectBatch, fallback);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_object_preallocate(JBackend* backend, gpointer data, guint64 length, guint64 offset)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = FALSE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+
+	if (backend->object.backend_preallocate != NULL)
+	{
+		J_TRACE("backend_preallocate", "%p, %" G_GUINT64_FORMAT ", %" G_GUINT64_FORMAT, data, length, offset);
+		ret = backend->object.backend_preallocate(backend->data, data, length, offset);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_object_truncate(JBackend* backend, gpointer data, guint64 size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = FALSE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_OBJECT, FALSE);
+	g_return_val_if_fail(data != NULL, FALSE);
+
+	if (backend->object.backend_truncate != NULL)
+	{
+		J_TRACE("backend_truncate", "%p, %" G_GUINT64_FORMAT, data, size);
+		ret = backend->object.backend_truncate(backend->data, data, size);
+	}
+	else
+	{
+		// Fall back to writing a zero byte, which can only extend objects.
+		gint64 modification_time;
+		guint64 current_size;
+
+		if (j_backend_object_status(backend, data, &modification_time, &current_size))
+		{
+			if (size > current_size)
+			{
+				gchar const zero = 0;
+				guint64 bytes_written;
+
+				ret = j_backend_object_write(backend, data, &zero, 1, size - 1, &bytes_written);
+			}
+			else
+			{
+				ret = (size == current_size);
+			}
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * Locks used to serialize appends and reservations.
+ * Objects are mapped to locks using their hash, so unrelated objects only rarely contend.
+ **/
+static GMutex j_backend_append_locks[64];
+
+GMutex*
+j_backend_object_get_append_lock(gchar const* namespace, gchar const* path)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	guint hash;
+
+	g_return_val_if_fail(namespace != NULL, NULL);
+	g_return_val_if_fail(path != NULL, NULL);
+
+	hash = g_str_hash(namespace) * 31 + g_str_hash(path);
+
+	return &(j_backend_append_locks[hash % G_N_ELEMENTS(j_backend_append_locks)]);
+}
+
+gboolean
+j_backend_kv_init(JBackend* backend, gchar const* path)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(path != NULL, FALSE);
+
+	{
+		J_TRACE("backend_init", "%s", path);
+		ret = backend->kv.backend_init(path, &(backend->data));
+	}
+
+	return ret;
+}
+
+void
+j_backend_kv_fini(JBackend* backend)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(backend != NULL);
+	g_return_if_fail(backend->type == J_BACKEND_TYPE_KV);
+
+	{
+		J_TRACE("backend_fini", NULL);
+		backend->kv.backend_fini(backend->data);
+	}
+}
+
+gboolean
+j_backend_kv_batch_start(JBackend* backend, gchar const* namespace, JSemantics* semantics, gpointer* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+
+	{
+		J_TRACE("backend_batch_start", "%s, %p, %p", namespace, (gpointer)semantics, (gpointer)batch);
+		ret = backend->kv.backend_batch_start(backend->data, namespace, semantics, batch);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_batch_execute(JBackend* backend, gpointer batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+
+	{
+		J_TRACE("backend_batch_execute", "%p", batch);
+		ret = backend->kv.backend_batch_execute(backend->data, batch);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_put(JBackend* backend, gpointer batch, gchar const* key, gconstpointer value, guint32 value_len)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	{
+		J_TRACE("backend_put", "%p, %s, %p, %u", batch, key, (gconstpointer)value, value_len);
+		ret = backend->kv.backend_put(backend->data, batch, key, value, value_len);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_delete(JBackend* backend, gpointer batch, gchar const* key)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+
+	{
+		J_TRACE("backend_delete", "%p, %s", batch, key);
+		ret = backend->kv.backend_delete(backend->data, batch, key);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_get(JBackend* backend, gpointer batch, gchar const* key, gpointer* value, guint32* value_len)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+	g_return_val_if_fail(value_len != NULL, FALSE);
+
+	{
+		J_TRACE("backend_get", "%p, %s, %p, %p", batch, key, (gpointer)value, (gpointer)value_len);
+		ret = backend->kv.backend_get(backend->data, batch, key, value, value_len);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_get_view(JBackend* backend, gpointer batch, gchar const* key, gconstpointer* value, guint32* value_len, GDestroyNotify* value_free)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+	g_return_val_if_fail(value_len != NULL, FALSE);
+	g_return_val_if_fail(value_free != NULL, FALSE);
+
+	if (backend->kv.backend_get_view != NULL)
+	{
+		J_TRACE("backend_get_view", "%p, %s, %p, %p", batch, key, (gpointer)value, (gpointer)value_len);
+		ret = backend->kv.backend_get_view(backend->data, batch, key, value, value_len);
+		*value_free = NULL;
+	}
+	else
+	{
+		gpointer copy = NULL;
+
+		// Fall back to a copy, which has to be freed by the caller.
+		ret = j_backend_kv_get(backend, batch, key, &copy, value_len);
+		*value = copy;
+		*value_free = (ret) ? g_free : NULL;
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_get_all(JBackend* backend, gchar const* namespace, gpointer* iterator)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(iterator != NULL, FALSE);
+
+	{
+		J_TRACE("backend_get_all", "%s, %p", namespace, (gpointer)iterator);
+		ret = backend->kv.backend_get_all(backend->data, namespace, iterator);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_get_by_prefix(JBackend* backend, gchar const* namespace, gchar const* prefix, gpointer* iterator)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(prefix != NULL, FALSE);
+	g_return_val_if_fail(iterator != NULL, FALSE);
+
+	{
+		J_TRACE("backend_get_by_prefix", "%s, %s, %p", namespace, prefix, (gpointer)iterator);
+		ret = backend->kv.backend_get_by_prefix(backend->data, namespace, prefix, iterator);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_get_range(JBackend* backend, gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse, gpointer* iterator)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = FALSE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(namespace != NULL, FALSE);
+	g_return_val_if_fail(iterator != NULL, FALSE);
+
+	if (backend->kv.backend_get_range != NULL)
+	{
+		J_TRACE("backend_get_range", "%s, %s, %s, %u, %d, %p", namespace, (start != NULL) ? start : "(null)", (end != NULL) ? end : "(null)", limit, reverse, (gpointer)iterator);
+		ret = backend->kv.backend_get_range(backend->data, namespace, start, end, limit, reverse, iterator);
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_iterate(JBackend* backend, gpointer iterator, gchar const** key, gconstpointer* value, guint32* value_len)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(iterator != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+	g_return_val_if_fail(value_len != NULL, FALSE);
+
+	{
+		J_TRACE("backend_iterate", "%p, %p, %p, %p", iterator, (gpointer)key, (gpointer)value, (gpointer)value_len);
+		ret = backend->kv.backend_iterate(backend->data, iterator, key, value, value_len);
+	}
+
+	return ret;
+}
+
+void
+j_backend_kv_iterate_free(JBackend* backend, gpointer iterator)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(backend != NULL);
+	g_return_if_fail(backend->type == J_BACKEND_TYPE_KV);
+	g_return_if_fail(iterator != NULL);
+
+	if (backend->kv.backend_iterate_free != NULL)
+	{
+		J_TRACE("backend_iterate_free", "%p", iterator);
+		backend->kv.backend_iterate_free(backend->data, iterator);
+	}
+	else
+	{
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		// Fall back to draining the iterator, which frees it once its end has been reached.
+		while (j_backend_kv_iterate(backend, iterator, &key, &value, &len))
+		{
+		}
+	}
+}
+
+gboolean
+j_backend_kv_delete_by_prefix(JBackend* backend, gpointer batch, gchar const* namespace, gchar const* prefix)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(namespace != NULL, FALSE);
+
+	if (backend->kv.backend_delete_by_prefix != NULL)
+	{
+		J_TRACE("backend_delete_by_prefix", "%p, %s", batch, (prefix != NULL) ? prefix : "(null)");
+		ret = backend->kv.backend_delete_by_prefix(backend->data, batch, prefix);
+	}
+	else
+	{
+		// Fall back to deleting the key-value pairs one by one.
+		g_autoptr(GPtrArray) keys = NULL;
+		gpointer iterator = NULL;
+		gboolean iterator_ret;
+		gchar const* key;
+		gconstpointer value;
+		guint32 value_len;
+
+		keys = g_ptr_array_new_with_free_func(g_free);
+
+		if (prefix == NULL)
+		{
+			iterator_ret = j_backend_kv_get_all(backend, namespace, &iterator);
+		}
+		else
+		{
+			iterator_ret = j_backend_kv_get_by_prefix(backend, namespace, prefix, &iterator);
+		}
+
+		if (!iterator_ret)
+		{
+			return FALSE;
+		}
+
+		while (j_backend_kv_iterate(backend, iterator, &key, &value, &value_len))
+		{
+			g_ptr_array_add(keys, g_strdup(key));
+		}
+
+		for (guint i = 0; i < keys->len; i++)
+		{
+			ret = j_backend_kv_delete(backend, batch, g_ptr_array_index(keys, i)) && ret;
+		}
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_compare_and_swap(JBackend* backend, gpointer batch, gchar const* key, gconstpointer expected, guint32 expected_len, gconstpointer value, guint32 value_len)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	if (backend->kv.backend_compare_and_swap != NULL)
+	{
+		J_TRACE("backend_compare_and_swap", "%p, %s, %p, %u, %p, %u", batch, key, expected, expected_len, value, value_len);
+		ret = backend->kv.backend_compare_and_swap(backend->data, batch, key, expected, expected_len, value, value_len);
+	}
+	else
+	{
+		// Fall back to reading and writing the value, which is not atomic.
+		g_autofree gpointer current = NULL;
+		guint32 current_len = 0;
+		gboolean exists;
+
+		exists = j_backend_kv_get(backend, batch, key, &current, &current_len);
+
+		if (expected == NULL)
+		{
+			ret = !exists;
+		}
+		else
+		{
+			ret = exists && current_len == expected_len && memcmp(current, expected, expected_len) == 0;
+		}
+
+		if (ret)
+		{
+			ret = j_backend_kv_put(backend, batch, key, value, value_len);
+		}
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_add(JBackend* backend, gpointer batch, gchar const* key, gint64 delta)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+
+	if (backend->kv.backend_add != NULL)
+	{
+		J_TRACE("backend_add", "%p, %s, %" G_GINT64_FORMAT, batch, key, delta);
+		ret = backend->kv.backend_add(backend->data, batch, key, delta);
+	}
+	else
+	{
+		// Fall back to reading and writing the value, which is not atomic.
+		g_autofree gpointer current = NULL;
+		guint32 current_len = 0;
+		gint64 counter = 0;
+
+		ret = TRUE;
+
+		if (j_backend_kv_get(backend, batch, key, &current, &current_len))
+		{
+			ret = (current_len == sizeof(counter));
+
+			if (ret)
+			{
+				memcpy(&counter, current, sizeof(counter));
+				counter = GINT64_FROM_LE(counter);
+			}
+		}
+
+		if (ret)
+		{
+			counter = GINT64_TO_LE(counter + delta);
+			ret = j_backend_kv_put(backend, batch, key, &counter, sizeof(counter));
+		}
+	}
+
+	return ret;
+}
+
+gboolean
+j_backend_kv_append(JBackend* backend, gpointer batch, gchar const* key, gconstpointer value, guint32 value_len)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret;
+
+	g_return_val_if_fail(backend != NULL, FALSE);
+	g_return_val_if_fail(backend->type == J_BACKEND_TYPE_KV, FALSE);
+	g_return_val_if_fail(batch != NULL, FALSE);
+	g_return_val_if_fail(key != NULL, FALSE);
+	g_return_val_if_fail(value != NULL, FALSE);
+
+	if (backend->kv.backend_append != NULL)
+	{
+		J_TRACE("backend_append", "%p, %s, %p, %u", batch, key, value, value_len);
+		ret = backend->kv.backend_append(backend->data, batch, key, value, value_len);
+	}
+	else
+	{
+		// Fall back to reading and writing the value, which is not atomic.
+		g_autofree gpointer current = NULL;
+		g_autofree gchar* appended = NULL;
+		guint32 current_len = 0;
+
+		if (!j_backend_kv_get(backend, batch, key, &current, &current_len))
+		{
+			current_len = 0;
+		}
+
+		appended = g_malloc(current_len + value_len);
+
+		if (current_len > 0)
+		{
+			memcpy(appended, current, current_len);
+		}
+
+		memcpy(appended + current_len, value, value_len);
+
+		ret = j_backend_kv_put(backend, batch, key, appended, current_len + value_len);
 	}
 
 	return ret;
@@ -364,15 +364,23 @@ j_batch_execute_internal(JBatch* batch)
 	J_TRACE_FUNCTION(NULL);
 
 	g_autoptr(JList) same_list = NULL;
+	g_autoptr(JList) same_operations = NULL;
 	g_autoptr(JListIterator) iterator = NULL;
 	JOperationExecFunc last_exec_func;
+	JOperationExecFunc last_compound_exec_func;
 	gconstpointer last_key;
+	guint last_compound_position;
+	gboolean compound;
 	gboolean ret = TRUE;
 
 	iterator = j_list_iterator_new(batch->list);
 	same_list = j_list_new(NULL);
+	same_operations = j_list_new(NULL);
 	last_key = NULL;
 	last_exec_func = NULL;
+	last_compound_exec_func = NULL;
+	last_compound_position = 0;
+	compound = FALSE;
 
 	/** \todo Perform some (reordering) optimizations
 		* It is important to consider dependencies:
@@ -383,23 +391,61 @@ j_batch_execute_internal(JBatch* batch)
 	/**
 	 * Try to combine as many operations of the same type as possible.
 	 * These are temporarily stored in same_list.
+	 * Sequences of different operations (such as create, write and sync) are combined if they share a compound function.
+	 * Their operations are stored in same_operations.
 	 */
 	while (j_list_iterator_next(iterator))
 	{
 		JOperation* operation = j_list_iterator_get(iterator);
+		gboolean same;
 
 		/* We only combine operations with the same type and the same key. */
-		if ((operation->exec_func != last_exec_func || operation->key != last_key) && last_exec_func != NULL)
+		same = (operation->exec_func == last_exec_func && operation->key == last_key);
+
+		/* Different types can only be combined if they share the same compound function and appear in its order. */
+		if (!same && last_exec_func != NULL && operation->key == last_key && operation->compound_exec_func != NULL && operation->compound_exec_func == last_compound_exec_func && operation->compound_position >= last_compound_position)
 		{
-			ret = j_batch_execute_same(batch, last_exec_func, same_list) && ret;
+			same = TRUE;
+			compound = TRUE;
+		}
+
+		if (!same)
+		{
+			if (last_exec_func != NULL)
+			{
+				if (compound)
+				{
+					ret = j_batch_execute_same(batch, last_compound_exec_func, same_operations) && ret;
+					j_list_delete_all(same_list);
+				}
+				else
+				{
+					ret = j_batch_execute_same(batch, last_exec_func, same_list) && ret;
+					j_list_delete_all(same_operations);
+				}
+			}
+
+			last_compound_exec_func = operation->compound_exec_func;
+			compound = FALSE;
 		}
 
 		last_key = operation->key;
 		last_exec_func = operation->exec_func;
+		last_compound_position = operation->compound_position;
 		j_list_append(same_list, operation->data);
+		j_list_append(same_operations, operation);
 	}
 
-	ret = j_batch_execute_same(batch, last_exec_func, same_list) && ret;
+	if (compound)
+	{
+		ret = j_batch_execute_same(batch, last_compound_exec_func, same_operations) && ret;
+		j_list_delete_all(same_list);
+	}
+	else
+	{
+		ret = j_batch_execute_same(batch, last_exec_func, same_list) && ret;
+		j_list_delete_all(same_operations);
+	}
 
 	return ret;
 }
@@ -31,6 +31,8 @@
 
 #include <jbackend.h>
 #include <jcredentials.h>
+#include <jhash-ring.h>
+#include <jhelper.h>
 #include <jtrace.h>
 
 /**
@@ -39,6 +41,24 @@
  * @{
  **/
 
+/**
+ * The placement of keys and objects on servers.
+ */
+enum JConfigurationPlacement
+{
+	/**
+	 * The key's hash modulo the number of servers.
+	 */
+	J_CONFIGURATION_PLACEMENT_MODULO,
+
+	/**
+	 * A consistent hash ring.
+	 */
+	J_CONFIGURATION_PLACEMENT_RING
+};
+
+typedef enum JConfigurationPlacement JConfigurationPlacement;
+
 /**
  * A configuration.
  */
@@ -75,8 +95,54 @@ struct JConfiguration
 		 * The number of db servers.
 		 */
 		guint32 db_len;
+
+		/**
+		 * The object servers' weights, NULL if all servers have the same weight.
+		 */
+		gint* object_weights;
+
+		/**
+		 * The kv servers' weights, NULL if all servers have the same weight.
+		 */
+		gint* kv_weights;
+
+		/**
+		 * The db servers' weights, NULL if all servers have the same weight.
+		 */
+		gint* db_weights;
 	} servers;
 
+	/**
+	 * The placement configuration.
+	 */
+	struct
+	{
+		/**
+		 * The placement.
+		 */
+		JConfigurationPlacement placement;
+
+		/**
+		 * The number of virtual nodes per server.
+		 */
+		guint32 virtual_nodes;
+
+		/**
+		 * The hash ring for object servers, NULL if no ring is used.
+		 */
+		JHashRing* object;
+
+		/**
+		 * The hash ring for kv servers, NULL if no ring is used.
+		 */
+		JHashRing* kv;
+
+		/**
+		 * The hash ring for db servers, NULL if no ring is used.
+		 */
+		JHashRing* db;
+	} placement;
+
 	/**
 	 * The object configuration.
 	 */
@@ -147,6 +213,11 @@ struct JConfiguration
 	guint32 max_connections;
 	guint64 stripe_size;
 
+	/**
+	 * The latency percentile after which reads are hedged, 0 if hedging is disabled.
+	 */
+	guint32 hedge_percentile;
+
 	gchar* checksum;
 
 	/**
@@ -266,6 +337,75 @@ out:
 	return configuration;
 }
 
+/**
+ * Reads the servers' weights.
+ *
+ * \private
+ *
+ * \param key_file     The configuration data.
+ * \param key          The key.
+ * \param server_count The number of servers.
+ *
+ * \return The weights, NULL if they are not configured or invalid. Should be freed with g_free().
+ **/
+static gint*
+j_configuration_get_weights(GKeyFile* key_file, gchar const* key, guint32 server_count)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gint* weights;
+	gsize weights_len = 0;
+	gboolean nonzero = FALSE;
+
+	weights = g_key_file_get_integer_list(key_file, "servers", key, &weights_len, NULL);
+
+	if (weights == NULL)
+	{
+		return NULL;
+	}
+
+	if (weights_len != server_count)
+	{
+		g_warning("Ignoring %s because it contains %" G_GSIZE_FORMAT " weights for %u servers.", key, weights_len, server_count);
+		g_free(weights);
+
+		return NULL;
+	}
+
+	for (gsize i = 0; i < weights_len; i++)
+	{
+		if (weights[i] < 0)
+		{
+			g_warning("Ignoring %s because it contains negative weights.", key);
+			g_free(weights);
+
+			return NULL;
+		}
+
+		// Every unit of weight adds virtual nodes to the hash ring.
+		if (weights[i] > 1024)
+		{
+			g_warning("Ignoring %s because it contains weights larger than 1024.", key);
+			g_free(weights);
+
+			return NULL;
+		}
+
+		nonzero = nonzero || (weights[i] > 0);
+	}
+
+	// Without any weight, no server would be responsible for any data.
+	if (!nonzero)
+	{
+		g_warning("Ignoring %s because all weights are 0.", key);
+		g_free(weights);
+
+		return NULL;
+	}
+
+	return weights;
+}
+
 JConfiguration*
 j_configuration_new_for_data(GKeyFile* key_file)
 {
@@ -284,12 +424,15 @@ j_configuration_new_for_data(GKeyFile* key_file)
 	gchar* db_backend;
 	gchar* db_component;
 	gchar* db_path;
+	g_autofree gchar* placement = NULL;
 	g_autofree gchar* key_file_str = NULL;
 	guint64 max_operation_size;
 	guint64 max_inject_size;
 	guint32 port;
 	guint32 max_connections;
 	guint64 stripe_size;
+	gint virtual_nodes;
+	gint hedge_percentile;
 
 	g_return_val_if_fail(key_file != NULL, FALSE);
 
@@ -298,6 +441,9 @@ j_configuration_new_for_data(GKeyFile* key_file)
 	port = g_key_file_get_integer(key_file, "core", "port", NULL);
 	max_connections = g_key_file_get_integer(key_file, "clients", "max-connections", NULL);
 	stripe_size = g_key_file_get_uint64(key_file, "clients", "stripe-size", NULL);
+	placement = g_key_file_get_string(key_file, "clients", "placement", NULL);
+	virtual_nodes = g_key_file_get_integer(key_file, "clients", "virtual-nodes", NULL);
+	hedge_percentile = g_key_file_get_integer(key_file, "clients", "hedge-percentile", NULL);
 	servers_object = g_key_file_get_string_list(key_file, "servers", "object", NULL, NULL);
 	servers_kv = g_key_file_get_string_list(key_file, "servers", "kv", NULL, NULL);
 	servers_db = g_key_file_get_string_list(key_file, "servers", "db", NULL, NULL);
@@ -311,6 +457,23 @@ j_configuration_new_for_data(GKeyFile* key_file)
 	db_component = g_key_file_get_string(key_file, "db", "component", NULL);
 	db_path = g_key_file_get_string(key_file, "db", "path", NULL);
 
+	if (virtual_nodes < 0)
+	{
+		g_warning("Ignoring virtual-nodes because it is negative.");
+		virtual_nodes = 0;
+	}
+	else if (virtual_nodes > 4096)
+	{
+		g_warning("Ignoring virtual-nodes because it is larger than 4096.");
+		virtual_nodes = 0;
+	}
+
+	// Unlike the placement, hedging cannot fall back to a sensible default.
+	if (hedge_percentile < 0 || hedge_percentile > 100)
+	{
+		g_warning("Cannot use hedge-percentile %d because it is not between 0 and 100.", hedge_percentile);
+	}
+
 	/// \todo check value ranges (max_operation_size, port, max_connections, stripe_size)
 	// configuration->port < 0 || configuration->port > 65535
 
@@ -325,7 +488,8 @@ j_configuration_new_for_data(GKeyFile* key_file)
 	    || kv_path == NULL
 	    || db_backend == NULL
 	    || db_component == NULL
-	    || db_path == NULL)
+	    || db_path == NULL
+	    || hedge_percentile < 0 || hedge_percentile > 100)
 	{
 		g_free(db_backend);
 		g_free(db_component);
@@ -350,6 +514,14 @@ j_configuration_new_for_data(GKeyFile* key_file)
 	configuration->servers.object_len = g_strv_length(servers_object);
 	configuration->servers.kv_len = g_strv_length(servers_kv);
 	configuration->servers.db_len = g_strv_length(servers_db);
+	configuration->servers.object_weights = j_configuration_get_weights(key_file, "object-weights", configuration->servers.object_len);
+	configuration->servers.kv_weights = j_configuration_get_weights(key_file, "kv-weights", configuration->servers.kv_len);
+	configuration->servers.db_weights = j_configuration_get_weights(key_file, "db-weights", configuration->servers.db_len);
+	configuration->placement.placement = J_CONFIGURATION_PLACEMENT_MODULO;
+	configuration->placement.virtual_nodes = virtual_nodes;
+	configuration->placement.object = NULL;
+	configuration->placement.kv = NULL;
+	configuration->placement.db = NULL;
 	configuration->object.backend = object_backend;
 	configuration->object.component = object_component;
 	configuration->object.path = object_path;
@@ -364,6 +536,7 @@ j_configuration_new_for_data(GKeyFile* key_file)
 	configuration->max_inject_size = max_inject_size;
 	configuration->max_connections = max_connections;
 	configuration->stripe_size = stripe_size;
+	configuration->hedge_percentile = hedge_percentile;
 	configuration->checksum = NULL;
 	configuration->ref_count = 1;
 
@@ -394,6 +567,23 @@ j_configuration_new_for_data(GKeyFile* key_file)
 		configuration->stripe_size = 4 * 1024 * 1024;
 	}
 
+	if (configuration->placement.virtual_nodes == 0)
+	{
+		configuration->placement.virtual_nodes = 128;
+	}
+
+	if (g_strcmp0(placement, "ring") == 0)
+	{
+		configuration->placement.placement = J_CONFIGURATION_PLACEMENT_RING;
+		configuration->placement.object = j_hash_ring_new_for_configuration(configuration, J_BACKEND_TYPE_OBJECT);
+		configuration->placement.kv = j_hash_ring_new_for_configuration(configuration, J_BACKEND_TYPE_KV);
+		configuration->placement.db = j_hash_ring_new_for_configuration(configuration, J_BACKEND_TYPE_DB);
+	}
+	else if (placement != NULL && g_strcmp0(placement, "modulo") != 0)
+	{
+		g_warning("Unknown placement %s, using modulo.", placement);
+	}
+
 	key_file_str = g_key_file_to_data(key_file, NULL, NULL);
 	configuration->checksum = g_compute_checksum_for_string(G_CHECKSUM_SHA512, key_file_str, -1);
 
@@ -437,6 +627,25 @@ j_configuration_unref(JConfiguration* configuration)
 		g_strfreev(configuration->servers.kv);
 		g_strfreev(configuration->servers.db);
 
+		g_free(configuration->servers.object_weights);
+		g_free(configuration->servers.kv_weights);
+		g_free(configuration->servers.db_weights);
+
+		if (configuration->placement.object != NULL)
+		{
+			j_hash_ring_unref(configuration->placement.object);
+		}
+
+		if (configuration->placement.kv != NULL)
+		{
+			j_hash_ring_unref(configuration->placement.kv);
+		}
+
+		if (configuration->placement.db != NULL)
+		{
+			j_hash_ring_unref(configuration->placement.db);
+		}
+
 		g_free(configuration->checksum);
 
 		g_slice_free(JConfiguration, configuration);
@@ -490,6 +699,67 @@ j_configuration_get_server_count(JConfiguration* configuration, JBackendType bac
 	return 0;
 }
 
+guint32
+j_configuration_get_server_weight(JConfiguration* configuration, JBackendType backend, guint32 index)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gint const* weights = NULL;
+
+	g_return_val_if_fail(configuration != NULL, 0);
+	g_return_val_if_fail(index < j_configuration_get_server_count(configuration, backend), 0);
+
+	switch (backend)
+	{
+		case J_BACKEND_TYPE_OBJECT:
+			weights = configuration->servers.object_weights;
+			break;
+		case J_BACKEND_TYPE_KV:
+			weights = configuration->servers.kv_weights;
+			break;
+		case J_BACKEND_TYPE_DB:
+			weights = configuration->servers.db_weights;
+			break;
+		default:
+			g_assert_not_reached();
+	}
+
+	return (weights != NULL) ? (guint32)weights[index] : 1;
+}
+
+guint32
+j_configuration_get_server_index(JConfiguration* configuration, JBackendType backend, gchar const* key)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JHashRing* ring = NULL;
+
+	g_return_val_if_fail(configuration != NULL, 0);
+	g_return_val_if_fail(key != NULL, 0);
+
+	switch (backend)
+	{
+		case J_BACKEND_TYPE_OBJECT:
+			ring = configuration->placement.object;
+			break;
+		case J_BACKEND_TYPE_KV:
+			ring = configuration->placement.kv;
+			break;
+		case J_BACKEND_TYPE_DB:
+			ring = configuration->placement.db;
+			break;
+		default:
+			g_assert_not_reached();
+	}
+
+	if (ring != NULL)
+	{
+		return j_hash_ring_get(ring, key);
+	}
+
+	return j_helper_hash(key) % j_configuration_get_server_count(configuration, backend);
+}
+
 gchar const*
 j_configuration_get_backend(JConfiguration* configuration, JBackendType backend)
 {
@@ -596,6 +866,26 @@ j_configuration_get_stripe_size(JConfiguration* configuration)
 	return configuration->stripe_size;
 }
 
+guint32
+j_configuration_get_virtual_nodes(JConfiguration* configuration)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(configuration != NULL, 0);
+
+	return configuration->placement.virtual_nodes;
+}
+
+guint32
+j_configuration_get_hedge_percentile(JConfiguration* configuration)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(configuration != NULL, 0);
+
+	return configuration->hedge_percentile;
+}
+
 guint16
 j_configuration_get_port(JConfiguration* configuration)
 {
@@ -331,6 +331,56 @@ j_connection_pool_push(JBackendType backend, guint32 index, gpointer connection)
 	}
 }
 
+/**
+ * Closes a connection whose state is unknown instead of returning it to the pool.
+ *
+ * \private
+ *
+ * \param queue      The connection's queue.
+ * \param connection The connection.
+ **/
+static void
+j_connection_pool_discard_internal(JConnectionPoolQueue* queue, GSocketConnection* connection)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(queue != NULL);
+	g_return_if_fail(connection != NULL);
+
+	g_io_stream_close(G_IO_STREAM(connection), NULL, NULL);
+	g_object_unref(connection);
+
+	// Allow a new connection to be established in its place.
+	g_atomic_int_add(&(queue->count), -1);
+}
+
+void
+j_connection_pool_discard(JBackendType backend, guint32 index, gpointer connection)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(j_connection_pool != NULL);
+	g_return_if_fail(connection != NULL);
+
+	switch (backend)
+	{
+		case J_BACKEND_TYPE_OBJECT:
+			g_return_if_fail(index < j_connection_pool->object_len);
+			j_connection_pool_discard_internal(&(j_connection_pool->object_queues[index]), connection);
+			break;
+		case J_BACKEND_TYPE_KV:
+			g_return_if_fail(index < j_connection_pool->kv_len);
+			j_connection_pool_discard_internal(&(j_connection_pool->kv_queues[index]), connection);
+			break;
+		case J_BACKEND_TYPE_DB:
+			g_return_if_fail(index < j_connection_pool->db_len);
+			j_connection_pool_discard_internal(&(j_connection_pool->db_queues[index]), connection);
+			break;
+		default:
+			g_assert_not_reached();
+	}
+}
+
 /**
  * @}
  **/
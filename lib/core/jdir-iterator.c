@@ -20,10 +20,20 @@
  * \file
  **/
 
+// Required for the d_type constants
+#define _DEFAULT_SOURCE
+
 #include <julea-config.h>
 
 #include <glib.h>
 
+#include <dirent.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <jdir-iterator.h>
 
 #include <jtrace.h>
@@ -54,6 +64,11 @@ struct JDirIterator
 	 **/
 	gchar* current;
 
+	/**
+	 * The current file's name within its directory.
+	 **/
+	gchar const* current_name;
+
 	/**
 	 * The root directory.
 	 **/
@@ -65,6 +80,26 @@ struct JDirIterator
 	guint depth;
 };
 
+/**
+ * Checks whether a directory entry is a directory itself.
+ * The entry's type is used if available, which avoids a stat() for every file.
+ **/
+static gboolean
+j_dir_iterator_is_dir(DIR* dir, struct dirent const* entry)
+{
+	struct stat buf;
+
+#ifdef HAVE_DIRENT_D_TYPE
+	// Symbolic links are followed, so their targets have to be checked.
+	if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK)
+	{
+		return (entry->d_type == DT_DIR);
+	}
+#endif
+
+	return (fstatat(dirfd(dir), entry->d_name, &buf, 0) == 0 && S_ISDIR(buf.st_mode));
+}
+
 JDirIterator*
 j_dir_iterator_new(gchar const* path)
 {
@@ -72,12 +107,12 @@ j_dir_iterator_new(gchar const* path)
 
 	JDirIterator* iterator;
 
-	GDir* dir;
+	DIR* dir;
 	gchar* path_tmp;
 
 	g_return_val_if_fail(path != NULL, NULL);
 
-	dir = g_dir_open(path, 0, NULL);
+	dir = opendir(path);
 
 	if (dir == NULL)
 	{
@@ -85,9 +120,10 @@ j_dir_iterator_new(gchar const* path)
 	}
 
 	iterator = g_slice_new(JDirIterator);
-	iterator->dirs = g_array_new(FALSE, FALSE, sizeof(GDir*));
+	iterator->dirs = g_array_new(FALSE, FALSE, sizeof(DIR*));
 	iterator->paths = g_array_new(FALSE, FALSE, sizeof(gchar*));
 	iterator->current = NULL;
+	iterator->current_name = NULL;
 	iterator->root = g_strdup(path);
 	iterator->depth = 0;
 
@@ -116,15 +152,16 @@ j_dir_iterator_free(JDirIterator* iterator)
 
 	for (guint i = 0; i < iterator->dirs->len; i++)
 	{
-		GDir* dir;
+		DIR* dir;
 
-		dir = g_array_index(iterator->dirs, GDir*, i);
-		g_dir_close(dir);
+		dir = g_array_index(iterator->dirs, DIR*, i);
+		closedir(dir);
 	}
 
 	g_array_unref(iterator->paths);
 	g_array_unref(iterator->dirs);
 
+	g_free(iterator->current);
 	g_free(iterator->root);
 
 	g_slice_free(JDirIterator, iterator);
@@ -139,30 +176,28 @@ j_dir_iterator_next(JDirIterator* iterator)
 
 	while (TRUE)
 	{
-		GDir* dir;
+		DIR* dir;
 		gchar* path;
 
-		gchar const* name;
+		struct dirent* entry;
 
-		dir = g_array_index(iterator->dirs, GDir*, iterator->depth);
+		dir = g_array_index(iterator->dirs, DIR*, iterator->depth);
 		path = g_array_index(iterator->paths, gchar*, iterator->depth);
 
-		if ((name = g_dir_read_name(dir)) != NULL)
-		{
-			g_free(iterator->current);
-			iterator->current = g_build_filename(path, name, NULL);
-		}
-		else
+		g_free(iterator->current);
+		iterator->current = NULL;
+		iterator->current_name = NULL;
+
+		do
 		{
-			g_free(iterator->current);
-			iterator->current = NULL;
-		}
+			entry = readdir(dir);
+		} while (entry != NULL && (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0));
 
-		if (iterator->current == NULL)
+		if (entry == NULL)
 		{
 			if (iterator->depth > 0)
 			{
-				g_dir_close(dir);
+				closedir(dir);
 				g_array_remove_index(iterator->dirs, iterator->depth);
 
 				g_free(path);
@@ -172,29 +207,38 @@ j_dir_iterator_next(JDirIterator* iterator)
 
 				continue;
 			}
+
+			break;
 		}
-		else
-		{
-			g_autofree gchar* root_path = NULL;
 
-			root_path = g_build_filename(iterator->root, iterator->current, NULL);
+		iterator->current = g_build_filename(path, entry->d_name, NULL);
+		iterator->current_name = iterator->current + strlen(iterator->current) - strlen(entry->d_name);
 
-			if (g_file_test(root_path, G_FILE_TEST_IS_DIR))
-			{
-				dir = g_dir_open(root_path, 0, NULL);
+		if (j_dir_iterator_is_dir(dir, entry))
+		{
+			DIR* subdir = NULL;
+			gint fd;
 
-				if (dir != NULL)
+			// Opening subdirectories relative to their parents avoids resolving the whole path again.
+			if ((fd = openat(dirfd(dir), entry->d_name, O_RDONLY | O_DIRECTORY)) != -1)
+			{
+				if ((subdir = fdopendir(fd)) == NULL)
 				{
-					path = g_strdup(iterator->current);
+					close(fd);
+				}
+			}
 
-					g_array_append_val(iterator->dirs, dir);
-					g_array_append_val(iterator->paths, path);
+			if (subdir != NULL)
+			{
+				path = g_strdup(iterator->current);
 
-					iterator->depth++;
-				}
+				g_array_append_val(iterator->dirs, subdir);
+				g_array_append_val(iterator->paths, path);
 
-				continue;
+				iterator->depth++;
 			}
+
+			continue;
 		}
 
 		break;
@@ -214,6 +258,42 @@ j_dir_iterator_get(JDirIterator* iterator)
 	return iterator->current;
 }
 
+gboolean
+j_dir_iterator_get_status(JDirIterator* iterator, gint64* modification_time, guint64* size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	DIR* dir;
+	struct stat buf;
+
+	g_return_val_if_fail(iterator != NULL, FALSE);
+	g_return_val_if_fail(iterator->current != NULL, FALSE);
+
+	dir = g_array_index(iterator->dirs, DIR*, iterator->depth);
+
+	// The file is looked up relative to its directory, which is still open.
+	if (fstatat(dirfd(dir), iterator->current_name, &buf, 0) != 0)
+	{
+		return FALSE;
+	}
+
+	if (modification_time != NULL)
+	{
+		*modification_time = buf.st_mtime * G_USEC_PER_SEC;
+
+#ifdef HAVE_STMTIM_TVNSEC
+		*modification_time += buf.st_mtim.tv_nsec / 1000;
+#endif
+	}
+
+	if (size != NULL)
+	{
+		*size = buf.st_size;
+	}
+
+	return TRUE;
+}
+
 /**
  * @}
  **/
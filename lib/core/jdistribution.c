@@ -56,13 +56,23 @@ struct JDistribution
 	 */
 	gpointer distribution;
 
+	/**
+	 * The server count.
+	 **/
+	guint server_count;
+
+	/**
+	 * The number of copies of each block.
+	 **/
+	guint32 replicas;
+
 	/**
 	 * The reference count.
 	 **/
 	guint ref_count;
 };
 
-static JDistributionVTable j_distribution_vtables[3];
+static JDistributionVTable j_distribution_vtables[5];
 
 static JDistribution*
 j_distribution_new_common(JDistributionType type, JConfiguration* configuration)
@@ -79,6 +89,8 @@ j_distribution_new_common(JDistributionType type, JConfiguration* configuration)
 	distribution = g_slice_new(JDistribution);
 	distribution->type = type;
 	distribution->distribution = j_distribution_vtables[type].distribution_new(server_count, stripe_size);
+	distribution->server_count = server_count;
+	distribution->replicas = 1;
 	distribution->ref_count = 1;
 
 	return distribution;
@@ -145,6 +157,16 @@ j_distribution_set(JDistribution* distribution, gchar const* key, guint64 value)
 	g_return_if_fail(distribution != NULL);
 	g_return_if_fail(key != NULL);
 
+	// Replication is independent of the actual distribution.
+	if (g_strcmp0(key, "replicas") == 0)
+	{
+		g_return_if_fail(value > 0 && value <= distribution->server_count);
+
+		distribution->replicas = value;
+
+		return;
+	}
+
 	if (j_distribution_vtables[distribution->type].distribution_set != NULL)
 	{
 		j_distribution_vtables[distribution->type].distribution_set(distribution->distribution, key, value);
@@ -165,6 +187,72 @@ j_distribution_set2(JDistribution* distribution, gchar const* key, guint64 value
 	}
 }
 
+void
+j_distribution_set_placement_key(JDistribution* distribution, gchar const* key)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	guint32 index;
+
+	g_return_if_fail(distribution != NULL);
+	g_return_if_fail(key != NULL);
+	g_return_if_fail(distribution->type == J_DISTRIBUTION_SINGLE_SERVER);
+
+	index = j_configuration_get_server_index(j_configuration(), J_BACKEND_TYPE_OBJECT, key);
+	j_distribution_set(distribution, "index", index);
+}
+
+guint32
+j_distribution_get_replicas(JDistribution* distribution)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(distribution != NULL, 1);
+
+	return distribution->replicas;
+}
+
+guint32
+j_distribution_get_replica_index(JDistribution* distribution, guint32 index, guint32 replica)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(distribution != NULL, index);
+	g_return_val_if_fail(replica < distribution->replicas, index);
+
+	// Copies are stored on the following servers, so each copy is stored on a different server.
+	return (index + replica) % distribution->server_count;
+}
+
+gboolean
+j_distribution_get_erasure(JDistribution* distribution, guint32* data_blocks, guint32* parity_blocks, guint64* block_size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(distribution != NULL, FALSE);
+	g_return_val_if_fail(data_blocks != NULL, FALSE);
+	g_return_val_if_fail(parity_blocks != NULL, FALSE);
+	g_return_val_if_fail(block_size != NULL, FALSE);
+
+	if (j_distribution_vtables[distribution->type].distribution_get_erasure == NULL)
+	{
+		return FALSE;
+	}
+
+	return j_distribution_vtables[distribution->type].distribution_get_erasure(distribution->distribution, data_blocks, parity_blocks, block_size);
+}
+
+guint32
+j_distribution_get_group_index(JDistribution* distribution, guint64 group, guint32 position)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(distribution != NULL, 0);
+	g_return_val_if_fail(j_distribution_vtables[distribution->type].distribution_get_group_index != NULL, 0);
+
+	return j_distribution_vtables[distribution->type].distribution_get_group_index(distribution->distribution, group, position);
+}
+
 void
 j_distribution_reset(JDistribution* distribution, guint64 length, guint64 offset)
 {
@@ -188,6 +276,37 @@ j_distribution_distribute(JDistribution* distribution, guint* index, guint64* ne
 	return j_distribution_vtables[distribution->type].distribution_distribute(distribution->distribution, index, new_length, new_offset, block_id);
 }
 
+guint
+j_distribution_distribute_range(JDistribution* distribution, guint64 length, guint64 offset, GArray* chunks)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributionChunk chunk;
+	guint count = 0;
+	guint64 range_offset = 0;
+
+	g_return_val_if_fail(distribution != NULL, 0);
+	g_return_val_if_fail(chunks != NULL, 0);
+
+	if (j_distribution_vtables[distribution->type].distribution_distribute_range != NULL)
+	{
+		return j_distribution_vtables[distribution->type].distribution_distribute_range(distribution->distribution, length, offset, chunks);
+	}
+
+	j_distribution_vtables[distribution->type].distribution_reset(distribution->distribution, length, offset);
+
+	while (j_distribution_vtables[distribution->type].distribution_distribute(distribution->distribution, &(chunk.index), &(chunk.length), &(chunk.offset), &(chunk.block_id)))
+	{
+		chunk.range_offset = range_offset;
+		range_offset += chunk.length;
+
+		g_array_append_val(chunks, chunk);
+		count++;
+	}
+
+	return count;
+}
+
 bson_t*
 j_distribution_serialize(JDistribution* distribution)
 {
@@ -202,6 +321,12 @@ j_distribution_serialize(JDistribution* distribution)
 	bson_append_int32(b, "type", -1, distribution->type);
 	//bson_append_int64(b, "BlockSize", -1, distribution->block_size);
 
+	// Unreplicated distributions are serialized as before.
+	if (distribution->replicas > 1)
+	{
+		bson_append_int32(b, "replicas", -1, distribution->replicas);
+	}
+
 	j_distribution_vtables[distribution->type].distribution_serialize(distribution->distribution, b);
 
 	//bson_finish(b);
@@ -219,6 +344,8 @@ j_distribution_deserialize(JDistribution* distribution, bson_t const* b)
 	g_return_if_fail(distribution != NULL);
 	g_return_if_fail(b != NULL);
 
+	distribution->replicas = 1;
+
 	bson_iter_init(&iterator, b);
 
 	while (bson_iter_next(&iterator))
@@ -227,9 +354,48 @@ j_distribution_deserialize(JDistribution* distribution, bson_t const* b)
 
 		key = bson_iter_key(&iterator);
 
-		if (g_strcmp0(key, "type") == 0)
+		if (g_strcmp0(key, "replicas") == 0)
 		{
-			distribution->type = bson_iter_int32(&iterator);
+			gint32 replicas;
+
+			replicas = bson_iter_int32(&iterator);
+
+			// The data comes from storage or other clients, so it is validated like j_distribution_set() does.
+			if (replicas <= 0 || (guint32)replicas > distribution->server_count)
+			{
+				g_warning("Ignoring %d replicas for %u servers.", replicas, distribution->server_count);
+				continue;
+			}
+
+			distribution->replicas = replicas;
+		}
+		else if (g_strcmp0(key, "type") == 0)
+		{
+			JDistributionType type;
+			gint32 value;
+
+			value = bson_iter_int32(&iterator);
+
+			if (value < 0 || (guint)value >= G_N_ELEMENTS(j_distribution_vtables))
+			{
+				g_warning("Ignoring unknown distribution type %d.", value);
+				continue;
+			}
+
+			type = value;
+
+			// The actual distribution has to match the type, otherwise its fields would be misinterpreted.
+			if (type != distribution->type)
+			{
+				guint64 stripe_size;
+
+				stripe_size = j_configuration_get_stripe_size(j_configuration());
+
+				j_distribution_vtables[distribution->type].distribution_free(distribution->distribution);
+
+				distribution->type = type;
+				distribution->distribution = j_distribution_vtables[type].distribution_new(distribution->server_count, stripe_size);
+			}
 		}
 	}
 
@@ -253,6 +419,8 @@ j_distribution_check_vtables(void)
 
 		g_return_if_fail(j_distribution_vtables[i].distribution_reset != NULL);
 		g_return_if_fail(j_distribution_vtables[i].distribution_distribute != NULL);
+
+		g_return_if_fail(j_distribution_vtables[i].distribution_get_erasure == NULL || j_distribution_vtables[i].distribution_get_group_index != NULL);
 	}
 }
 
@@ -264,6 +432,8 @@ j_distribution_init(void)
 	j_distribution_round_robin_get_vtable(&(j_distribution_vtables[J_DISTRIBUTION_ROUND_ROBIN]));
 	j_distribution_single_server_get_vtable(&(j_distribution_vtables[J_DISTRIBUTION_SINGLE_SERVER]));
 	j_distribution_weighted_get_vtable(&(j_distribution_vtables[J_DISTRIBUTION_WEIGHTED]));
+	j_distribution_adaptive_get_vtable(&(j_distribution_vtables[J_DISTRIBUTION_ADAPTIVE]));
+	j_distribution_erasure_get_vtable(&(j_distribution_vtables[J_DISTRIBUTION_ERASURE]));
 
 	j_distribution_check_vtables();
 }
@@ -282,6 +452,54 @@ j_distribution_new_from_bson(bson_t const* b)
 	return distribution;
 }
 
+JDistribution*
+j_distribution_new_for_hint(guint64 size, JDistributionAccess access)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistribution* distribution;
+	guint64 stripe_size;
+	guint64 stripe_count;
+	guint server_count;
+
+	if (size == 0)
+	{
+		return j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	}
+
+	server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+	stripe_size = j_configuration_get_stripe_size(j_configuration());
+
+	if (access == J_DISTRIBUTION_ACCESS_SEQUENTIAL)
+	{
+		guint64 max_stripe_size;
+
+		// Grow the stripes until each server receives one, but stay within the maximum operation size.
+		max_stripe_size = j_configuration_get_max_operation_size(j_configuration());
+
+		while (stripe_size * 2 <= max_stripe_size && stripe_size * server_count < size)
+		{
+			stripe_size *= 2;
+		}
+	}
+
+	stripe_count = MIN(server_count, ((size - 1) / stripe_size) + 1);
+
+	if (stripe_count == 1)
+	{
+		distribution = j_distribution_new(J_DISTRIBUTION_SINGLE_SERVER);
+		j_distribution_set_block_size(distribution, stripe_size);
+
+		return distribution;
+	}
+
+	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	j_distribution_set_block_size(distribution, stripe_size);
+	j_distribution_set(distribution, "stripe-count", stripe_count);
+
+	return distribution;
+}
+
 JDistribution*
 j_distribution_new_for_configuration(JDistributionType type, JConfiguration* configuration)
 {
@@ -0,0 +1,522 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ **/
+
+#include <julea-config.h>
+
+#include <glib.h>
+
+#include <string.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define J_ERASURE_X86 1
+#include <immintrin.h>
+#endif
+
+#include <jerasure.h>
+
+#include <jtrace.h>
+
+/**
+ * \addtogroup JErasure Erasure Code
+ *
+ * @{
+ **/
+
+/**
+ * An erasure code.
+ **/
+struct JErasure
+{
+	/**
+	 * The number of data blocks.
+	 **/
+	guint32 data_blocks;
+
+	/**
+	 * The number of parity blocks.
+	 **/
+	guint32 parity_blocks;
+
+	/**
+	 * The coding matrix with one row per parity block and one column per data block.
+	 **/
+	guint8* matrix;
+
+	/**
+	 * The reference count.
+	 **/
+	gint ref_count;
+};
+
+/**
+ * Multiplies a region with a constant and adds it to another region.
+ *
+ * \param dst    The destination.
+ * \param src    The source.
+ * \param low    The products of the constant and all low nibbles.
+ * \param high   The products of the constant and all high nibbles.
+ * \param length The length.
+ **/
+typedef void (*JErasureMulAddFunc)(guint8* dst, guint8 const* src, guint8 const* low, guint8 const* high, gsize length);
+
+static guint8 j_erasure_exp[512];
+static guint8 j_erasure_log[256];
+
+static JErasureMulAddFunc j_erasure_mul_add_func = NULL;
+
+static guint8
+j_erasure_mul(guint8 a, guint8 b)
+{
+	if (a == 0 || b == 0)
+	{
+		return 0;
+	}
+
+	return j_erasure_exp[j_erasure_log[a] + j_erasure_log[b]];
+}
+
+static guint8
+j_erasure_inv(guint8 a)
+{
+	g_return_val_if_fail(a != 0, 0);
+
+	return j_erasure_exp[255 - j_erasure_log[a]];
+}
+
+/**
+ * Multiplies and adds using lookup tables.
+ *
+ * \private
+ *
+ * Splitting the multiplication into nibbles allows the same tables to be used by the vectorized versions.
+ **/
+static void
+j_erasure_mul_add_scalar(guint8* dst, guint8 const* src, guint8 const* low, guint8 const* high, gsize length)
+{
+	for (gsize i = 0; i < length; i++)
+	{
+		dst[i] ^= low[src[i] & 0x0f] ^ high[src[i] >> 4];
+	}
+}
+
+#ifdef J_ERASURE_X86
+__attribute__((target("ssse3"))) static void
+j_erasure_mul_add_ssse3(guint8* dst, guint8 const* src, guint8 const* low, guint8 const* high, gsize length)
+{
+	__m128i const mask = _mm_set1_epi8(0x0f);
+	__m128i const low_table = _mm_loadu_si128((__m128i const*)(gconstpointer)low);
+	__m128i const high_table = _mm_loadu_si128((__m128i const*)(gconstpointer)high);
+	gsize i = 0;
+
+	for (; i + 16 <= length; i += 16)
+	{
+		__m128i s;
+		__m128i d;
+		__m128i product;
+
+		s = _mm_loadu_si128((__m128i const*)(gconstpointer)(src + i));
+		d = _mm_loadu_si128((__m128i const*)(gpointer)(dst + i));
+
+		product = _mm_xor_si128(_mm_shuffle_epi8(low_table, _mm_and_si128(s, mask)), _mm_shuffle_epi8(high_table, _mm_and_si128(_mm_srli_epi64(s, 4), mask)));
+		_mm_storeu_si128((__m128i*)(gpointer)(dst + i), _mm_xor_si128(d, product));
+	}
+
+	j_erasure_mul_add_scalar(dst + i, src + i, low, high, length - i);
+}
+
+__attribute__((target("avx2"))) static void
+j_erasure_mul_add_avx2(guint8* dst, guint8 const* src, guint8 const* low, guint8 const* high, gsize length)
+{
+	__m256i const mask = _mm256_set1_epi8(0x0f);
+	__m256i const low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*)(gconstpointer)low));
+	__m256i const high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i const*)(gconstpointer)high));
+	gsize i = 0;
+
+	for (; i + 32 <= length; i += 32)
+	{
+		__m256i s;
+		__m256i d;
+		__m256i product;
+
+		s = _mm256_loadu_si256((__m256i const*)(gconstpointer)(src + i));
+		d = _mm256_loadu_si256((__m256i const*)(gpointer)(dst + i));
+
+		product = _mm256_xor_si256(_mm256_shuffle_epi8(low_table, _mm256_and_si256(s, mask)), _mm256_shuffle_epi8(high_table, _mm256_and_si256(_mm256_srli_epi64(s, 4), mask)));
+		_mm256_storeu_si256((__m256i*)(gpointer)(dst + i), _mm256_xor_si256(d, product));
+	}
+
+	j_erasure_mul_add_scalar(dst + i, src + i, low, high, length - i);
+}
+#endif
+
+/**
+ * Initializes the Galois field tables and selects the fastest kernel.
+ *
+ * \private
+ **/
+static void
+j_erasure_init(void)
+{
+	static gsize initialized = 0;
+
+	if (g_once_init_enter(&initialized))
+	{
+		guint x = 1;
+
+		// Use the primitive polynomial x^8 + x^4 + x^3 + x^2 + 1.
+		for (guint i = 0; i < 255; i++)
+		{
+			j_erasure_exp[i] = x;
+			j_erasure_exp[i + 255] = x;
+			j_erasure_log[x] = i;
+
+			x <<= 1;
+
+			if (x & 0x100)
+			{
+				x ^= 0x11d;
+			}
+		}
+
+		j_erasure_exp[510] = j_erasure_exp[0];
+		j_erasure_exp[511] = j_erasure_exp[1];
+		j_erasure_log[0] = 0;
+
+		j_erasure_mul_add_func = j_erasure_mul_add_scalar;
+
+#ifdef J_ERASURE_X86
+		__builtin_cpu_init();
+
+		if (__builtin_cpu_supports("avx2"))
+		{
+			j_erasure_mul_add_func = j_erasure_mul_add_avx2;
+		}
+		else if (__builtin_cpu_supports("ssse3"))
+		{
+			j_erasure_mul_add_func = j_erasure_mul_add_ssse3;
+		}
+#endif
+
+		g_once_init_leave(&initialized, 1);
+	}
+}
+
+/**
+ * Multiplies a region with a constant and adds it to another region.
+ *
+ * \private
+ *
+ * \param dst      The destination.
+ * \param src      The source.
+ * \param constant The constant.
+ * \param length   The length.
+ **/
+static void
+j_erasure_mul_add(guint8* dst, guint8 const* src, guint8 constant, gsize length)
+{
+	guint8 low[16];
+	guint8 high[16];
+
+	if (constant == 0)
+	{
+		return;
+	}
+
+	for (guint i = 0; i < 16; i++)
+	{
+		low[i] = j_erasure_mul(constant, i);
+		high[i] = j_erasure_mul(constant, i << 4);
+	}
+
+	j_erasure_mul_add_func(dst, src, low, high, length);
+}
+
+/**
+ * Inverts a square matrix in place.
+ *
+ * \private
+ *
+ * \param matrix The matrix.
+ * \param n      The number of rows and columns.
+ *
+ * \return TRUE on success, FALSE if the matrix is singular.
+ **/
+static gboolean
+j_erasure_invert(guint8* matrix, guint32 n)
+{
+	g_autofree guint8* inverse = NULL;
+
+	inverse = g_new0(guint8, n * n);
+
+	for (guint32 i = 0; i < n; i++)
+	{
+		inverse[i * n + i] = 1;
+	}
+
+	// Gauss-Jordan elimination, addition and subtraction are both XOR.
+	for (guint32 column = 0; column < n; column++)
+	{
+		guint32 pivot = column;
+		guint8 factor;
+
+		while (pivot < n && matrix[pivot * n + column] == 0)
+		{
+			pivot++;
+		}
+
+		if (pivot == n)
+		{
+			return FALSE;
+		}
+
+		if (pivot != column)
+		{
+			for (guint32 i = 0; i < n; i++)
+			{
+				guint8 tmp;
+
+				tmp = matrix[pivot * n + i];
+				matrix[pivot * n + i] = matrix[column * n + i];
+				matrix[column * n + i] = tmp;
+
+				tmp = inverse[pivot * n + i];
+				inverse[pivot * n + i] = inverse[column * n + i];
+				inverse[column * n + i] = tmp;
+			}
+		}
+
+		factor = j_erasure_inv(matrix[column * n + column]);
+
+		for (guint32 i = 0; i < n; i++)
+		{
+			matrix[column * n + i] = j_erasure_mul(matrix[column * n + i], factor);
+			inverse[column * n + i] = j_erasure_mul(inverse[column * n + i], factor);
+		}
+
+		for (guint32 row = 0; row < n; row++)
+		{
+			if (row == column || matrix[row * n + column] == 0)
+			{
+				continue;
+			}
+
+			factor = matrix[row * n + column];
+
+			for (guint32 i = 0; i < n; i++)
+			{
+				matrix[row * n + i] ^= j_erasure_mul(matrix[column * n + i], factor);
+				inverse[row * n + i] ^= j_erasure_mul(inverse[column * n + i], factor);
+			}
+		}
+	}
+
+	memcpy(matrix, inverse, n * n);
+
+	return TRUE;
+}
+
+JErasure*
+j_erasure_new(guint32 data_blocks, guint32 parity_blocks)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JErasure* erasure;
+
+	g_return_val_if_fail(data_blocks > 0, NULL);
+	g_return_val_if_fail(data_blocks + parity_blocks <= 256, NULL);
+
+	j_erasure_init();
+
+	erasure = g_slice_new(JErasure);
+	erasure->data_blocks = data_blocks;
+	erasure->parity_blocks = parity_blocks;
+	erasure->matrix = g_new(guint8, MAX(parity_blocks * data_blocks, 1));
+	erasure->ref_count = 1;
+
+	/**
+	 * Every square submatrix of a Cauchy matrix is invertible, so any data_blocks blocks suffice for reconstruction.
+	 * Scaling the columns keeps this property and turns the first parity block into the XOR of all data blocks.
+	 */
+	for (guint32 i = 0; i < parity_blocks; i++)
+	{
+		for (guint32 j = 0; j < data_blocks; j++)
+		{
+			guint8 cauchy;
+
+			cauchy = j_erasure_inv(i ^ (parity_blocks + j));
+
+			// The first row's elements are 1 / (parity_blocks + j), so scale by their inverse.
+			erasure->matrix[i * data_blocks + j] = j_erasure_mul(cauchy, parity_blocks + j);
+		}
+	}
+
+	return erasure;
+}
+
+JErasure*
+j_erasure_ref(JErasure* erasure)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(erasure != NULL, NULL);
+
+	g_atomic_int_inc(&(erasure->ref_count));
+
+	return erasure;
+}
+
+void
+j_erasure_unref(JErasure* erasure)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(erasure != NULL);
+
+	if (g_atomic_int_dec_and_test(&(erasure->ref_count)))
+	{
+		g_free(erasure->matrix);
+
+		g_slice_free(JErasure, erasure);
+	}
+}
+
+void
+j_erasure_encode(JErasure* erasure, gconstpointer const* data, gpointer* parity, gsize length)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(erasure != NULL);
+	g_return_if_fail(data != NULL);
+	g_return_if_fail(parity != NULL || erasure->parity_blocks == 0);
+
+	for (guint32 i = 0; i < erasure->parity_blocks; i++)
+	{
+		memset(parity[i], 0, length);
+
+		for (guint32 j = 0; j < erasure->data_blocks; j++)
+		{
+			j_erasure_mul_add(parity[i], data[j], erasure->matrix[i * erasure->data_blocks + j], length);
+		}
+	}
+}
+
+gboolean
+j_erasure_decode(JErasure* erasure, gpointer* blocks, gboolean const* present, gsize length)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autofree guint8* matrix = NULL;
+	g_autofree guint32* rows = NULL;
+	guint32 k;
+	guint32 found = 0;
+	gboolean parity_missing = FALSE;
+
+	g_return_val_if_fail(erasure != NULL, FALSE);
+	g_return_val_if_fail(blocks != NULL, FALSE);
+	g_return_val_if_fail(present != NULL, FALSE);
+
+	k = erasure->data_blocks;
+	rows = g_new(guint32, k);
+
+	// Use the first data_blocks blocks that are present, preferring data blocks since they are cheaper to use.
+	for (guint32 i = 0; i < k + erasure->parity_blocks && found < k; i++)
+	{
+		if (present[i])
+		{
+			rows[found] = i;
+			found++;
+		}
+	}
+
+	if (found < k)
+	{
+		return FALSE;
+	}
+
+	if (rows[k - 1] >= k)
+	{
+		matrix = g_new0(guint8, k * k);
+
+		for (guint32 r = 0; r < k; r++)
+		{
+			if (rows[r] < k)
+			{
+				matrix[r * k + rows[r]] = 1;
+			}
+			else
+			{
+				memcpy(matrix + r * k, erasure->matrix + (rows[r] - k) * k, k);
+			}
+		}
+
+		if (!j_erasure_invert(matrix, k))
+		{
+			return FALSE;
+		}
+
+		// Each missing data block is a linear combination of the blocks that are present.
+		for (guint32 j = 0; j < k; j++)
+		{
+			if (present[j])
+			{
+				continue;
+			}
+
+			memset(blocks[j], 0, length);
+
+			for (guint32 r = 0; r < k; r++)
+			{
+				j_erasure_mul_add(blocks[j], blocks[rows[r]], matrix[j * k + r], length);
+			}
+		}
+	}
+
+	for (guint32 i = 0; i < erasure->parity_blocks; i++)
+	{
+		parity_missing = parity_missing || !present[k + i];
+	}
+
+	// With all data blocks available, missing parity blocks can simply be recomputed.
+	if (parity_missing)
+	{
+		for (guint32 i = 0; i < erasure->parity_blocks; i++)
+		{
+			if (present[k + i])
+			{
+				continue;
+			}
+
+			memset(blocks[k + i], 0, length);
+
+			for (guint32 j = 0; j < k; j++)
+			{
+				j_erasure_mul_add(blocks[k + i], blocks[j], erasure->matrix[i * k + j], length);
+			}
+		}
+	}
+
+	return TRUE;
+}
+
+/**
+ * @}
+ **/
@@ -0,0 +1,292 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * \file
+ **/
+
+#include <julea-config.h>
+
+#include <glib.h>
+
+#include <jhash-ring.h>
+
+#include <jconfiguration.h>
+#include <jtrace.h>
+
+/**
+ * \addtogroup JHashRing Hash Ring
+ *
+ * @{
+ **/
+
+/**
+ * A virtual node.
+ **/
+struct JHashRingNode
+{
+	/**
+	 * The node's position on the ring.
+	 **/
+	guint32 hash;
+
+	/**
+	 * The server index.
+	 **/
+	guint32 index;
+};
+
+typedef struct JHashRingNode JHashRingNode;
+
+/**
+ * A hash ring.
+ **/
+struct JHashRing
+{
+	/**
+	 * The virtual nodes, sorted by their position.
+	 **/
+	GArray* nodes;
+
+	/**
+	 * The number of virtual nodes per unit of weight.
+	 **/
+	guint32 virtual_nodes;
+
+	/**
+	 * The reference count.
+	 **/
+	gint ref_count;
+};
+
+/**
+ * Hashes a string.
+ *
+ * \private
+ *
+ * j_helper_hash() produces similar values for similar strings, which would cluster the virtual nodes.
+ * Therefore, FNV-1a is used and its result is mixed using MurmurHash3's finalizer.
+ *
+ * \param str A string.
+ *
+ * \return The hash.
+ **/
+static guint32
+j_hash_ring_hash(gchar const* str)
+{
+	guint32 hash = 2166136261U;
+
+	for (guchar const* c = (guchar const*)str; *c != '\0'; c++)
+	{
+		hash ^= *c;
+		hash *= 16777619U;
+	}
+
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35U;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+static gint
+j_hash_ring_node_compare(gconstpointer a, gconstpointer b)
+{
+	JHashRingNode const* node_a = a;
+	JHashRingNode const* node_b = b;
+
+	if (node_a->hash != node_b->hash)
+	{
+		return (node_a->hash < node_b->hash) ? -1 : 1;
+	}
+
+	// Make collisions deterministic.
+	if (node_a->index != node_b->index)
+	{
+		return (node_a->index < node_b->index) ? -1 : 1;
+	}
+
+	return 0;
+}
+
+JHashRing*
+j_hash_ring_new(guint32 virtual_nodes)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JHashRing* ring;
+
+	g_return_val_if_fail(virtual_nodes > 0, NULL);
+
+	ring = g_slice_new(JHashRing);
+	ring->nodes = g_array_new(FALSE, FALSE, sizeof(JHashRingNode));
+	ring->virtual_nodes = virtual_nodes;
+	ring->ref_count = 1;
+
+	return ring;
+}
+
+JHashRing*
+j_hash_ring_new_for_configuration(JConfiguration* configuration, JBackendType backend)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JHashRing* ring;
+	guint32 server_count;
+
+	g_return_val_if_fail(configuration != NULL, NULL);
+
+	ring = j_hash_ring_new(j_configuration_get_virtual_nodes(configuration));
+	server_count = j_configuration_get_server_count(configuration, backend);
+
+	for (guint32 i = 0; i < server_count; i++)
+	{
+		g_autofree gchar* name = NULL;
+		gchar const* server;
+		guint32 occurrence = 0;
+
+		server = j_configuration_get_server(configuration, backend, i);
+
+		// The same server might be listed multiple times, for instance, when running several servers on one host.
+		for (guint32 j = 0; j < i; j++)
+		{
+			if (g_strcmp0(server, j_configuration_get_server(configuration, backend, j)) == 0)
+			{
+				occurrence++;
+			}
+		}
+
+		if (occurrence > 0)
+		{
+			name = g_strdup_printf("%s/%u", server, occurrence);
+		}
+		else
+		{
+			name = g_strdup(server);
+		}
+
+		j_hash_ring_add(ring, name, i, j_configuration_get_server_weight(configuration, backend, i));
+	}
+
+	return ring;
+}
+
+JHashRing*
+j_hash_ring_ref(JHashRing* ring)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(ring != NULL, NULL);
+
+	g_atomic_int_inc(&(ring->ref_count));
+
+	return ring;
+}
+
+void
+j_hash_ring_unref(JHashRing* ring)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_if_fail(ring != NULL);
+
+	if (g_atomic_int_dec_and_test(&(ring->ref_count)))
+	{
+		g_array_unref(ring->nodes);
+
+		g_slice_free(JHashRing, ring);
+	}
+}
+
+void
+j_hash_ring_add(JHashRing* ring, gchar const* name, guint32 index, guint32 weight)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	guint32 count;
+
+	g_return_if_fail(ring != NULL);
+	g_return_if_fail(name != NULL);
+	g_return_if_fail(weight == 0 || ring->virtual_nodes <= G_MAXUINT32 / weight);
+
+	count = ring->virtual_nodes * weight;
+
+	for (guint32 i = 0; i < count; i++)
+	{
+		g_autofree gchar* node_name = NULL;
+		JHashRingNode node;
+
+		node_name = g_strdup_printf("%s#%u", name, i);
+
+		node.hash = j_hash_ring_hash(node_name);
+		node.index = index;
+
+		g_array_append_val(ring->nodes, node);
+	}
+
+	g_array_sort(ring->nodes, j_hash_ring_node_compare);
+}
+
+guint32
+j_hash_ring_get(JHashRing* ring, gchar const* key)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JHashRingNode const* nodes;
+	guint32 hash;
+	guint left;
+	guint right;
+
+	g_return_val_if_fail(ring != NULL, 0);
+	g_return_val_if_fail(ring->nodes->len > 0, 0);
+	g_return_val_if_fail(key != NULL, 0);
+
+	nodes = (JHashRingNode const*)(gpointer)ring->nodes->data;
+	hash = j_hash_ring_hash(key);
+	left = 0;
+	right = ring->nodes->len;
+
+	// Find the first virtual node at or after the key's position.
+	while (left < right)
+	{
+		guint middle = left + (right - left) / 2;
+
+		if (nodes[middle].hash < hash)
+		{
+			left = middle + 1;
+		}
+		else
+		{
+			right = middle;
+		}
+	}
+
+	// Wrap around at the end of the ring.
+	if (left == ring->nodes->len)
+	{
+		left = 0;
+	}
+
+	return nodes[left].index;
+}
+
+/**
+ * @}
+ **/
@@ -24,10 +24,12 @@
 
 #include <glib.h>
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <jmemory-chunk.h>
 
+#include <jhelper.h>
 #include <jtrace.h>
 
 /**
@@ -68,7 +70,8 @@ j_memory_chunk_new(guint64 size)
 
 	cache = g_slice_new(JMemoryChunk);
 	cache->size = size;
-	cache->data = g_malloc(cache->size);
+	// aligned_alloc() requires the size to be a multiple of the alignment.
+	cache->data = j_helper_alloc_aligned(J_MEMORY_CHUNK_ALIGNMENT, (size + J_MEMORY_CHUNK_ALIGNMENT - 1) / J_MEMORY_CHUNK_ALIGNMENT * J_MEMORY_CHUNK_ALIGNMENT);
 	cache->current = cache->data;
 
 	return cache;
@@ -83,7 +86,7 @@ j_memory_chunk_free(JMemoryChunk* cache)
 
 	if (cache->data != NULL)
 	{
-		g_free(cache->data);
+		free(cache->data);
 	}
 
 	g_slice_free(JMemoryChunk, cache);
@@ -94,17 +97,33 @@ j_memory_chunk_get(JMemoryChunk* cache, guint64 length)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	gpointer ret = NULL;
+	gchar* current;
 
 	g_return_val_if_fail(cache != NULL, NULL);
 
-	if (cache->current + length > cache->data + cache->size)
+	current = cache->current;
+
+	// Large segments are aligned so that they can be used for direct I/O.
+	if (length >= J_MEMORY_CHUNK_ALIGNMENT)
+	{
+		guint64 displacement;
+
+		displacement = (current - cache->data) % J_MEMORY_CHUNK_ALIGNMENT;
+
+		if (displacement > 0)
+		{
+			current += J_MEMORY_CHUNK_ALIGNMENT - displacement;
+		}
+	}
+
+	if (length > (guint64)(cache->data + cache->size - current))
 	{
 		return NULL;
 	}
 
-	ret = cache->current;
-	cache->current += length;
+	cache->current = current + length;
+
+	return current;
 
 	return ret;
 }
@@ -73,6 +73,12 @@ struct JMessageData
 	 * The data length.
 	 **/
 	guint64 length;
+
+	/**
+	 * The function to release the data, NULL if the data is not owned by the message.
+	 **/
+	GDestroyNotify free_func;
+	gpointer free_data;
 };
 
 typedef struct JMessageData JMessageData;
@@ -186,7 +192,14 @@ j_message_data_free(gpointer data)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	g_slice_free(JMessageData, data);
+	JMessageData* message_data = data;
+
+	if (message_data->free_func != NULL)
+	{
+		message_data->free_func(message_data->free_data);
+	}
+
+	g_slice_free(JMessageData, message_data);
 }
 
 /**
@@ -679,6 +692,49 @@ j_message_write(JMessage* message, GOutputStream* stream)
 	g_return_val_if_fail(message != NULL, FALSE);
 	g_return_val_if_fail(stream != NULL, FALSE);
 
+#if GLIB_CHECK_VERSION(2, 60, 0)
+	{
+		g_autoptr(GArray) vectors = NULL;
+		GOutputVector vector;
+
+		// Write the header, the data and the additional data with as few system calls as possible.
+		vectors = g_array_sized_new(FALSE, FALSE, sizeof(GOutputVector), 2 + ((message->send_list != NULL) ? j_list_length(message->send_list) : 0));
+
+		vector.buffer = &(message->header);
+		vector.size = sizeof(JMessageHeader);
+		g_array_append_val(vectors, vector);
+
+		vector.buffer = message->data;
+		vector.size = j_message_length(message);
+		g_array_append_val(vectors, vector);
+
+		if (message->send_list != NULL)
+		{
+			iterator = j_list_iterator_new(message->send_list);
+
+			while (j_list_iterator_next(iterator))
+			{
+				JMessageData* message_data = j_list_iterator_get(iterator);
+
+				vector.buffer = message_data->data;
+				vector.size = message_data->length;
+				g_array_append_val(vectors, vector);
+			}
+		}
+
+		if (!g_output_stream_writev_all(stream, (GOutputVector*)vectors->data, vectors->len, &bytes_written, NULL, &error))
+		{
+			goto end;
+		}
+
+		g_output_stream_flush(stream, NULL, NULL);
+
+		ret = TRUE;
+
+		goto end;
+	}
+#endif
+
 	if (!g_output_stream_write_all(stream, &(message->header), sizeof(JMessageHeader), &bytes_written, NULL, &error) || bytes_written != sizeof(JMessageHeader))
 	{
 		goto end;
@@ -723,6 +779,14 @@ j_message_add_send(JMessage* message, gconstpointer data, guint64 length)
 {
 	J_TRACE_FUNCTION(NULL);
 
+	j_message_add_send_full(message, data, length, NULL, NULL);
+}
+
+void
+j_message_add_send_full(JMessage* message, gconstpointer data, guint64 length, GDestroyNotify free_func, gpointer free_data)
+{
+	J_TRACE_FUNCTION(NULL);
+
 	JMessageData* message_data;
 
 	g_return_if_fail(message != NULL);
@@ -732,6 +796,8 @@ j_message_add_send(JMessage* message, gconstpointer data, guint64 length)
 	message_data = g_slice_new(JMessageData);
 	message_data->data = data;
 	message_data->length = length;
+	message_data->free_func = free_func;
+	message_data->free_data = free_data;
 
 	j_list_append(message->send_list, message_data);
 }
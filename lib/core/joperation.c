@@ -46,6 +46,8 @@ j_operation_new(void)
 	operation->data = NULL;
 	operation->exec_func = NULL;
 	operation->free_func = NULL;
+	operation->compound_exec_func = NULL;
+	operation->compound_position = 0;
 
 	return operation;
 }
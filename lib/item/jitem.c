@@ -186,6 +186,60 @@ j_item_create(JCollection* collection, gchar const* name, JDistribution* distrib
 	return item;
 }
 
+JItem*
+j_item_create_for_hint(JCollection* collection, gchar const* name, guint64 size, JDistributionAccess access, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistribution* distribution;
+	JItem* item;
+
+	g_return_val_if_fail(collection != NULL, NULL);
+	g_return_val_if_fail(name != NULL, NULL);
+
+	distribution = j_distribution_new_for_hint(size, access);
+
+	// The item takes over the distribution.
+	if ((item = j_item_create(collection, name, distribution, batch)) == NULL)
+	{
+		j_distribution_unref(distribution);
+	}
+
+	return item;
+}
+
+JItem*
+j_item_copy(JItem* item, JCollection* collection, gchar const* name, guint64* bytes_copied, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistribution* distribution;
+	JItem* copy;
+	bson_t* b_distribution;
+
+	g_return_val_if_fail(item != NULL, NULL);
+	g_return_val_if_fail(collection != NULL, NULL);
+	g_return_val_if_fail(name != NULL, NULL);
+	g_return_val_if_fail(bytes_copied != NULL, NULL);
+
+	// Servers can only copy their parts locally if both items use the same distribution.
+	// The copy gets its own instance, since distributions keep iteration state.
+	b_distribution = j_distribution_serialize(item->distribution);
+	distribution = j_distribution_new_from_bson(b_distribution);
+	bson_destroy(b_distribution);
+
+	// The item takes over the distribution.
+	if ((copy = j_item_create(collection, name, distribution, batch)) == NULL)
+	{
+		j_distribution_unref(distribution);
+		return NULL;
+	}
+
+	j_distributed_object_copy(item->object, copy->object, bytes_copied, batch);
+
+	return copy;
+}
+
 static void
 j_item_get_callback(gpointer value, guint32 len, gpointer data_)
 {
@@ -31,6 +31,94 @@
 
 #include <julea.h>
 
+/**
+ * A key-value pair of a page.
+ **/
+struct JKVIteratorPair
+{
+	gchar const* key;
+	gconstpointer value;
+	guint32 len;
+};
+
+typedef struct JKVIteratorPair JKVIteratorPair;
+
+/**
+ * A page of key-value pairs received from a server.
+ **/
+struct JKVIteratorPage
+{
+	JMessage* reply;
+
+	/**
+	 * The page's pairs, which point into the reply.
+	 **/
+	GArray* pairs;
+
+	/**
+	 * The cursor for the next page, 0 if the server has no more pairs.
+	 **/
+	guint64 cursor;
+};
+
+typedef struct JKVIteratorPage JKVIteratorPage;
+
+/**
+ * The bounds of a range scan.
+ **/
+struct JKVIteratorRange
+{
+	/**
+	 * The first key (inclusive), NULL for no lower bound.
+	 **/
+	gchar* start;
+
+	/**
+	 * The last key (exclusive), NULL for no upper bound.
+	 **/
+	gchar* end;
+
+	/**
+	 * The maximum number of pairs, 0 for no limit.
+	 **/
+	guint32 limit;
+
+	gboolean reverse;
+};
+
+typedef struct JKVIteratorRange JKVIteratorRange;
+
+/**
+ * The state of a server's cursor.
+ **/
+struct JKVIteratorServer
+{
+	guint32 index;
+
+	gchar const* namespace;
+	gchar const* prefix;
+
+	/**
+	 * The range to scan, NULL if the prefix is used.
+	 **/
+	JKVIteratorRange const* range;
+
+	/**
+	 * The cursor for the next page, 0 if no page has been requested yet.
+	 **/
+	guint64 cursor;
+
+	/**
+	 * The request for the next page, NULL if there are no more pages.
+	 **/
+	JBackgroundOperation* prefetch;
+
+	JKVIteratorPage* page;
+	guint position;
+};
+
+typedef struct JKVIteratorServer JKVIteratorServer;
+
 /**
  * \ingroup JKVIterator
  **/
@@ -54,59 +142,214 @@ struct JKVIterator
 	gconstpointer value;
 	guint32 len;
 
-	JMessage** replies;
-	guint32 replies_n;
-	guint32 replies_cur;
+	gchar* namespace;
+	gchar* prefix;
+
+	/**
+	 * The range to scan, NULL if the prefix is used.
+	 * The servers' pairs are merged to return them in order.
+	 **/
+	JKVIteratorRange* range;
+
+	/**
+	 * The number of pairs returned so far.
+	 **/
+	guint32 count;
+
+	JKVIteratorServer* servers;
+	guint32 servers_n;
+	guint32 servers_cur;
 
 	gboolean done;
 };
 
-static JMessage*
-fetch_reply(guint32 index, gchar const* namespace, gchar const* prefix)
+static void
+j_kv_iterator_page_free(JKVIteratorPage* page)
 {
 	J_TRACE_FUNCTION(NULL);
 
+	j_message_unref(page->reply);
+	g_array_unref(page->pairs);
+
+	g_slice_free(JKVIteratorPage, page);
+}
+
+/**
+ * Fetches a server's next page.
+ * The first page is requested using the namespace and prefix, later pages using the cursor.
+ *
+ * \param data A JKVIteratorServer.
+ *
+ * \return The page.
+ **/
+static gpointer
+j_kv_iterator_fetch(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVIteratorServer* server = data;
+
 	g_autoptr(JMessage) message = NULL;
-	JMessage* reply;
-	JMessageType message_type;
+	JKVIteratorPage* page;
 	gpointer kv_connection;
-	gsize namespace_len;
-	gsize prefix_len;
 
-	namespace_len = strlen(namespace) + 1;
+	if (server->cursor == 0 && server->range != NULL)
+	{
+		JKVIteratorRange const* range = server->range;
+		guint8 flags = 0;
+		gsize namespace_len;
+		gsize start_len = 0;
+		gsize end_len = 0;
+
+		namespace_len = strlen(server->namespace) + 1;
+
+		if (range->start != NULL)
+		{
+			flags |= J_MESSAGE_KV_RANGE_START;
+			start_len = strlen(range->start) + 1;
+		}
+
+		if (range->end != NULL)
+		{
+			flags |= J_MESSAGE_KV_RANGE_END;
+			end_len = strlen(range->end) + 1;
+		}
+
+		if (range->reverse)
+		{
+			flags |= J_MESSAGE_KV_RANGE_REVERSE;
+		}
 
-	if (prefix == NULL)
+		message = j_message_new(J_MESSAGE_KV_GET_RANGE, namespace_len + 1 + 4 + start_len + end_len);
+		j_message_append_n(message, server->namespace, namespace_len);
+		j_message_append_1(message, &flags);
+		j_message_append_4(message, &(range->limit));
+
+		if (range->start != NULL)
+		{
+			j_message_append_n(message, range->start, start_len);
+		}
+
+		if (range->end != NULL)
+		{
+			j_message_append_n(message, range->end, end_len);
+		}
+	}
+	else if (server->cursor == 0)
 	{
-		message_type = J_MESSAGE_KV_GET_ALL;
-		prefix_len = 0;
+		JMessageType message_type;
+		gsize namespace_len;
+		gsize prefix_len;
+
+		namespace_len = strlen(server->namespace) + 1;
+
+		if (server->prefix == NULL)
+		{
+			message_type = J_MESSAGE_KV_GET_ALL;
+			prefix_len = 0;
+		}
+		else
+		{
+			message_type = J_MESSAGE_KV_GET_BY_PREFIX;
+			prefix_len = strlen(server->prefix) + 1;
+		}
+
+		message = j_message_new(message_type, namespace_len + prefix_len);
+		j_message_append_n(message, server->namespace, namespace_len);
+
+		if (server->prefix != NULL)
+		{
+			j_message_append_n(message, server->prefix, prefix_len);
+		}
 	}
 	else
 	{
-		message_type = J_MESSAGE_KV_GET_BY_PREFIX;
-		prefix_len = strlen(prefix) + 1;
+		gchar type = J_BACKEND_TYPE_KV;
+
+		message = j_message_new(J_MESSAGE_CURSOR_NEXT, sizeof(server->cursor) + 1);
+		j_message_append_8(message, &(server->cursor));
+		j_message_append_1(message, &type);
 	}
 
-	message = j_message_new(message_type, namespace_len + prefix_len);
-	j_message_append_n(message, namespace, namespace_len);
+	page = g_slice_new(JKVIteratorPage);
+	page->reply = j_message_new_reply(message);
+	page->pairs = g_array_new(FALSE, FALSE, sizeof(JKVIteratorPair));
 
-	if (prefix != NULL)
+	kv_connection = j_connection_pool_pop(J_BACKEND_TYPE_KV, server->index);
+	j_message_send(message, kv_connection);
+	j_message_receive(page->reply, kv_connection);
+	j_connection_pool_push(J_BACKEND_TYPE_KV, server->index, kv_connection);
+
+	// The pairs are parsed here, so that the cursor at the end of the page is known immediately.
+	while (TRUE)
 	{
-		j_message_append_n(message, prefix, prefix_len);
+		JKVIteratorPair pair;
+
+		pair.len = j_message_get_4(page->reply);
+
+		if (pair.len == 0)
+		{
+			break;
+		}
+
+		pair.value = j_message_get_n(page->reply, pair.len);
+		pair.key = j_message_get_string(page->reply);
+
+		g_array_append_val(page->pairs, pair);
 	}
 
-	kv_connection = j_connection_pool_pop(J_BACKEND_TYPE_KV, index);
-	j_message_send(message, kv_connection);
+	page->cursor = j_message_get_8(page->reply);
 
-	reply = j_message_new_reply(message);
-	j_message_receive(reply, kv_connection);
+	return page;
+}
+
+/**
+ * Returns a server's current pair without consuming it.
+ * Pages are waited for and prefetched as necessary.
+ *
+ * \param server A JKVIteratorServer.
+ *
+ * \return The current pair, NULL if the server has no more pairs.
+ **/
+static JKVIteratorPair*
+j_kv_iterator_server_peek(JKVIteratorServer* server)
+{
+	J_TRACE_FUNCTION(NULL);
 
-	j_connection_pool_push(J_BACKEND_TYPE_KV, index, kv_connection);
+	while (TRUE)
+	{
+		if (server->page != NULL && server->position < server->page->pairs->len)
+		{
+			return &g_array_index(server->page->pairs, JKVIteratorPair, server->position);
+		}
 
-	return reply;
+		if (server->page != NULL)
+		{
+			j_kv_iterator_page_free(server->page);
+			server->page = NULL;
+		}
+
+		if (server->prefetch == NULL)
+		{
+			return NULL;
+		}
+
+		server->page = j_background_operation_wait(server->prefetch);
+		server->position = 0;
+		server->cursor = server->page->cursor;
+		j_background_operation_unref(server->prefetch);
+		server->prefetch = NULL;
+
+		// Request the next page while this one is being consumed.
+		if (server->cursor != 0)
+		{
+			server->prefetch = j_background_operation_new(j_kv_iterator_fetch, server);
+		}
+	}
 }
 
-JKVIterator*
-j_kv_iterator_new(gchar const* namespace, gchar const* prefix)
+static JKVIterator*
+j_kv_iterator_new_internal(gboolean for_index, guint32 index, gchar const* namespace, gchar const* prefix, JKVIteratorRange* range)
 {
 	J_TRACE_FUNCTION(NULL);
 
@@ -114,8 +357,6 @@ j_kv_iterator_new(gchar const* namespace, gchar const* prefix)
 
 	JConfiguration* configuration = j_configuration();
 
-	g_return_val_if_fail(namespace != NULL, NULL);
-
 	/// \todo still necessary?
 	//j_operation_cache_flush();
 
@@ -125,27 +366,57 @@ j_kv_iterator_new(gchar const* namespace, gchar const* prefix)
 	iterator->key = NULL;
 	iterator->value = NULL;
 	iterator->len = 0;
-	iterator->replies_n = j_configuration_get_server_count(configuration, J_BACKEND_TYPE_KV);
-	iterator->replies = g_new0(JMessage*, iterator->replies_n);
-	iterator->replies_cur = 0;
+	iterator->namespace = g_strdup(namespace);
+	iterator->prefix = g_strdup(prefix);
+	iterator->range = range;
+	iterator->count = 0;
+	iterator->servers_n = 0;
+	iterator->servers = NULL;
+	iterator->servers_cur = 0;
 	iterator->done = (iterator->kv_backend == NULL);
 
 	if (iterator->kv_backend == NULL)
 	{
-		for (guint32 i = 0; i < iterator->replies_n; i++)
+		iterator->servers_n = (for_index) ? 1 : j_configuration_get_server_count(configuration, J_BACKEND_TYPE_KV);
+		iterator->servers = g_new0(JKVIteratorServer, iterator->servers_n);
+
+		// The first pages of all servers are fetched in parallel.
+		for (guint32 i = 0; i < iterator->servers_n; i++)
 		{
-			iterator->replies[i] = fetch_reply(i, namespace, prefix);
+			JKVIteratorServer* server = &(iterator->servers[i]);
+
+			server->index = (for_index) ? index : i;
+			server->namespace = iterator->namespace;
+			server->prefix = iterator->prefix;
+			server->range = iterator->range;
+			server->cursor = 0;
+			server->page = NULL;
+			server->position = 0;
+			server->prefetch = j_background_operation_new(j_kv_iterator_fetch, server);
 		}
 	}
 	else
 	{
-		if (prefix == NULL)
+		gboolean ret;
+
+		if (range != NULL)
 		{
-			j_backend_kv_get_all(iterator->kv_backend, namespace, &(iterator->cursor));
+			ret = j_backend_kv_get_range(iterator->kv_backend, namespace, range->start, range->end, range->limit, range->reverse, &(iterator->cursor));
+		}
+		else if (prefix == NULL)
+		{
+			ret = j_backend_kv_get_all(iterator->kv_backend, namespace, &(iterator->cursor));
 		}
 		else
 		{
-			j_backend_kv_get_by_prefix(iterator->kv_backend, namespace, prefix, &(iterator->cursor));
+			ret = j_backend_kv_get_by_prefix(iterator->kv_backend, namespace, prefix, &(iterator->cursor));
+		}
+
+		// Without a backend iterator, there is nothing to iterate over.
+		if (!ret)
+		{
+			iterator->cursor = NULL;
+			iterator->done = TRUE;
 		}
 	}
 
@@ -153,48 +424,42 @@ j_kv_iterator_new(gchar const* namespace, gchar const* prefix)
 }
 
 JKVIterator*
-j_kv_iterator_new_for_index(guint32 index, gchar const* namespace, gchar const* prefix)
+j_kv_iterator_new(gchar const* namespace, gchar const* prefix)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	JKVIterator* iterator;
+	g_return_val_if_fail(namespace != NULL, NULL);
 
-	JConfiguration* configuration = j_configuration();
+	return j_kv_iterator_new_internal(FALSE, 0, namespace, prefix, NULL);
+}
+
+JKVIterator*
+j_kv_iterator_new_for_index(guint32 index, gchar const* namespace, gchar const* prefix)
+{
+	J_TRACE_FUNCTION(NULL);
 
 	g_return_val_if_fail(namespace != NULL, NULL);
-	g_return_val_if_fail(index < j_configuration_get_server_count(configuration, J_BACKEND_TYPE_KV), NULL);
+	g_return_val_if_fail(index < j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_KV), NULL);
 
-	/// \todo still necessary?
-	//j_operation_cache_flush();
+	return j_kv_iterator_new_internal(TRUE, index, namespace, prefix, NULL);
+}
 
-	iterator = g_slice_new(JKVIterator);
-	iterator->kv_backend = j_kv_get_backend();
-	iterator->cursor = NULL;
-	iterator->key = NULL;
-	iterator->value = NULL;
-	iterator->len = 0;
-	iterator->replies_n = 1;
-	iterator->replies = g_new0(JMessage*, 1);
-	iterator->replies_cur = 0;
-	iterator->done = (iterator->kv_backend == NULL);
+JKVIterator*
+j_kv_iterator_new_range(gchar const* namespace, gchar const* start, gchar const* end, guint32 limit, gboolean reverse)
+{
+	J_TRACE_FUNCTION(NULL);
 
-	if (iterator->kv_backend == NULL)
-	{
-		iterator->replies[0] = fetch_reply(index, namespace, prefix);
-	}
-	else
-	{
-		if (prefix == NULL)
-		{
-			j_backend_kv_get_all(iterator->kv_backend, namespace, &(iterator->cursor));
-		}
-		else
-		{
-			j_backend_kv_get_by_prefix(iterator->kv_backend, namespace, prefix, &(iterator->cursor));
-		}
-	}
+	JKVIteratorRange* range;
 
-	return iterator;
+	g_return_val_if_fail(namespace != NULL, NULL);
+
+	range = g_slice_new(JKVIteratorRange);
+	range->start = g_strdup(start);
+	range->end = g_strdup(end);
+	range->limit = limit;
+	range->reverse = reverse;
+
+	return j_kv_iterator_new_internal(FALSE, 0, namespace, NULL, range);
 }
 
 void
@@ -204,23 +469,56 @@ j_kv_iterator_free(JKVIterator* iterator)
 
 	g_return_if_fail(iterator != NULL);
 
-	if (!iterator->done)
+	if (iterator->kv_backend != NULL && !iterator->done && iterator->cursor != NULL)
 	{
-		// There is currently no way to cancel an iterator, so drain it.
-		while (j_kv_iterator_next(iterator))
-		{
-		}
+		j_backend_kv_iterate_free(iterator->kv_backend, iterator->cursor);
 	}
 
-	for (guint32 i = 0; i < iterator->replies_n; i++)
+	for (guint32 i = 0; i < iterator->servers_n; i++)
 	{
-		if (iterator->replies[i] != NULL)
+		JKVIteratorServer* server = &(iterator->servers[i]);
+
+		if (server->prefetch != NULL)
+		{
+			JKVIteratorPage* page;
+
+			page = j_background_operation_wait(server->prefetch);
+			j_background_operation_unref(server->prefetch);
+
+			server->cursor = page->cursor;
+			j_kv_iterator_page_free(page);
+		}
+
+		// Release cursors that have not reached their end, so that the servers do not have to wait for them to expire.
+		if (server->cursor != 0)
 		{
-			j_message_unref(iterator->replies[i]);
+			g_autoptr(JMessage) message = NULL;
+			gpointer kv_connection;
+
+			message = j_message_new(J_MESSAGE_CURSOR_CLOSE, sizeof(server->cursor));
+			j_message_append_8(message, &(server->cursor));
+
+			kv_connection = j_connection_pool_pop(J_BACKEND_TYPE_KV, server->index);
+			j_message_send(message, kv_connection);
+			j_connection_pool_push(J_BACKEND_TYPE_KV, server->index, kv_connection);
+		}
+
+		if (server->page != NULL)
+		{
+			j_kv_iterator_page_free(server->page);
 		}
 	}
 
-	g_free(iterator->replies);
+	g_free(iterator->servers);
+	g_free(iterator->namespace);
+	g_free(iterator->prefix);
+
+	if (iterator->range != NULL)
+	{
+		g_free(iterator->range->start);
+		g_free(iterator->range->end);
+		g_slice_free(JKVIteratorRange, iterator->range);
+	}
 
 	g_slice_free(JKVIterator, iterator);
 }
@@ -234,30 +532,90 @@ j_kv_iterator_next(JKVIterator* iterator)
 
 	g_return_val_if_fail(iterator != NULL, FALSE);
 
-	if (iterator->kv_backend == NULL)
+	if (iterator->range != NULL && iterator->range->limit > 0 && iterator->count >= iterator->range->limit)
 	{
-	retry:
-		iterator->len = j_message_get_4(iterator->replies[iterator->replies_cur]);
+		return FALSE;
+	}
 
-		if (iterator->len > 0)
+	if (iterator->kv_backend == NULL && iterator->range != NULL)
+	{
+		JKVIteratorServer* next = NULL;
+		JKVIteratorPair* next_pair = NULL;
+
+		// Every server returns its pairs in order, so the next pair is the smallest (or largest) of the servers' current pairs.
+		for (guint32 i = 0; i < iterator->servers_n; i++)
 		{
-			iterator->value = j_message_get_n(iterator->replies[iterator->replies_cur], iterator->len);
-			iterator->key = j_message_get_string(iterator->replies[iterator->replies_cur]);
+			JKVIteratorServer* server = &(iterator->servers[i]);
+			JKVIteratorPair* pair;
+			gint cmp;
+
+			pair = j_kv_iterator_server_peek(server);
+
+			if (pair == NULL)
+			{
+				continue;
+			}
+
+			if (next_pair != NULL)
+			{
+				// All backends order their ranges bytewise, which matches g_strcmp0().
+				cmp = g_strcmp0(pair->key, next_pair->key);
+
+				if ((iterator->range->reverse) ? cmp <= 0 : cmp >= 0)
+				{
+					continue;
+				}
+			}
+
+			next = server;
+			next_pair = pair;
+		}
+
+		if (next_pair != NULL)
+		{
+			iterator->key = next_pair->key;
+			iterator->value = next_pair->value;
+			iterator->len = next_pair->len;
+			next->position++;
 
 			ret = TRUE;
 		}
-		else if (iterator->replies_cur < iterator->replies_n - 1)
+	}
+	else if (iterator->kv_backend == NULL)
+	{
+		while (iterator->servers_cur < iterator->servers_n)
 		{
-			iterator->replies_cur++;
-			goto retry;
+			JKVIteratorServer* server = &(iterator->servers[iterator->servers_cur]);
+			JKVIteratorPair* pair;
+
+			pair = j_kv_iterator_server_peek(server);
+
+			if (pair == NULL)
+			{
+				iterator->servers_cur++;
+				continue;
+			}
+
+			iterator->key = pair->key;
+			iterator->value = pair->value;
+			iterator->len = pair->len;
+			server->position++;
+
+			ret = TRUE;
+			break;
 		}
 	}
-	else
+	else if (!iterator->done)
 	{
 		ret = j_backend_kv_iterate(iterator->kv_backend, iterator->cursor, &(iterator->key), &(iterator->value), &(iterator->len));
 		iterator->done = !ret;
 	}
 
+	if (ret)
+	{
+		iterator->count++;
+	}
+
 	return ret;
 }
 
@@ -46,6 +46,7 @@ struct JKVOperation
 			JKV* kv;
 			gpointer* value;
 			guint32* value_len;
+			GBytes** view;
 			JKVGetFunc func;
 			gpointer data;
 		} get;
@@ -57,6 +58,25 @@ struct JKVOperation
 			guint32 value_len;
 			GDestroyNotify value_destroy;
 		} put;
+
+		struct
+		{
+			gchar* namespace;
+			gchar* prefix;
+		} delete_by_prefix;
+
+		struct
+		{
+			JKV* kv;
+			JMessageKVUpdateType type;
+			gconstpointer expected;
+			guint32 expected_len;
+			gpointer value;
+			guint32 value_len;
+			GDestroyNotify value_destroy;
+			gint64 delta;
+			gboolean* swapped;
+		} update;
 	};
 };
 
@@ -186,6 +206,36 @@ j_kv_get_free(gpointer data)
 	g_slice_free(JKVOperation, operation);
 }
 
+static void
+j_kv_delete_by_prefix_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVOperation* operation = data;
+
+	g_free(operation->delete_by_prefix.namespace);
+	g_free(operation->delete_by_prefix.prefix);
+
+	g_slice_free(JKVOperation, operation);
+}
+
+static void
+j_kv_update_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVOperation* operation = data;
+
+	j_kv_unref(operation->update.kv);
+
+	if (operation->update.value_destroy != NULL)
+	{
+		operation->update.value_destroy(operation->update.value);
+	}
+
+	g_slice_free(JKVOperation, operation);
+}
+
 static gboolean
 j_kv_put_exec(JList* operations, JSemantics* semantics)
 {
@@ -449,17 +499,46 @@ j_kv_get_exec(JList* operations, JSemantics* semantics)
 				gpointer value;
 				guint32 len;
 
-				ret = j_backend_kv_get(kv_backend, kv_batch, kop->get.kv->key, &value, &len) && ret;
-
-				if (ret)
+				if (j_backend_kv_get(kv_backend, kv_batch, kop->get.kv->key, &value, &len))
 				{
 					// j_backend_kv_get returns a new copy, pass it along
 					kop->get.func(value, len, kop->get.data);
 				}
+				else
+				{
+					ret = FALSE;
+				}
 			}
-			else
+			else if (kop->get.view != NULL)
+			{
+				gconstpointer value;
+				guint32 len;
+				GDestroyNotify value_free;
+
+				if (j_backend_kv_get_view(kv_backend, kv_batch, kop->get.kv->key, &value, &len, &value_free))
+				{
+					// Borrowed values are only valid until the batch is executed, so they have to be copied.
+					if (value_free != NULL)
+					{
+						*(kop->get.view) = g_bytes_new_with_free_func(value, len, value_free, (gpointer)value);
+					}
+					else
+					{
+						*(kop->get.view) = g_bytes_new(value, len);
+					}
+				}
+				else
+				{
+					*(kop->get.view) = NULL;
+					ret = FALSE;
+				}
+			}
+			else if (!j_backend_kv_get(kv_backend, kv_batch, kop->get.kv->key, kop->get.value, kop->get.value_len))
 			{
-				ret = j_backend_kv_get(kv_backend, kv_batch, kop->get.kv->key, kop->get.value, kop->get.value_len) && ret;
+				// Missing key-value pairs do not have a value.
+				*(kop->get.value) = NULL;
+				*(kop->get.value_len) = 0;
+				ret = FALSE;
 			}
 		}
 	}
@@ -468,55 +547,295 @@ j_kv_get_exec(JList* operations, JSemantics* semantics)
 	{
 		g_autoptr(JListIterator) iter = NULL;
 		g_autoptr(JMessage) reply = NULL;
+		g_autoptr(GBytes) views = NULL;
+		g_autofree guint32* lens = NULL;
+		GInputStream* input;
 		gpointer kv_connection;
+		gchar* views_data = NULL;
+		gsize views_len = 0;
+		gsize views_offset = 0;
+		gsize bytes_read;
+		guint32 reply_operation_count;
+		gboolean received;
 
 		kv_connection = j_connection_pool_pop(J_BACKEND_TYPE_KV, index);
-		j_message_send(message, kv_connection);
-
 		reply = j_message_new_reply(message);
-		j_message_receive(reply, kv_connection);
+		received = j_message_send(message, kv_connection) && j_message_receive(reply, kv_connection);
+
+		input = g_io_stream_get_input_stream(G_IO_STREAM(kv_connection));
+		reply_operation_count = (received) ? j_message_get_count(reply) : 0;
+		ret = received && ret;
+		lens = g_new(guint32, reply_operation_count);
+
+		// The reply only contains the values' lengths, the values follow it.
+		iter = j_list_iterator_new(operations);
+
+		for (guint32 i = 0; i < reply_operation_count && j_list_iterator_next(iter); i++)
+		{
+			JKVOperation* kop = j_list_iterator_get(iter);
+
+			lens[i] = j_message_get_4(reply);
+
+			if (kop->get.view != NULL)
+			{
+				views_len += lens[i];
+			}
+		}
+
+		// All views of a reply share a single buffer, which is freed once all of them have been released.
+		if (views_len > 0)
+		{
+			views_data = g_malloc(views_len);
+			views = g_bytes_new_take(views_data, views_len);
+		}
 
+		j_list_iterator_free(iter);
 		iter = j_list_iterator_new(operations);
 
-		while (j_list_iterator_next(iter))
+		for (guint32 i = 0; i < reply_operation_count && j_list_iterator_next(iter); i++)
 		{
 			JKVOperation* kop = j_list_iterator_get(iter);
-			guint32 len;
+			guint32 len = lens[i];
 
-			len = j_message_get_4(reply);
-			ret = (len > 0) && ret;
+			// Missing key-value pairs do not have a value.
+			if (len == 0)
+			{
+				ret = FALSE;
+
+				if (kop->get.view != NULL)
+				{
+					*(kop->get.view) = NULL;
+				}
+				else if (kop->get.func == NULL)
+				{
+					*(kop->get.value) = NULL;
+					*(kop->get.value_len) = 0;
+				}
 
-			if (len > 0)
+				continue;
+			}
+
+			// Values are received directly into their final buffers.
+			if (kop->get.view != NULL)
 			{
-				gconstpointer data;
+				if (!g_input_stream_read_all(input, views_data + views_offset, len, &bytes_read, NULL, NULL) || bytes_read != len)
+				{
+					*(kop->get.view) = NULL;
+					ret = FALSE;
+					received = FALSE;
+					break;
+				}
 
-				data = j_message_get_n(reply, len);
+				*(kop->get.view) = g_bytes_new_from_bytes(views, views_offset, len);
+				views_offset += len;
+			}
+			else
+			{
+				gpointer value;
+
+				value = g_malloc(len);
+
+				if (!g_input_stream_read_all(input, value, len, &bytes_read, NULL, NULL) || bytes_read != len)
+				{
+					g_free(value);
+					ret = FALSE;
+					received = FALSE;
+					break;
+				}
 
 				if (kop->get.func != NULL)
 				{
-					gpointer value;
-
-					// data belongs to the message, create a copy for the callback
-#if GLIB_CHECK_VERSION(2, 68, 0)
-					value = g_memdup2(data, len);
-#else
-					value = g_memdup(data, len);
-#endif
 					kop->get.func(value, len, kop->get.data);
 				}
 				else
 				{
-#if GLIB_CHECK_VERSION(2, 68, 0)
-					*(kop->get.value) = g_memdup2(data, len);
-#else
-					*(kop->get.value) = g_memdup(data, len);
-#endif
+					*(kop->get.value) = value;
 					*(kop->get.value_len) = len;
 				}
 			}
 		}
 
+		// The remaining values might still be in transit, so the connection cannot be reused.
+		if (received)
+		{
+			j_connection_pool_push(J_BACKEND_TYPE_KV, index, kv_connection);
+		}
+		else
+		{
+			j_connection_pool_discard(J_BACKEND_TYPE_KV, index, kv_connection);
+		}
+	}
+	else
+	{
+		ret = j_backend_kv_batch_execute(kv_backend, kv_batch) && ret;
+	}
+
+	return ret;
+}
+
+/**
+ * Stores the result of an update operation.
+ *
+ * \param kop    An update operation.
+ * \param result Whether the operation has been applied.
+ *
+ * \return FALSE if the operation failed, TRUE otherwise. Comparisons that do not match are not failures.
+ **/
+static gboolean
+j_kv_update_result(JKVOperation* kop, gboolean result)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	switch (kop->update.type)
+	{
+		case J_MESSAGE_KV_UPDATE_COMPARE_AND_SWAP:
+		case J_MESSAGE_KV_UPDATE_CREATE:
+			if (kop->update.swapped != NULL)
+			{
+				*(kop->update.swapped) = result;
+			}
+
+			return TRUE;
+		case J_MESSAGE_KV_UPDATE_ADD:
+		case J_MESSAGE_KV_UPDATE_APPEND:
+		default:
+			return result;
+	}
+}
+
+static gboolean
+j_kv_update_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	JBackend* kv_backend;
+	g_autoptr(JListIterator) it = NULL;
+	g_autoptr(JMessage) message = NULL;
+	gchar const* namespace;
+	gpointer kv_batch = NULL;
+	gsize namespace_len;
+	guint32 index;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	{
+		JKVOperation* kop;
+
+		kop = j_list_get_first(operations);
+		g_assert(kop != NULL);
+
+		namespace = kop->update.kv->namespace;
+		namespace_len = strlen(namespace) + 1;
+		index = kop->update.kv->index;
+	}
+
+	it = j_list_iterator_new(operations);
+	kv_backend = j_kv_get_backend();
+
+	if (kv_backend == NULL)
+	{
+		message = j_message_new(J_MESSAGE_KV_UPDATE, namespace_len);
+		j_message_set_semantics(message, semantics);
+		j_message_append_n(message, namespace, namespace_len);
+	}
+	else
+	{
+		ret = j_backend_kv_batch_start(kv_backend, namespace, semantics, &kv_batch);
+	}
+
+	while (j_list_iterator_next(it))
+	{
+		JKVOperation* kop = j_list_iterator_get(it);
+		gchar const* key = kop->update.kv->key;
+
+		if (kv_backend == NULL)
+		{
+			gchar type = kop->update.type;
+			gsize key_len;
+
+			key_len = strlen(key) + 1;
+
+			switch (kop->update.type)
+			{
+				case J_MESSAGE_KV_UPDATE_COMPARE_AND_SWAP:
+					j_message_add_operation(message, key_len + 1 + 4 + kop->update.expected_len + 4 + kop->update.value_len);
+					j_message_append_n(message, key, key_len);
+					j_message_append_1(message, &type);
+					j_message_append_4(message, &(kop->update.expected_len));
+					j_message_append_n(message, kop->update.expected, kop->update.expected_len);
+					j_message_append_4(message, &(kop->update.value_len));
+					j_message_append_n(message, kop->update.value, kop->update.value_len);
+					break;
+				case J_MESSAGE_KV_UPDATE_CREATE:
+				case J_MESSAGE_KV_UPDATE_APPEND:
+					j_message_add_operation(message, key_len + 1 + 4 + kop->update.value_len);
+					j_message_append_n(message, key, key_len);
+					j_message_append_1(message, &type);
+					j_message_append_4(message, &(kop->update.value_len));
+					j_message_append_n(message, kop->update.value, kop->update.value_len);
+					break;
+				case J_MESSAGE_KV_UPDATE_ADD:
+					j_message_add_operation(message, key_len + 1 + 8);
+					j_message_append_n(message, key, key_len);
+					j_message_append_1(message, &type);
+					j_message_append_8(message, &(kop->update.delta));
+					break;
+				default:
+					g_assert_not_reached();
+			}
+		}
+		else
+		{
+			gboolean lret = FALSE;
+
+			switch (kop->update.type)
+			{
+				case J_MESSAGE_KV_UPDATE_COMPARE_AND_SWAP:
+				case J_MESSAGE_KV_UPDATE_CREATE:
+					lret = j_backend_kv_compare_and_swap(kv_backend, kv_batch, key, kop->update.expected, kop->update.expected_len, kop->update.value, kop->update.value_len);
+					break;
+				case J_MESSAGE_KV_UPDATE_ADD:
+					lret = j_backend_kv_add(kv_backend, kv_batch, key, kop->update.delta);
+					break;
+				case J_MESSAGE_KV_UPDATE_APPEND:
+					lret = j_backend_kv_append(kv_backend, kv_batch, key, kop->update.value, kop->update.value_len);
+					break;
+				default:
+					g_assert_not_reached();
+			}
+
+			ret = j_kv_update_result(kop, lret) && ret;
+		}
+	}
+
+	if (kv_backend == NULL)
+	{
+		g_autoptr(JListIterator) reply_it = NULL;
+		g_autoptr(JMessage) reply = NULL;
+		gpointer kv_connection;
+
+		// The reply is always received, because it contains the results of the comparisons.
+		kv_connection = j_connection_pool_pop(J_BACKEND_TYPE_KV, index);
+		j_message_send(message, kv_connection);
+
+		reply = j_message_new_reply(message);
+		j_message_receive(reply, kv_connection);
+
 		j_connection_pool_push(J_BACKEND_TYPE_KV, index, kv_connection);
+
+		reply_it = j_list_iterator_new(operations);
+
+		while (j_list_iterator_next(reply_it))
+		{
+			JKVOperation* kop = j_list_iterator_get(reply_it);
+			guint32 status;
+
+			status = j_message_get_4(reply);
+			ret = j_kv_update_result(kop, status == 1) && ret;
+		}
 	}
 	else
 	{
@@ -526,6 +845,112 @@ j_kv_get_exec(JList* operations, JSemantics* semantics)
 	return ret;
 }
 
+static gboolean
+j_kv_delete_by_prefix_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	JBackend* kv_backend;
+	g_autoptr(JListIterator) it = NULL;
+	g_autoptr(JMessage) message = NULL;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	it = j_list_iterator_new(operations);
+	kv_backend = j_kv_get_backend();
+
+	if (kv_backend == NULL)
+	{
+		message = j_message_new(J_MESSAGE_KV_DELETE_PREFIX, 0);
+		j_message_set_semantics(message, semantics);
+	}
+
+	while (j_list_iterator_next(it))
+	{
+		JKVOperation* operation = j_list_iterator_get(it);
+		gchar const* namespace = operation->delete_by_prefix.namespace;
+		gchar const* prefix = operation->delete_by_prefix.prefix;
+
+		if (kv_backend == NULL)
+		{
+			gsize namespace_len;
+			gsize prefix_len;
+
+			// An empty prefix deletes the whole namespace.
+			prefix = (prefix != NULL) ? prefix : "";
+
+			namespace_len = strlen(namespace) + 1;
+			prefix_len = strlen(prefix) + 1;
+
+			j_message_add_operation(message, namespace_len + prefix_len);
+			j_message_append_n(message, namespace, namespace_len);
+			j_message_append_n(message, prefix, prefix_len);
+		}
+		else
+		{
+			gpointer kv_batch = NULL;
+			gboolean lret = FALSE;
+
+			if (j_backend_kv_batch_start(kv_backend, namespace, semantics, &kv_batch))
+			{
+				lret = j_backend_kv_delete_by_prefix(kv_backend, kv_batch, namespace, prefix);
+				lret = j_backend_kv_batch_execute(kv_backend, kv_batch) && lret;
+			}
+
+			ret = lret && ret;
+		}
+	}
+
+	if (kv_backend == NULL)
+	{
+		JConfiguration* configuration = j_configuration();
+		JSemanticsPersistency persistency;
+		g_autofree gpointer* kv_connections = NULL;
+		guint32 server_count;
+
+		persistency = j_semantics_get(semantics, J_SEMANTICS_PERSISTENCY);
+		server_count = j_configuration_get_server_count(configuration, J_BACKEND_TYPE_KV);
+		kv_connections = g_new(gpointer, server_count);
+
+		// Keys are hashed to all servers, so the deletion has to be broadcast.
+		// Send to all servers first so that they can delete concurrently.
+		for (guint32 i = 0; i < server_count; i++)
+		{
+			kv_connections[i] = j_connection_pool_pop(J_BACKEND_TYPE_KV, i);
+			j_message_send(message, kv_connections[i]);
+		}
+
+		for (guint32 i = 0; i < server_count; i++)
+		{
+			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+			{
+				g_autoptr(JMessage) reply = NULL;
+				guint32 operation_count;
+
+				reply = j_message_new_reply(message);
+				j_message_receive(reply, kv_connections[i]);
+
+				operation_count = j_message_get_count(reply);
+
+				for (guint j = 0; j < operation_count; j++)
+				{
+					guint32 status;
+
+					status = j_message_get_4(reply);
+					ret = (status == 1) && ret;
+				}
+			}
+
+			j_connection_pool_push(J_BACKEND_TYPE_KV, i, kv_connections[i]);
+		}
+	}
+
+	return ret;
+}
+
 JKV*
 j_kv_new(gchar const* namespace, gchar const* key)
 {
@@ -538,7 +963,7 @@ j_kv_new(gchar const* namespace, gchar const* key)
 	g_return_val_if_fail(key != NULL, NULL);
 
 	kv = g_slice_new(JKV);
-	kv->index = j_helper_hash(key) % j_configuration_get_server_count(configuration, J_BACKEND_TYPE_KV);
+	kv->index = j_configuration_get_server_index(configuration, J_BACKEND_TYPE_KV, key);
 	kv->namespace = g_strdup(namespace);
 	kv->key = g_strdup(key);
 	kv->ref_count = 1;
@@ -639,6 +1064,30 @@ j_kv_delete(JKV* kv, JBatch* batch)
 	j_batch_add(batch, operation);
 }
 
+void
+j_kv_delete_by_prefix(gchar const* namespace, gchar const* prefix, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVOperation* kop;
+	JOperation* operation;
+
+	g_return_if_fail(namespace != NULL);
+
+	kop = g_slice_new(JKVOperation);
+	kop->delete_by_prefix.namespace = g_strdup(namespace);
+	kop->delete_by_prefix.prefix = g_strdup(prefix);
+
+	operation = j_operation_new();
+	// All prefix deletions are broadcast, so they can share one message.
+	operation->key = NULL;
+	operation->data = kop;
+	operation->exec_func = j_kv_delete_by_prefix_exec;
+	operation->free_func = j_kv_delete_by_prefix_free;
+
+	j_batch_add(batch, operation);
+}
+
 void
 j_kv_get(JKV* kv, gpointer* value, guint32* value_len, JBatch* batch)
 {
@@ -653,6 +1102,7 @@ j_kv_get(JKV* kv, gpointer* value, guint32* value_len, JBatch* batch)
 	kop->get.kv = j_kv_ref(kv);
 	kop->get.value = value;
 	kop->get.value_len = value_len;
+	kop->get.view = NULL;
 	kop->get.func = NULL;
 	kop->get.data = NULL;
 
@@ -680,6 +1130,7 @@ j_kv_get_callback(JKV* kv, JKVGetFunc func, gpointer data, JBatch* batch)
 	kop->get.kv = j_kv_ref(kv);
 	kop->get.value = NULL;
 	kop->get.value_len = NULL;
+	kop->get.view = NULL;
 	kop->get.func = func;
 	kop->get.data = data;
 
@@ -692,6 +1143,124 @@ j_kv_get_callback(JKV* kv, JKVGetFunc func, gpointer data, JBatch* batch)
 	j_batch_add(batch, operation);
 }
 
+void
+j_kv_get_view(JKV* kv, GBytes** value, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVOperation* kop;
+	JOperation* operation;
+
+	g_return_if_fail(kv != NULL);
+	g_return_if_fail(value != NULL);
+
+	kop = g_slice_new(JKVOperation);
+	kop->get.kv = j_kv_ref(kv);
+	kop->get.value = NULL;
+	kop->get.value_len = NULL;
+	kop->get.view = value;
+	kop->get.func = NULL;
+	kop->get.data = NULL;
+
+	operation = j_operation_new();
+	operation->key = kv;
+	operation->data = kop;
+	operation->exec_func = j_kv_get_exec;
+	operation->free_func = j_kv_get_free;
+
+	j_batch_add(batch, operation);
+}
+
+/**
+ * Adds an update operation to a batch.
+ **/
+static void
+j_kv_update(JKVOperation* kop, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JOperation* operation;
+
+	operation = j_operation_new();
+	operation->key = kop->update.kv;
+	operation->data = kop;
+	operation->exec_func = j_kv_update_exec;
+	operation->free_func = j_kv_update_free;
+
+	j_batch_add(batch, operation);
+}
+
+void
+j_kv_compare_and_swap(JKV* kv, gconstpointer expected, guint32 expected_len, gpointer value, guint32 value_len, GDestroyNotify value_destroy, gboolean* swapped, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVOperation* kop;
+
+	g_return_if_fail(kv != NULL);
+	g_return_if_fail(value != NULL);
+
+	kop = g_slice_new(JKVOperation);
+	kop->update.kv = j_kv_ref(kv);
+	kop->update.type = (expected != NULL) ? J_MESSAGE_KV_UPDATE_COMPARE_AND_SWAP : J_MESSAGE_KV_UPDATE_CREATE;
+	kop->update.expected = expected;
+	kop->update.expected_len = (expected != NULL) ? expected_len : 0;
+	kop->update.value = value;
+	kop->update.value_len = value_len;
+	kop->update.value_destroy = value_destroy;
+	kop->update.delta = 0;
+	kop->update.swapped = swapped;
+
+	j_kv_update(kop, batch);
+}
+
+void
+j_kv_add(JKV* kv, gint64 delta, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVOperation* kop;
+
+	g_return_if_fail(kv != NULL);
+
+	kop = g_slice_new(JKVOperation);
+	kop->update.kv = j_kv_ref(kv);
+	kop->update.type = J_MESSAGE_KV_UPDATE_ADD;
+	kop->update.expected = NULL;
+	kop->update.expected_len = 0;
+	kop->update.value = NULL;
+	kop->update.value_len = 0;
+	kop->update.value_destroy = NULL;
+	kop->update.delta = delta;
+	kop->update.swapped = NULL;
+
+	j_kv_update(kop, batch);
+}
+
+void
+j_kv_append(JKV* kv, gpointer value, guint32 value_len, GDestroyNotify value_destroy, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JKVOperation* kop;
+
+	g_return_if_fail(kv != NULL);
+	g_return_if_fail(value != NULL);
+
+	kop = g_slice_new(JKVOperation);
+	kop->update.kv = j_kv_ref(kv);
+	kop->update.type = J_MESSAGE_KV_UPDATE_APPEND;
+	kop->update.expected = NULL;
+	kop->update.expected_len = 0;
+	kop->update.value = value;
+	kop->update.value_len = value_len;
+	kop->update.value_destroy = value_destroy;
+	kop->update.delta = 0;
+	kop->update.swapped = NULL;
+
+	j_kv_update(kop, batch);
+}
+
 /**
  * Returns the kv backend.
  *
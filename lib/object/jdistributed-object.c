@@ -24,6 +24,7 @@
 
 #include <glib.h>
 
+#include <stdlib.h>
 #include <string.h>
 
 #include <object/jdistributed-object.h>
@@ -64,6 +65,21 @@ struct JDistributedObjectBackgroundData
 			 * Contains #JDistributedObjectReadBuffer elements.
 			 */
 			JList* buffers;
+
+			/**
+			 * The same read for another copy, NULL if reads are not hedged.
+			 */
+			JMessage* hedge;
+
+			/**
+			 * The index of the server storing the other copy.
+			 */
+			guint32 hedge_index;
+
+			/**
+			 * The number of bytes read.
+			 */
+			guint64 load;
 		} read;
 
 		/**
@@ -73,19 +89,114 @@ struct JDistributedObjectBackgroundData
 		{
 			JList* bytes_written;
 		} write;
+
+		/**
+		 * The copy part.
+		 */
+		struct
+		{
+			JList* bytes_copied;
+		} copy;
 	};
 };
 
 typedef struct JDistributedObjectBackgroundData JDistributedObjectBackgroundData;
 
+/**
+ * A buffer to read into.
+ * Operations that span multiple chunks use a linked list of buffers, which are filled in order.
+ */
 struct JDistributedObjectReadBuffer
 {
 	gchar* data;
+	guint64 length;
 	guint64* bytes_read;
+
+	struct JDistributedObjectReadBuffer* next;
 };
 
 typedef struct JDistributedObjectReadBuffer JDistributedObjectReadBuffer;
 
+/**
+ * The state for building messages from extents.
+ */
+struct JDistributedObjectExtentData
+{
+	JDistributedObject* object;
+	JSemantics* semantics;
+
+	/**
+	 * The messages, one per copy and server.
+	 * The message for copy r on server s is stored at r * server_count + s.
+	 */
+	JMessage** messages;
+	JList** lists;
+
+	guint32 server_count;
+	guint32 replicas;
+
+	/**
+	 * The namespaces of the copies.
+	 */
+	gchar** namespaces;
+
+	/**
+	 * For reads, the hedged messages using the same layout as #messages, NULL if reads are not hedged.
+	 */
+	JMessage** hedges;
+
+	/**
+	 * For reads, the number of bytes read per message.
+	 */
+	guint64* loads;
+
+	/**
+	 * For writes, the number of bytes written to the other copies.
+	 */
+	guint64* replica_bytes;
+
+	/**
+	 * The data of the current operation.
+	 */
+	gchar* data;
+
+	/**
+	 * The number of bytes read or written by the current operation.
+	 */
+	guint64* bytes;
+
+	/**
+	 * The #JMessageObjectCompoundFlags for writes.
+	 */
+	guint32 flags;
+};
+
+typedef struct JDistributedObjectExtentData JDistributedObjectExtentData;
+
+/**
+ * The data for discarding the reply to a hedged read.
+ */
+struct JDistributedObjectDrainData
+{
+	JMessage* message;
+	gpointer connection;
+	guint32 index;
+};
+
+typedef struct JDistributedObjectDrainData JDistributedObjectDrainData;
+
+/**
+ * Handles a contiguous extent on a server.
+ *
+ * \param index      The server index.
+ * \param length     The extent's length.
+ * \param offset     The extent's offset on the server.
+ * \param chunks     The chunks making up the extent.
+ * \param chunks_len The number of chunks.
+ * \param data       User data.
+ */
+typedef void (*JDistributedObjectExtentFunc)(guint32 index, guint64 length, guint64 offset, JDistributionChunk const* chunks, guint chunks_len, gpointer data);
+
 struct JDistributedObjectOperation
 {
 	union
@@ -119,6 +230,22 @@ struct JDistributedObjectOperation
 			guint64 offset;
 			guint64* bytes_written;
 		} write;
+
+		struct
+		{
+			JDistributedObject* object;
+			JDistributedObject* destination;
+			guint64* bytes_copied;
+		} copy;
+
+		struct
+		{
+			JDistributedObject* object;
+			gconstpointer data;
+			guint64 length;
+			guint64* bytes_written;
+			guint64* reserved_offset;
+		} append;
 	};
 };
 
@@ -215,128 +342,172 @@ j_distributed_object_write_free(gpointer data)
 	g_slice_free(JDistributedObjectOperation, operation);
 }
 
+static void
+j_distributed_object_append_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectOperation* operation = data;
+
+	j_distributed_object_unref(operation->append.object);
+
+	g_slice_free(JDistributedObjectOperation, operation);
+}
+
+static void
+j_distributed_object_copy_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectOperation* operation = data;
+
+	j_distributed_object_unref(operation->copy.object);
+	j_distributed_object_unref(operation->copy.destination);
+
+	g_slice_free(JDistributedObjectOperation, operation);
+}
+
 /**
- * Executes create operations in a background operation.
+ * The number of recent read latencies used to determine when to hedge reads.
+ **/
+#define J_DISTRIBUTED_OBJECT_LATENCY_SAMPLES 128
+
+/**
+ * The minimum number of latencies required before reads are hedged.
+ **/
+#define J_DISTRIBUTED_OBJECT_LATENCY_MIN_SAMPLES 32
+
+G_LOCK_DEFINE_STATIC(j_distributed_object_latency);
+
+static gint64 j_distributed_object_latencies[J_DISTRIBUTED_OBJECT_LATENCY_SAMPLES];
+static guint j_distributed_object_latencies_len = 0;
+static guint j_distributed_object_latencies_next = 0;
+
+/**
+ * Returns the number of bytes currently being read from each server by this process.
  *
  * \private
  *
- * \param data Background data.
- *
- * \return #data.
+ * \return An array with one element per server.
  **/
-static gpointer
-j_distributed_object_create_background_operation(gpointer data)
+static guint64*
+j_distributed_object_get_server_loads(void)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	JDistributedObjectBackgroundData* background_data = data;
+	static guint64* loads = NULL;
 
-	JSemanticsPersistency persistency;
+	if (g_once_init_enter(&loads))
+	{
+		guint64* new_loads;
 
-	gpointer object_connection;
+		new_loads = g_new0(guint64, j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT));
 
-	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
-	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+		g_once_init_leave(&loads, new_loads);
+	}
 
-	j_message_send(background_data->message, object_connection);
+	return loads;
+}
 
-	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
-	{
-		g_autoptr(JMessage) reply = NULL;
+/**
+ * Records the latency of a read.
+ *
+ * \private
+ *
+ * \param latency The latency in microseconds.
+ **/
+static void
+j_distributed_object_add_latency(gint64 latency)
+{
+	J_TRACE_FUNCTION(NULL);
 
-		reply = j_message_new_reply(background_data->message);
-		j_message_receive(reply, object_connection);
+	G_LOCK(j_distributed_object_latency);
 
-		/// \todo do something with reply
-	}
+	j_distributed_object_latencies[j_distributed_object_latencies_next] = latency;
+	j_distributed_object_latencies_next = (j_distributed_object_latencies_next + 1) % J_DISTRIBUTED_OBJECT_LATENCY_SAMPLES;
+	j_distributed_object_latencies_len = MIN(j_distributed_object_latencies_len + 1, J_DISTRIBUTED_OBJECT_LATENCY_SAMPLES);
 
-	j_message_unref(background_data->message);
-	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+	G_UNLOCK(j_distributed_object_latency);
+}
 
-	g_slice_free(JDistributedObjectBackgroundData, background_data);
+static gint
+j_distributed_object_latency_compare(gconstpointer a, gconstpointer b)
+{
+	gint64 const* latency_a = a;
+	gint64 const* latency_b = b;
 
-	return NULL;
+	if (*latency_a != *latency_b)
+	{
+		return (*latency_a < *latency_b) ? -1 : 1;
+	}
+
+	return 0;
 }
 
 /**
- * Executes create operations in a background operation.
+ * Returns the latency after which reads are hedged.
  *
  * \private
  *
- * \param data Background data.
- *
- * \return #data.
+ * \return The latency in microseconds, 0 if reads should not be hedged.
  **/
-static gpointer
-j_distributed_object_delete_background_operation(gpointer data)
+static gint64
+j_distributed_object_get_hedge_latency(void)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	JDistributedObjectBackgroundData* background_data = data;
-
-	JSemanticsPersistency persistency;
-
-	gpointer object_connection;
-
-	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
-	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+	gint64 latencies[J_DISTRIBUTED_OBJECT_LATENCY_SAMPLES];
+	guint32 percentile;
+	guint len;
 
-	j_message_send(background_data->message, object_connection);
+	percentile = j_configuration_get_hedge_percentile(j_configuration());
 
-	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	if (percentile == 0)
 	{
-		g_autoptr(JMessage) reply = NULL;
-		guint32 operation_count;
+		return 0;
+	}
 
-		reply = j_message_new_reply(background_data->message);
-		j_message_receive(reply, object_connection);
+	G_LOCK(j_distributed_object_latency);
 
-		operation_count = j_message_get_count(reply);
+	len = j_distributed_object_latencies_len;
+	memcpy(latencies, j_distributed_object_latencies, len * sizeof(gint64));
 
-		for (guint i = 0; i < operation_count; i++)
-		{
-			guint32 status;
+	G_UNLOCK(j_distributed_object_latency);
 
-			status = j_message_get_4(reply);
-			background_data->ret = (status == 1) && background_data->ret;
-		}
+	// Without enough samples, the percentile is meaningless.
+	if (len < J_DISTRIBUTED_OBJECT_LATENCY_MIN_SAMPLES)
+	{
+		return 0;
 	}
 
-	j_message_unref(background_data->message);
-	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+	qsort(latencies, len, sizeof(gint64), j_distributed_object_latency_compare);
 
-	return data;
+	return MAX(latencies[(len - 1) * percentile / 100], 1);
 }
 
 /**
- * Executes write operations in a background operation.
+ * Receives the replies to a read message.
  *
  * \private
  *
- * \param data Background data.
- *
- * \return #data.
+ * \param background_data Background data.
+ * \param message         The read message.
+ * \param connection      The connection the message has been sent on.
  **/
-static gpointer
-j_distributed_object_read_background_operation(gpointer data)
+static void
+j_distributed_object_read_receive(JDistributedObjectBackgroundData* background_data, JMessage* message, gpointer connection)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	JDistributedObjectBackgroundData* background_data = data;
-
 	g_autoptr(JListIterator) it = NULL;
 	g_autoptr(JMessage) reply = NULL;
-	gpointer object_connection;
 	guint32 operations_done;
 	guint32 operation_count;
 
-	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
-	j_message_send(background_data->message, object_connection);
-
-	reply = j_message_new_reply(background_data->message);
+	reply = j_message_new_reply(message);
 
 	operations_done = 0;
-	operation_count = j_message_get_count(background_data->message);
+	operation_count = j_message_get_count(message);
 
 	it = j_list_iterator_new(background_data->read.buffers);
 
@@ -349,7 +520,7 @@ j_distributed_object_read_background_operation(gpointer data)
 	{
 		guint32 reply_operation_count;
 
-		j_message_receive(reply, object_connection);
+		j_message_receive(reply, connection);
 
 		reply_operation_count = j_message_get_count(reply);
 
@@ -362,7 +533,6 @@ j_distributed_object_read_background_operation(gpointer data)
 		for (guint i = 0; i < reply_operation_count && j_list_iterator_next(it); i++)
 		{
 			JDistributedObjectReadBuffer* buffer = j_list_iterator_get(it);
-			gchar* read_data = buffer->data;
 			guint64* bytes_read = buffer->bytes_read;
 
 			guint64 nbytes;
@@ -370,98 +540,397 @@ j_distributed_object_read_background_operation(gpointer data)
 			nbytes = j_message_get_8(reply);
 			j_helper_atomic_add(bytes_read, nbytes);
 
-			if (nbytes > 0)
+			// Scatter the data into the operation's buffers, short reads only fill the first ones.
+			for (; buffer != NULL && nbytes > 0; buffer = buffer->next)
 			{
 				GInputStream* input;
+				guint64 buffer_nbytes;
+
+				buffer_nbytes = MIN(nbytes, buffer->length);
 
-				input = g_io_stream_get_input_stream(G_IO_STREAM(object_connection));
-				g_input_stream_read_all(input, read_data, nbytes, NULL, NULL, NULL);
+				input = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+				g_input_stream_read_all(input, buffer->data, buffer_nbytes, NULL, NULL, NULL);
+
+				nbytes -= buffer_nbytes;
 			}
 		}
 
 		operations_done += reply_operation_count;
 	}
-
-	j_message_unref(background_data->message);
-
-	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
-
-	j_list_unref(background_data->read.buffers);
-
-	return data;
 }
 
 /**
- * Executes write operations in a background operation.
+ * Discards the replies to a hedged read that lost the race.
  *
  * \private
  *
- * \param data Background data.
+ * The connection can only be reused once the replies have been received completely.
  *
- * \return #data.
+ * \param data A #JDistributedObjectDrainData.
+ *
+ * \return NULL.
  **/
 static gpointer
-j_distributed_object_write_background_operation(gpointer data)
+j_distributed_object_drain_background_operation(gpointer data)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	JDistributedObjectBackgroundData* background_data = data;
-
-	JSemanticsPersistency persistency;
+	JDistributedObjectDrainData* drain_data = data;
 
-	gpointer object_connection;
+	g_autoptr(JMessage) reply = NULL;
+	GInputStream* input;
+	guint32 operations_done = 0;
+	guint32 operation_count;
 
-	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
-	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
-	j_message_send(background_data->message, object_connection);
+	reply = j_message_new_reply(drain_data->message);
+	operation_count = j_message_get_count(drain_data->message);
+	input = g_io_stream_get_input_stream(G_IO_STREAM(drain_data->connection));
 
-	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	while (operations_done < operation_count)
 	{
-		g_autoptr(JListIterator) it = NULL;
-		g_autoptr(JMessage) reply = NULL;
-		guint64 nbytes;
+		guint32 reply_operation_count;
 
-		reply = j_message_new_reply(background_data->message);
-		j_message_receive(reply, object_connection);
+		j_message_receive(reply, drain_data->connection);
+
+		reply_operation_count = j_message_get_count(reply);
 
-		if (j_message_get_count(reply) > 0)
+		if (reply_operation_count == 0)
 		{
-			it = j_list_iterator_new(background_data->write.bytes_written);
+			break;
+		}
 
-			while (j_list_iterator_next(it))
+		for (guint i = 0; i < reply_operation_count; i++)
+		{
+			guint64 nbytes;
+
+			nbytes = j_message_get_8(reply);
+
+			while (nbytes > 0)
 			{
-				guint64* bytes_written = j_list_iterator_get(it);
+				gssize skipped;
 
-				nbytes = j_message_get_8(reply);
-				j_helper_atomic_add(bytes_written, nbytes);
+				skipped = g_input_stream_skip(input, nbytes, NULL, NULL);
+
+				if (skipped <= 0)
+				{
+					break;
+				}
+
+				nbytes -= skipped;
 			}
 		}
-		else
-		{
-			background_data->ret = FALSE;
-		}
-	}
 
-	j_message_unref(background_data->message);
+		operations_done += reply_operation_count;
+	}
 
-	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, drain_data->index, drain_data->connection);
+	j_message_unref(drain_data->message);
 
-	j_list_unref(background_data->write.bytes_written);
+	g_slice_free(JDistributedObjectDrainData, drain_data);
 
-	return data;
+	return NULL;
 }
 
 /**
- * Executes status operations in a background operation.
+ * Discards the replies to a read in the background.
  *
  * \private
  *
- * \param data Background data.
- *
- * \return #data.
+ * \param message    The read message, ownership is transferred.
+ * \param connection The connection the message has been sent on.
+ * \param index      The server index.
  **/
-static gpointer
-j_distributed_object_status_background_operation(gpointer data)
+static void
+j_distributed_object_drain(JMessage* message, gpointer connection, guint32 index)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JBackgroundOperation* background_operation;
+	JDistributedObjectDrainData* drain_data;
+
+	drain_data = g_slice_new(JDistributedObjectDrainData);
+	drain_data->message = message;
+	drain_data->connection = connection;
+	drain_data->index = index;
+
+	background_operation = j_background_operation_new(j_distributed_object_drain_background_operation, drain_data);
+	j_background_operation_unref(background_operation);
+}
+
+/**
+ * Executes create operations in a background operation.
+ *
+ * \private
+ *
+ * \param data Background data.
+ *
+ * \return #data.
+ **/
+static gpointer
+j_distributed_object_create_background_operation(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectBackgroundData* background_data = data;
+
+	JSemanticsPersistency persistency;
+
+	gpointer object_connection;
+
+	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+
+	j_message_send(background_data->message, object_connection);
+
+	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		g_autoptr(JMessage) reply = NULL;
+
+		reply = j_message_new_reply(background_data->message);
+		j_message_receive(reply, object_connection);
+
+		/// \todo do something with reply
+	}
+
+	j_message_unref(background_data->message);
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+
+	g_slice_free(JDistributedObjectBackgroundData, background_data);
+
+	return NULL;
+}
+
+/**
+ * Executes create operations in a background operation.
+ *
+ * \private
+ *
+ * \param data Background data.
+ *
+ * \return #data.
+ **/
+static gpointer
+j_distributed_object_delete_background_operation(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectBackgroundData* background_data = data;
+
+	JSemanticsPersistency persistency;
+
+	gpointer object_connection;
+
+	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+
+	j_message_send(background_data->message, object_connection);
+
+	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		g_autoptr(JMessage) reply = NULL;
+		guint32 operation_count;
+
+		reply = j_message_new_reply(background_data->message);
+		j_message_receive(reply, object_connection);
+
+		operation_count = j_message_get_count(reply);
+
+		for (guint i = 0; i < operation_count; i++)
+		{
+			guint32 status;
+
+			status = j_message_get_4(reply);
+			background_data->ret = (status == 1) && background_data->ret;
+		}
+	}
+
+	j_message_unref(background_data->message);
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+
+	return data;
+}
+
+/**
+ * Executes write operations in a background operation.
+ *
+ * \private
+ *
+ * \param data Background data.
+ *
+ * \return #data.
+ **/
+static gpointer
+j_distributed_object_read_background_operation(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectBackgroundData* background_data = data;
+
+	guint64* loads;
+	gpointer object_connection;
+	gint64 hedge_latency = 0;
+	gint64 start_time;
+
+	loads = j_distributed_object_get_server_loads();
+	j_helper_atomic_add(&(loads[background_data->index]), background_data->read.load);
+
+	if (background_data->read.hedge != NULL)
+	{
+		hedge_latency = j_distributed_object_get_hedge_latency();
+	}
+
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+
+	// Unreachable servers are reported as failed, which allows reconstructing erasure coded data.
+	if (object_connection == NULL)
+	{
+		background_data->ret = FALSE;
+
+		j_helper_atomic_add(&(loads[background_data->index]), -background_data->read.load);
+		j_message_unref(background_data->message);
+
+		if (background_data->read.hedge != NULL)
+		{
+			j_message_unref(background_data->read.hedge);
+		}
+
+		j_list_unref(background_data->read.buffers);
+
+		return data;
+	}
+
+	start_time = g_get_monotonic_time();
+	j_message_send(background_data->message, object_connection);
+
+	if (hedge_latency > 0 && !g_socket_condition_timed_wait(g_socket_connection_get_socket(object_connection), G_IO_IN, hedge_latency, NULL, NULL))
+	{
+		GPollFD fds[2];
+		gpointer hedge_connection;
+
+		// The server is slow, ask another copy and use whichever reply arrives first.
+		hedge_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->read.hedge_index);
+		j_message_send(background_data->read.hedge, hedge_connection);
+
+		fds[0].fd = g_socket_get_fd(g_socket_connection_get_socket(object_connection));
+		fds[0].events = G_IO_IN;
+		fds[0].revents = 0;
+		fds[1].fd = g_socket_get_fd(g_socket_connection_get_socket(hedge_connection));
+		fds[1].events = G_IO_IN;
+		fds[1].revents = 0;
+
+		g_poll(fds, 2, -1);
+
+		if (fds[0].revents != 0)
+		{
+			j_distributed_object_read_receive(background_data, background_data->message, object_connection);
+			j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+
+			j_distributed_object_drain(background_data->read.hedge, hedge_connection, background_data->read.hedge_index);
+		}
+		else
+		{
+			j_distributed_object_read_receive(background_data, background_data->read.hedge, hedge_connection);
+			j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->read.hedge_index, hedge_connection);
+			j_message_unref(background_data->read.hedge);
+
+			j_distributed_object_drain(j_message_ref(background_data->message), object_connection, background_data->index);
+		}
+
+		background_data->read.hedge = NULL;
+	}
+	else
+	{
+		j_distributed_object_read_receive(background_data, background_data->message, object_connection);
+		j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+	}
+
+	j_distributed_object_add_latency(g_get_monotonic_time() - start_time);
+	j_helper_atomic_add(&(loads[background_data->index]), -background_data->read.load);
+
+	j_message_unref(background_data->message);
+
+	if (background_data->read.hedge != NULL)
+	{
+		j_message_unref(background_data->read.hedge);
+	}
+
+	j_list_unref(background_data->read.buffers);
+
+	return data;
+}
+
+/**
+ * Executes write operations in a background operation.
+ *
+ * \private
+ *
+ * \param data Background data.
+ *
+ * \return #data.
+ **/
+static gpointer
+j_distributed_object_write_background_operation(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectBackgroundData* background_data = data;
+
+	JSemanticsPersistency persistency;
+
+	gpointer object_connection;
+
+	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+	j_message_send(background_data->message, object_connection);
+
+	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		g_autoptr(JListIterator) it = NULL;
+		g_autoptr(JMessage) reply = NULL;
+		guint64 nbytes;
+
+		reply = j_message_new_reply(background_data->message);
+		j_message_receive(reply, object_connection);
+
+		// Compound messages might not contain any writes for this server
+		if (j_message_get_count(reply) == j_list_length(background_data->write.bytes_written))
+		{
+			it = j_list_iterator_new(background_data->write.bytes_written);
+
+			while (j_list_iterator_next(it))
+			{
+				guint64* bytes_written = j_list_iterator_get(it);
+
+				nbytes = j_message_get_8(reply);
+				j_helper_atomic_add(bytes_written, nbytes);
+			}
+		}
+		else
+		{
+			background_data->ret = FALSE;
+		}
+	}
+
+	j_message_unref(background_data->message);
+
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+
+	j_list_unref(background_data->write.bytes_written);
+
+	return data;
+}
+
+/**
+ * Executes status operations in a background operation.
+ *
+ * \private
+ *
+ * \param data Background data.
+ *
+ * \return #data.
+ **/
+static gpointer
+j_distributed_object_status_background_operation(gpointer data)
 {
 	J_TRACE_FUNCTION(NULL);
 
@@ -502,186 +971,2020 @@ j_distributed_object_status_background_operation(gpointer data)
 		}
 	}
 
-	j_message_unref(background_data->message);
+	j_message_unref(background_data->message);
+
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+
+	g_slice_free(JDistributedObjectBackgroundData, background_data);
+
+	return NULL;
+}
+
+/**
+ * Executes sync operations in a background operation.
+ *
+ * \private
+ *
+ * \param data Background data.
+ *
+ * \return #data.
+ **/
+static gpointer
+j_distributed_object_sync_background_operation(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectBackgroundData* background_data = data;
+
+	JSemanticsPersistency persistency;
+	gpointer object_connection;
+
+	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+	j_message_send(background_data->message, object_connection);
+
+	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		g_autoptr(JMessage) reply = NULL;
+
+		reply = j_message_new_reply(background_data->message);
+		j_message_receive(reply, object_connection);
+
+		/// \todo do something with reply
+	}
+
+	j_message_unref(background_data->message);
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+
+	g_slice_free(JDistributedObjectBackgroundData, background_data);
+
+	return NULL;
+}
+
+/**
+ * Executes copy operations in a background operation.
+ *
+ * \private
+ *
+ * \param data Background data.
+ *
+ * \return #data.
+ **/
+static gpointer
+j_distributed_object_copy_background_operation(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectBackgroundData* background_data = data;
+
+	g_autoptr(JListIterator) it = NULL;
+	g_autoptr(JMessage) reply = NULL;
+	gpointer object_connection;
+
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
+	j_message_send(background_data->message, object_connection);
+
+	reply = j_message_new_reply(background_data->message);
+	background_data->ret = j_message_receive(reply, object_connection) && background_data->ret;
+
+	if (j_message_get_count(reply) != j_list_length(background_data->copy.bytes_copied))
+	{
+		background_data->ret = FALSE;
+	}
+	else
+	{
+		it = j_list_iterator_new(background_data->copy.bytes_copied);
+
+		while (j_list_iterator_next(it))
+		{
+			guint64* bytes_copied = j_list_iterator_get(it);
+			guint32 status;
+			guint64 nbytes;
+
+			status = j_message_get_4(reply);
+			nbytes = j_message_get_8(reply);
+
+			background_data->ret = (status == 1) && background_data->ret;
+			j_helper_atomic_add(bytes_copied, nbytes);
+		}
+	}
+
+	j_message_unref(background_data->message);
+
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+
+	j_list_unref(background_data->copy.bytes_copied);
+
+	return data;
+}
+
+/**
+ * Frees a list of read buffers.
+ *
+ * \private
+ *
+ * \param data The first read buffer.
+ **/
+static void
+j_distributed_object_read_buffer_free(gpointer data)
+{
+	JDistributedObjectReadBuffer* buffer = data;
+
+	while (buffer != NULL)
+	{
+		JDistributedObjectReadBuffer* next = buffer->next;
+
+		g_slice_free(JDistributedObjectReadBuffer, buffer);
+		buffer = next;
+	}
+}
+
+/**
+ * Splits a range of an object into contiguous extents per server.
+ *
+ * \private
+ *
+ * The whole range is distributed at once.
+ * Consecutive chunks that are stored contiguously on the same server are merged into one extent, as long as it does not exceed the maximum operation size.
+ * This reduces the number of operations per server considerably for small stripe sizes.
+ *
+ * \param object       An object.
+ * \param length       A length.
+ * \param offset       An offset.
+ * \param server_count The number of servers.
+ * \param func         A function to call for each extent.
+ * \param data         User data for \p func.
+ **/
+static void
+j_distributed_object_foreach_extent(JDistributedObject* object, guint64 length, guint64 offset, guint32 server_count, JDistributedObjectExtentFunc func, gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autoptr(GArray) chunks = NULL;
+	g_autofree JDistributionChunk* sorted = NULL;
+	g_autofree guint* positions = NULL;
+	JDistributionChunk const* chunk;
+	guint64 max_length;
+
+	chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+	j_distribution_distribute_range(object->distribution, length, offset, chunks);
+
+	if (chunks->len == 0)
+	{
+		return;
+	}
+
+	if (chunks->len == 1)
+	{
+		chunk = &g_array_index(chunks, JDistributionChunk, 0);
+		func(chunk->index, chunk->length, chunk->offset, chunk, 1, data);
+
+		return;
+	}
+
+	max_length = j_configuration_get_max_operation_size(j_configuration());
+
+	// Group the chunks by server, keeping their order within each server.
+	positions = g_new0(guint, server_count);
+	sorted = g_new(JDistributionChunk, chunks->len);
+
+	for (guint i = 0; i < chunks->len; i++)
+	{
+		chunk = &g_array_index(chunks, JDistributionChunk, i);
+
+		if (chunk->index + 1 < server_count)
+		{
+			positions[chunk->index + 1]++;
+		}
+	}
+
+	for (guint i = 1; i < server_count; i++)
+	{
+		positions[i] += positions[i - 1];
+	}
+
+	for (guint i = 0; i < chunks->len; i++)
+	{
+		chunk = &g_array_index(chunks, JDistributionChunk, i);
+		sorted[positions[chunk->index]++] = *chunk;
+	}
+
+	for (guint i = 0; i < chunks->len;)
+	{
+		guint64 extent_length = sorted[i].length;
+		guint j = i + 1;
+
+		while (j < chunks->len
+		       && sorted[j].index == sorted[i].index
+		       && sorted[j - 1].offset + sorted[j - 1].length == sorted[j].offset
+		       && extent_length + sorted[j].length <= max_length)
+		{
+			extent_length += sorted[j].length;
+			j++;
+		}
+
+		func(sorted[i].index, extent_length, sorted[i].offset, &(sorted[i]), j - i, data);
+
+		i = j;
+	}
+}
+
+/**
+ * Returns the namespaces of an object's copies.
+ *
+ * \private
+ *
+ * The first copy is stored in the object's namespace, all other copies use separate namespaces.
+ * This is necessary because a server stores blocks of the object itself as well as copies of other servers' blocks at the same offsets.
+ *
+ * \param namespace The object's namespace.
+ * \param replicas  The number of copies.
+ *
+ * \return The namespaces, one per copy. Should be freed with g_strfreev().
+ **/
+static gchar**
+j_distributed_object_get_replica_namespaces(gchar const* namespace, guint32 replicas)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gchar** namespaces;
+
+	namespaces = g_new(gchar*, replicas + 1);
+	namespaces[0] = g_strdup(namespace);
+
+	for (guint32 i = 1; i < replicas; i++)
+	{
+		namespaces[i] = g_strdup_printf("%s.replica%u", namespace, i);
+	}
+
+	namespaces[replicas] = NULL;
+
+	return namespaces;
+}
+
+/**
+ * Adds an operation for an extent to a message, creating the message if necessary.
+ *
+ * \private
+ *
+ * \param extent_data A #JDistributedObjectExtentData.
+ * \param messages    The messages.
+ * \param slot        The message's slot.
+ * \param type        The message type.
+ * \param replica     The copy.
+ * \param length      The extent's length.
+ * \param offset      The extent's offset on the server.
+ *
+ * \return The message.
+ **/
+static JMessage*
+j_distributed_object_extent_message(JDistributedObjectExtentData* extent_data, JMessage** messages, guint32 slot, JMessageType type, guint32 replica, guint64 length, guint64 offset)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	if (messages[slot] == NULL)
+	{
+		gchar const* namespace = extent_data->namespaces[replica];
+		gsize name_len;
+		gsize namespace_len;
+		gsize size;
+
+		namespace_len = strlen(namespace) + 1;
+		name_len = strlen(extent_data->object->name) + 1;
+		size = namespace_len + name_len;
+
+		if (type == J_MESSAGE_OBJECT_COMPOUND)
+		{
+			size += sizeof(guint32);
+		}
+
+		messages[slot] = j_message_new(type, size);
+		j_message_set_semantics(messages[slot], extent_data->semantics);
+		j_message_append_n(messages[slot], namespace, namespace_len);
+		j_message_append_n(messages[slot], extent_data->object->name, name_len);
+
+		if (type == J_MESSAGE_OBJECT_COMPOUND)
+		{
+			// Stripes are created when they are first written to.
+			j_message_append_4(messages[slot], &(extent_data->flags));
+		}
+	}
+
+	j_message_add_operation(messages[slot], sizeof(guint64) + sizeof(guint64));
+	j_message_append_8(messages[slot], &length);
+	j_message_append_8(messages[slot], &offset);
+
+	return messages[slot];
+}
+
+/**
+ * Adds a read operation for an extent.
+ *
+ * \private
+ *
+ * The extent is read from the copy whose server has the fewest outstanding bytes.
+ * Ties are broken based on the block, so that idle clients spread their reads across all copies.
+ *
+ * \param index      The server index.
+ * \param length     The extent's length.
+ * \param offset     The extent's offset on the server.
+ * \param chunks     The chunks making up the extent.
+ * \param chunks_len The number of chunks.
+ * \param data       A #JDistributedObjectExtentData.
+ **/
+static void
+j_distributed_object_read_extent(guint32 index, guint64 length, guint64 offset, JDistributionChunk const* chunks, guint chunks_len, gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectExtentData* extent_data = data;
+	JDistribution* distribution = extent_data->object->distribution;
+
+	JDistributedObjectReadBuffer* first = NULL;
+	JDistributedObjectReadBuffer* last = NULL;
+	guint32 replica = 0;
+	guint32 slot;
+
+	if (extent_data->replicas > 1)
+	{
+		guint64* server_loads;
+		guint64 best_load = G_MAXUINT64;
+
+		server_loads = j_distributed_object_get_server_loads();
+
+		for (guint32 i = 0; i < extent_data->replicas; i++)
+		{
+			guint32 candidate = (chunks[0].block_id + i) % extent_data->replicas;
+			guint32 server;
+			guint64 load;
+
+			server = j_distribution_get_replica_index(distribution, index, candidate);
+			load = j_helper_atomic_add(&(server_loads[server]), 0);
+
+			// Also take the reads into account that have already been assigned to the server.
+			for (guint32 j = 0; j < extent_data->replicas; j++)
+			{
+				load += extent_data->loads[(j * extent_data->server_count) + server];
+			}
+
+			if (load < best_load)
+			{
+				best_load = load;
+				replica = candidate;
+			}
+		}
+	}
+
+	slot = (replica * extent_data->server_count) + j_distribution_get_replica_index(distribution, index, replica);
+
+	j_distributed_object_extent_message(extent_data, extent_data->messages, slot, J_MESSAGE_OBJECT_READ, replica, length, offset);
+
+	if (extent_data->lists[slot] == NULL)
+	{
+		extent_data->lists[slot] = j_list_new(j_distributed_object_read_buffer_free);
+	}
+
+	// Hedged reads are sent to the next copy.
+	if (extent_data->hedges != NULL && extent_data->replicas > 1)
+	{
+		j_distributed_object_extent_message(extent_data, extent_data->hedges, slot, J_MESSAGE_OBJECT_READ, (replica + 1) % extent_data->replicas, length, offset);
+	}
+
+	extent_data->loads[slot] += length;
+
+	for (guint i = 0; i < chunks_len; i++)
+	{
+		JDistributedObjectReadBuffer* buffer;
+
+		buffer = g_slice_new(JDistributedObjectReadBuffer);
+		buffer->data = extent_data->data + chunks[i].range_offset;
+		buffer->length = chunks[i].length;
+		buffer->bytes_read = extent_data->bytes;
+		buffer->next = NULL;
+
+		if (last == NULL)
+		{
+			first = buffer;
+		}
+		else
+		{
+			last->next = buffer;
+		}
+
+		last = buffer;
+	}
+
+	j_list_append(extent_data->lists[slot], first);
+}
+
+/**
+ * Adds a write operation for an extent.
+ *
+ * \private
+ *
+ * The extent is written to all copies in parallel.
+ *
+ * \param index      The server index.
+ * \param length     The extent's length.
+ * \param offset     The extent's offset on the server.
+ * \param chunks     The chunks making up the extent.
+ * \param chunks_len The number of chunks.
+ * \param data       A #JDistributedObjectExtentData.
+ **/
+static void
+j_distributed_object_write_extent(guint32 index, guint64 length, guint64 offset, JDistributionChunk const* chunks, guint chunks_len, gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectExtentData* extent_data = data;
+
+	for (guint32 replica = 0; replica < extent_data->replicas; replica++)
+	{
+		JMessage* message;
+		guint64* bytes;
+		guint32 slot;
+
+		slot = (replica * extent_data->server_count) + j_distribution_get_replica_index(extent_data->object->distribution, index, replica);
+		message = j_distributed_object_extent_message(extent_data, extent_data->messages, slot, J_MESSAGE_OBJECT_COMPOUND, replica, length, offset);
+
+		if (extent_data->lists[slot] == NULL)
+		{
+			extent_data->lists[slot] = j_list_new(NULL);
+		}
+
+		// The server receives the chunks as one contiguous extent.
+		for (guint i = 0; i < chunks_len; i++)
+		{
+			j_message_add_send(message, extent_data->data + chunks[i].range_offset, chunks[i].length);
+		}
+
+		// Only the first copy counts towards the bytes written, failures of the other copies are reported via the return value.
+		bytes = (replica == 0) ? extent_data->bytes : extent_data->replica_bytes;
+		j_list_append(extent_data->lists[slot], bytes);
+
+		// Fake bytes_written here instead of doing another loop further down
+		if (j_semantics_get(extent_data->semantics, J_SEMANTICS_PERSISTENCY) == J_SEMANTICS_PERSISTENCY_NONE)
+		{
+			j_helper_atomic_add(bytes, length);
+		}
+	}
+}
+
+/**
+ * Returns the namespace of an object's size marker.
+ *
+ * \private
+ *
+ * The size marker is a sparse object stored on the server holding the object's first block.
+ * Its size is kept at the object's size, which allows creating objects and querying their status by contacting a single server.
+ * The object's stripes are created lazily when they are written to for the first time.
+ *
+ * \param object An object.
+ *
+ * \return The namespace. Should be freed with g_free().
+ **/
+static gchar*
+j_distributed_object_get_marker_namespace(JDistributedObject* object)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	return g_strconcat(object->namespace, ".size", NULL);
+}
+
+/**
+ * Returns the index of the server storing an object's size marker.
+ *
+ * \private
+ *
+ * \param object An object.
+ *
+ * \return The server index.
+ **/
+static guint32
+j_distributed_object_get_marker_index(JDistributedObject* object)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autoptr(GArray) chunks = NULL;
+
+	chunks = g_array_sized_new(FALSE, FALSE, sizeof(JDistributionChunk), 1);
+	j_distribution_distribute_range(object->distribution, 1, 0, chunks);
+
+	return g_array_index(chunks, JDistributionChunk, 0).index;
+}
+
+/**
+ * Marks the servers storing stripes of an object.
+ *
+ * \private
+ *
+ * Objects without a size marker have been written before size markers were introduced and have stripes on all servers.
+ *
+ * \param object       An object.
+ * \param size         The object's size.
+ * \param legacy       Whether the object does not have a size marker.
+ * \param servers      An array with one element per server, elements of servers storing stripes are set to TRUE.
+ * \param server_count The number of servers.
+ **/
+static void
+j_distributed_object_get_servers(JDistributedObject* object, guint64 size, gboolean legacy, gboolean* servers, guint32 server_count)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	// Ranges are distributed piecewise to limit the number of chunks.
+	static guint64 const window = 64 * 1024 * 1024;
+
+	g_autoptr(GArray) chunks = NULL;
+	guint32 found = 0;
+	guint32 index;
+	guint32 data_blocks;
+	guint32 parity_blocks;
+	guint64 block_size;
+	guint64 offset = 0;
+
+	if (legacy)
+	{
+		for (guint32 i = 0; i < server_count; i++)
+		{
+			servers[i] = TRUE;
+		}
+
+		return;
+	}
+
+	chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+
+	// The distribution is shared with concurrent operations, so its stateless interface is used.
+	// Stop early once all servers have been found, large objects usually span all of them.
+	while (found < server_count && offset < size)
+	{
+		guint64 length;
+
+		length = MIN(size - offset, window);
+
+		g_array_set_size(chunks, 0);
+		j_distribution_distribute_range(object->distribution, length, offset, chunks);
+
+		for (guint i = 0; i < chunks->len; i++)
+		{
+			index = g_array_index(chunks, JDistributionChunk, i).index;
+
+			if (!servers[index])
+			{
+				servers[index] = TRUE;
+				found++;
+			}
+		}
+
+		offset += length;
+	}
+
+	// Parity blocks are stored on servers that do not necessarily hold any data.
+	if (size > 0 && j_distribution_get_erasure(object->distribution, &data_blocks, &parity_blocks, &block_size))
+	{
+		guint64 groups;
+
+		groups = ((size - 1) / (data_blocks * block_size)) + 1;
+
+		for (guint64 group = 0; group < groups && found < server_count; group++)
+		{
+			for (guint32 position = data_blocks; position < data_blocks + parity_blocks; position++)
+			{
+				index = j_distribution_get_group_index(object->distribution, group, position);
+
+				if (!servers[index])
+				{
+					servers[index] = TRUE;
+					found++;
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Creates a message that creates an object's size marker and extends it to a size.
+ *
+ * \private
+ *
+ * \param object           An object.
+ * \param marker_namespace The marker's namespace.
+ * \param size             The size, 0 to only create the marker.
+ * \param flags            Additional #JMessageObjectCompoundFlags.
+ * \param semantics        A semantics object.
+ *
+ * \return A new message. Should be freed with j_message_unref().
+ **/
+static JMessage*
+j_distributed_object_marker_message_new(JDistributedObject* object, gchar const* marker_namespace, guint64 size, guint32 flags, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	static gchar const zero = 0;
+
+	JMessage* message;
+	gsize name_len;
+	gsize namespace_len;
+
+	namespace_len = strlen(marker_namespace) + 1;
+	name_len = strlen(object->name) + 1;
+	flags |= J_MESSAGE_OBJECT_COMPOUND_CREATE;
+
+	message = j_message_new(J_MESSAGE_OBJECT_COMPOUND, namespace_len + name_len + sizeof(guint32));
+	j_message_set_semantics(message, semantics);
+	j_message_append_n(message, marker_namespace, namespace_len);
+	j_message_append_n(message, object->name, name_len);
+	j_message_append_4(message, &flags);
+
+	if (size > 0)
+	{
+		guint64 length = 1;
+		guint64 offset = size - 1;
+
+		// Writing only the last byte grows the marker without allocating space for the rest.
+		j_message_add_operation(message, sizeof(guint64) + sizeof(guint64));
+		j_message_append_8(message, &length);
+		j_message_append_8(message, &offset);
+		j_message_add_send(message, &zero, 1);
+	}
+
+	return message;
+}
+
+/**
+ * Queries the size markers of objects.
+ *
+ * \private
+ *
+ * \param operations A list of status operations, their results have to be initialized.
+ * \param semantics  A semantics object.
+ **/
+static void
+j_distributed_object_status_markers(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autoptr(JListIterator) it = NULL;
+	g_autofree JMessage** messages = NULL;
+	g_autofree JList** operation_lists = NULL;
+	g_autofree gpointer* background_data = NULL;
+	g_autofree gchar* marker_namespace = NULL;
+	gsize namespace_len;
+	guint32 server_count;
+
+	{
+		JDistributedObjectOperation* operation = j_list_get_first(operations);
+		g_assert(operation != NULL);
+
+		marker_namespace = j_distributed_object_get_marker_namespace(operation->status.object);
+		namespace_len = strlen(marker_namespace) + 1;
+	}
+
+	server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+	messages = g_new0(JMessage*, server_count);
+	operation_lists = g_new0(JList*, server_count);
+
+	it = j_list_iterator_new(operations);
+
+	while (j_list_iterator_next(it))
+	{
+		JDistributedObjectOperation* operation = j_list_iterator_get(it);
+		JDistributedObject* object = operation->status.object;
+		gsize name_len;
+		guint32 index;
+
+		index = j_distributed_object_get_marker_index(object);
+		name_len = strlen(object->name) + 1;
+
+		if (messages[index] == NULL)
+		{
+			messages[index] = j_message_new(J_MESSAGE_OBJECT_STATUS, namespace_len);
+			j_message_set_semantics(messages[index], semantics);
+			j_message_append_n(messages[index], marker_namespace, namespace_len);
+
+			operation_lists[index] = j_list_new(NULL);
+		}
+
+		j_message_add_operation(messages[index], name_len);
+		j_message_append_n(messages[index], object->name, name_len);
+
+		j_list_append(operation_lists[index], operation);
+	}
+
+	background_data = g_new(gpointer, server_count);
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		JDistributedObjectBackgroundData* data;
+
+		if (messages[i] == NULL)
+		{
+			background_data[i] = NULL;
+			continue;
+		}
+
+		data = g_slice_new(JDistributedObjectBackgroundData);
+		data->index = i;
+		data->message = messages[i];
+		data->operations = operation_lists[i];
+		data->semantics = semantics;
+
+		background_data[i] = data;
+	}
+
+	j_helper_execute_parallel(j_distributed_object_status_background_operation, background_data, server_count);
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		if (operation_lists[i] != NULL)
+		{
+			j_list_unref(operation_lists[i]);
+		}
+	}
+}
+
+/**
+ * Queries the stripes of objects that do not have a size marker.
+ *
+ * \private
+ *
+ * Objects that have been written before size markers were introduced have stripes on all servers.
+ * Their status is derived from their stripes instead.
+ *
+ * \param objects            A list of objects.
+ * \param semantics          A semantics object.
+ * \param modification_times The objects' modification times, the latest stripe's modification time is stored.
+ * \param sizes              The objects' sizes, the stripes' sizes are added.
+ **/
+static void
+j_distributed_object_status_stripes(JList* objects, JSemantics* semantics, gint64* modification_times, guint64* sizes)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autofree JDistributedObjectOperation* operations = NULL;
+	g_autofree gint64* server_modification_times = NULL;
+	g_autofree JList** operation_lists = NULL;
+	g_autofree gpointer* background_data = NULL;
+	gchar const* namespace;
+	gsize namespace_len;
+	guint32 server_count;
+	guint length;
+
+	{
+		JDistributedObject* object = j_list_get_first(objects);
+		g_assert(object != NULL);
+
+		namespace = object->namespace;
+		namespace_len = strlen(namespace) + 1;
+	}
+
+	length = j_list_length(objects);
+	server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+
+	operations = g_new0(JDistributedObjectOperation, server_count * length);
+	server_modification_times = g_new0(gint64, server_count * length);
+	operation_lists = g_new(JList*, server_count);
+	background_data = g_new(gpointer, server_count);
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		JDistributedObjectBackgroundData* data;
+		JListIterator* it;
+		guint j = 0;
+
+		operation_lists[i] = j_list_new(NULL);
+
+		data = g_slice_new(JDistributedObjectBackgroundData);
+		data->index = i;
+		data->message = j_message_new(J_MESSAGE_OBJECT_STATUS, namespace_len);
+		data->operations = operation_lists[i];
+		data->semantics = semantics;
+
+		j_message_set_semantics(data->message, semantics);
+		j_message_append_n(data->message, namespace, namespace_len);
+
+		it = j_list_iterator_new(objects);
+
+		while (j_list_iterator_next(it))
+		{
+			JDistributedObject* object = j_list_iterator_get(it);
+			JDistributedObjectOperation* operation = &(operations[(i * length) + j]);
+			gsize name_len;
+
+			name_len = strlen(object->name) + 1;
+
+			// Sizes are added atomically, so all servers can share them.
+			operation->status.object = object;
+			operation->status.modification_time = &(server_modification_times[(i * length) + j]);
+			operation->status.size = &(sizes[j]);
+
+			j_message_add_operation(data->message, name_len);
+			j_message_append_n(data->message, object->name, name_len);
+
+			j_list_append(operation_lists[i], operation);
+			j++;
+		}
+
+		j_list_iterator_free(it);
+
+		background_data[i] = data;
+	}
+
+	j_helper_execute_parallel(j_distributed_object_status_background_operation, background_data, server_count);
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		for (guint j = 0; j < length; j++)
+		{
+			modification_times[j] = MAX(modification_times[j], server_modification_times[(i * length) + j]);
+		}
+
+		j_list_unref(operation_lists[i]);
+	}
+}
+
+/**
+ * Queries the status of objects.
+ *
+ * \private
+ *
+ * \param objects            A list of objects.
+ * \param semantics          A semantics object.
+ * \param modification_times The objects' modification times, 0 for objects that do not exist.
+ * \param sizes              The objects' sizes.
+ * \param legacy             Whether objects do not have a size marker but stripes, may be NULL.
+ **/
+static void
+j_distributed_object_get_status(JList* objects, JSemantics* semantics, gint64* modification_times, guint64* sizes, gboolean* legacy)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autoptr(JList) status_operations = NULL;
+	g_autoptr(JList) legacy_objects = NULL;
+	g_autoptr(JListIterator) it = NULL;
+	g_autofree JDistributedObjectOperation* operations = NULL;
+	g_autofree guint* legacy_indices = NULL;
+	guint length;
+	guint legacy_count = 0;
+	guint i = 0;
+
+	length = j_list_length(objects);
+	operations = g_new0(JDistributedObjectOperation, length);
+	legacy_indices = g_new(guint, length);
+	status_operations = j_list_new(NULL);
+	legacy_objects = j_list_new(NULL);
+
+	it = j_list_iterator_new(objects);
+
+	while (j_list_iterator_next(it))
+	{
+		modification_times[i] = 0;
+		sizes[i] = 0;
+
+		if (legacy != NULL)
+		{
+			legacy[i] = FALSE;
+		}
+
+		operations[i].status.object = j_list_iterator_get(it);
+		operations[i].status.modification_time = &(modification_times[i]);
+		operations[i].status.size = &(sizes[i]);
+
+		j_list_append(status_operations, &(operations[i]));
+		i++;
+	}
+
+	j_distributed_object_status_markers(status_operations, semantics);
+
+	// Size markers always have a modification time, objects without one have either been written before size markers were introduced or do not exist.
+	for (i = 0; i < length; i++)
+	{
+		if (modification_times[i] == 0)
+		{
+			legacy_indices[legacy_count] = i;
+			legacy_count++;
+
+			j_list_append(legacy_objects, operations[i].status.object);
+		}
+	}
+
+	if (legacy_count > 0)
+	{
+		g_autofree gint64* legacy_modification_times = NULL;
+		g_autofree guint64* legacy_sizes = NULL;
+
+		legacy_modification_times = g_new0(gint64, legacy_count);
+		legacy_sizes = g_new0(guint64, legacy_count);
+
+		j_distributed_object_status_stripes(legacy_objects, semantics, legacy_modification_times, legacy_sizes);
+
+		for (i = 0; i < legacy_count; i++)
+		{
+			modification_times[legacy_indices[i]] = legacy_modification_times[i];
+			sizes[legacy_indices[i]] = legacy_sizes[i];
+
+			if (legacy != NULL)
+			{
+				legacy[legacy_indices[i]] = (legacy_modification_times[i] > 0);
+			}
+		}
+	}
+}
+
+/**
+ * Queries the sizes of objects.
+ *
+ * \private
+ *
+ * \param objects   A list of objects.
+ * \param semantics A semantics object.
+ * \param legacy    Whether objects do not have a size marker but stripes, may be NULL.
+ *
+ * \return The objects' sizes. Should be freed with g_free().
+ **/
+static guint64*
+j_distributed_object_get_sizes(JList* objects, JSemantics* semantics, gboolean* legacy)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autofree gint64* modification_times = NULL;
+	guint64* sizes;
+	guint length;
+
+	length = j_list_length(objects);
+	modification_times = g_new0(gint64, length);
+	sizes = g_new0(guint64, length);
+
+	j_distributed_object_get_status(objects, semantics, modification_times, sizes, legacy);
+
+	return sizes;
+}
+
+static gboolean
+j_distributed_object_create_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	/// \todo check return value for messages
+	gboolean ret = TRUE;
+
+	JBackend* object_backend;
+	g_autoptr(JListIterator) it = NULL;
+	g_autofree JMessage** messages = NULL;
+	g_autofree gchar* marker_namespace = NULL;
+	gsize namespace_len = 0;
+	guint32 server_count = 0;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	{
+		JDistributedObject* object;
+
+		object = j_list_get_first(operations);
+		g_assert(object != NULL);
+
+		marker_namespace = j_distributed_object_get_marker_namespace(object);
+		namespace_len = strlen(marker_namespace) + 1;
+	}
+
+	it = j_list_iterator_new(operations);
+	object_backend = j_object_get_backend();
+
+	if (object_backend == NULL)
+	{
+		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+		messages = g_new0(JMessage*, server_count);
+	}
+
+	while (j_list_iterator_next(it))
+	{
+		JDistributedObject* object = j_list_iterator_get(it);
+
+		if (object_backend == NULL)
+		{
+			gsize name_len;
+			guint32 index;
+
+			// Only the size marker is created, stripes are created when they are first written to.
+			index = j_distributed_object_get_marker_index(object);
+			name_len = strlen(object->name) + 1;
+
+			if (messages[index] == NULL)
+			{
+				/**
+				 * Force safe semantics to make the server send a reply.
+				 * Otherwise, nasty races can occur when using unsafe semantics:
+				 * - The client creates the object and sends its first write.
+				 * - The client sends another operation using another connection from the pool.
+				 * - The second operation is executed first and fails because the object does not exist.
+				 * This does not completely eliminate all races but fixes the common case of create, write, write, ...
+				 **/
+				messages[index] = j_message_new(J_MESSAGE_OBJECT_CREATE, namespace_len);
+				j_message_set_semantics(messages[index], semantics);
+				j_message_append_n(messages[index], marker_namespace, namespace_len);
+			}
+
+			j_message_add_operation(messages[index], name_len);
+			j_message_append_n(messages[index], object->name, name_len);
+		}
+		else
+		{
+			gpointer object_handle;
+
+			ret = j_backend_object_create(object_backend, object->namespace, object->name, &object_handle) && ret;
+			ret = j_backend_object_close(object_backend, object_handle) && ret;
+		}
+	}
+
+	if (object_backend == NULL)
+	{
+		g_autofree gpointer* background_data = NULL;
+
+		background_data = g_new(gpointer, server_count);
+
+		for (guint i = 0; i < server_count; i++)
+		{
+			JDistributedObjectBackgroundData* data;
+
+			if (messages[i] == NULL)
+			{
+				background_data[i] = NULL;
+				continue;
+			}
+
+			data = g_slice_new(JDistributedObjectBackgroundData);
+			data->index = i;
+			data->message = messages[i];
+			data->operations = NULL;
+			data->semantics = semantics;
+
+			background_data[i] = data;
+		}
+
+		j_helper_execute_parallel(j_distributed_object_create_background_operation, background_data, server_count);
+	}
+
+	return ret;
+}
+
+static gboolean
+j_distributed_object_delete_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	JBackend* object_backend;
+	g_autoptr(JListIterator) it = NULL;
+	g_autofree JMessage** messages = NULL;
+	g_autofree gboolean* servers = NULL;
+	g_autofree guint64* sizes = NULL;
+	g_autofree gboolean* legacy = NULL;
+	g_autofree gchar* marker_namespace = NULL;
+	g_auto(GStrv) namespaces = NULL;
+	gchar const* namespace = NULL;
+	gsize marker_namespace_len = 0;
+	guint32 server_count = 0;
+	guint32 stripe_count = 0;
+	guint i = 0;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	{
+		JDistributedObject* object;
+
+		object = j_list_get_first(operations);
+		g_assert(object != NULL);
+
+		namespace = object->namespace;
+		marker_namespace = j_distributed_object_get_marker_namespace(object);
+		marker_namespace_len = strlen(marker_namespace) + 1;
+	}
+
+	it = j_list_iterator_new(operations);
+	object_backend = j_object_get_backend();
+
+	if (object_backend == NULL)
+	{
+		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+
+		// The objects might use different numbers of copies, so there is room for the maximum number of copies.
+		namespaces = j_distributed_object_get_replica_namespaces(namespace, server_count);
+		stripe_count = server_count * server_count;
+
+		// The first messages delete stripes, one per copy and server, the remaining ones delete size markers.
+		messages = g_new0(JMessage*, stripe_count + server_count);
+		servers = g_new(gboolean, server_count);
+
+		// The sizes determine which servers store stripes.
+		legacy = g_new(gboolean, j_list_length(operations));
+		sizes = j_distributed_object_get_sizes(operations, semantics, legacy);
+	}
+
+	while (j_list_iterator_next(it))
+	{
+		JDistributedObject* object = j_list_iterator_get(it);
+
+		if (object_backend == NULL)
+		{
+			gsize name_len;
+			guint32 index;
+			guint32 replicas;
+
+			name_len = strlen(object->name) + 1;
+			replicas = j_distribution_get_replicas(object->distribution);
+
+			memset(servers, 0, server_count * sizeof(gboolean));
+			j_distributed_object_get_servers(object, sizes[i], legacy[i], servers, server_count);
+
+			for (guint j = 0; j < server_count; j++)
+			{
+				if (!servers[j])
+				{
+					continue;
+				}
+
+				for (guint32 r = 0; r < replicas; r++)
+				{
+					guint32 slot;
+
+					slot = (r * server_count) + j_distribution_get_replica_index(object->distribution, j, r);
+
+					if (messages[slot] == NULL)
+					{
+						messages[slot] = j_message_new(J_MESSAGE_OBJECT_DELETE, strlen(namespaces[r]) + 1);
+						j_message_set_semantics(messages[slot], semantics);
+						j_message_append_n(messages[slot], namespaces[r], strlen(namespaces[r]) + 1);
+					}
+
+					j_message_add_operation(messages[slot], name_len);
+					j_message_append_n(messages[slot], object->name, name_len);
+				}
+			}
+
+			// Objects without a size marker only consist of stripes.
+			if (legacy[i])
+			{
+				i++;
+				continue;
+			}
+
+			index = stripe_count + j_distributed_object_get_marker_index(object);
+
+			if (messages[index] == NULL)
+			{
+				messages[index] = j_message_new(J_MESSAGE_OBJECT_DELETE, marker_namespace_len);
+				j_message_set_semantics(messages[index], semantics);
+				j_message_append_n(messages[index], marker_namespace, marker_namespace_len);
+			}
+
+			j_message_add_operation(messages[index], name_len);
+			j_message_append_n(messages[index], object->name, name_len);
+
+			i++;
+		}
+		else
+		{
+			gboolean lret = FALSE;
+			gpointer object_handle;
+
+			if (j_backend_object_open(object_backend, object->namespace, object->name, &object_handle)
+			    && j_backend_object_delete(object_backend, object_handle))
+			{
+				lret = TRUE;
+			}
+
+			ret = lret && ret;
+		}
+	}
+
+	if (object_backend == NULL)
+	{
+		g_autofree gpointer* background_data = NULL;
+
+		background_data = g_new(gpointer, stripe_count + server_count);
+
+		for (guint j = 0; j < stripe_count + server_count; j++)
+		{
+			JDistributedObjectBackgroundData* data;
+
+			if (messages[j] == NULL)
+			{
+				background_data[j] = NULL;
+				continue;
+			}
+
+			data = g_slice_new(JDistributedObjectBackgroundData);
+			data->index = j % server_count;
+			data->message = messages[j];
+			data->operations = NULL;
+			data->semantics = semantics;
+			data->ret = TRUE;
+
+			background_data[j] = data;
+		}
+
+		j_helper_execute_parallel(j_distributed_object_delete_background_operation, background_data, stripe_count + server_count);
+
+		for (guint j = 0; j < stripe_count + server_count; j++)
+		{
+			JDistributedObjectBackgroundData* data = background_data[j];
+
+			if (data == NULL)
+			{
+				continue;
+			}
+
+			// Stripes in holes have never been written and do not exist, so only the size markers decide about success.
+			// Objects without a size marker have already been found by their stripes.
+			if (j >= stripe_count)
+			{
+				ret = data->ret && ret;
+			}
+
+			g_slice_free(JDistributedObjectBackgroundData, data);
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * Reconstructs the parts of a read that are stored on failed servers.
+ *
+ * \private
+ *
+ * All groups whose data blocks in the range are stored on failed servers are read completely from the remaining servers and decoded.
+ * Other groups have already been read successfully and are left untouched.
+ *
+ * \param object     An erasure coded object.
+ * \param semantics  A semantics object.
+ * \param failed     An array with one element per server, elements of failed servers are TRUE.
+ * \param data       The read's buffer.
+ * \param length     The read's length.
+ * \param offset     The read's offset.
+ * \param size       The object's size.
+ * \param bytes_read The number of bytes read, which is updated on success.
+ *
+ * \return TRUE on success, FALSE if too many servers have failed.
+ **/
+static gboolean
+j_distributed_object_reconstruct(JDistributedObject* object, JSemantics* semantics, gboolean const* failed, gchar* data, guint64 length, guint64 offset, guint64 size, guint64* bytes_read)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	g_autoptr(GArray) groups = NULL;
+	g_autoptr(JErasure) erasure = NULL;
+	g_autofree JList** lists = NULL;
+	g_autofree JMessage** messages = NULL;
+	g_autofree gpointer* background_data = NULL;
+	g_autofree gboolean* missing = NULL;
+	g_autofree gchar* buffer = NULL;
+	g_autofree guint64* block_bytes = NULL;
+	g_auto(GStrv) namespaces = NULL;
+	JDistributedObjectExtentData extent_data;
+	guint32 data_blocks;
+	guint32 parity_blocks;
+	guint32 server_count;
+	guint64 block_size;
+	guint64 group_size;
+	guint64 end;
+
+	if (!j_distribution_get_erasure(object->distribution, &data_blocks, &parity_blocks, &block_size))
+	{
+		return FALSE;
+	}
+
+	end = MIN(offset + length, size);
+
+	if (offset >= end)
+	{
+		return TRUE;
+	}
+
+	server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+	group_size = data_blocks * block_size;
+	groups = g_array_new(FALSE, FALSE, sizeof(guint64));
+
+	for (guint64 group = offset / group_size; group <= (end - 1) / group_size; group++)
+	{
+		for (guint32 position = 0; position < data_blocks; position++)
+		{
+			guint64 block_start = (group * group_size) + (position * block_size);
+
+			if (block_start < end && block_start + block_size > offset && failed[j_distribution_get_group_index(object->distribution, group, position)])
+			{
+				g_array_append_val(groups, group);
+				break;
+			}
+		}
+	}
+
+	if (groups->len == 0)
+	{
+		return TRUE;
+	}
+
+	// The remaining blocks of each group are read with one message per server, like regular reads.
+	buffer = g_malloc0(groups->len * (data_blocks + parity_blocks) * block_size);
+	block_bytes = g_new0(guint64, groups->len * (data_blocks + parity_blocks));
+	messages = g_new0(JMessage*, server_count);
+	lists = g_new0(JList*, server_count);
+	missing = g_new(gboolean, server_count);
+	namespaces = j_distributed_object_get_replica_namespaces(object->namespace, 1);
+
+	memcpy(missing, failed, server_count * sizeof(gboolean));
+
+	extent_data.object = object;
+	extent_data.semantics = semantics;
+	extent_data.messages = messages;
+	extent_data.lists = lists;
+	extent_data.server_count = server_count;
+	extent_data.replicas = 1;
+	extent_data.namespaces = namespaces;
+	extent_data.hedges = NULL;
+	extent_data.loads = NULL;
+	extent_data.replica_bytes = NULL;
+	extent_data.data = NULL;
+	extent_data.bytes = NULL;
+	extent_data.flags = 0;
+
+	for (guint i = 0; i < groups->len; i++)
+	{
+		guint64 group = g_array_index(groups, guint64, i);
+
+		for (guint32 position = 0; position < data_blocks + parity_blocks; position++)
+		{
+			JDistributedObjectReadBuffer* read_buffer;
+			guint32 block = (i * (data_blocks + parity_blocks)) + position;
+			guint32 index;
+
+			index = j_distribution_get_group_index(object->distribution, group, position);
+
+			if (missing[index])
+			{
+				continue;
+			}
+
+			j_distributed_object_extent_message(&extent_data, messages, index, J_MESSAGE_OBJECT_READ, 0, block_size, group * block_size);
+
+			if (lists[index] == NULL)
+			{
+				lists[index] = j_list_new(j_distributed_object_read_buffer_free);
+			}
+
+			read_buffer = g_slice_new(JDistributedObjectReadBuffer);
+			read_buffer->data = buffer + (block * block_size);
+			read_buffer->length = block_size;
+			read_buffer->bytes_read = &(block_bytes[block]);
+			read_buffer->next = NULL;
+
+			j_list_append(lists[index], read_buffer);
+		}
+	}
+
+	background_data = g_new(gpointer, server_count);
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		JDistributedObjectBackgroundData* bg_data;
+
+		if (messages[i] == NULL)
+		{
+			background_data[i] = NULL;
+			continue;
+		}
+
+		bg_data = g_slice_new(JDistributedObjectBackgroundData);
+		bg_data->index = i;
+		bg_data->message = messages[i];
+		bg_data->operations = NULL;
+		bg_data->semantics = semantics;
+		bg_data->read.buffers = lists[i];
+		bg_data->read.hedge = NULL;
+		bg_data->read.hedge_index = 0;
+		bg_data->read.load = 0;
+		bg_data->ret = TRUE;
+
+		background_data[i] = bg_data;
+	}
+
+	j_helper_execute_parallel(j_distributed_object_read_background_operation, background_data, server_count);
+
+	for (guint i = 0; i < server_count; i++)
+	{
+		JDistributedObjectBackgroundData* bg_data = background_data[i];
+
+		if (bg_data == NULL)
+		{
+			continue;
+		}
+
+		// Servers might also fail while reconstructing.
+		if (!bg_data->ret)
+		{
+			missing[i] = TRUE;
+		}
+
+		g_slice_free(JDistributedObjectBackgroundData, bg_data);
+	}
+
+	erasure = j_erasure_new(data_blocks, parity_blocks);
+
+	for (guint i = 0; i < groups->len && ret; i++)
+	{
+		g_autofree gpointer* blocks = NULL;
+		g_autofree gboolean* present = NULL;
+		guint64 group = g_array_index(groups, guint64, i);
+
+		blocks = g_new(gpointer, data_blocks + parity_blocks);
+		present = g_new(gboolean, data_blocks + parity_blocks);
+
+		// Short reads leave zeros behind, which matches how the parity has been computed.
+		for (guint32 position = 0; position < data_blocks + parity_blocks; position++)
+		{
+			blocks[position] = buffer + (((i * (data_blocks + parity_blocks)) + position) * block_size);
+			present[position] = !missing[j_distribution_get_group_index(object->distribution, group, position)];
+		}
+
+		if (!j_erasure_decode(erasure, blocks, present, block_size))
+		{
+			ret = FALSE;
+			break;
+		}
+
+		for (guint32 position = 0; position < data_blocks; position++)
+		{
+			guint64 block_start = (group * group_size) + (position * block_size);
+			guint64 copy_start = MAX(block_start, offset);
+			guint64 copy_end = MIN(block_start + block_size, end);
+
+			if (copy_start < copy_end)
+			{
+				memcpy(data + (copy_start - offset), (gchar*)blocks[position] + (copy_start - block_start), copy_end - copy_start);
+			}
+		}
+	}
+
+	if (ret)
+	{
+		*bytes_read = end - offset;
+	}
+
+	return ret;
+}
+
+static gboolean
+j_distributed_object_read_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	/// \todo check return value for messages
+	gboolean ret = TRUE;
+
+	JBackend* object_backend;
+	g_autofree JList** br_lists = NULL;
+	g_autoptr(JListIterator) it = NULL;
+	g_autofree JMessage** messages = NULL;
+	g_autofree JMessage** hedges = NULL;
+	g_autofree guint64* loads = NULL;
+	g_autofree guint64* operation_bytes = NULL;
+	g_autofree gboolean* failed = NULL;
+	g_auto(GStrv) namespaces = NULL;
+	JDistributedObject* object = NULL;
+	gpointer object_handle;
+	gboolean erasure = FALSE;
+	gboolean degraded = FALSE;
+	guint32 server_count = 0;
+	guint32 replicas = 1;
+	guint operation_index = 0;
+
+	/// \todo
+	//JLock* lock = NULL;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	{
+		JDistributedObjectOperation* operation = j_list_get_first(operations);
+		g_assert(operation != NULL);
+
+		object = operation->read.object;
+		g_assert(object != NULL);
+	}
+
+	it = j_list_iterator_new(operations);
+	object_backend = j_object_get_backend();
+
+	if (object_backend == NULL)
+	{
+		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+		replicas = j_distribution_get_replicas(object->distribution);
+		namespaces = j_distributed_object_get_replica_namespaces(object->namespace, replicas);
+
+		// There is one message per copy and server.
+		messages = g_new0(JMessage*, replicas * server_count);
+		br_lists = g_new0(JList*, replicas * server_count);
+		loads = g_new0(guint64, replicas * server_count);
+
+		if (replicas > 1 && j_configuration_get_hedge_percentile(j_configuration()) > 0)
+		{
+			hedges = g_new0(JMessage*, replicas * server_count);
+		}
+
+		{
+			guint32 data_blocks;
+			guint32 parity_blocks;
+			guint64 block_size;
+
+			erasure = j_distribution_get_erasure(object->distribution, &data_blocks, &parity_blocks, &block_size) && parity_blocks > 0;
+		}
+
+		// Erasure coded reads are only accounted for once it is known whether they have to be reconstructed.
+		if (erasure)
+		{
+			operation_bytes = g_new0(guint64, j_list_length(operations));
+			failed = g_new0(gboolean, server_count);
+		}
+	}
+	else
+	{
+		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+	}
+
+	/*
+	if (j_semantics_get(semantics, J_SEMANTICS_ATOMICITY) != J_SEMANTICS_ATOMICITY_NONE)
+	{
+		lock = j_lock_new("object", path);
+	}
+	*/
+
+	while (j_list_iterator_next(it))
+	{
+		JDistributedObjectOperation* operation = j_list_iterator_get(it);
+		gpointer data = operation->read.data;
+		guint64 length = operation->read.length;
+		guint64 offset = operation->read.offset;
+		guint64* bytes_read = operation->read.bytes_read;
+
+		j_trace_file_begin(object->name, J_TRACE_FILE_READ);
+
+		if (object_backend == NULL)
+		{
+			JDistributedObjectExtentData extent_data;
+
+			extent_data.object = object;
+			extent_data.semantics = semantics;
+			extent_data.messages = messages;
+			extent_data.lists = br_lists;
+			extent_data.server_count = server_count;
+			extent_data.replicas = replicas;
+			extent_data.namespaces = namespaces;
+			extent_data.hedges = hedges;
+			extent_data.loads = loads;
+			extent_data.replica_bytes = NULL;
+			extent_data.data = data;
+			extent_data.bytes = (erasure) ? &(operation_bytes[operation_index]) : bytes_read;
+			extent_data.flags = 0;
+
+			j_distributed_object_foreach_extent(object, length, offset, server_count, j_distributed_object_read_extent, &extent_data);
+		}
+		else
+		{
+			guint64 nbytes = 0;
+
+			ret = j_backend_object_read(object_backend, object_handle, data, length, offset, &nbytes) && ret;
+			j_helper_atomic_add(bytes_read, nbytes);
+		}
+
+		j_trace_file_end(object->name, J_TRACE_FILE_READ, length, offset);
+
+		operation_index++;
+	}
+
+	if (object_backend == NULL)
+	{
+		g_autofree gpointer* background_data = NULL;
+
+		background_data = g_new(gpointer, replicas * server_count);
+
+		for (guint i = 0; i < replicas * server_count; i++)
+		{
+			JDistributedObjectBackgroundData* data;
+
+			if (messages[i] == NULL)
+			{
+				background_data[i] = NULL;
+				continue;
+			}
+
+			data = g_slice_new(JDistributedObjectBackgroundData);
+			data->index = i % server_count;
+			data->message = messages[i];
+			data->operations = NULL;
+			data->semantics = semantics;
+			data->read.buffers = br_lists[i];
+			data->read.hedge = NULL;
+			data->read.hedge_index = 0;
+			data->read.load = loads[i];
+			data->ret = TRUE;
+
+			if (hedges != NULL)
+			{
+				guint32 replica;
+				guint32 primary;
+
+				// Find the server whose blocks are stored in this message's copy and look up the server storing the next copy.
+				replica = i / server_count;
+				primary = (data->index + server_count - replica) % server_count;
+
+				data->read.hedge = hedges[i];
+				data->read.hedge_index = j_distribution_get_replica_index(object->distribution, primary, (replica + 1) % replicas);
+			}
+
+			background_data[i] = data;
+		}
+
+		j_helper_execute_parallel(j_distributed_object_read_background_operation, background_data, replicas * server_count);
+
+		for (guint i = 0; i < replicas * server_count; i++)
+		{
+			JDistributedObjectBackgroundData* data;
+
+			if (background_data[i] == NULL)
+			{
+				continue;
+			}
+
+			data = background_data[i];
+
+			if (erasure && !data->ret)
+			{
+				failed[data->index] = TRUE;
+				degraded = TRUE;
+			}
+			else
+			{
+				ret = data->ret && ret;
+			}
+
+			g_slice_free(JDistributedObjectBackgroundData, data);
+		}
+
+		if (degraded)
+		{
+			g_autoptr(JList) objects = NULL;
+			g_autofree guint64* sizes = NULL;
+
+			// Reads that touch failed servers are reconstructed from the remaining data and parity blocks.
+			objects = j_list_new(NULL);
+			j_list_append(objects, object);
+			sizes = j_distributed_object_get_sizes(objects, semantics, NULL);
+
+			j_list_iterator_free(it);
+			it = j_list_iterator_new(operations);
+			operation_index = 0;
+
+			while (j_list_iterator_next(it))
+			{
+				JDistributedObjectOperation* operation = j_list_iterator_get(it);
+
+				ret = j_distributed_object_reconstruct(object, semantics, failed, operation->read.data, operation->read.length, operation->read.offset, sizes[0], &(operation_bytes[operation_index])) && ret;
+				operation_index++;
+			}
+		}
+
+		if (erasure)
+		{
+			j_list_iterator_free(it);
+			it = j_list_iterator_new(operations);
+			operation_index = 0;
+
+			while (j_list_iterator_next(it))
+			{
+				JDistributedObjectOperation* operation = j_list_iterator_get(it);
+
+				j_helper_atomic_add(operation->read.bytes_read, operation_bytes[operation_index]);
+				operation_index++;
+			}
+		}
+	}
+	else
+	{
+		ret = j_backend_object_close(object_backend, object_handle) && ret;
+	}
+
+	/*
+	if (lock != NULL)
+	{
+		/// \todo busy wait
+		while (!j_lock_acquire(lock));
+
+		j_lock_free(lock);
+	}
+	*/
+
+	return ret;
+}
+
+/**
+ * A group of an erasure coded object that is written to.
+ */
+struct JDistributedObjectGroup
+{
+	guint64 group;
+
+	/**
+	 * The group's new contents, NULL if they can be taken from #source.
+	 */
+	gchar* data;
+
+	/**
+	 * The data of the only write covering the group completely.
+	 */
+	gchar const* source;
+
+	/**
+	 * The number of writes to the group.
+	 */
+	guint writes;
+
+	/**
+	 * Whether a write covers the group completely.
+	 */
+	gboolean covered;
+};
 
-	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+typedef struct JDistributedObjectGroup JDistributedObjectGroup;
 
-	g_slice_free(JDistributedObjectBackgroundData, background_data);
+static void
+j_distributed_object_group_free(gpointer data)
+{
+	JDistributedObjectGroup* group = data;
 
-	return NULL;
+	g_free(group->data);
+	g_slice_free(JDistributedObjectGroup, group);
 }
 
 /**
- * Executes sync operations in a background operation.
+ * Adds the parity blocks of the groups touched by writes.
  *
  * \private
  *
- * \param data Background data.
+ * The parity is computed from the groups' new contents.
+ * Groups that are only written partially have to be read first, which is not atomic with regard to other clients writing to the same group.
+ * Short data blocks are treated as if they were padded with zeros.
  *
- * \return #data.
+ * \param object      An erasure coded object.
+ * \param writes      A list of write operations.
+ * \param semantics   A semantics object.
+ * \param extent_data A #JDistributedObjectExtentData for the writes' messages.
+ * \param buffers     An array that keeps the parity blocks alive until the messages have been sent.
+ *
+ * \return TRUE on success, FALSE if the groups could not be read.
  **/
-static gpointer
-j_distributed_object_sync_background_operation(gpointer data)
+static gboolean
+j_distributed_object_write_parity(JDistributedObject* object, JList* writes, JSemantics* semantics, JDistributedObjectExtentData* extent_data, GPtrArray* buffers)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	JDistributedObjectBackgroundData* background_data = data;
+	gboolean ret = TRUE;
 
-	JSemanticsPersistency persistency;
-	gpointer object_connection;
+	g_autoptr(GHashTable) groups = NULL;
+	g_autoptr(JErasure) erasure = NULL;
+	g_autoptr(JList) reads = NULL;
+	g_autoptr(JListIterator) it = NULL;
+	g_autofree JDistributedObjectOperation* read_operations = NULL;
+	g_autofree gconstpointer* data_pointers = NULL;
+	g_autofree gpointer* parity_pointers = NULL;
+	GHashTableIter iter;
+	gpointer value;
+	guint32 data_blocks;
+	guint32 parity_blocks;
+	guint64 block_size;
+	guint64 group_size;
+	guint64 read_bytes = 0;
+	guint read_count = 0;
+
+	if (!j_distribution_get_erasure(object->distribution, &data_blocks, &parity_blocks, &block_size) || parity_blocks == 0)
+	{
+		return TRUE;
+	}
 
-	persistency = j_semantics_get(background_data->semantics, J_SEMANTICS_PERSISTENCY);
-	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, background_data->index);
-	j_message_send(background_data->message, object_connection);
+	group_size = data_blocks * block_size;
+	groups = g_hash_table_new_full(g_int64_hash, g_int64_equal, NULL, j_distributed_object_group_free);
 
-	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	it = j_list_iterator_new(writes);
+
+	while (j_list_iterator_next(it))
 	{
-		g_autoptr(JMessage) reply = NULL;
+		JDistributedObjectOperation* operation = j_list_iterator_get(it);
+		guint64 length = operation->write.length;
+		guint64 offset = operation->write.offset;
 
-		reply = j_message_new_reply(background_data->message);
-		j_message_receive(reply, object_connection);
+		if (length == 0)
+		{
+			continue;
+		}
 
-		/// \todo do something with reply
-	}
+		for (guint64 g = offset / group_size; g <= (offset + length - 1) / group_size; g++)
+		{
+			JDistributedObjectGroup* group;
 
-	j_message_unref(background_data->message);
-	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, background_data->index, object_connection);
+			group = g_hash_table_lookup(groups, &g);
 
-	g_slice_free(JDistributedObjectBackgroundData, background_data);
+			if (group == NULL)
+			{
+				group = g_slice_new(JDistributedObjectGroup);
+				group->group = g;
+				group->data = NULL;
+				group->source = NULL;
+				group->writes = 0;
+				group->covered = FALSE;
+
+				g_hash_table_insert(groups, &(group->group), group);
+			}
 
-	return NULL;
-}
+			group->writes++;
 
-static gboolean
-j_distributed_object_create_exec(JList* operations, JSemantics* semantics)
-{
-	J_TRACE_FUNCTION(NULL);
+			if (offset <= g * group_size && offset + length >= (g + 1) * group_size)
+			{
+				group->covered = TRUE;
+				group->source = (gchar const*)operation->write.data + ((g * group_size) - offset);
+			}
+		}
+	}
 
-	/// \todo check return value for messages
-	gboolean ret = TRUE;
+	if (g_hash_table_size(groups) == 0)
+	{
+		return TRUE;
+	}
 
-	JBackend* object_backend;
-	g_autoptr(JListIterator) it = NULL;
-	g_autofree JMessage** messages = NULL;
-	gchar const* namespace = NULL;
-	gsize namespace_len = 0;
-	guint32 server_count = 0;
+	// Groups that are not overwritten completely need their current contents.
+	reads = j_list_new(NULL);
+	read_operations = g_new(JDistributedObjectOperation, g_hash_table_size(groups));
 
-	g_return_val_if_fail(operations != NULL, FALSE);
-	g_return_val_if_fail(semantics != NULL, FALSE);
+	g_hash_table_iter_init(&iter, groups);
 
+	while (g_hash_table_iter_next(&iter, NULL, &value))
 	{
-		JDistributedObject* object;
+		JDistributedObjectGroup* group = value;
 
-		object = j_list_get_first(operations);
-		g_assert(object != NULL);
+		if (group->writes == 1 && group->covered)
+		{
+			continue;
+		}
 
-		namespace = object->namespace;
-		namespace_len = strlen(namespace) + 1;
-	}
+		group->data = g_malloc0(group_size);
 
-	it = j_list_iterator_new(operations);
-	object_backend = j_object_get_backend();
+		if (!group->covered)
+		{
+			JDistributedObjectOperation* read_operation = &(read_operations[read_count++]);
 
-	if (object_backend == NULL)
-	{
-		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
-		messages = g_new(JMessage*, server_count);
+			read_operation->read.object = object;
+			read_operation->read.data = group->data;
+			read_operation->read.length = group_size;
+			read_operation->read.offset = group->group * group_size;
+			read_operation->read.bytes_read = &read_bytes;
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
-		{
-			/**
-			 * Force safe semantics to make the server send a reply.
-			 * Otherwise, nasty races can occur when using unsafe semantics:
-			 * - The client creates the object and sends its first write.
-			 * - The client sends another operation using another connection from the pool.
-			 * - The second operation is executed first and fails because the object does not exist.
-			 * This does not completely eliminate all races but fixes the common case of create, write, write, ...
-			 **/
-			messages[i] = j_message_new(J_MESSAGE_OBJECT_CREATE, namespace_len);
-			j_message_set_semantics(messages[i], semantics);
-			j_message_append_n(messages[i], namespace, namespace_len);
+			j_list_append(reads, read_operation);
 		}
 	}
 
+	if (read_count > 0)
+	{
+		ret = j_distributed_object_read_exec(reads, semantics);
+	}
+
+	// Apply the writes in order, later writes win.
+	j_list_iterator_free(it);
+	it = j_list_iterator_new(writes);
+
 	while (j_list_iterator_next(it))
 	{
-		JDistributedObject* object = j_list_iterator_get(it);
+		JDistributedObjectOperation* operation = j_list_iterator_get(it);
+		gchar const* data = operation->write.data;
+		guint64 length = operation->write.length;
+		guint64 offset = operation->write.offset;
 
-		if (object_backend == NULL)
+		if (length == 0)
 		{
-			gsize name_len;
+			continue;
+		}
 
-			name_len = strlen(object->name) + 1;
+		for (guint64 g = offset / group_size; g <= (offset + length - 1) / group_size; g++)
+		{
+			JDistributedObjectGroup* group;
+			guint64 start;
+			guint64 end;
 
-			/// \todo use actual distribution
-			for (guint i = 0; i < server_count; i++)
+			group = g_hash_table_lookup(groups, &g);
+
+			if (group->data == NULL)
 			{
-				j_message_add_operation(messages[i], name_len);
-				j_message_append_n(messages[i], object->name, name_len);
+				continue;
 			}
-		}
-		else
-		{
-			gpointer object_handle;
 
-			ret = j_backend_object_create(object_backend, object->namespace, object->name, &object_handle) && ret;
-			ret = j_backend_object_close(object_backend, object_handle) && ret;
+			start = MAX(offset, g * group_size);
+			end = MIN(offset + length, (g + 1) * group_size);
+
+			memcpy(group->data + (start - (g * group_size)), data + (start - offset), end - start);
 		}
 	}
 
-	if (object_backend == NULL)
+	erasure = j_erasure_new(data_blocks, parity_blocks);
+	data_pointers = g_new(gconstpointer, data_blocks);
+	parity_pointers = g_new(gpointer, parity_blocks);
+
+	g_hash_table_iter_init(&iter, groups);
+
+	while (g_hash_table_iter_next(&iter, NULL, &value))
 	{
-		g_autofree gpointer* background_data = NULL;
+		JDistributedObjectGroup* group = value;
+		gchar const* contents;
+		gchar* parity;
+		guint64* parity_bytes;
 
-		background_data = g_new(gpointer, server_count);
+		contents = (group->data != NULL) ? group->data : group->source;
+		parity = g_malloc(parity_blocks * block_size);
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
+		for (guint32 i = 0; i < data_blocks; i++)
 		{
-			JDistributedObjectBackgroundData* data;
-
-			data = g_slice_new(JDistributedObjectBackgroundData);
-			data->index = i;
-			data->message = messages[i];
-			data->operations = NULL;
-			data->semantics = semantics;
+			data_pointers[i] = contents + (i * block_size);
+		}
 
-			background_data[i] = data;
+		for (guint32 i = 0; i < parity_blocks; i++)
+		{
+			parity_pointers[i] = parity + (i * block_size);
 		}
 
-		j_helper_execute_parallel(j_distributed_object_create_background_operation, background_data, server_count);
+		j_erasure_encode(erasure, data_pointers, parity_pointers, block_size);
+
+		// The messages only reference the parity, so it has to outlive them.
+		parity_bytes = g_new0(guint64, 1);
+		g_ptr_array_add(buffers, parity);
+		g_ptr_array_add(buffers, parity_bytes);
+
+		extent_data->data = parity;
+		extent_data->bytes = parity_bytes;
+
+		for (guint32 i = 0; i < parity_blocks; i++)
+		{
+			JDistributionChunk chunk;
+
+			// Every server stores at most one block per group, so the parity is stored at the group's offset.
+			chunk.index = j_distribution_get_group_index(object->distribution, group->group, data_blocks + i);
+			chunk.length = block_size;
+			chunk.offset = group->group * block_size;
+			chunk.block_id = (group->group * data_blocks) + i;
+			chunk.range_offset = i * block_size;
+
+			j_distributed_object_write_extent(chunk.index, chunk.length, chunk.offset, &chunk, 1, extent_data);
+		}
 	}
 
 	return ret;
 }
 
 static gboolean
-j_distributed_object_delete_exec(JList* operations, JSemantics* semantics)
+j_distributed_object_write_exec(JList* operations, JSemantics* semantics)
 {
 	J_TRACE_FUNCTION(NULL);
 
+	/// \todo check return value for messages
 	gboolean ret = TRUE;
 
 	JBackend* object_backend;
+	g_autofree JList** bw_lists = NULL;
 	g_autoptr(JListIterator) it = NULL;
 	g_autofree JMessage** messages = NULL;
-	gchar const* namespace = NULL;
-	gsize namespace_len = 0;
+	g_autoptr(GPtrArray) parity_buffers = NULL;
+	g_auto(GStrv) namespaces = NULL;
+	JDistributedObject* object = NULL;
+	gpointer object_handle;
 	guint32 server_count = 0;
+	guint32 replicas = 1;
+	guint32 stripe_count = 0;
+	guint64 marker_bytes_written = 0;
+	guint64 replica_bytes_written = 0;
+	guint64 size = 0;
+
+	/// \todo
+	//JLock* lock = NULL;
 
 	g_return_val_if_fail(operations != NULL, FALSE);
 	g_return_val_if_fail(semantics != NULL, FALSE);
 
 	{
-		JDistributedObject* object;
+		JDistributedObjectOperation* operation = j_list_get_first(operations);
+		g_assert(operation != NULL);
 
-		object = j_list_get_first(operations);
+		object = operation->write.object;
 		g_assert(object != NULL);
-
-		namespace = object->namespace;
-		namespace_len = strlen(namespace) + 1;
 	}
 
 	it = j_list_iterator_new(operations);
@@ -690,105 +2993,180 @@ j_distributed_object_delete_exec(JList* operations, JSemantics* semantics)
 	if (object_backend == NULL)
 	{
 		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
-		messages = g_new(JMessage*, server_count);
+		replicas = j_distribution_get_replicas(object->distribution);
+		namespaces = j_distributed_object_get_replica_namespaces(object->namespace, replicas);
+		stripe_count = replicas * server_count;
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
-		{
-			messages[i] = j_message_new(J_MESSAGE_OBJECT_DELETE, namespace_len);
-			j_message_set_semantics(messages[i], semantics);
-			j_message_append_n(messages[i], namespace, namespace_len);
-		}
+		// There is one message per copy and server, the last message extends the size marker.
+		messages = g_new0(JMessage*, stripe_count + 1);
+		bw_lists = g_new0(JList*, stripe_count + 1);
+	}
+	else
+	{
+		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+	}
+
+	/*
+	if (j_semantics_get(semantics, J_SEMANTICS_ATOMICITY) != J_SEMANTICS_ATOMICITY_NONE)
+	{
+		lock = j_lock_new("object", path);
 	}
+	*/
 
 	while (j_list_iterator_next(it))
 	{
-		JDistributedObject* object = j_list_iterator_get(it);
+		JDistributedObjectOperation* operation = j_list_iterator_get(it);
+		gconstpointer data = operation->write.data;
+		guint64 length = operation->write.length;
+		guint64 offset = operation->write.offset;
+		guint64* bytes_written = operation->write.bytes_written;
+
+		j_trace_file_begin(object->name, J_TRACE_FILE_WRITE);
 
 		if (object_backend == NULL)
 		{
-			gsize name_len;
-
-			name_len = strlen(object->name) + 1;
+			JDistributedObjectExtentData extent_data;
 
-			/// \todo use actual distribution
-			for (guint i = 0; i < server_count; i++)
+			if (length > 0)
 			{
-				j_message_add_operation(messages[i], name_len);
-				j_message_append_n(messages[i], object->name, name_len);
+				size = MAX(size, offset + length);
 			}
+
+			extent_data.object = object;
+			extent_data.semantics = semantics;
+			extent_data.messages = messages;
+			extent_data.lists = bw_lists;
+			extent_data.server_count = server_count;
+			extent_data.replicas = replicas;
+			extent_data.namespaces = namespaces;
+			extent_data.hedges = NULL;
+			extent_data.loads = NULL;
+			extent_data.replica_bytes = &replica_bytes_written;
+			extent_data.data = (gchar*)(guintptr)data;
+			extent_data.bytes = bytes_written;
+			extent_data.flags = J_MESSAGE_OBJECT_COMPOUND_CREATE;
+
+			j_distributed_object_foreach_extent(object, length, offset, server_count, j_distributed_object_write_extent, &extent_data);
 		}
 		else
 		{
-			gboolean lret = FALSE;
-			gpointer object_handle;
-
-			if (j_backend_object_open(object_backend, object->namespace, object->name, &object_handle)
-			    && j_backend_object_delete(object_backend, object_handle))
-			{
-				lret = TRUE;
-			}
+			guint64 nbytes = 0;
 
-			ret = lret && ret;
+			ret = j_backend_object_write(object_backend, object_handle, data, length, offset, &nbytes) && ret;
+			j_helper_atomic_add(bytes_written, nbytes);
 		}
+
+		j_trace_file_end(object->name, J_TRACE_FILE_WRITE, length, offset);
 	}
 
 	if (object_backend == NULL)
 	{
 		g_autofree gpointer* background_data = NULL;
+		g_autofree gchar* marker_namespace = NULL;
+		JDistributedObjectExtentData extent_data;
+
+		extent_data.object = object;
+		extent_data.semantics = semantics;
+		extent_data.messages = messages;
+		extent_data.lists = bw_lists;
+		extent_data.server_count = server_count;
+		extent_data.replicas = replicas;
+		extent_data.namespaces = namespaces;
+		extent_data.hedges = NULL;
+		extent_data.loads = NULL;
+		extent_data.replica_bytes = &replica_bytes_written;
+		extent_data.data = NULL;
+		extent_data.bytes = NULL;
+		extent_data.flags = J_MESSAGE_OBJECT_COMPOUND_CREATE;
+
+		parity_buffers = g_ptr_array_new_with_free_func(g_free);
+		ret = j_distributed_object_write_parity(object, operations, semantics, &extent_data, parity_buffers) && ret;
+
+		if (size > 0)
+		{
+			marker_namespace = j_distributed_object_get_marker_namespace(object);
+			messages[stripe_count] = j_distributed_object_marker_message_new(object, marker_namespace, size, 0, semantics);
+			bw_lists[stripe_count] = j_list_new(NULL);
+			j_list_append(bw_lists[stripe_count], &marker_bytes_written);
+		}
 
-		background_data = g_new(gpointer, server_count);
+		background_data = g_new(gpointer, stripe_count + 1);
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
+		for (guint i = 0; i < stripe_count + 1; i++)
 		{
 			JDistributedObjectBackgroundData* data;
 
+			if (messages[i] == NULL)
+			{
+				background_data[i] = NULL;
+				continue;
+			}
+
 			data = g_slice_new(JDistributedObjectBackgroundData);
-			data->index = i;
+			data->index = (i < stripe_count) ? i % server_count : j_distributed_object_get_marker_index(object);
 			data->message = messages[i];
 			data->operations = NULL;
 			data->semantics = semantics;
+			data->write.bytes_written = bw_lists[i];
 			data->ret = TRUE;
 
 			background_data[i] = data;
 		}
 
-		j_helper_execute_parallel(j_distributed_object_delete_background_operation, background_data, server_count);
+		j_helper_execute_parallel(j_distributed_object_write_background_operation, background_data, stripe_count + 1);
 
-		for (guint i = 0; i < server_count; i++)
+		for (guint i = 0; i < stripe_count + 1; i++)
 		{
-			JDistributedObjectBackgroundData* data = background_data[i];
+			JDistributedObjectBackgroundData* data;
+
+			if (background_data[i] == NULL)
+			{
+				continue;
+			}
 
+			data = background_data[i];
 			ret = data->ret && ret;
 
 			g_slice_free(JDistributedObjectBackgroundData, data);
 		}
 	}
+	else
+	{
+		ret = j_backend_object_close(object_backend, object_handle) && ret;
+	}
+
+	/*
+	if (lock != NULL)
+	{
+		/// \todo busy wait
+		while (!j_lock_acquire(lock));
+
+		j_lock_free(lock);
+	}
+	*/
 
 	return ret;
 }
 
 static gboolean
-j_distributed_object_read_exec(JList* operations, JSemantics* semantics)
+j_distributed_object_append_exec(JList* operations, JSemantics* semantics)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	/// \todo check return value for messages
 	gboolean ret = TRUE;
 
 	JBackend* object_backend;
-	g_autofree JList** br_lists = NULL;
 	g_autoptr(JListIterator) it = NULL;
-	g_autofree JMessage** messages = NULL;
+	g_autoptr(JMessage) message = NULL;
+	g_autoptr(JMessage) reply = NULL;
+	g_autoptr(JList) write_list = NULL;
+	g_autofree JDistributedObjectOperation* write_operations = NULL;
+	g_autofree gchar* reservation_namespace = NULL;
 	JDistributedObject* object = NULL;
-	gpointer object_handle;
-	gsize name_len = 0;
-	gsize namespace_len = 0;
-	guint32 server_count = 0;
-
-	/// \todo
-	//JLock* lock = NULL;
+	gpointer object_connection;
+	gsize name_len;
+	gsize namespace_len;
+	guint32 index;
 
 	g_return_val_if_fail(operations != NULL, FALSE);
 	g_return_val_if_fail(semantics != NULL, FALSE);
@@ -797,170 +3175,209 @@ j_distributed_object_read_exec(JList* operations, JSemantics* semantics)
 		JDistributedObjectOperation* operation = j_list_get_first(operations);
 		g_assert(operation != NULL);
 
-		object = operation->read.object;
+		object = operation->append.object;
 		g_assert(object != NULL);
 	}
 
 	it = j_list_iterator_new(operations);
 	object_backend = j_object_get_backend();
 
-	if (object_backend == NULL)
+	if (object_backend != NULL)
 	{
-		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
-		messages = g_new(JMessage*, server_count);
-		br_lists = g_new(JList*, server_count);
+		GMutex* lock;
+		gpointer object_handle = NULL;
 
-		namespace_len = strlen(object->namespace) + 1;
-		name_len = strlen(object->name) + 1;
+		// The current size determines the offset, so appends to the same object have to be serialized.
+		lock = j_backend_object_get_append_lock(object->namespace, object->name);
+		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+
+		while (ret && j_list_iterator_next(it))
+		{
+			JDistributedObjectOperation* operation = j_list_iterator_get(it);
+			gint64 modification_time;
+			guint64 nbytes = 0;
+			guint64 offset = 0;
+
+			g_mutex_lock(lock);
+
+			if (j_backend_object_status(object_backend, object_handle, &modification_time, &offset))
+			{
+				ret = j_backend_object_write(object_backend, object_handle, operation->append.data, operation->append.length, offset, &nbytes) && ret;
+			}
+			else
+			{
+				ret = FALSE;
+			}
+
+			g_mutex_unlock(lock);
+
+			*(operation->append.reserved_offset) = offset;
+			j_helper_atomic_add(operation->append.bytes_written, nbytes);
+		}
 
-		for (guint i = 0; i < server_count; i++)
+		if (object_handle != NULL)
 		{
-			messages[i] = NULL;
-			br_lists[i] = NULL;
+			ret = j_backend_object_close(object_backend, object_handle) && ret;
 		}
+
+		return ret;
 	}
-	else
+
+	/**
+	 * Offsets are reserved by growing the size marker on the server storing the first block.
+	 * Afterwards, the data is written in parallel like any other write, so appending clients only contend for the reservation.
+	 **/
+	index = j_distributed_object_get_marker_index(object);
+	reservation_namespace = j_distributed_object_get_marker_namespace(object);
+	namespace_len = strlen(reservation_namespace) + 1;
+	name_len = strlen(object->name) + 1;
+
+	message = j_message_new(J_MESSAGE_OBJECT_RESERVE, namespace_len + name_len);
+	j_message_set_semantics(message, semantics);
+	j_message_append_n(message, reservation_namespace, namespace_len);
+	j_message_append_n(message, object->name, name_len);
+
+	while (j_list_iterator_next(it))
 	{
-		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+		JDistributedObjectOperation* operation = j_list_iterator_get(it);
+
+		j_message_add_operation(message, sizeof(guint64));
+		j_message_append_8(message, &(operation->append.length));
 	}
 
-	/*
-	if (j_semantics_get(semantics, J_SEMANTICS_ATOMICITY) != J_SEMANTICS_ATOMICITY_NONE)
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, index);
+	j_message_send(message, object_connection);
+
+	reply = j_message_new_reply(message);
+	j_message_receive(reply, object_connection);
+
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, index, object_connection);
+
+	if (j_message_get_count(reply) != j_list_length(operations))
 	{
-		lock = j_lock_new("object", path);
+		return FALSE;
 	}
-	*/
 
-	while (j_list_iterator_next(it))
+	j_list_iterator_free(it);
+	it = j_list_iterator_new(operations);
+
+	write_operations = g_new(JDistributedObjectOperation, j_list_length(operations));
+	write_list = j_list_new(NULL);
+
+	// Once their offsets have been reserved, appends are executed like any other write.
+	for (guint i = 0; j_list_iterator_next(it); i++)
 	{
 		JDistributedObjectOperation* operation = j_list_iterator_get(it);
-		gpointer data = operation->read.data;
-		guint64 length = operation->read.length;
-		guint64 offset = operation->read.offset;
-		guint64* bytes_read = operation->read.bytes_read;
+		JDistributedObjectOperation* write_operation = &(write_operations[i]);
 
-		j_trace_file_begin(object->name, J_TRACE_FILE_READ);
+		*(operation->append.reserved_offset) = j_message_get_8(reply);
 
-		if (object_backend == NULL)
-		{
-			gchar* new_data;
-			guint32 index;
-			guint64 block_id;
-			guint64 new_length;
-			guint64 new_offset;
+		write_operation->write.object = operation->append.object;
+		write_operation->write.data = operation->append.data;
+		write_operation->write.length = operation->append.length;
+		write_operation->write.offset = *(operation->append.reserved_offset);
+		write_operation->write.bytes_written = operation->append.bytes_written;
 
-			j_distribution_reset(object->distribution, length, offset);
-			new_data = data;
+		j_list_append(write_list, write_operation);
+	}
 
-			while (j_distribution_distribute(object->distribution, &index, &new_length, &new_offset, &block_id))
-			{
-				JDistributedObjectReadBuffer* buffer;
+	return j_distributed_object_write_exec(write_list, semantics);
+}
 
-				if (messages[index] == NULL && br_lists[index] == NULL)
-				{
-					messages[index] = j_message_new(J_MESSAGE_OBJECT_READ, namespace_len + name_len);
-					j_message_set_semantics(messages[index], semantics);
-					j_message_append_n(messages[index], object->namespace, namespace_len);
-					j_message_append_n(messages[index], object->name, name_len);
+static gboolean
+j_distributed_object_status_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
 
-					br_lists[index] = j_list_new(g_free);
-				}
+	/// \todo check return value for messages
+	gboolean ret = TRUE;
 
-				j_message_add_operation(messages[index], sizeof(guint64) + sizeof(guint64));
-				j_message_append_8(messages[index], &new_length);
-				j_message_append_8(messages[index], &new_offset);
+	JBackend* object_backend;
+	g_autoptr(JListIterator) it = NULL;
 
-				buffer = g_new(JDistributedObjectReadBuffer, 1);
-				buffer->data = new_data;
-				buffer->bytes_read = bytes_read;
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
 
-				j_list_append(br_lists[index], buffer);
+	it = j_list_iterator_new(operations);
+	object_backend = j_object_get_backend();
 
-				/*
-				if (lock != NULL)
-				{
-					j_lock_add(lock, block_id);
-				}
-				*/
+	while (j_list_iterator_next(it))
+	{
+		JDistributedObjectOperation* operation = j_list_iterator_get(it);
+		JDistributedObject* object = operation->status.object;
+		gint64* modification_time = operation->status.modification_time;
+		guint64* size = operation->status.size;
 
-				new_data += new_length;
-			}
-		}
-		else
+		if (modification_time != NULL)
 		{
-			guint64 nbytes = 0;
+			*modification_time = 0;
+		}
 
-			ret = j_backend_object_read(object_backend, object_handle, data, length, offset, &nbytes) && ret;
-			j_helper_atomic_add(bytes_read, nbytes);
+		if (size != NULL)
+		{
+			*size = 0;
 		}
 
-		j_trace_file_end(object->name, J_TRACE_FILE_READ, length, offset);
+		if (object_backend != NULL)
+		{
+			gpointer object_handle;
+
+			ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+			ret = j_backend_object_status(object_backend, object_handle, modification_time, size) && ret;
+			ret = j_backend_object_close(object_backend, object_handle) && ret;
+		}
 	}
 
 	if (object_backend == NULL)
 	{
-		g_autofree gpointer* background_data = NULL;
+		g_autoptr(JList) objects = NULL;
+		g_autofree gint64* modification_times = NULL;
+		g_autofree guint64* sizes = NULL;
+		guint i = 0;
 
-		background_data = g_new(gpointer, server_count);
-
-		for (guint i = 0; i < server_count; i++)
-		{
-			JDistributedObjectBackgroundData* data;
+		objects = j_list_new(NULL);
+		modification_times = g_new0(gint64, j_list_length(operations));
+		sizes = g_new0(guint64, j_list_length(operations));
 
-			if (messages[i] == NULL)
-			{
-				background_data[i] = NULL;
-				continue;
-			}
+		j_list_iterator_free(it);
+		it = j_list_iterator_new(operations);
 
-			data = g_slice_new(JDistributedObjectBackgroundData);
-			data->index = i;
-			data->message = messages[i];
-			data->operations = NULL;
-			data->semantics = semantics;
-			data->read.buffers = br_lists[i];
-			data->ret = TRUE;
+		while (j_list_iterator_next(it))
+		{
+			JDistributedObjectOperation* operation = j_list_iterator_get(it);
 
-			background_data[i] = data;
+			j_list_append(objects, operation->status.object);
 		}
 
-		j_helper_execute_parallel(j_distributed_object_read_background_operation, background_data, server_count);
+		// The size marker is modified by every write, so its status is the object's status.
+		j_distributed_object_get_status(objects, semantics, modification_times, sizes, NULL);
 
-		for (guint i = 0; i < server_count; i++)
+		j_list_iterator_free(it);
+		it = j_list_iterator_new(operations);
+
+		while (j_list_iterator_next(it))
 		{
-			JDistributedObjectBackgroundData* data;
+			JDistributedObjectOperation* operation = j_list_iterator_get(it);
 
-			if (background_data[i] == NULL)
+			if (operation->status.modification_time != NULL)
 			{
-				continue;
+				*(operation->status.modification_time) = modification_times[i];
 			}
 
-			data = background_data[i];
-			ret = data->ret && ret;
+			if (operation->status.size != NULL)
+			{
+				*(operation->status.size) = sizes[i];
+			}
 
-			g_slice_free(JDistributedObjectBackgroundData, data);
+			i++;
 		}
 	}
-	else
-	{
-		ret = j_backend_object_close(object_backend, object_handle) && ret;
-	}
-
-	/*
-	if (lock != NULL)
-	{
-		/// \todo busy wait
-		while (!j_lock_acquire(lock));
-
-		j_lock_free(lock);
-	}
-	*/
 
 	return ret;
 }
 
 static gboolean
-j_distributed_object_write_exec(JList* operations, JSemantics* semantics)
+j_distributed_object_sync_exec(JList* operations, JSemantics* semantics)
 {
 	J_TRACE_FUNCTION(NULL);
 
@@ -968,27 +3385,32 @@ j_distributed_object_write_exec(JList* operations, JSemantics* semantics)
 	gboolean ret = TRUE;
 
 	JBackend* object_backend;
-	g_autofree JList** bw_lists = NULL;
 	g_autoptr(JListIterator) it = NULL;
 	g_autofree JMessage** messages = NULL;
-	JDistributedObject* object = NULL;
-	gpointer object_handle;
-	gsize name_len = 0;
-	gsize namespace_len = 0;
+	g_autofree gboolean* servers = NULL;
+	g_autofree guint64* sizes = NULL;
+	g_autofree gboolean* legacy = NULL;
+	g_autofree gchar* marker_namespace = NULL;
+	g_auto(GStrv) namespaces = NULL;
+	gchar const* namespace = NULL;
+	gsize marker_namespace_len = 0;
 	guint32 server_count = 0;
-
-	/// \todo
-	//JLock* lock = NULL;
+	guint32 stripe_count = 0;
+	guint i = 0;
 
 	g_return_val_if_fail(operations != NULL, FALSE);
 	g_return_val_if_fail(semantics != NULL, FALSE);
 
 	{
 		JDistributedObjectOperation* operation = j_list_get_first(operations);
-		g_assert(operation != NULL);
+		JDistributedObject* object = operation->sync.object;
 
-		object = operation->write.object;
+		g_assert(operation != NULL);
 		g_assert(object != NULL);
+
+		namespace = object->namespace;
+		marker_namespace = j_distributed_object_get_marker_namespace(object);
+		marker_namespace_len = strlen(marker_namespace) + 1;
 	}
 
 	it = j_list_iterator_new(operations);
@@ -996,299 +3418,453 @@ j_distributed_object_write_exec(JList* operations, JSemantics* semantics)
 
 	if (object_backend == NULL)
 	{
+		g_autoptr(JList) objects = NULL;
+
 		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
-		messages = g_new(JMessage*, server_count);
-		bw_lists = g_new(JList*, server_count);
 
-		namespace_len = strlen(object->namespace) + 1;
-		name_len = strlen(object->name) + 1;
+		// The objects might use different numbers of copies, so there is room for the maximum number of copies.
+		namespaces = j_distributed_object_get_replica_namespaces(namespace, server_count);
+		stripe_count = server_count * server_count;
 
-		for (guint i = 0; i < server_count; i++)
+		// The first messages sync stripes, one per copy and server, the remaining ones sync size markers.
+		messages = g_new0(JMessage*, stripe_count + server_count);
+		servers = g_new(gboolean, server_count);
+
+		objects = j_list_new(NULL);
+
+		while (j_list_iterator_next(it))
 		{
-			messages[i] = NULL;
-			bw_lists[i] = NULL;
+			JDistributedObjectOperation* operation = j_list_iterator_get(it);
+
+			j_list_append(objects, operation->sync.object);
 		}
-	}
-	else
-	{
-		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
-	}
 
-	/*
-	if (j_semantics_get(semantics, J_SEMANTICS_ATOMICITY) != J_SEMANTICS_ATOMICITY_NONE)
-	{
-		lock = j_lock_new("object", path);
+		j_list_iterator_free(it);
+		it = j_list_iterator_new(operations);
+
+		// The sizes determine which servers store stripes.
+		legacy = g_new(gboolean, j_list_length(objects));
+		sizes = j_distributed_object_get_sizes(objects, semantics, legacy);
 	}
-	*/
 
 	while (j_list_iterator_next(it))
 	{
 		JDistributedObjectOperation* operation = j_list_iterator_get(it);
-		gconstpointer data = operation->write.data;
-		guint64 length = operation->write.length;
-		guint64 offset = operation->write.offset;
-		guint64* bytes_written = operation->write.bytes_written;
-
-		j_trace_file_begin(object->name, J_TRACE_FILE_WRITE);
+		JDistributedObject* object = operation->sync.object;
 
 		if (object_backend == NULL)
 		{
-			gchar const* new_data;
+			gsize name_len;
 			guint32 index;
-			guint64 block_id;
-			guint64 new_length;
-			guint64 new_offset;
+			guint32 replicas;
 
-			j_distribution_reset(object->distribution, length, offset);
-			new_data = data;
+			name_len = strlen(object->name) + 1;
+			replicas = j_distribution_get_replicas(object->distribution);
+
+			memset(servers, 0, server_count * sizeof(gboolean));
+			j_distributed_object_get_servers(object, sizes[i], legacy[i], servers, server_count);
 
-			while (j_distribution_distribute(object->distribution, &index, &new_length, &new_offset, &block_id))
+			for (guint j = 0; j < server_count; j++)
 			{
-				if (messages[index] == NULL && bw_lists[index] == NULL)
+				if (!servers[j])
 				{
-					messages[index] = j_message_new(J_MESSAGE_OBJECT_WRITE, namespace_len + name_len);
-					j_message_set_semantics(messages[index], semantics);
-					j_message_append_n(messages[index], object->namespace, namespace_len);
-					j_message_append_n(messages[index], object->name, name_len);
-
-					bw_lists[index] = j_list_new(NULL);
+					continue;
 				}
 
-				j_message_add_operation(messages[index], sizeof(guint64) + sizeof(guint64));
-				j_message_append_8(messages[index], &new_length);
-				j_message_append_8(messages[index], &new_offset);
-				j_message_add_send(messages[index], new_data, new_length);
+				for (guint32 r = 0; r < replicas; r++)
+				{
+					guint32 slot;
+
+					slot = (r * server_count) + j_distribution_get_replica_index(object->distribution, j, r);
 
-				j_list_append(bw_lists[index], bytes_written);
+					if (messages[slot] == NULL)
+					{
+						messages[slot] = j_message_new(J_MESSAGE_OBJECT_SYNC, strlen(namespaces[r]) + 1);
+						j_message_set_semantics(messages[slot], semantics);
+						j_message_append_n(messages[slot], namespaces[r], strlen(namespaces[r]) + 1);
+					}
 
-				/*
-				if (lock != NULL)
-				{
-					j_lock_add(lock, block_id);
+					j_message_add_operation(messages[slot], name_len);
+					j_message_append_n(messages[slot], object->name, name_len);
 				}
-				*/
+			}
 
-				new_data += new_length;
+			// Objects without a size marker only consist of stripes.
+			if (legacy[i])
+			{
+				i++;
+				continue;
+			}
 
-				// Fake bytes_written here instead of doing another loop further down
-				if (j_semantics_get(semantics, J_SEMANTICS_PERSISTENCY) == J_SEMANTICS_PERSISTENCY_NONE)
-				{
-					j_helper_atomic_add(bytes_written, new_length);
-				}
+			index = stripe_count + j_distributed_object_get_marker_index(object);
+
+			if (messages[index] == NULL)
+			{
+				messages[index] = j_message_new(J_MESSAGE_OBJECT_SYNC, marker_namespace_len);
+				j_message_set_semantics(messages[index], semantics);
+				j_message_append_n(messages[index], marker_namespace, marker_namespace_len);
 			}
+
+			j_message_add_operation(messages[index], name_len);
+			j_message_append_n(messages[index], object->name, name_len);
+
+			i++;
 		}
 		else
 		{
-			guint64 nbytes = 0;
+			gpointer object_handle;
 
-			ret = j_backend_object_write(object_backend, object_handle, data, length, offset, &nbytes) && ret;
-			j_helper_atomic_add(bytes_written, nbytes);
+			ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+			ret = j_backend_object_sync(object_backend, object_handle) && ret;
+			ret = j_backend_object_close(object_backend, object_handle) && ret;
 		}
-
-		j_trace_file_end(object->name, J_TRACE_FILE_WRITE, length, offset);
 	}
 
 	if (object_backend == NULL)
 	{
 		g_autofree gpointer* background_data = NULL;
 
-		background_data = g_new(gpointer, server_count);
+		background_data = g_new(gpointer, stripe_count + server_count);
 
-		for (guint i = 0; i < server_count; i++)
+		for (guint j = 0; j < stripe_count + server_count; j++)
 		{
 			JDistributedObjectBackgroundData* data;
 
-			if (messages[i] == NULL)
+			if (messages[j] == NULL)
 			{
-				background_data[i] = NULL;
+				background_data[j] = NULL;
 				continue;
 			}
 
 			data = g_slice_new(JDistributedObjectBackgroundData);
-			data->index = i;
-			data->message = messages[i];
-			data->operations = NULL;
+			data->index = j % server_count;
+			data->message = messages[j];
+			data->operations = operations;
 			data->semantics = semantics;
-			data->write.bytes_written = bw_lists[i];
-			data->ret = TRUE;
-
-			background_data[i] = data;
-		}
-
-		j_helper_execute_parallel(j_distributed_object_write_background_operation, background_data, server_count);
-
-		for (guint i = 0; i < server_count; i++)
-		{
-			JDistributedObjectBackgroundData* data;
-
-			if (background_data[i] == NULL)
-			{
-				continue;
-			}
 
-			data = background_data[i];
-			ret = data->ret && ret;
-
-			g_slice_free(JDistributedObjectBackgroundData, data);
+			background_data[j] = data;
 		}
-	}
-	else
-	{
-		ret = j_backend_object_close(object_backend, object_handle) && ret;
-	}
-
-	/*
-	if (lock != NULL)
-	{
-		/// \todo busy wait
-		while (!j_lock_acquire(lock));
 
-		j_lock_free(lock);
+		j_helper_execute_parallel(j_distributed_object_sync_background_operation, background_data, stripe_count + server_count);
 	}
-	*/
 
 	return ret;
 }
 
+/**
+ * Executes a sequence of create, write and sync operations on the same object.
+ *
+ * \private
+ *
+ * \param operations A list of #JOperation elements.
+ * \param semantics  A semantics object.
+ *
+ * \return TRUE on success, FALSE if an error occurred.
+ **/
 static gboolean
-j_distributed_object_status_exec(JList* operations, JSemantics* semantics)
+j_distributed_object_compound_exec(JList* operations, JSemantics* semantics)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	/// \todo check return value for messages
 	gboolean ret = TRUE;
 
 	JBackend* object_backend;
+	g_autofree JList** bw_lists = NULL;
 	g_autoptr(JListIterator) it = NULL;
+	g_autoptr(JList) sync_list = NULL;
+	g_autoptr(JList) write_list = NULL;
+	g_autoptr(GPtrArray) parity_buffers = NULL;
 	g_autofree JMessage** messages = NULL;
-	gchar const* namespace = NULL;
-	gsize namespace_len = 0;
-	guint32 server_count = 0;
+	g_autofree gpointer* background_data = NULL;
+	g_autofree gchar* marker_namespace = NULL;
+	g_auto(GStrv) namespaces = NULL;
+	JDistributedObject* object;
+	gboolean create = FALSE;
+	guint32 flags = J_MESSAGE_OBJECT_COMPOUND_CREATE;
+	guint32 server_count;
+	guint32 replicas;
+	guint32 stripe_count;
+	guint64 marker_bytes_written = 0;
+	guint64 replica_bytes_written = 0;
+	guint64 size = 0;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	object_backend = j_object_get_backend();
+
+	if (object_backend != NULL)
+	{
+		g_autoptr(JList) same_list = NULL;
+		JOperationExecFunc last_exec_func = NULL;
+
+		// The local backend does not suffer from reordering, execute the operations one type at a time.
+		same_list = j_list_new(NULL);
+		it = j_list_iterator_new(operations);
+
+		while (j_list_iterator_next(it))
+		{
+			JOperation* operation = j_list_iterator_get(it);
+
+			if (operation->exec_func != last_exec_func && last_exec_func != NULL)
+			{
+				ret = last_exec_func(same_list, semantics) && ret;
+				j_list_delete_all(same_list);
+			}
+
+			last_exec_func = operation->exec_func;
+			j_list_append(same_list, operation->data);
+		}
 
-	g_return_val_if_fail(operations != NULL, FALSE);
-	g_return_val_if_fail(semantics != NULL, FALSE);
+		if (last_exec_func != NULL)
+		{
+			ret = last_exec_func(same_list, semantics) && ret;
+		}
+
+		return ret;
+	}
 
 	{
-		JDistributedObjectOperation* operation = j_list_get_first(operations);
-		JDistributedObject* object = operation->status.object;
+		JOperation* operation = j_list_get_first(operations);
 
 		g_assert(operation != NULL);
-		g_assert(object != NULL);
 
-		namespace = object->namespace;
-		namespace_len = strlen(namespace) + 1;
+		object = (JDistributedObject*)operation->key;
+		g_assert(object != NULL);
 	}
 
+	sync_list = j_list_new(NULL);
+	write_list = j_list_new(NULL);
 	it = j_list_iterator_new(operations);
-	object_backend = j_object_get_backend();
 
-	if (object_backend == NULL)
+	while (j_list_iterator_next(it))
 	{
-		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
-		messages = g_new(JMessage*, server_count);
+		JOperation* operation = j_list_iterator_get(it);
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
+		if (operation->exec_func == j_distributed_object_create_exec)
+		{
+			create = TRUE;
+		}
+		else if (operation->exec_func == j_distributed_object_sync_exec)
+		{
+			j_list_append(sync_list, operation->data);
+		}
+		else if (operation->exec_func == j_distributed_object_write_exec)
 		{
-			messages[i] = j_message_new(J_MESSAGE_OBJECT_STATUS, namespace_len);
-			j_message_set_semantics(messages[i], semantics);
-			j_message_append_n(messages[i], namespace, namespace_len);
+			j_list_append(write_list, operation->data);
 		}
 	}
 
+	j_list_iterator_free(it);
+	it = NULL;
+
+	// A new object only consists of the stripes written here, so syncing them is sufficient.
+	if (create && j_list_length(sync_list) > 0)
+	{
+		flags |= J_MESSAGE_OBJECT_COMPOUND_SYNC;
+		j_list_delete_all(sync_list);
+	}
+
+	server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+	replicas = j_distribution_get_replicas(object->distribution);
+	namespaces = j_distributed_object_get_replica_namespaces(object->namespace, replicas);
+	stripe_count = replicas * server_count;
+
+	// There is one message per copy and server, the last message creates and extends the size marker.
+	messages = g_new0(JMessage*, stripe_count + 1);
+	bw_lists = g_new0(JList*, stripe_count + 1);
+
+	it = j_list_iterator_new(operations);
+
 	while (j_list_iterator_next(it))
 	{
-		JDistributedObjectOperation* operation = j_list_iterator_get(it);
-		JDistributedObject* object = operation->status.object;
-		gint64* modification_time = operation->status.modification_time;
-		guint64* size = operation->status.size;
+		JOperation* operation = j_list_iterator_get(it);
+		JDistributedObjectOperation* iop;
+		JDistributedObjectExtentData extent_data;
 
-		if (modification_time != NULL)
+		if (operation->exec_func != j_distributed_object_write_exec)
 		{
-			*modification_time = 0;
+			continue;
 		}
 
-		if (size != NULL)
+		iop = operation->data;
+
+		if (iop->write.length > 0)
 		{
-			*size = 0;
+			size = MAX(size, iop->write.offset + iop->write.length);
 		}
 
-		if (object_backend == NULL)
-		{
-			gsize name_len;
+		j_trace_file_begin(object->name, J_TRACE_FILE_WRITE);
 
-			name_len = strlen(object->name) + 1;
+		extent_data.object = object;
+		extent_data.semantics = semantics;
+		extent_data.messages = messages;
+		extent_data.lists = bw_lists;
+		extent_data.server_count = server_count;
+		extent_data.replicas = replicas;
+		extent_data.namespaces = namespaces;
+		extent_data.hedges = NULL;
+		extent_data.loads = NULL;
+		extent_data.replica_bytes = &replica_bytes_written;
+		extent_data.data = (gchar*)(guintptr)iop->write.data;
+		extent_data.bytes = iop->write.bytes_written;
+		extent_data.flags = flags;
+
+		j_distributed_object_foreach_extent(object, iop->write.length, iop->write.offset, server_count, j_distributed_object_write_extent, &extent_data);
+
+		j_trace_file_end(object->name, J_TRACE_FILE_WRITE, iop->write.length, iop->write.offset);
+	}
 
-			/// \todo use actual distribution
-			for (guint i = 0; i < server_count; i++)
-			{
-				j_message_add_operation(messages[i], name_len);
-				j_message_append_n(messages[i], object->name, name_len);
-			}
+	{
+		JDistributedObjectExtentData extent_data;
+
+		extent_data.object = object;
+		extent_data.semantics = semantics;
+		extent_data.messages = messages;
+		extent_data.lists = bw_lists;
+		extent_data.server_count = server_count;
+		extent_data.replicas = replicas;
+		extent_data.namespaces = namespaces;
+		extent_data.hedges = NULL;
+		extent_data.loads = NULL;
+		extent_data.replica_bytes = &replica_bytes_written;
+		extent_data.data = NULL;
+		extent_data.bytes = NULL;
+		extent_data.flags = flags;
+
+		parity_buffers = g_ptr_array_new_with_free_func(g_free);
+		ret = j_distributed_object_write_parity(object, write_list, semantics, &extent_data, parity_buffers) && ret;
+	}
+
+	if (create || size > 0)
+	{
+		marker_namespace = j_distributed_object_get_marker_namespace(object);
+		messages[stripe_count] = j_distributed_object_marker_message_new(object, marker_namespace, size, flags, semantics);
+		bw_lists[stripe_count] = j_list_new(NULL);
+
+		if (size > 0)
+		{
+			j_list_append(bw_lists[stripe_count], &marker_bytes_written);
 		}
-		else
+	}
+
+	background_data = g_new(gpointer, stripe_count + 1);
+
+	for (guint i = 0; i < stripe_count + 1; i++)
+	{
+		JDistributedObjectBackgroundData* data;
+
+		if (messages[i] == NULL)
 		{
-			gpointer object_handle;
+			background_data[i] = NULL;
+			continue;
+		}
 
-			ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
-			ret = j_backend_object_status(object_backend, object_handle, modification_time, size) && ret;
-			ret = j_backend_object_close(object_backend, object_handle) && ret;
+		data = g_slice_new(JDistributedObjectBackgroundData);
+		data->index = (i < stripe_count) ? i % server_count : j_distributed_object_get_marker_index(object);
+		data->message = messages[i];
+		data->operations = NULL;
+		data->semantics = semantics;
+		data->write.bytes_written = bw_lists[i];
+		data->ret = TRUE;
+
+		background_data[i] = data;
+	}
+
+	j_helper_execute_parallel(j_distributed_object_write_background_operation, background_data, stripe_count + 1);
+
+	for (guint i = 0; i < stripe_count + 1; i++)
+	{
+		JDistributedObjectBackgroundData* data;
+
+		if (background_data[i] == NULL)
+		{
+			continue;
 		}
+
+		data = background_data[i];
+		ret = data->ret && ret;
+
+		g_slice_free(JDistributedObjectBackgroundData, data);
 	}
 
-	if (object_backend == NULL)
+	// Existing objects might have stripes that have not been written here, sync them separately.
+	if (j_list_length(sync_list) > 0)
 	{
-		g_autofree gpointer* background_data = NULL;
+		ret = j_distributed_object_sync_exec(sync_list, semantics) && ret;
+	}
 
-		background_data = g_new(gpointer, server_count);
+	return ret;
+}
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
-		{
-			JDistributedObjectBackgroundData* data;
+/**
+ * Checks whether two objects share the same data layout.
+ *
+ * \private
+ *
+ * \param object      An object.
+ * \param destination Another object.
+ *
+ * \return TRUE if both objects are distributed in the same way, FALSE otherwise.
+ **/
+static gboolean
+j_distributed_object_same_layout(JDistributedObject* object, JDistributedObject* destination)
+{
+	J_TRACE_FUNCTION(NULL);
 
-			data = g_slice_new(JDistributedObjectBackgroundData);
-			data->index = i;
-			data->message = messages[i];
-			data->operations = operations;
-			data->semantics = semantics;
+	gboolean ret;
 
-			background_data[i] = data;
-		}
+	bson_t* b_object;
+	bson_t* b_destination;
 
-		j_helper_execute_parallel(j_distributed_object_status_background_operation, background_data, server_count);
+	if (object->distribution == destination->distribution)
+	{
+		return TRUE;
 	}
 
+	b_object = j_distribution_serialize(object->distribution);
+	b_destination = j_distribution_serialize(destination->distribution);
+
+	ret = bson_equal(b_object, b_destination);
+
+	bson_destroy(b_object);
+	bson_destroy(b_destination);
+
 	return ret;
 }
 
 static gboolean
-j_distributed_object_sync_exec(JList* operations, JSemantics* semantics)
+j_distributed_object_copy_exec(JList* operations, JSemantics* semantics)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	/// \todo check return value for messages
 	gboolean ret = TRUE;
 
 	JBackend* object_backend;
+	g_autofree JList** bc_lists = NULL;
 	g_autoptr(JListIterator) it = NULL;
+	g_autoptr(GPtrArray) marker_data = NULL;
 	g_autofree JMessage** messages = NULL;
-	gchar const* namespace = NULL;
-	gsize namespace_len = 0;
+	g_autofree gboolean* servers = NULL;
+	g_auto(GStrv) namespaces = NULL;
+	JDistributedObject* object = NULL;
+	gpointer object_handle = NULL;
 	guint32 server_count = 0;
+	guint32 replicas = 1;
+	guint32 stripe_count = 0;
+	guint64 marker_bytes_written = 0;
+	guint64 replica_bytes_copied = 0;
+	guint64 size = 0;
 
 	g_return_val_if_fail(operations != NULL, FALSE);
 	g_return_val_if_fail(semantics != NULL, FALSE);
 
 	{
 		JDistributedObjectOperation* operation = j_list_get_first(operations);
-		JDistributedObject* object = operation->sync.object;
-
 		g_assert(operation != NULL);
-		g_assert(object != NULL);
 
-		namespace = object->namespace;
-		namespace_len = strlen(namespace) + 1;
+		object = operation->copy.object;
+		g_assert(object != NULL);
 	}
 
 	it = j_list_iterator_new(operations);
@@ -1296,43 +3872,141 @@ j_distributed_object_sync_exec(JList* operations, JSemantics* semantics)
 
 	if (object_backend == NULL)
 	{
+		g_autoptr(JList) objects = NULL;
+		g_autofree guint64* sizes = NULL;
+		gboolean legacy = FALSE;
+
 		server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
-		messages = g_new(JMessage*, server_count);
+		replicas = j_distribution_get_replicas(object->distribution);
+		namespaces = j_distributed_object_get_replica_namespaces(object->namespace, replicas);
+		stripe_count = replicas * server_count;
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
-		{
-			messages[i] = j_message_new(J_MESSAGE_OBJECT_SYNC, namespace_len);
-			j_message_set_semantics(messages[i], semantics);
-			j_message_append_n(messages[i], namespace, namespace_len);
-		}
+		// There is one message per copy and server.
+		messages = g_new0(JMessage*, stripe_count);
+		bc_lists = g_new0(JList*, stripe_count);
+		servers = g_new0(gboolean, server_count);
+		marker_data = g_ptr_array_new();
+
+		objects = j_list_new(NULL);
+		j_list_append(objects, object);
+
+		// Only the servers storing parts of the source have anything to copy.
+		// Copying an object without a size marker creates one for the destination.
+		sizes = j_distributed_object_get_sizes(objects, semantics, &legacy);
+		size = sizes[0];
+
+		j_distributed_object_get_servers(object, size, legacy, servers, server_count);
+	}
+	else
+	{
+		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
 	}
 
 	while (j_list_iterator_next(it))
 	{
 		JDistributedObjectOperation* operation = j_list_iterator_get(it);
-		JDistributedObject* object = operation->sync.object;
+		JDistributedObject* destination = operation->copy.destination;
+		guint64* bytes_copied = operation->copy.bytes_copied;
+
+		// Each server copies its parts locally, which only results in a valid copy if the layouts match.
+		if (!j_distributed_object_same_layout(object, destination))
+		{
+			g_warning("Cannot copy %s/%s to %s/%s because their distributions differ.", object->namespace, object->name, destination->namespace, destination->name);
+			ret = FALSE;
+			continue;
+		}
 
 		if (object_backend == NULL)
 		{
-			gsize name_len;
+			JDistributedObjectBackgroundData* data;
+			g_autofree gchar* marker_namespace = NULL;
+			g_auto(GStrv) destination_namespaces = NULL;
+			gsize destination_name_len;
+			guint32 flags = J_MESSAGE_OBJECT_COPY_SPARSE;
 
-			name_len = strlen(object->name) + 1;
+			destination_namespaces = j_distributed_object_get_replica_namespaces(destination->namespace, replicas);
+			destination_name_len = strlen(destination->name) + 1;
 
-			/// \todo use actual distribution
 			for (guint i = 0; i < server_count; i++)
 			{
-				j_message_add_operation(messages[i], name_len);
-				j_message_append_n(messages[i], object->name, name_len);
+				if (!servers[i])
+				{
+					continue;
+				}
+
+				// Every copy is copied by the server storing it.
+				for (guint32 r = 0; r < replicas; r++)
+				{
+					gsize destination_namespace_len;
+					guint32 index;
+					guint32 slot;
+
+					index = j_distribution_get_replica_index(object->distribution, i, r);
+					slot = (r * server_count) + index;
+
+					if (messages[slot] == NULL)
+					{
+						gsize name_len;
+						gsize namespace_len;
+
+						namespace_len = strlen(namespaces[r]) + 1;
+						name_len = strlen(object->name) + 1;
+
+						messages[slot] = j_message_new(J_MESSAGE_OBJECT_COPY, namespace_len + name_len);
+						j_message_set_semantics(messages[slot], semantics);
+						j_message_append_n(messages[slot], namespaces[r], namespace_len);
+						j_message_append_n(messages[slot], object->name, name_len);
+
+						bc_lists[slot] = j_list_new(NULL);
+					}
+
+					destination_namespace_len = strlen(destination_namespaces[r]) + 1;
+
+					j_message_add_operation(messages[slot], sizeof(guint32) + sizeof(guint32) + destination_namespace_len + destination_name_len);
+					j_message_append_4(messages[slot], &index);
+					j_message_append_4(messages[slot], &flags);
+					j_message_append_n(messages[slot], destination_namespaces[r], destination_namespace_len);
+					j_message_append_n(messages[slot], destination->name, destination_name_len);
+
+					// Only the first copy counts towards the bytes copied.
+					j_list_append(bc_lists[slot], (r == 0) ? bytes_copied : &replica_bytes_copied);
+				}
+			}
+
+			// The destination's size marker has to reflect the copied size.
+			marker_namespace = j_distributed_object_get_marker_namespace(destination);
+
+			data = g_slice_new(JDistributedObjectBackgroundData);
+			data->index = j_distributed_object_get_marker_index(destination);
+			data->message = j_distributed_object_marker_message_new(destination, marker_namespace, size, 0, semantics);
+			data->operations = NULL;
+			data->semantics = semantics;
+			data->write.bytes_written = j_list_new(NULL);
+			data->ret = TRUE;
+
+			if (size > 0)
+			{
+				j_list_append(data->write.bytes_written, &marker_bytes_written);
 			}
+
+			g_ptr_array_add(marker_data, data);
 		}
-		else
+		else if (object_handle != NULL)
 		{
-			gpointer object_handle;
+			gpointer destination_handle;
+			guint64 nbytes = 0;
 
-			ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
-			ret = j_backend_object_sync(object_backend, object_handle) && ret;
-			ret = j_backend_object_close(object_backend, object_handle) && ret;
+			if (j_backend_object_create(object_backend, destination->namespace, destination->name, &destination_handle))
+			{
+				ret = j_backend_object_copy(object_backend, object_handle, destination_handle, &nbytes) && ret;
+				ret = j_backend_object_close(object_backend, destination_handle) && ret;
+			}
+			else
+			{
+				ret = FALSE;
+			}
+
+			j_helper_atomic_add(bytes_copied, nbytes);
 		}
 	}
 
@@ -1340,23 +4014,60 @@ j_distributed_object_sync_exec(JList* operations, JSemantics* semantics)
 	{
 		g_autofree gpointer* background_data = NULL;
 
-		background_data = g_new(gpointer, server_count);
+		background_data = g_new(gpointer, stripe_count);
 
-		/// \todo use actual distribution
-		for (guint i = 0; i < server_count; i++)
+		for (guint i = 0; i < stripe_count; i++)
 		{
 			JDistributedObjectBackgroundData* data;
 
+			if (messages[i] == NULL)
+			{
+				background_data[i] = NULL;
+				continue;
+			}
+
 			data = g_slice_new(JDistributedObjectBackgroundData);
-			data->index = i;
+			data->index = i % server_count;
 			data->message = messages[i];
-			data->operations = operations;
+			data->operations = NULL;
 			data->semantics = semantics;
+			data->copy.bytes_copied = bc_lists[i];
+			data->ret = TRUE;
 
 			background_data[i] = data;
 		}
 
-		j_helper_execute_parallel(j_distributed_object_sync_background_operation, background_data, server_count);
+		j_helper_execute_parallel(j_distributed_object_copy_background_operation, background_data, stripe_count);
+
+		for (guint i = 0; i < stripe_count; i++)
+		{
+			JDistributedObjectBackgroundData* data;
+
+			if (background_data[i] == NULL)
+			{
+				continue;
+			}
+
+			data = background_data[i];
+			ret = data->ret && ret;
+
+			g_slice_free(JDistributedObjectBackgroundData, data);
+		}
+
+		j_helper_execute_parallel(j_distributed_object_write_background_operation, marker_data->pdata, marker_data->len);
+
+		for (guint i = 0; i < marker_data->len; i++)
+		{
+			JDistributedObjectBackgroundData* data = g_ptr_array_index(marker_data, i);
+
+			ret = data->ret && ret;
+
+			g_slice_free(JDistributedObjectBackgroundData, data);
+		}
+	}
+	else if (object_handle != NULL)
+	{
+		ret = j_backend_object_close(object_backend, object_handle) && ret;
 	}
 
 	return ret;
@@ -1382,6 +4093,21 @@ j_distributed_object_new(gchar const* namespace, gchar const* name, JDistributio
 	return object;
 }
 
+JDistributedObject*
+j_distributed_object_new_for_hint(gchar const* namespace, gchar const* name, guint64 size, JDistributionAccess access)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autoptr(JDistribution) distribution = NULL;
+
+	g_return_val_if_fail(namespace != NULL, NULL);
+	g_return_val_if_fail(name != NULL, NULL);
+
+	distribution = j_distribution_new_for_hint(size, access);
+
+	return j_distributed_object_new(namespace, name, distribution);
+}
+
 JDistributedObject*
 j_distributed_object_ref(JDistributedObject* object)
 {
@@ -1427,6 +4153,9 @@ j_distributed_object_create(JDistributedObject* object, JBatch* batch)
 	operation->data = j_distributed_object_ref(object);
 	operation->exec_func = j_distributed_object_create_exec;
 	operation->free_func = j_distributed_object_create_free;
+	operation->compound_exec_func = j_distributed_object_compound_exec;
+	// Compound operations are executed in the order create, write and sync.
+	operation->compound_position = 0;
 
 	j_batch_add(batch, operation);
 }
@@ -1530,6 +4259,8 @@ j_distributed_object_write(JDistributedObject* object, gconstpointer data, guint
 		operation->data = iop;
 		operation->exec_func = j_distributed_object_write_exec;
 		operation->free_func = j_distributed_object_write_free;
+		operation->compound_exec_func = j_distributed_object_compound_exec;
+		operation->compound_position = 1;
 
 		j_batch_add(batch, operation);
 
@@ -1541,6 +4272,39 @@ j_distributed_object_write(JDistributedObject* object, gconstpointer data, guint
 	*bytes_written = 0;
 }
 
+void
+j_distributed_object_append(JDistributedObject* object, gconstpointer data, guint64 length, guint64* offset, guint64* bytes_written, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectOperation* iop;
+	JOperation* operation;
+
+	g_return_if_fail(object != NULL);
+	g_return_if_fail(data != NULL);
+	g_return_if_fail(length > 0);
+	g_return_if_fail(offset != NULL);
+	g_return_if_fail(bytes_written != NULL);
+
+	iop = g_slice_new(JDistributedObjectOperation);
+	iop->append.object = j_distributed_object_ref(object);
+	iop->append.data = data;
+	iop->append.length = length;
+	iop->append.bytes_written = bytes_written;
+	iop->append.reserved_offset = offset;
+
+	operation = j_operation_new();
+	operation->key = object;
+	operation->data = iop;
+	operation->exec_func = j_distributed_object_append_exec;
+	operation->free_func = j_distributed_object_append_free;
+
+	j_batch_add(batch, operation);
+
+	*offset = 0;
+	*bytes_written = 0;
+}
+
 void
 j_distributed_object_status(JDistributedObject* object, gint64* modification_time, guint64* size, JBatch* batch)
 {
@@ -1583,8 +4347,38 @@ j_distributed_object_sync(JDistributedObject* object, JBatch* batch)
 	operation->data = iop;
 	operation->exec_func = j_distributed_object_sync_exec;
 	operation->free_func = j_distributed_object_sync_free;
+	operation->compound_exec_func = j_distributed_object_compound_exec;
+	operation->compound_position = 2;
+
+	j_batch_add(batch, operation);
+}
+
+void
+j_distributed_object_copy(JDistributedObject* object, JDistributedObject* destination, guint64* bytes_copied, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JDistributedObjectOperation* iop;
+	JOperation* operation;
+
+	g_return_if_fail(object != NULL);
+	g_return_if_fail(destination != NULL);
+	g_return_if_fail(bytes_copied != NULL);
+
+	iop = g_slice_new(JDistributedObjectOperation);
+	iop->copy.object = j_distributed_object_ref(object);
+	iop->copy.destination = j_distributed_object_ref(destination);
+	iop->copy.bytes_copied = bytes_copied;
+
+	operation = j_operation_new();
+	operation->key = object;
+	operation->data = iop;
+	operation->exec_func = j_distributed_object_copy_exec;
+	operation->free_func = j_distributed_object_copy_free;
 
 	j_batch_add(batch, operation);
+
+	*bytes_copied = 0;
 }
 
 /**
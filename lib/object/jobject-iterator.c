@@ -36,6 +36,65 @@
  * @{
  **/
 
+/**
+ * An object of a page.
+ **/
+struct JObjectIteratorEntry
+{
+	gchar const* name;
+	gint64 modification_time;
+	guint64 size;
+};
+
+typedef struct JObjectIteratorEntry JObjectIteratorEntry;
+
+/**
+ * A page of objects received from a server.
+ **/
+struct JObjectIteratorPage
+{
+	JMessage* reply;
+
+	/**
+	 * The page's objects, whose names point into the reply.
+	 **/
+	GArray* entries;
+
+	/**
+	 * The cursor for the next page, 0 if the server has no more objects.
+	 **/
+	guint64 cursor;
+};
+
+typedef struct JObjectIteratorPage JObjectIteratorPage;
+
+/**
+ * The state of a server's cursor.
+ **/
+struct JObjectIteratorServer
+{
+	guint32 index;
+
+	gchar const* namespace;
+	gchar const* prefix;
+	gboolean status;
+
+	/**
+	 * The cursor for the next page, 0 if no page has been requested yet.
+	 **/
+	guint64 cursor;
+
+	/**
+	 * The request for the next page, NULL if there are no more pages.
+	 **/
+	JBackgroundOperation* prefetch;
+
+	JObjectIteratorPage* page;
+	guint position;
+};
+
+typedef struct JObjectIteratorServer JObjectIteratorServer;
+
 struct JObjectIterator
 {
 	JBackend* object_backend;
@@ -50,57 +109,138 @@ struct JObjectIterator
 	 **/
 	gchar const* name;
 
-	JMessage** replies;
-	guint32 replies_n;
-	guint32 replies_cur;
+	/**
+	 * Whether the replies contain the objects' status.
+	 **/
+	gboolean status;
+
+	/**
+	 * The current object's status.
+	 **/
+	gint64 modification_time;
+	guint64 size;
+
+	gchar* namespace;
+	gchar* prefix;
+
+	JObjectIteratorServer* servers;
+	guint32 servers_n;
+	guint32 servers_cur;
 };
 
-static JMessage*
-fetch_reply(guint32 index, gchar const* namespace, gchar const* prefix)
+static void
+j_object_iterator_page_free(JObjectIteratorPage* page)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	j_message_unref(page->reply);
+	g_array_unref(page->entries);
+
+	g_slice_free(JObjectIteratorPage, page);
+}
+
+/**
+ * Fetches a server's next page.
+ * The first page is requested using the namespace and prefix, later pages using the cursor.
+ *
+ * \param data A JObjectIteratorServer.
+ *
+ * \return The page.
+ **/
+static gpointer
+j_object_iterator_fetch(gpointer data)
 {
 	J_TRACE_FUNCTION(NULL);
 
+	JObjectIteratorServer* server = data;
+
 	g_autoptr(JMessage) message = NULL;
-	JMessage* reply;
-	JMessageType message_type;
+	JObjectIteratorPage* page;
 	gpointer object_connection;
-	gsize namespace_len;
-	gsize prefix_len;
 
-	namespace_len = strlen(namespace) + 1;
-
-	if (prefix == NULL)
+	if (server->cursor == 0)
 	{
-		message_type = J_MESSAGE_OBJECT_GET_ALL;
-		prefix_len = 0;
+		JMessageType message_type;
+		gchar const* prefix = server->prefix;
+		gsize namespace_len;
+		gsize prefix_len;
+
+		namespace_len = strlen(server->namespace) + 1;
+
+		if (server->status)
+		{
+			// Listing with status always sends a prefix, an empty one matches all objects.
+			message_type = J_MESSAGE_OBJECT_LIST;
+			prefix = (prefix != NULL) ? prefix : "";
+			prefix_len = strlen(prefix) + 1;
+		}
+		else if (prefix == NULL)
+		{
+			message_type = J_MESSAGE_OBJECT_GET_ALL;
+			prefix_len = 0;
+		}
+		else
+		{
+			message_type = J_MESSAGE_OBJECT_GET_BY_PREFIX;
+			prefix_len = strlen(prefix) + 1;
+		}
+
+		message = j_message_new(message_type, namespace_len + prefix_len);
+		j_message_append_n(message, server->namespace, namespace_len);
+
+		if (prefix != NULL)
+		{
+			j_message_append_n(message, prefix, prefix_len);
+		}
 	}
 	else
 	{
-		message_type = J_MESSAGE_OBJECT_GET_BY_PREFIX;
-		prefix_len = strlen(prefix) + 1;
+		gchar type = J_BACKEND_TYPE_OBJECT;
+
+		message = j_message_new(J_MESSAGE_CURSOR_NEXT, sizeof(server->cursor) + 1);
+		j_message_append_8(message, &(server->cursor));
+		j_message_append_1(message, &type);
 	}
 
-	message = j_message_new(message_type, namespace_len + prefix_len);
-	j_message_append_n(message, namespace, namespace_len);
+	page = g_slice_new(JObjectIteratorPage);
+	page->reply = j_message_new_reply(message);
+	page->entries = g_array_new(FALSE, FALSE, sizeof(JObjectIteratorEntry));
+
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, server->index);
+	j_message_send(message, object_connection);
+	j_message_receive(page->reply, object_connection);
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, server->index, object_connection);
 
-	if (prefix != NULL)
+	// The objects are parsed here, so that the cursor at the end of the page is known immediately.
+	while (TRUE)
 	{
-		j_message_append_n(message, prefix, prefix_len);
-	}
+		JObjectIteratorEntry entry;
 
-	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, index);
-	j_message_send(message, object_connection);
+		entry.name = j_message_get_string(page->reply);
+		entry.modification_time = 0;
+		entry.size = 0;
+
+		if (entry.name[0] == '\0')
+		{
+			break;
+		}
 
-	reply = j_message_new_reply(message);
-	j_message_receive(reply, object_connection);
+		if (server->status)
+		{
+			entry.modification_time = j_message_get_8(page->reply);
+			entry.size = j_message_get_8(page->reply);
+		}
 
-	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, index, object_connection);
+		g_array_append_val(page->entries, entry);
+	}
 
-	return reply;
+	page->cursor = j_message_get_8(page->reply);
+
+	return page;
 }
 
-JObjectIterator*
-j_object_iterator_new(gchar const* namespace, gchar const* prefix)
+static JObjectIterator*
+j_object_iterator_new_internal(gboolean for_index, guint32 index, gchar const* namespace, gchar const* prefix, gboolean status)
 {
 	J_TRACE_FUNCTION(NULL);
 
@@ -108,24 +248,40 @@ j_object_iterator_new(gchar const* namespace, gchar const* prefix)
 
 	JConfiguration* configuration = j_configuration();
 
-	g_return_val_if_fail(namespace != NULL, NULL);
-
-	//// \todo still necessary?
+	/// \todo still necessary?
 	//j_operation_cache_flush();
 
 	iterator = g_slice_new(JObjectIterator);
 	iterator->object_backend = j_object_get_backend();
 	iterator->cursor = NULL;
 	iterator->name = NULL;
-	iterator->replies_n = j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT);
-	iterator->replies = g_new0(JMessage*, iterator->replies_n);
-	iterator->replies_cur = 0;
+	iterator->status = status;
+	iterator->modification_time = 0;
+	iterator->size = 0;
+	iterator->namespace = g_strdup(namespace);
+	iterator->prefix = g_strdup(prefix);
+	iterator->servers_n = 0;
+	iterator->servers = NULL;
+	iterator->servers_cur = 0;
 
 	if (iterator->object_backend == NULL)
 	{
-		for (guint32 i = 0; i < iterator->replies_n; i++)
+		iterator->servers_n = (for_index) ? 1 : j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT);
+		iterator->servers = g_new0(JObjectIteratorServer, iterator->servers_n);
+
+		// The first pages of all servers are fetched in parallel.
+		for (guint32 i = 0; i < iterator->servers_n; i++)
 		{
-			iterator->replies[i] = fetch_reply(i, namespace, prefix);
+			JObjectIteratorServer* server = &(iterator->servers[i]);
+
+			server->index = (for_index) ? index : i;
+			server->namespace = iterator->namespace;
+			server->prefix = iterator->prefix;
+			server->status = status;
+			server->cursor = 0;
+			server->page = NULL;
+			server->position = 0;
+			server->prefetch = j_background_operation_new(j_object_iterator_fetch, server);
 		}
 	}
 	else
@@ -143,46 +299,46 @@ j_object_iterator_new(gchar const* namespace, gchar const* prefix)
 	return iterator;
 }
 
+JObjectIterator*
+j_object_iterator_new(gchar const* namespace, gchar const* prefix)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(namespace != NULL, NULL);
+
+	return j_object_iterator_new_internal(FALSE, 0, namespace, prefix, FALSE);
+}
+
 JObjectIterator*
 j_object_iterator_new_for_index(guint32 index, gchar const* namespace, gchar const* prefix)
 {
 	J_TRACE_FUNCTION(NULL);
 
-	JObjectIterator* iterator;
+	g_return_val_if_fail(namespace != NULL, NULL);
+	g_return_val_if_fail(index < j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT), NULL);
 
-	JConfiguration* configuration = j_configuration();
+	return j_object_iterator_new_internal(TRUE, index, namespace, prefix, FALSE);
+}
+
+JObjectIterator*
+j_object_iterator_new_with_status(gchar const* namespace, gchar const* prefix)
+{
+	J_TRACE_FUNCTION(NULL);
 
 	g_return_val_if_fail(namespace != NULL, NULL);
-	g_return_val_if_fail(index < j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT), NULL);
 
-	/// \todo still necessary?
-	//j_operation_cache_flush();
+	return j_object_iterator_new_internal(FALSE, 0, namespace, prefix, TRUE);
+}
 
-	iterator = g_slice_new(JObjectIterator);
-	iterator->object_backend = j_object_get_backend();
-	iterator->cursor = NULL;
-	iterator->name = NULL;
-	iterator->replies_n = 1;
-	iterator->replies = g_new0(JMessage*, 1);
-	iterator->replies_cur = 0;
+JObjectIterator*
+j_object_iterator_new_for_index_with_status(guint32 index, gchar const* namespace, gchar const* prefix)
+{
+	J_TRACE_FUNCTION(NULL);
 
-	if (iterator->object_backend == NULL)
-	{
-		iterator->replies[0] = fetch_reply(index, namespace, prefix);
-	}
-	else
-	{
-		if (prefix == NULL)
-		{
-			/// \todo j_backend_object_get_all(iterator->object_backend, namespace, &(iterator->cursor));
-		}
-		else
-		{
-			/// \todo j_backend_object_get_by_prefix(iterator->object_backend, namespace, prefix, &(iterator->cursor));
-		}
-	}
+	g_return_val_if_fail(namespace != NULL, NULL);
+	g_return_val_if_fail(index < j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT), NULL);
 
-	return iterator;
+	return j_object_iterator_new_internal(TRUE, index, namespace, prefix, TRUE);
 }
 
 void
@@ -192,15 +348,44 @@ j_object_iterator_free(JObjectIterator* iterator)
 
 	g_return_if_fail(iterator != NULL);
 
-	for (guint32 i = 0; i < iterator->replies_n; i++)
+	for (guint32 i = 0; i < iterator->servers_n; i++)
 	{
-		if (iterator->replies[i] != NULL)
+		JObjectIteratorServer* server = &(iterator->servers[i]);
+
+		if (server->prefetch != NULL)
+		{
+			JObjectIteratorPage* page;
+
+			page = j_background_operation_wait(server->prefetch);
+			j_background_operation_unref(server->prefetch);
+
+			server->cursor = page->cursor;
+			j_object_iterator_page_free(page);
+		}
+
+		// Release cursors that have not reached their end, so that the servers do not have to wait for them to expire.
+		if (server->cursor != 0)
+		{
+			g_autoptr(JMessage) message = NULL;
+			gpointer object_connection;
+
+			message = j_message_new(J_MESSAGE_CURSOR_CLOSE, sizeof(server->cursor));
+			j_message_append_8(message, &(server->cursor));
+
+			object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, server->index);
+			j_message_send(message, object_connection);
+			j_connection_pool_push(J_BACKEND_TYPE_OBJECT, server->index, object_connection);
+		}
+
+		if (server->page != NULL)
 		{
-			j_message_unref(iterator->replies[i]);
+			j_object_iterator_page_free(server->page);
 		}
 	}
 
-	g_free(iterator->replies);
+	g_free(iterator->servers);
+	g_free(iterator->namespace);
+	g_free(iterator->prefix);
 
 	g_slice_free(JObjectIterator, iterator);
 }
@@ -216,17 +401,46 @@ j_object_iterator_next(JObjectIterator* iterator)
 
 	if (iterator->object_backend == NULL)
 	{
-	retry:
-		iterator->name = j_message_get_string(iterator->replies[iterator->replies_cur]);
-
-		if (iterator->name[0] != '\0')
+		while (iterator->servers_cur < iterator->servers_n)
 		{
-			ret = TRUE;
-		}
-		else if (iterator->replies_cur < iterator->replies_n - 1)
-		{
-			iterator->replies_cur++;
-			goto retry;
+			JObjectIteratorServer* server = &(iterator->servers[iterator->servers_cur]);
+
+			if (server->page != NULL && server->position < server->page->entries->len)
+			{
+				JObjectIteratorEntry* entry = &g_array_index(server->page->entries, JObjectIteratorEntry, server->position);
+
+				iterator->name = entry->name;
+				iterator->modification_time = entry->modification_time;
+				iterator->size = entry->size;
+				server->position++;
+
+				ret = TRUE;
+				break;
+			}
+
+			if (server->page != NULL)
+			{
+				j_object_iterator_page_free(server->page);
+				server->page = NULL;
+			}
+
+			if (server->prefetch == NULL)
+			{
+				iterator->servers_cur++;
+				continue;
+			}
+
+			server->page = j_background_operation_wait(server->prefetch);
+			server->position = 0;
+			server->cursor = server->page->cursor;
+			j_background_operation_unref(server->prefetch);
+			server->prefetch = NULL;
+
+			// Request the next page while this one is being consumed.
+			if (server->cursor != 0)
+			{
+				server->prefetch = j_background_operation_new(j_object_iterator_fetch, server);
+			}
 		}
 	}
 	else
@@ -247,6 +461,31 @@ j_object_iterator_get(JObjectIterator* iterator)
 	return iterator->name;
 }
 
+gboolean
+j_object_iterator_get_status(JObjectIterator* iterator, gint64* modification_time, guint64* size)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_return_val_if_fail(iterator != NULL, FALSE);
+
+	if (!iterator->status)
+	{
+		return FALSE;
+	}
+
+	if (modification_time != NULL)
+	{
+		*modification_time = iterator->modification_time;
+	}
+
+	if (size != NULL)
+	{
+		*size = iterator->size;
+	}
+
+	return TRUE;
+}
+
 /**
  * @}
  **/
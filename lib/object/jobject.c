@@ -70,6 +70,28 @@ struct JObjectOperation
 			guint64 offset;
 			guint64* bytes_written;
 		} write;
+
+		struct
+		{
+			JObject* object;
+			JObject* destination;
+			guint64* bytes_copied;
+		} copy;
+
+		struct
+		{
+			JObject* object;
+			gconstpointer data;
+			guint64 length;
+			guint64* offset;
+			guint64* bytes_written;
+		} append;
+
+		struct
+		{
+			gchar* namespace;
+			gchar* prefix;
+		} delete_by_prefix;
 	};
 };
 
@@ -228,6 +250,44 @@ j_object_write_free(gpointer data)
 	g_slice_free(JObjectOperation, operation);
 }
 
+static void
+j_object_copy_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JObjectOperation* operation = data;
+
+	j_object_unref(operation->copy.object);
+	j_object_unref(operation->copy.destination);
+
+	g_slice_free(JObjectOperation, operation);
+}
+
+static void
+j_object_append_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JObjectOperation* operation = data;
+
+	j_object_unref(operation->append.object);
+
+	g_slice_free(JObjectOperation, operation);
+}
+
+static void
+j_object_delete_by_prefix_free(gpointer data)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JObjectOperation* operation = data;
+
+	g_free(operation->delete_by_prefix.namespace);
+	g_free(operation->delete_by_prefix.prefix);
+
+	g_slice_free(JObjectOperation, operation);
+}
+
 static gboolean
 j_object_create_exec(JList* operations, JSemantics* semantics)
 {
@@ -750,6 +810,141 @@ j_object_write_exec(JList* operations, JSemantics* semantics)
 	return ret;
 }
 
+static gboolean
+j_object_append_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	JBackend* object_backend;
+	JListIterator* it;
+	g_autoptr(JMessage) message = NULL;
+	JObject* object;
+	gpointer object_handle = NULL;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	{
+		JObjectOperation* operation = j_list_get_first(operations);
+
+		object = operation->append.object;
+
+		g_assert(operation != NULL);
+		g_assert(object != NULL);
+	}
+
+	it = j_list_iterator_new(operations);
+	object_backend = j_object_get_backend();
+
+	if (object_backend == NULL)
+	{
+		gsize name_len;
+		gsize namespace_len;
+
+		namespace_len = strlen(object->namespace) + 1;
+		name_len = strlen(object->name) + 1;
+
+		message = j_message_new(J_MESSAGE_OBJECT_APPEND, namespace_len + name_len);
+		j_message_set_semantics(message, semantics);
+		j_message_append_n(message, object->namespace, namespace_len);
+		j_message_append_n(message, object->name, name_len);
+	}
+	else
+	{
+		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+	}
+
+	while (j_list_iterator_next(it))
+	{
+		JObjectOperation* operation = j_list_iterator_get(it);
+		gconstpointer data = operation->append.data;
+		guint64 length = operation->append.length;
+
+		j_trace_file_begin(object->name, J_TRACE_FILE_WRITE);
+
+		if (object_backend == NULL)
+		{
+			j_message_add_operation(message, sizeof(guint64));
+			j_message_append_8(message, &length);
+			j_message_add_send(message, data, length);
+		}
+		else if (object_handle != NULL)
+		{
+			GMutex* lock;
+			gint64 modification_time;
+			guint64 nbytes = 0;
+			guint64 offset = 0;
+
+			// The current size determines the offset, so appends to the same object have to be serialized.
+			lock = j_backend_object_get_append_lock(object->namespace, object->name);
+			g_mutex_lock(lock);
+
+			if (j_backend_object_status(object_backend, object_handle, &modification_time, &offset))
+			{
+				ret = j_backend_object_write(object_backend, object_handle, data, length, offset, &nbytes) && ret;
+			}
+			else
+			{
+				ret = FALSE;
+			}
+
+			g_mutex_unlock(lock);
+
+			*(operation->append.offset) = offset;
+			j_helper_atomic_add(operation->append.bytes_written, nbytes);
+		}
+
+		j_trace_file_end(object->name, J_TRACE_FILE_WRITE, length, 0);
+	}
+
+	j_list_iterator_free(it);
+
+	if (object_backend == NULL)
+	{
+		g_autoptr(JMessage) reply = NULL;
+		gpointer object_connection;
+
+		object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, object->index);
+		j_message_send(message, object_connection);
+
+		reply = j_message_new_reply(message);
+		j_message_receive(reply, object_connection);
+
+		if (j_message_get_count(reply) == j_list_length(operations))
+		{
+			it = j_list_iterator_new(operations);
+
+			while (j_list_iterator_next(it))
+			{
+				JObjectOperation* operation = j_list_iterator_get(it);
+				guint64 nbytes;
+
+				*(operation->append.offset) = j_message_get_8(reply);
+				nbytes = j_message_get_8(reply);
+
+				ret = (nbytes == operation->append.length) && ret;
+				j_helper_atomic_add(operation->append.bytes_written, nbytes);
+			}
+
+			j_list_iterator_free(it);
+		}
+		else
+		{
+			ret = FALSE;
+		}
+
+		j_connection_pool_push(J_BACKEND_TYPE_OBJECT, object->index, object_connection);
+	}
+	else if (object_handle != NULL)
+	{
+		ret = j_backend_object_close(object_backend, object_handle) && ret;
+	}
+
+	return ret;
+}
+
 static gboolean
 j_object_status_exec(JList* operations, JSemantics* semantics)
 {
@@ -952,6 +1147,413 @@ j_object_sync_exec(JList* operations, JSemantics* semantics)
 	return ret;
 }
 
+/**
+ * Executes a sequence of create, write and sync operations on the same object.
+ *
+ * \private
+ *
+ * \param operations A list of #JOperation elements.
+ * \param semantics  A semantics object.
+ *
+ * \return TRUE on success, FALSE if an error occurred.
+ **/
+static gboolean
+j_object_compound_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	JBackend* object_backend;
+	JListIterator* it;
+	g_autoptr(JMessage) message = NULL;
+	g_autoptr(JList) bytes_written_list = NULL;
+	JObject* object;
+	JSemanticsPersistency persistency;
+	gpointer object_connection;
+	gsize name_len;
+	gsize namespace_len;
+	guint32 flags = 0;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	object_backend = j_object_get_backend();
+
+	if (object_backend != NULL)
+	{
+		g_autoptr(JList) same_list = NULL;
+		JOperationExecFunc last_exec_func = NULL;
+
+		// The local backend does not suffer from reordering, execute the operations one type at a time.
+		same_list = j_list_new(NULL);
+		it = j_list_iterator_new(operations);
+
+		while (j_list_iterator_next(it))
+		{
+			JOperation* operation = j_list_iterator_get(it);
+
+			if (operation->exec_func != last_exec_func && last_exec_func != NULL)
+			{
+				ret = last_exec_func(same_list, semantics) && ret;
+				j_list_delete_all(same_list);
+			}
+
+			last_exec_func = operation->exec_func;
+			j_list_append(same_list, operation->data);
+		}
+
+		j_list_iterator_free(it);
+
+		if (last_exec_func != NULL)
+		{
+			ret = last_exec_func(same_list, semantics) && ret;
+		}
+
+		return ret;
+	}
+
+	{
+		JOperation* operation = j_list_get_first(operations);
+
+		g_assert(operation != NULL);
+
+		object = (JObject*)operation->key;
+		g_assert(object != NULL);
+	}
+
+	it = j_list_iterator_new(operations);
+
+	while (j_list_iterator_next(it))
+	{
+		JOperation* operation = j_list_iterator_get(it);
+
+		if (operation->exec_func == j_object_create_exec)
+		{
+			flags |= J_MESSAGE_OBJECT_COMPOUND_CREATE;
+		}
+		else if (operation->exec_func == j_object_sync_exec)
+		{
+			flags |= J_MESSAGE_OBJECT_COMPOUND_SYNC;
+		}
+	}
+
+	j_list_iterator_free(it);
+
+	namespace_len = strlen(object->namespace) + 1;
+	name_len = strlen(object->name) + 1;
+
+	message = j_message_new(J_MESSAGE_OBJECT_COMPOUND, namespace_len + name_len + sizeof(guint32));
+	j_message_set_semantics(message, semantics);
+	j_message_append_n(message, object->namespace, namespace_len);
+	j_message_append_n(message, object->name, name_len);
+	j_message_append_4(message, &flags);
+
+	bytes_written_list = j_list_new(NULL);
+	persistency = j_semantics_get(semantics, J_SEMANTICS_PERSISTENCY);
+
+	it = j_list_iterator_new(operations);
+
+	while (j_list_iterator_next(it))
+	{
+		JOperation* operation = j_list_iterator_get(it);
+		JObjectOperation* iop;
+
+		if (operation->exec_func != j_object_write_exec)
+		{
+			continue;
+		}
+
+		iop = operation->data;
+
+		j_message_add_operation(message, sizeof(guint64) + sizeof(guint64));
+		j_message_append_8(message, &(iop->write.length));
+		j_message_append_8(message, &(iop->write.offset));
+		j_message_add_send(message, iop->write.data, iop->write.length);
+
+		j_list_append(bytes_written_list, iop->write.bytes_written);
+
+		// Fake bytes_written here instead of doing another loop further down
+		if (persistency == J_SEMANTICS_PERSISTENCY_NONE)
+		{
+			j_helper_atomic_add(iop->write.bytes_written, iop->write.length);
+		}
+	}
+
+	j_list_iterator_free(it);
+
+	object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, object->index);
+	j_message_send(message, object_connection);
+
+	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		g_autoptr(JMessage) reply = NULL;
+
+		reply = j_message_new_reply(message);
+		j_message_receive(reply, object_connection);
+
+		if (j_message_get_count(reply) == j_list_length(bytes_written_list))
+		{
+			it = j_list_iterator_new(bytes_written_list);
+
+			while (j_list_iterator_next(it))
+			{
+				guint64* bytes_written = j_list_iterator_get(it);
+				guint64 nbytes;
+
+				nbytes = j_message_get_8(reply);
+				j_helper_atomic_add(bytes_written, nbytes);
+			}
+
+			j_list_iterator_free(it);
+		}
+		else
+		{
+			ret = FALSE;
+		}
+	}
+
+	j_connection_pool_push(J_BACKEND_TYPE_OBJECT, object->index, object_connection);
+
+	return ret;
+}
+
+static gboolean
+j_object_copy_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	JBackend* object_backend;
+	JListIterator* it;
+	g_autoptr(JMessage) message = NULL;
+	JObject* object;
+	gpointer object_handle = NULL;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	{
+		JObjectOperation* operation = j_list_get_first(operations);
+
+		object = operation->copy.object;
+
+		g_assert(operation != NULL);
+		g_assert(object != NULL);
+	}
+
+	it = j_list_iterator_new(operations);
+	object_backend = j_object_get_backend();
+
+	if (object_backend == NULL)
+	{
+		gsize name_len;
+		gsize namespace_len;
+
+		namespace_len = strlen(object->namespace) + 1;
+		name_len = strlen(object->name) + 1;
+
+		message = j_message_new(J_MESSAGE_OBJECT_COPY, namespace_len + name_len);
+		j_message_set_semantics(message, semantics);
+		j_message_append_n(message, object->namespace, namespace_len);
+		j_message_append_n(message, object->name, name_len);
+	}
+	else
+	{
+		ret = j_backend_object_open(object_backend, object->namespace, object->name, &object_handle) && ret;
+	}
+
+	while (j_list_iterator_next(it))
+	{
+		JObjectOperation* operation = j_list_iterator_get(it);
+		JObject* destination = operation->copy.destination;
+		guint64* bytes_copied = operation->copy.bytes_copied;
+
+		if (object_backend == NULL)
+		{
+			gsize destination_name_len;
+			gsize destination_namespace_len;
+			guint32 flags = 0;
+
+			destination_namespace_len = strlen(destination->namespace) + 1;
+			destination_name_len = strlen(destination->name) + 1;
+
+			if (destination->index != object->index)
+			{
+				flags |= J_MESSAGE_OBJECT_COPY_REMOTE;
+			}
+
+			j_message_add_operation(message, sizeof(guint32) + sizeof(guint32) + destination_namespace_len + destination_name_len);
+			j_message_append_4(message, &(destination->index));
+			j_message_append_4(message, &flags);
+			j_message_append_n(message, destination->namespace, destination_namespace_len);
+			j_message_append_n(message, destination->name, destination_name_len);
+		}
+		else if (object_handle != NULL)
+		{
+			gpointer destination_handle;
+			guint64 nbytes = 0;
+
+			if (j_backend_object_create(object_backend, destination->namespace, destination->name, &destination_handle))
+			{
+				ret = j_backend_object_copy(object_backend, object_handle, destination_handle, &nbytes) && ret;
+				ret = j_backend_object_close(object_backend, destination_handle) && ret;
+			}
+			else
+			{
+				ret = FALSE;
+			}
+
+			j_helper_atomic_add(bytes_copied, nbytes);
+		}
+	}
+
+	j_list_iterator_free(it);
+
+	if (object_backend == NULL)
+	{
+		g_autoptr(JMessage) reply = NULL;
+		gpointer object_connection;
+
+		object_connection = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, object->index);
+		j_message_send(message, object_connection);
+
+		reply = j_message_new_reply(message);
+		ret = j_message_receive(reply, object_connection) && ret;
+
+		if (j_message_get_count(reply) != j_list_length(operations))
+		{
+			ret = FALSE;
+		}
+		else
+		{
+			it = j_list_iterator_new(operations);
+
+			while (j_list_iterator_next(it))
+			{
+				JObjectOperation* operation = j_list_iterator_get(it);
+				guint64* bytes_copied = operation->copy.bytes_copied;
+				guint32 status;
+				guint64 nbytes;
+
+				status = j_message_get_4(reply);
+				nbytes = j_message_get_8(reply);
+
+				ret = (status == 1) && ret;
+				j_helper_atomic_add(bytes_copied, nbytes);
+			}
+
+			j_list_iterator_free(it);
+		}
+
+		j_connection_pool_push(J_BACKEND_TYPE_OBJECT, object->index, object_connection);
+	}
+	else if (object_handle != NULL)
+	{
+		ret = j_backend_object_close(object_backend, object_handle) && ret;
+	}
+
+	return ret;
+}
+
+static gboolean
+j_object_delete_by_prefix_exec(JList* operations, JSemantics* semantics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gboolean ret = TRUE;
+
+	JBackend* object_backend;
+	g_autoptr(JListIterator) it = NULL;
+	g_autoptr(JMessage) message = NULL;
+
+	g_return_val_if_fail(operations != NULL, FALSE);
+	g_return_val_if_fail(semantics != NULL, FALSE);
+
+	it = j_list_iterator_new(operations);
+	object_backend = j_object_get_backend();
+
+	if (object_backend == NULL)
+	{
+		message = j_message_new(J_MESSAGE_OBJECT_DELETE_PREFIX, 0);
+		j_message_set_semantics(message, semantics);
+	}
+
+	while (j_list_iterator_next(it))
+	{
+		JObjectOperation* operation = j_list_iterator_get(it);
+		gchar const* namespace = operation->delete_by_prefix.namespace;
+		gchar const* prefix = operation->delete_by_prefix.prefix;
+
+		if (object_backend == NULL)
+		{
+			gsize namespace_len;
+			gsize prefix_len;
+
+			// An empty prefix deletes the whole namespace.
+			prefix = (prefix != NULL) ? prefix : "";
+
+			namespace_len = strlen(namespace) + 1;
+			prefix_len = strlen(prefix) + 1;
+
+			j_message_add_operation(message, namespace_len + prefix_len);
+			j_message_append_n(message, namespace, namespace_len);
+			j_message_append_n(message, prefix, prefix_len);
+		}
+		else
+		{
+			ret = j_backend_object_delete_by_prefix(object_backend, namespace, prefix) && ret;
+		}
+	}
+
+	if (object_backend == NULL)
+	{
+		JConfiguration* configuration = j_configuration();
+		JSemanticsPersistency persistency;
+		g_autofree gpointer* object_connections = NULL;
+		guint32 server_count;
+
+		persistency = j_semantics_get(semantics, J_SEMANTICS_PERSISTENCY);
+		server_count = j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT);
+		object_connections = g_new(gpointer, server_count);
+
+		// Objects can be stored on any server, so the deletion has to be broadcast.
+		// Send to all servers first so that they can delete concurrently.
+		for (guint32 i = 0; i < server_count; i++)
+		{
+			object_connections[i] = j_connection_pool_pop(J_BACKEND_TYPE_OBJECT, i);
+			j_message_send(message, object_connections[i]);
+		}
+
+		for (guint32 i = 0; i < server_count; i++)
+		{
+			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+			{
+				g_autoptr(JMessage) reply = NULL;
+				guint32 operation_count;
+
+				reply = j_message_new_reply(message);
+				j_message_receive(reply, object_connections[i]);
+
+				operation_count = j_message_get_count(reply);
+
+				for (guint j = 0; j < operation_count; j++)
+				{
+					guint32 status;
+
+					status = j_message_get_4(reply);
+					ret = (status == 1) && ret;
+				}
+			}
+
+			j_connection_pool_push(J_BACKEND_TYPE_OBJECT, i, object_connections[i]);
+		}
+	}
+
+	return ret;
+}
+
 JObject*
 j_object_new(gchar const* namespace, gchar const* name)
 {
@@ -964,7 +1566,7 @@ j_object_new(gchar const* namespace, gchar const* name)
 	g_return_val_if_fail(name != NULL, NULL);
 
 	object = g_slice_new(JObject);
-	object->index = j_helper_hash(name) % j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT);
+	object->index = j_configuration_get_server_index(configuration, J_BACKEND_TYPE_OBJECT, name);
 	object->namespace = g_strdup(namespace);
 	object->name = g_strdup(name);
 	object->ref_count = 1;
@@ -1036,6 +1638,9 @@ j_object_create(JObject* object, JBatch* batch)
 	operation->data = j_object_ref(object);
 	operation->exec_func = j_object_create_exec;
 	operation->free_func = j_object_create_free;
+	operation->compound_exec_func = j_object_compound_exec;
+	// Compound operations are executed in the order create, write and sync.
+	operation->compound_position = 0;
 
 	j_batch_add(batch, operation);
 }
@@ -1058,6 +1663,30 @@ j_object_delete(JObject* object, JBatch* batch)
 	j_batch_add(batch, operation);
 }
 
+void
+j_object_delete_by_prefix(gchar const* namespace, gchar const* prefix, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JObjectOperation* iop;
+	JOperation* operation;
+
+	g_return_if_fail(namespace != NULL);
+
+	iop = g_slice_new(JObjectOperation);
+	iop->delete_by_prefix.namespace = g_strdup(namespace);
+	iop->delete_by_prefix.prefix = g_strdup(prefix);
+
+	operation = j_operation_new();
+	// All prefix deletions are broadcast, so they can share one message.
+	operation->key = NULL;
+	operation->data = iop;
+	operation->exec_func = j_object_delete_by_prefix_exec;
+	operation->free_func = j_object_delete_by_prefix_free;
+
+	j_batch_add(batch, operation);
+}
+
 void
 j_object_read(JObject* object, gpointer data, guint64 length, guint64 offset, guint64* bytes_read, JBatch* batch)
 {
@@ -1139,6 +1768,8 @@ j_object_write(JObject* object, gconstpointer data, guint64 length, guint64 offs
 		operation->data = iop;
 		operation->exec_func = j_object_write_exec;
 		operation->free_func = j_object_write_free;
+		operation->compound_exec_func = j_object_compound_exec;
+		operation->compound_position = 1;
 
 		j_batch_add(batch, operation);
 
@@ -1150,6 +1781,41 @@ j_object_write(JObject* object, gconstpointer data, guint64 length, guint64 offs
 	*bytes_written = 0;
 }
 
+void
+j_object_append(JObject* object, gconstpointer data, guint64 length, guint64* offset, guint64* bytes_written, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JObjectOperation* iop;
+	JOperation* operation;
+
+	g_return_if_fail(object != NULL);
+	g_return_if_fail(data != NULL);
+	g_return_if_fail(length > 0);
+	// Appends cannot be chunked since the chunks would not be contiguous
+	g_return_if_fail(length <= j_configuration_get_max_operation_size(j_configuration()));
+	g_return_if_fail(offset != NULL);
+	g_return_if_fail(bytes_written != NULL);
+
+	iop = g_slice_new(JObjectOperation);
+	iop->append.object = j_object_ref(object);
+	iop->append.data = data;
+	iop->append.length = length;
+	iop->append.offset = offset;
+	iop->append.bytes_written = bytes_written;
+
+	operation = j_operation_new();
+	operation->key = object;
+	operation->data = iop;
+	operation->exec_func = j_object_append_exec;
+	operation->free_func = j_object_append_free;
+
+	j_batch_add(batch, operation);
+
+	*offset = 0;
+	*bytes_written = 0;
+}
+
 void
 j_object_status(JObject* object, gint64* modification_time, guint64* size, JBatch* batch)
 {
@@ -1192,8 +1858,38 @@ j_object_sync(JObject* object, JBatch* batch)
 	operation->data = iop;
 	operation->exec_func = j_object_sync_exec;
 	operation->free_func = j_object_sync_free;
+	operation->compound_exec_func = j_object_compound_exec;
+	operation->compound_position = 2;
+
+	j_batch_add(batch, operation);
+}
+
+void
+j_object_copy(JObject* object, JObject* destination, guint64* bytes_copied, JBatch* batch)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	JObjectOperation* iop;
+	JOperation* operation;
+
+	g_return_if_fail(object != NULL);
+	g_return_if_fail(destination != NULL);
+	g_return_if_fail(bytes_copied != NULL);
+
+	iop = g_slice_new(JObjectOperation);
+	iop->copy.object = j_object_ref(object);
+	iop->copy.destination = j_object_ref(destination);
+	iop->copy.bytes_copied = bytes_copied;
+
+	operation = j_operation_new();
+	operation->key = object;
+	operation->data = iop;
+	operation->exec_func = j_object_copy_exec;
+	operation->free_func = j_object_copy_free;
 
 	j_batch_add(batch, operation);
+
+	*bytes_copied = 0;
 }
 
 /**
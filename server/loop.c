@@ -28,6 +28,728 @@
 
 static guint jd_thread_num = 0;
 
+/**
+ * The maximum number of entries and bytes per page of a cursor.
+ * A page always contains at least one entry, even if it exceeds the size.
+ **/
+#define JD_CURSOR_PAGE_ENTRIES 1024
+#define JD_CURSOR_PAGE_SIZE (1024 * 1024)
+
+/**
+ * The time in microseconds after which idle cursors are released.
+ **/
+#define JD_CURSOR_TIMEOUT (300 * G_USEC_PER_SEC)
+
+/**
+ * A backend iterator whose entries are returned in pages.
+ **/
+struct JCursor
+{
+	guint64 id;
+
+	/**
+	 * The backend type, which determines the entries' format.
+	 **/
+	JBackendType type;
+
+	/**
+	 * Whether entries contain the objects' status.
+	 **/
+	gboolean status;
+
+	gchar* namespace;
+
+	/**
+	 * The backend iterator, NULL once its end has been reached.
+	 **/
+	gpointer iterator;
+
+	gint64 last_used;
+};
+
+typedef struct JCursor JCursor;
+
+/**
+ * Maps IDs to cursors that are not currently in use.
+ * Cursors are shared by all connections, because clients can request each page using a different connection.
+ **/
+static GHashTable* jd_cursors = NULL;
+static GMutex jd_cursors_mutex;
+static guint64 jd_cursors_next_id = 1;
+
+static JCursor*
+jd_cursor_new(JBackendType type, gchar const* namespace, gpointer iterator, gboolean status)
+{
+	JCursor* cursor;
+
+	cursor = g_slice_new(JCursor);
+	cursor->id = 0;
+	cursor->type = type;
+	cursor->status = status;
+	cursor->namespace = g_strdup(namespace);
+	cursor->iterator = iterator;
+	cursor->last_used = 0;
+
+	return cursor;
+}
+
+static void
+jd_cursor_free(JCursor* cursor)
+{
+	if (cursor->iterator != NULL)
+	{
+		if (cursor->type == J_BACKEND_TYPE_KV)
+		{
+			j_backend_kv_iterate_free(jd_kv_backend, cursor->iterator);
+		}
+		else
+		{
+			j_backend_object_iterate_free(jd_object_backend, cursor->iterator);
+		}
+	}
+
+	g_free(cursor->namespace);
+	g_slice_free(JCursor, cursor);
+}
+
+/**
+ * Removes a cursor, which gives the caller exclusive access to it.
+ *
+ * \param id The cursor's ID.
+ *
+ * \return The cursor, NULL if it does not exist or has expired.
+ **/
+static JCursor*
+jd_cursor_take(guint64 id)
+{
+	JCursor* cursor = NULL;
+
+	g_mutex_lock(&jd_cursors_mutex);
+
+	if (jd_cursors != NULL)
+	{
+		cursor = g_hash_table_lookup(jd_cursors, &id);
+
+		if (cursor != NULL)
+		{
+			g_hash_table_remove(jd_cursors, &id);
+		}
+	}
+
+	g_mutex_unlock(&jd_cursors_mutex);
+
+	return cursor;
+}
+
+/**
+ * Stores a cursor for later pages and releases idle cursors of clients that have vanished.
+ *
+ * \param cursor The cursor.
+ *
+ * \return The cursor's ID.
+ **/
+static guint64
+jd_cursor_put(JCursor* cursor)
+{
+	GHashTableIter iter;
+	gpointer value;
+	GSList* expired = NULL;
+	guint64 id;
+	gint64 now;
+
+	now = g_get_monotonic_time();
+
+	g_mutex_lock(&jd_cursors_mutex);
+
+	if (jd_cursors == NULL)
+	{
+		jd_cursors = g_hash_table_new(g_int64_hash, g_int64_equal);
+	}
+
+	g_hash_table_iter_init(&iter, jd_cursors);
+
+	while (g_hash_table_iter_next(&iter, NULL, &value))
+	{
+		JCursor* idle = value;
+
+		if (now - idle->last_used > JD_CURSOR_TIMEOUT)
+		{
+			g_hash_table_iter_remove(&iter);
+			expired = g_slist_prepend(expired, idle);
+		}
+	}
+
+	if (cursor->id == 0)
+	{
+		cursor->id = jd_cursors_next_id++;
+	}
+
+	cursor->last_used = now;
+	id = cursor->id;
+
+	g_hash_table_insert(jd_cursors, &(cursor->id), cursor);
+
+	g_mutex_unlock(&jd_cursors_mutex);
+
+	// Freeing iterators can take a while, so do it without holding the lock.
+	g_slist_free_full(expired, (GDestroyNotify)jd_cursor_free);
+
+	return id;
+}
+
+/**
+ * Appends a cursor's next page to a reply.
+ * The page is terminated like the unpaged replies and followed by the cursor's ID, which is 0 if the cursor has reached its end.
+ * Afterwards, the cursor is either stored for the next page or freed.
+ *
+ * \param cursor The cursor.
+ * \param reply  The reply.
+ **/
+static void
+jd_cursor_reply(JCursor* cursor, JMessage* reply)
+{
+	guint64 id = 0;
+	guint64 size = 0;
+	guint entries = 0;
+
+	while (cursor->iterator != NULL && entries < JD_CURSOR_PAGE_ENTRIES && size < JD_CURSOR_PAGE_SIZE)
+	{
+		gchar const* key;
+		gsize key_len;
+
+		if (cursor->type == J_BACKEND_TYPE_KV)
+		{
+			gconstpointer value;
+			guint32 len;
+
+			if (!j_backend_kv_iterate(jd_kv_backend, cursor->iterator, &key, &value, &len))
+			{
+				cursor->iterator = NULL;
+				break;
+			}
+
+			key_len = strlen(key) + 1;
+
+			j_message_add_operation(reply, 4 + len + key_len);
+			j_message_append_4(reply, &len);
+			j_message_append_n(reply, value, len);
+			j_message_append_string(reply, key);
+
+			size += 4 + len + key_len;
+		}
+		else if (cursor->status)
+		{
+			gint64 modification_time;
+			guint64 object_size;
+
+			if (!j_backend_object_iterate_status(jd_object_backend, cursor->namespace, cursor->iterator, &key, &modification_time, &object_size))
+			{
+				cursor->iterator = NULL;
+				break;
+			}
+
+			key_len = strlen(key) + 1;
+
+			j_message_add_operation(reply, key_len + sizeof(modification_time) + sizeof(object_size));
+			j_message_append_string(reply, key);
+			j_message_append_8(reply, &modification_time);
+			j_message_append_8(reply, &object_size);
+
+			size += key_len + sizeof(modification_time) + sizeof(object_size);
+		}
+		else
+		{
+			if (!j_backend_object_iterate(jd_object_backend, cursor->iterator, &key))
+			{
+				cursor->iterator = NULL;
+				break;
+			}
+
+			key_len = strlen(key) + 1;
+
+			j_message_add_operation(reply, key_len);
+			j_message_append_string(reply, key);
+
+			size += key_len;
+		}
+
+		entries++;
+	}
+
+	if (cursor->type == J_BACKEND_TYPE_KV)
+	{
+		guint32 zero = 0;
+
+		j_message_add_operation(reply, 4);
+		j_message_append_4(reply, &zero);
+	}
+	else
+	{
+		gchar const* empty = "";
+
+		j_message_add_operation(reply, 1);
+		j_message_append_string(reply, empty);
+	}
+
+	if (cursor->iterator != NULL)
+	{
+		id = jd_cursor_put(cursor);
+	}
+	else
+	{
+		jd_cursor_free(cursor);
+	}
+
+	j_message_add_operation(reply, sizeof(id));
+	j_message_append_8(reply, &id);
+}
+
+void
+jd_cursors_fini(void)
+{
+	if (jd_cursors != NULL)
+	{
+		GHashTableIter iter;
+		gpointer value;
+
+		g_hash_table_iter_init(&iter, jd_cursors);
+
+		while (g_hash_table_iter_next(&iter, NULL, &value))
+		{
+			g_hash_table_iter_steal(&iter);
+			jd_cursor_free(value);
+		}
+
+		g_hash_table_unref(jd_cursors);
+		jd_cursors = NULL;
+	}
+}
+
+/**
+ * Executes a batch of reads and adds their results to a reply.
+ *
+ * All reads are submitted at once, so that the backend can keep them in flight concurrently.
+ *
+ * \param object     The object, NULL if it could not be opened.
+ * \param requests   The read requests.
+ * \param count      The number of requests.
+ * \param reply      The reply.
+ * \param statistics Statistics.
+ **/
+static void
+jd_object_read_requests(gpointer object, JBackendObjectRequest* requests, guint count, JMessage* reply, JStatistics* statistics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	if (object != NULL && count > 0)
+	{
+		j_backend_object_submit(jd_object_backend, object, requests, count, FALSE);
+		j_backend_object_complete(jd_object_backend, object);
+	}
+
+	for (guint i = 0; i < count; i++)
+	{
+		guint64 bytes_read = requests[i].bytes;
+
+		j_statistics_add(statistics, J_STATISTICS_BYTES_READ, bytes_read);
+
+		j_message_add_operation(reply, sizeof(guint64));
+		j_message_append_8(reply, &bytes_read);
+
+		if (bytes_read > 0)
+		{
+			j_message_add_send(reply, requests[i].buffer, bytes_read);
+		}
+
+		j_statistics_add(statistics, J_STATISTICS_BYTES_SENT, bytes_read);
+	}
+}
+
+static void
+jd_object_unmap(gpointer mapping)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	j_backend_object_unmap(jd_object_backend, mapping);
+}
+
+/**
+ * Tries to reply to a read with data the backend provides directly, avoiding a copy into the memory chunk.
+ * The reply references the data until it has been sent.
+ *
+ * \param object     The object.
+ * \param length     The length.
+ * \param offset     The offset.
+ * \param requests   The reads gathered so far, which are executed first to keep the replies in order.
+ * \param count      The number of gathered reads, reset to 0 if they have been executed.
+ * \param reply      The reply.
+ * \param statistics Statistics.
+ *
+ * \return TRUE if the read has been replied to, FALSE if it has to be executed using the memory chunk.
+ **/
+static gboolean
+jd_object_read_mapped(gpointer object, guint64 length, guint64 offset, JBackendObjectRequest* requests, guint* count, JMessage* reply, JStatistics* statistics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	gconstpointer data;
+	gpointer mapping;
+	guint64 bytes_read;
+
+	if (!j_backend_object_map(jd_object_backend, object, length, offset, &data, &bytes_read, &mapping))
+	{
+		return FALSE;
+	}
+
+	jd_object_read_requests(object, requests, *count, reply, statistics);
+	*count = 0;
+
+	j_statistics_add(statistics, J_STATISTICS_BYTES_READ, bytes_read);
+
+	j_message_add_operation(reply, sizeof(guint64));
+	j_message_append_8(reply, &bytes_read);
+
+	if (bytes_read > 0)
+	{
+		j_message_add_send_full(reply, data, bytes_read, jd_object_unmap, mapping);
+	}
+	else
+	{
+		j_backend_object_unmap(jd_object_backend, mapping);
+	}
+
+	j_statistics_add(statistics, J_STATISTICS_BYTES_SENT, bytes_read);
+
+	return TRUE;
+}
+
+/**
+ * Executes a batch of writes and adds their results to a reply.
+ *
+ * All writes are submitted at once, the sync is only started once all of them have finished.
+ *
+ * \param object     The object.
+ * \param requests   The write requests.
+ * \param count      The number of requests.
+ * \param sync       Whether to sync the object afterwards.
+ * \param reply      The reply, NULL if none is sent.
+ * \param statistics Statistics.
+ **/
+static void
+jd_object_write_requests(gpointer object, JBackendObjectRequest* requests, guint count, gboolean sync, JMessage* reply, JStatistics* statistics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	if (count == 0 && !sync)
+	{
+		return;
+	}
+
+	j_backend_object_submit(jd_object_backend, object, requests, count, sync);
+	j_backend_object_complete(jd_object_backend, object);
+
+	for (guint i = 0; i < count; i++)
+	{
+		guint64 bytes_written = requests[i].bytes;
+
+		j_statistics_add(statistics, J_STATISTICS_BYTES_WRITTEN, bytes_written);
+
+		if (reply != NULL)
+		{
+			j_message_add_operation(reply, sizeof(guint64));
+			j_message_append_8(reply, &bytes_written);
+		}
+	}
+
+	if (sync)
+	{
+		j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
+	}
+}
+
+/**
+ * Receives the data of a message's write operations and writes it in batches.
+ *
+ * The data is gathered in the memory chunk until it is full, so that the backend can execute many writes concurrently.
+ *
+ * \param message           The message.
+ * \param connection        The connection to receive the data from.
+ * \param object            The object, NULL if it could not be opened.
+ * \param sync              Whether to sync the object afterwards.
+ * \param reply             The reply, NULL if none is sent.
+ * \param memory_chunk      A memory chunk used for buffering.
+ * \param memory_chunk_size The memory chunk's size.
+ * \param statistics        Statistics.
+ **/
+static void
+jd_object_write_operations(JMessage* message, GSocketConnection* connection, gpointer object, gboolean sync, JMessage* reply, JMemoryChunk* memory_chunk, guint64 memory_chunk_size, JStatistics* statistics)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autofree JBackendObjectRequest* requests = NULL;
+	GInputStream* input;
+	guint32 operation_count;
+	guint count = 0;
+
+	operation_count = j_message_get_count(message);
+	requests = g_new(JBackendObjectRequest, operation_count);
+	input = g_io_stream_get_input_stream(G_IO_STREAM(connection));
+
+	for (guint i = 0; i < operation_count; i++)
+	{
+		gchar* buf;
+		guint64 length;
+		guint64 offset;
+
+		length = j_message_get_8(message);
+		offset = j_message_get_8(message);
+
+		if (length > memory_chunk_size)
+		{
+			guint64 bytes_written = 0;
+			guint64 position = 0;
+
+			// Earlier writes have to be replied to first.
+			if (object != NULL)
+			{
+				jd_object_write_requests(object, requests, count, FALSE, reply, statistics);
+			}
+
+			count = 0;
+
+			j_memory_chunk_reset(memory_chunk);
+			buf = j_memory_chunk_get(memory_chunk, memory_chunk_size);
+			g_assert(buf != NULL);
+
+			// Writes larger than the memory chunk are received and written piecewise, the payload has to be consumed completely even if writing fails.
+			while (position < length)
+			{
+				guint64 chunk_length;
+
+				chunk_length = MIN(length - position, memory_chunk_size);
+				g_input_stream_read_all(input, buf, chunk_length, NULL, NULL, NULL);
+
+				if (object != NULL && bytes_written == position)
+				{
+					guint64 nbytes = 0;
+
+					j_backend_object_write(jd_object_backend, object, buf, chunk_length, offset + position, &nbytes);
+					bytes_written += nbytes;
+				}
+
+				position += chunk_length;
+			}
+
+			j_memory_chunk_reset(memory_chunk);
+			j_statistics_add(statistics, J_STATISTICS_BYTES_RECEIVED, length);
+
+			if (object != NULL)
+			{
+				j_statistics_add(statistics, J_STATISTICS_BYTES_WRITTEN, bytes_written);
+
+				if (reply != NULL)
+				{
+					j_message_add_operation(reply, sizeof(guint64));
+					j_message_append_8(reply, &bytes_written);
+				}
+			}
+
+			continue;
+		}
+
+		buf = j_memory_chunk_get(memory_chunk, length);
+
+		if (buf == NULL)
+		{
+			// The writes gathered so far fill the memory chunk, execute them before receiving more data.
+			if (object != NULL)
+			{
+				jd_object_write_requests(object, requests, count, FALSE, reply, statistics);
+			}
+
+			count = 0;
+
+			j_memory_chunk_reset(memory_chunk);
+			buf = j_memory_chunk_get(memory_chunk, length);
+			g_assert(buf != NULL);
+		}
+
+		g_input_stream_read_all(input, buf, length, NULL, NULL, NULL);
+		j_statistics_add(statistics, J_STATISTICS_BYTES_RECEIVED, length);
+
+		if (G_LIKELY(object != NULL))
+		{
+			requests[count].write = TRUE;
+			requests[count].buffer = buf;
+			requests[count].length = length;
+			requests[count].offset = offset;
+			requests[count].bytes = 0;
+			count++;
+		}
+	}
+
+	if (object != NULL)
+	{
+		jd_object_write_requests(object, requests, count, sync, reply, statistics);
+	}
+
+	j_memory_chunk_reset(memory_chunk);
+}
+
+/**
+ * Copies an object to another server by streaming its contents.
+ *
+ * \param object            The source object.
+ * \param index             The destination server's index.
+ * \param namespace         The destination namespace.
+ * \param path              The destination path.
+ * \param semantics         The semantics to use for the destination server.
+ * \param memory_chunk      A memory chunk used for buffering.
+ * \param memory_chunk_size The memory chunk's size.
+ * \param statistics        Statistics.
+ * \param bytes_copied      Returns the number of bytes copied.
+ *
+ * \return TRUE if the whole object was copied, FALSE otherwise.
+ **/
+static gboolean
+jd_object_copy_to_server(gpointer object, guint32 index, gchar const* namespace, gchar const* path, JSemantics* semantics, JMemoryChunk* memory_chunk, guint64 memory_chunk_size, JStatistics* statistics, guint64* bytes_copied)
+{
+	J_TRACE_FUNCTION(NULL);
+
+	g_autoptr(GSocketClient) client = NULL;
+	g_autoptr(GSocketConnection) connection = NULL;
+	g_autoptr(JMessage) delete_message = NULL;
+	g_autoptr(JMessage) message = NULL;
+	JSemanticsPersistency persistency;
+	GError* error = NULL;
+	gint64 modification_time = 0;
+	guint64 size = 0;
+	guint64 offset = 0;
+	gsize namespace_len;
+	gsize path_len;
+
+	*bytes_copied = 0;
+
+	if (!j_backend_object_status(jd_object_backend, object, &modification_time, &size))
+	{
+		return FALSE;
+	}
+
+	client = g_socket_client_new();
+	connection = g_socket_client_connect_to_host(client, j_configuration_get_server(jd_configuration, J_BACKEND_TYPE_OBJECT, index), j_configuration_get_port(jd_configuration), NULL, &error);
+
+	if (connection == NULL)
+	{
+		if (error != NULL)
+		{
+			g_warning("%s", error->message);
+			g_error_free(error);
+		}
+
+		return FALSE;
+	}
+
+	j_helper_set_nodelay(connection, TRUE);
+
+	persistency = j_semantics_get(semantics, J_SEMANTICS_PERSISTENCY);
+	namespace_len = strlen(namespace) + 1;
+	path_len = strlen(path) + 1;
+
+	// Creating an object does not truncate it, so an existing destination is deleted first; it is fine if it does not exist.
+	delete_message = j_message_new(J_MESSAGE_OBJECT_DELETE, namespace_len);
+	j_message_set_semantics(delete_message, semantics);
+	j_message_append_n(delete_message, namespace, namespace_len);
+	j_message_add_operation(delete_message, path_len);
+	j_message_append_n(delete_message, path, path_len);
+	j_message_send(delete_message, connection);
+
+	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		g_autoptr(JMessage) reply = NULL;
+
+		reply = j_message_new_reply(delete_message);
+		j_message_receive(reply, connection);
+	}
+
+	message = j_message_new(J_MESSAGE_OBJECT_CREATE, namespace_len);
+	j_message_set_semantics(message, semantics);
+	j_message_append_n(message, namespace, namespace_len);
+	j_message_add_operation(message, path_len);
+	j_message_append_n(message, path, path_len);
+	j_message_send(message, connection);
+
+	if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+	{
+		g_autoptr(JMessage) reply = NULL;
+
+		reply = j_message_new_reply(message);
+
+		if (!j_message_receive(reply, connection))
+		{
+			return FALSE;
+		}
+	}
+
+	// The destination server processes messages in order, so the data can be streamed using the same connection.
+	while (offset < size)
+	{
+		g_autoptr(JMessage) write_message = NULL;
+		gchar* buf;
+		guint64 length;
+		guint64 bytes_read = 0;
+		guint64 bytes_written;
+
+		length = MIN(size - offset, memory_chunk_size);
+		buf = j_memory_chunk_get(memory_chunk, length);
+		g_assert(buf != NULL);
+
+		j_backend_object_read(jd_object_backend, object, buf, length, offset, &bytes_read);
+		j_statistics_add(statistics, J_STATISTICS_BYTES_READ, bytes_read);
+
+		if (bytes_read == 0)
+		{
+			j_memory_chunk_reset(memory_chunk);
+			break;
+		}
+
+		write_message = j_message_new(J_MESSAGE_OBJECT_WRITE, namespace_len + path_len);
+		j_message_set_semantics(write_message, semantics);
+		j_message_append_n(write_message, namespace, namespace_len);
+		j_message_append_n(write_message, path, path_len);
+		j_message_add_operation(write_message, sizeof(guint64) + sizeof(guint64));
+		j_message_append_8(write_message, &bytes_read);
+		j_message_append_8(write_message, &offset);
+		j_message_add_send(write_message, buf, bytes_read);
+		j_message_send(write_message, connection);
+		j_statistics_add(statistics, J_STATISTICS_BYTES_SENT, bytes_read);
+
+		bytes_written = bytes_read;
+
+		if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+		{
+			g_autoptr(JMessage) reply = NULL;
+
+			reply = j_message_new_reply(write_message);
+			j_message_receive(reply, connection);
+
+			bytes_written = (j_message_get_count(reply) > 0) ? j_message_get_8(reply) : 0;
+		}
+
+		j_memory_chunk_reset(memory_chunk);
+
+		offset += bytes_written;
+
+		if (bytes_written != bytes_read)
+		{
+			break;
+		}
+	}
+
+	*bytes_copied = offset;
+
+	return (offset == size);
+}
+
 gboolean
 jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk* memory_chunk, guint64 memory_chunk_size, JStatistics* statistics)
 {
@@ -54,7 +776,8 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 		case J_MESSAGE_OBJECT_CREATE:
 		{
 			g_autoptr(JMessage) reply = NULL;
-			gpointer object;
+			gpointer batch = NULL;
+			gboolean sync;
 
 			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
 			{
@@ -62,22 +785,18 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 			}
 
 			namespace = j_message_get_string(message);
+			sync = (persistency == J_SEMANTICS_PERSISTENCY_STORAGE);
+
+			// Batches allow backends to create the objects without opening them and to sync them together.
+			j_backend_object_batch_start(jd_object_backend, namespace, sync, &batch);
 
 			for (i = 0; i < operation_count; i++)
 			{
 				path = j_message_get_string(message);
 
-				if (j_backend_object_create(jd_object_backend, namespace, path, &object))
+				if (batch != NULL && j_backend_object_batch_create(jd_object_backend, batch, path))
 				{
 					j_statistics_add(statistics, J_STATISTICS_FILES_CREATED, 1);
-
-					if (persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
-					{
-						j_backend_object_sync(jd_object_backend, object);
-						j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
-					}
-
-					j_backend_object_close(jd_object_backend, object);
 				}
 
 				if (reply != NULL)
@@ -86,6 +805,16 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 				}
 			}
 
+			if (batch != NULL)
+			{
+				j_backend_object_batch_execute(jd_object_backend, batch);
+
+				if (sync)
+				{
+					j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
+				}
+			}
+
 			if (reply != NULL)
 			{
 				j_message_send(reply, connection);
@@ -95,7 +824,7 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 		case J_MESSAGE_OBJECT_DELETE:
 		{
 			g_autoptr(JMessage) reply = NULL;
-			gpointer object;
+			gpointer batch = NULL;
 
 			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
 			{
@@ -104,14 +833,15 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 
 			namespace = j_message_get_string(message);
 
+			j_backend_object_batch_start(jd_object_backend, namespace, FALSE, &batch);
+
 			for (i = 0; i < operation_count; i++)
 			{
 				guint32 status = 0;
 
 				path = j_message_get_string(message);
 
-				if (j_backend_object_open(jd_object_backend, namespace, path, &object)
-				    && j_backend_object_delete(jd_object_backend, object))
+				if (batch != NULL && j_backend_object_batch_delete(jd_object_backend, batch, path))
 				{
 					status = 1;
 					j_statistics_add(statistics, J_STATISTICS_FILES_DELETED, 1);
@@ -124,6 +854,11 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 				}
 			}
 
+			if (batch != NULL)
+			{
+				j_backend_object_batch_execute(jd_object_backend, batch);
+			}
+
 			if (reply != NULL)
 			{
 				j_message_send(reply, connection);
@@ -131,73 +866,52 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 		}
 		break;
 		case J_MESSAGE_OBJECT_GET_ALL:
+		case J_MESSAGE_OBJECT_GET_BY_PREFIX:
+		case J_MESSAGE_OBJECT_LIST:
 		{
 			g_autoptr(JMessage) reply = NULL;
-			gpointer iterator;
-			gchar const* empty = "";
+			JMessageType type;
+			gchar const* prefix = NULL;
+			gpointer iterator = NULL;
+			gboolean ret;
 
+			type = j_message_get_type(message);
 			reply = j_message_new_reply(message);
 			namespace = j_message_get_string(message);
 
-			if (j_backend_object_get_all(jd_object_backend, namespace, &iterator))
+			if (type != J_MESSAGE_OBJECT_GET_ALL)
 			{
-				while (j_backend_object_iterate(jd_object_backend, iterator, &key))
-				{
-					gsize key_len;
-
-					key_len = strlen(key) + 1;
-
-					j_message_add_operation(reply, key_len);
-					j_message_append_string(reply, key);
-				}
+				prefix = j_message_get_string(message);
 			}
 
-			j_message_add_operation(reply, 1);
-			j_message_append_string(reply, empty);
-
-			j_message_send(reply, connection);
-		}
-		break;
-		case J_MESSAGE_OBJECT_GET_BY_PREFIX:
-		{
-			g_autoptr(JMessage) reply = NULL;
-			gchar const* prefix;
-			gpointer iterator;
-			gchar const* empty = "";
-
-			reply = j_message_new_reply(message);
-			namespace = j_message_get_string(message);
-			prefix = j_message_get_string(message);
-
-			if (j_backend_object_get_by_prefix(jd_object_backend, namespace, prefix, &iterator))
+			// Listing with status always sends a prefix, an empty one matches all objects.
+			if (prefix == NULL || prefix[0] == '\0')
 			{
-				while (j_backend_object_iterate(jd_object_backend, iterator, &key))
-				{
-					gsize key_len;
-
-					key_len = strlen(key) + 1;
-
-					j_message_add_operation(reply, key_len);
-					j_message_append_string(reply, key);
-				}
+				ret = j_backend_object_get_all(jd_object_backend, namespace, &iterator);
+			}
+			else
+			{
+				ret = j_backend_object_get_by_prefix(jd_object_backend, namespace, prefix, &iterator);
 			}
 
-			j_message_add_operation(reply, 1);
-			j_message_append_string(reply, empty);
+			jd_cursor_reply(jd_cursor_new(J_BACKEND_TYPE_OBJECT, namespace, (ret) ? iterator : NULL, type == J_MESSAGE_OBJECT_LIST), reply);
 
 			j_message_send(reply, connection);
 		}
 		break;
 		case J_MESSAGE_OBJECT_READ:
 		{
+			g_autofree JBackendObjectRequest* requests = NULL;
 			JMessage* reply;
-			gpointer object;
+			gpointer object = NULL;
 			gboolean ret;
+			guint count = 0;
 
 			namespace = j_message_get_string(message);
 			path = j_message_get_string(message);
 
 			reply = j_message_new_reply(message);
+			requests = g_new(JBackendObjectRequest, operation_count);
 
 			ret = j_backend_object_open(jd_object_backend, namespace, path, &object);
 
@@ -211,13 +925,18 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 				length = j_message_get_8(message);
 				offset = j_message_get_8(message);
 
-				if (G_UNLIKELY(!ret))
+				if (G_LIKELY(ret) && length > 0 && jd_object_read_mapped(object, length, offset, requests, &count, reply, statistics))
 				{
-					break;
+					continue;
 				}
 
-				if (length > memory_chunk_size)
+				// Stripes are created lazily, a missing object has no data to read.
+				if (G_UNLIKELY(!ret) || length > memory_chunk_size)
 				{
+					// Earlier reads have to be replied to first.
+					jd_object_read_requests(object, requests, count, reply, statistics);
+					count = 0;
+
 					/// \todo return proper error
 					j_message_add_operation(reply, sizeof(guint64));
 					j_message_append_8(reply, &bytes_read);
@@ -228,7 +947,11 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 
 				if (buf == NULL)
 				{
+					// The reads gathered so far fill the memory chunk, reply to them before continuing.
 					/// \todo ugly
+					jd_object_read_requests(object, requests, count, reply, statistics);
+					count = 0;
+
 					j_message_send(reply, connection);
 					j_message_unref(reply);
 
@@ -238,18 +961,200 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 					buf = j_memory_chunk_get(memory_chunk, length);
 				}
 
-				j_backend_object_read(jd_object_backend, object, buf, length, offset, &bytes_read);
-				j_statistics_add(statistics, J_STATISTICS_BYTES_READ, bytes_read);
+				requests[count].write = FALSE;
+				requests[count].buffer = buf;
+				requests[count].length = length;
+				requests[count].offset = offset;
+				requests[count].bytes = 0;
+				count++;
+			}
 
-				j_message_add_operation(reply, sizeof(guint64));
-				j_message_append_8(reply, &bytes_read);
+			jd_object_read_requests(object, requests, count, reply, statistics);
+
+			if (ret)
+			{
+				j_backend_object_close(jd_object_backend, object);
+			}
+
+			j_message_send(reply, connection);
+			j_message_unref(reply);
+
+			j_memory_chunk_reset(memory_chunk);
+		}
+		break;
+		case J_MESSAGE_OBJECT_WRITE:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			gpointer object;
+			gboolean ret;
+
+			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+			{
+				reply = j_message_new_reply(message);
+			}
+
+			namespace = j_message_get_string(message);
+			path = j_message_get_string(message);
+
+			ret = j_backend_object_open(jd_object_backend, namespace, path, &object);
+
+			jd_object_write_operations(message, connection, (ret) ? object : NULL, persistency == J_SEMANTICS_PERSISTENCY_STORAGE, reply, memory_chunk, memory_chunk_size, statistics);
+
+			if (ret)
+			{
+				j_backend_object_close(jd_object_backend, object);
+			}
+
+			if (reply != NULL)
+			{
+				j_message_send(reply, connection);
+			}
+		}
+		break;
+		case J_MESSAGE_OBJECT_STATUS:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			gpointer object;
+
+			reply = j_message_new_reply(message);
+
+			namespace = j_message_get_string(message);
+
+			for (i = 0; i < operation_count; i++)
+			{
+				gint64 modification_time = 0;
+				guint64 size = 0;
+
+				path = j_message_get_string(message);
+
+				if (j_backend_object_open(jd_object_backend, namespace, path, &object))
+				{
+					if (j_backend_object_status(jd_object_backend, object, &modification_time, &size))
+					{
+						j_statistics_add(statistics, J_STATISTICS_FILES_STATED, 1);
+					}
+
+					j_backend_object_close(jd_object_backend, object);
+				}
+
+				j_message_add_operation(reply, sizeof(gint64) + sizeof(guint64));
+				j_message_append_8(reply, &modification_time);
+				j_message_append_8(reply, &size);
+			}
+
+			j_message_send(reply, connection);
+		}
+		break;
+		case J_MESSAGE_OBJECT_SYNC:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			gpointer object;
+
+			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+			{
+				reply = j_message_new_reply(message);
+			}
+
+			namespace = j_message_get_string(message);
+
+			for (i = 0; i < operation_count; i++)
+			{
+				path = j_message_get_string(message);
+
+				if (j_backend_object_open(jd_object_backend, namespace, path, &object))
+				{
+					j_backend_object_sync(jd_object_backend, object);
+					j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
+					j_backend_object_close(jd_object_backend, object);
+				}
+
+				if (reply != NULL)
+				{
+					j_message_add_operation(reply, 0);
+				}
+			}
+
+			if (reply != NULL)
+			{
+				j_message_send(reply, connection);
+			}
+		}
+		break;
+		case J_MESSAGE_OBJECT_COPY:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			gpointer object;
+			gboolean ret;
+
+			reply = j_message_new_reply(message);
+
+			namespace = j_message_get_string(message);
+			path = j_message_get_string(message);
+
+			ret = j_backend_object_open(jd_object_backend, namespace, path, &object);
+
+			for (i = 0; i < operation_count; i++)
+			{
+				gchar const* dst_namespace;
+				gchar const* dst_path;
+				guint32 dst_index;
+				guint32 flags;
+				guint32 status = 0;
+				guint64 bytes_copied = 0;
+
+				dst_index = j_message_get_4(message);
+				flags = j_message_get_4(message);
+				dst_namespace = j_message_get_string(message);
+				dst_path = j_message_get_string(message);
+
+				if (G_LIKELY(ret))
+				{
+					if (flags & J_MESSAGE_OBJECT_COPY_REMOTE)
+					{
+						if (jd_object_copy_to_server(object, dst_index, dst_namespace, dst_path, semantics, memory_chunk, memory_chunk_size, statistics, &bytes_copied))
+						{
+							status = 1;
+						}
+					}
+					else
+					{
+						gpointer dst_object;
+
+						if (j_backend_object_create(jd_object_backend, dst_namespace, dst_path, &dst_object))
+						{
+							j_statistics_add(statistics, J_STATISTICS_FILES_CREATED, 1);
+
+							if (j_backend_object_copy(jd_object_backend, object, dst_object, &bytes_copied))
+							{
+								status = 1;
+							}
+
+							j_statistics_add(statistics, J_STATISTICS_BYTES_READ, bytes_copied);
+							j_statistics_add(statistics, J_STATISTICS_BYTES_WRITTEN, bytes_copied);
+
+							if (persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+							{
+								if (!j_backend_object_sync(jd_object_backend, dst_object))
+								{
+									status = 0;
+								}
+
+								j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
+							}
 
-				if (bytes_read > 0)
+							j_backend_object_close(jd_object_backend, dst_object);
+						}
+					}
+				}
+				else if (flags & J_MESSAGE_OBJECT_COPY_SPARSE)
 				{
-					j_message_add_send(reply, buf, bytes_read);
+					// Stripes are created lazily, a missing stripe has no data to copy.
+					status = 1;
 				}
 
-				j_statistics_add(statistics, J_STATISTICS_BYTES_SENT, bytes_read);
+				j_message_add_operation(reply, sizeof(guint32) + sizeof(guint64));
+				j_message_append_4(reply, &status);
+				j_message_append_8(reply, &bytes_copied);
 			}
 
 			if (ret)
@@ -258,115 +1163,199 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 			}
 
 			j_message_send(reply, connection);
-			j_message_unref(reply);
-
-			j_memory_chunk_reset(memory_chunk);
 		}
 		break;
-		case J_MESSAGE_OBJECT_WRITE:
+		case J_MESSAGE_OBJECT_COMPOUND:
 		{
 			g_autoptr(JMessage) reply = NULL;
 			gpointer object;
 			gboolean ret;
+			guint32 flags;
 
 			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
 			{
 				reply = j_message_new_reply(message);
 			}
 
+			namespace = j_message_get_string(message);
+			path = j_message_get_string(message);
+			flags = j_message_get_4(message);
+
+			ret = j_backend_object_open(jd_object_backend, namespace, path, &object);
+
+			// The operations are executed in order, so the create cannot be overtaken by the writes.
+			// Objects are only created if they do not exist yet, since stripes are created on their first write.
+			if (!ret && (flags & J_MESSAGE_OBJECT_COMPOUND_CREATE))
+			{
+				ret = j_backend_object_create(jd_object_backend, namespace, path, &object);
+
+				if (ret)
+				{
+					j_statistics_add(statistics, J_STATISTICS_FILES_CREATED, 1);
+				}
+			}
+
+			jd_object_write_operations(message, connection, (ret) ? object : NULL, ret && ((flags & J_MESSAGE_OBJECT_COMPOUND_SYNC) || persistency == J_SEMANTICS_PERSISTENCY_STORAGE), reply, memory_chunk, memory_chunk_size, statistics);
+
+			if (ret)
+			{
+				j_backend_object_close(jd_object_backend, object);
+			}
+
+			if (reply != NULL)
+			{
+				j_message_send(reply, connection);
+			}
+		}
+		break;
+		case J_MESSAGE_OBJECT_APPEND:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			GMutex* lock;
+			gpointer object;
+			gboolean ret;
+
+			reply = j_message_new_reply(message);
+
 			namespace = j_message_get_string(message);
 			path = j_message_get_string(message);
 
+			lock = j_backend_object_get_append_lock(namespace, path);
 			ret = j_backend_object_open(jd_object_backend, namespace, path, &object);
 
 			for (i = 0; i < operation_count; i++)
 			{
 				GInputStream* input;
 				gchar* buf;
+				gboolean write_ret = FALSE;
+				guint64 chunk_length;
 				guint64 length;
-				guint64 offset;
+				guint64 position;
+				guint64 offset = 0;
 				guint64 bytes_written = 0;
 
 				length = j_message_get_8(message);
-				offset = j_message_get_8(message);
-
-				if (length > memory_chunk_size && reply != NULL && G_LIKELY(ret))
-				{
-					/// \todo return proper error
-					j_message_add_operation(reply, sizeof(guint64));
-					j_message_append_8(reply, &bytes_written);
-					continue;
-				}
+				chunk_length = MIN(length, memory_chunk_size);
 
 				// Guaranteed to work because memory_chunk is reset below
-				buf = j_memory_chunk_get(memory_chunk, length);
+				buf = j_memory_chunk_get(memory_chunk, chunk_length);
 				g_assert(buf != NULL);
 
 				input = g_io_stream_get_input_stream(G_IO_STREAM(connection));
-				g_input_stream_read_all(input, buf, length, NULL, NULL, NULL);
-				j_statistics_add(statistics, J_STATISTICS_BYTES_RECEIVED, length);
+				g_input_stream_read_all(input, buf, chunk_length, NULL, NULL, NULL);
+				position = chunk_length;
 
 				if (G_LIKELY(ret))
 				{
-					j_backend_object_write(jd_object_backend, object, buf, length, offset, &bytes_written);
-					j_statistics_add(statistics, J_STATISTICS_BYTES_WRITTEN, bytes_written);
+					gint64 modification_time;
+
+					// The current size determines the offset, so appends to the same object have to be serialized.
+					g_mutex_lock(lock);
+
+					write_ret = j_backend_object_status(jd_object_backend, object, &modification_time, &offset);
+				}
+
+				// Appends larger than the memory chunk are received piecewise, the payload has to be consumed completely even if writing fails.
+				while (TRUE)
+				{
+					if (write_ret)
+					{
+						guint64 nbytes = 0;
+
+						write_ret = j_backend_object_write(jd_object_backend, object, buf, chunk_length, offset + bytes_written, &nbytes);
+						bytes_written += nbytes;
+					}
 
-					if (reply != NULL)
+					if (position == length)
 					{
-						j_message_add_operation(reply, sizeof(guint64));
-						j_message_append_8(reply, &bytes_written);
+						break;
 					}
+
+					chunk_length = MIN(length - position, memory_chunk_size);
+					g_input_stream_read_all(input, buf, chunk_length, NULL, NULL, NULL);
+					position += chunk_length;
 				}
 
-				j_memory_chunk_reset(memory_chunk);
-			}
+				if (G_LIKELY(ret))
+				{
+					g_mutex_unlock(lock);
+				}
 
-			if (persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
-			{
-				j_backend_object_sync(jd_object_backend, object);
-				j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
+				j_statistics_add(statistics, J_STATISTICS_BYTES_RECEIVED, length);
+				j_statistics_add(statistics, J_STATISTICS_BYTES_WRITTEN, bytes_written);
+
+				j_message_add_operation(reply, sizeof(guint64) + sizeof(guint64));
+				j_message_append_8(reply, &offset);
+				j_message_append_8(reply, &bytes_written);
+
+				j_memory_chunk_reset(memory_chunk);
 			}
 
 			if (ret)
 			{
+				if (persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+				{
+					j_backend_object_sync(jd_object_backend, object);
+					j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
+				}
+
 				j_backend_object_close(jd_object_backend, object);
 			}
 
-			if (reply != NULL)
-			{
-				j_message_send(reply, connection);
-			}
+			j_message_send(reply, connection);
 
 			j_memory_chunk_reset(memory_chunk);
 		}
 		break;
-		case J_MESSAGE_OBJECT_STATUS:
+		case J_MESSAGE_OBJECT_RESERVE:
 		{
 			g_autoptr(JMessage) reply = NULL;
+			GMutex* lock;
 			gpointer object;
+			gboolean ret;
 
 			reply = j_message_new_reply(message);
 
 			namespace = j_message_get_string(message);
+			path = j_message_get_string(message);
+
+			lock = j_backend_object_get_append_lock(namespace, path);
+
+			// The reservation object's size marks the end of the reserved range, it does not contain any data.
+			ret = j_backend_object_create(jd_object_backend, namespace, path, &object);
 
 			for (i = 0; i < operation_count; i++)
 			{
-				gint64 modification_time = 0;
-				guint64 size = 0;
-
-				path = j_message_get_string(message);
+				guint64 length;
+				guint64 offset = 0;
 
-				/// \todo return value
-				j_backend_object_open(jd_object_backend, namespace, path, &object);
+				length = j_message_get_8(message);
 
-				if (j_backend_object_status(jd_object_backend, object, &modification_time, &size))
+				if (G_LIKELY(ret))
 				{
-					j_statistics_add(statistics, J_STATISTICS_FILES_STATED, 1);
+					gint64 modification_time;
+
+					g_mutex_lock(lock);
+
+					if (j_backend_object_status(jd_object_backend, object, &modification_time, &offset) && length > 0)
+					{
+						j_backend_object_truncate(jd_object_backend, object, offset + length);
+					}
+
+					g_mutex_unlock(lock);
 				}
 
-				j_message_add_operation(reply, sizeof(gint64) + sizeof(guint64));
-				j_message_append_8(reply, &modification_time);
-				j_message_append_8(reply, &size);
+				j_message_add_operation(reply, sizeof(guint64));
+				j_message_append_8(reply, &offset);
+			}
+
+			if (ret)
+			{
+				if (persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+				{
+					j_backend_object_sync(jd_object_backend, object);
+					j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
+				}
 
 				j_backend_object_close(jd_object_backend, object);
 			}
@@ -374,32 +1363,33 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 			j_message_send(reply, connection);
 		}
 		break;
-		case J_MESSAGE_OBJECT_SYNC:
+		case J_MESSAGE_OBJECT_DELETE_PREFIX:
 		{
 			g_autoptr(JMessage) reply = NULL;
-			gpointer object;
 
 			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
 			{
 				reply = j_message_new_reply(message);
 			}
 
-			namespace = j_message_get_string(message);
-
 			for (i = 0; i < operation_count; i++)
 			{
-				path = j_message_get_string(message);
+				gchar const* prefix;
+				gboolean ret;
 
-				if (j_backend_object_open(jd_object_backend, namespace, path, &object))
-				{
-					j_backend_object_sync(jd_object_backend, object);
-					j_statistics_add(statistics, J_STATISTICS_SYNC, 1);
-					j_backend_object_close(jd_object_backend, object);
-				}
+				namespace = j_message_get_string(message);
+				prefix = j_message_get_string(message);
+
+				// An empty prefix deletes the whole namespace.
+				ret = j_backend_object_delete_by_prefix(jd_object_backend, namespace, (prefix[0] != '\0') ? prefix : NULL);
 
 				if (reply != NULL)
 				{
-					j_message_add_operation(reply, 0);
+					guint32 dummy;
+
+					dummy = (ret) ? 1 : 0;
+					j_message_add_operation(reply, 4);
+					j_message_append_4(reply, &dummy);
 				}
 			}
 
@@ -415,6 +1405,7 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 			JStatistics* r_statistics;
 			gchar get_all;
 			guint64 value;
+			guint64 value_total;
 
 			get_all = j_message_get_1(message);
 			r_statistics = (get_all == 0) ? statistics : jd_statistics;
@@ -450,9 +1441,79 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 				g_mutex_unlock(jd_statistics_mutex);
 			}
 
+			// The second operation contains the server's current load, clients that do not need it can ignore it.
+			j_message_add_operation(reply, 4 * sizeof(guint64));
+
+			value = 0;
+			value_total = 0;
+
+			if (jd_object_path != NULL && jd_object_path[0] != '\0')
+			{
+				g_autoptr(GFile) file = NULL;
+				g_autoptr(GFileInfo) info = NULL;
+
+				file = g_file_new_for_path(jd_object_path);
+				info = g_file_query_filesystem_info(file, G_FILE_ATTRIBUTE_FILESYSTEM_FREE "," G_FILE_ATTRIBUTE_FILESYSTEM_SIZE, NULL, NULL);
+
+				if (info != NULL)
+				{
+					value = g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_FILESYSTEM_FREE);
+					value_total = g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_FILESYSTEM_SIZE);
+				}
+			}
+
+			// A total capacity of 0 means that the capacity is unknown.
+			j_message_append_8(reply, &value);
+			j_message_append_8(reply, &value_total);
+
+			value = j_helper_atomic_add(&jd_bytes_written, 0);
+			j_message_append_8(reply, &value);
+
+			// Do not count this message.
+			value = MAX(g_atomic_int_get(&jd_operations_active), 1) - 1;
+			j_message_append_8(reply, &value);
+
+			j_message_send(reply, connection);
+		}
+		break;
+		case J_MESSAGE_CURSOR_NEXT:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			JCursor* cursor;
+			JBackendType type;
+			guint64 id;
+
+			reply = j_message_new_reply(message);
+			id = j_message_get_8(message);
+			type = j_message_get_1(message);
+
+			if ((cursor = jd_cursor_take(id)) == NULL)
+			{
+				g_warning("Cursor %" G_GUINT64_FORMAT " does not exist, it might have expired.", id);
+
+				// Terminate the iteration with an empty page of the expected type.
+				cursor = jd_cursor_new(type, "", NULL, FALSE);
+			}
+
+			jd_cursor_reply(cursor, reply);
+
 			j_message_send(reply, connection);
 		}
 		break;
+		case J_MESSAGE_CURSOR_CLOSE:
+		{
+			JCursor* cursor;
+			guint64 id;
+
+			// Clients do not wait for a reply when abandoning a cursor.
+			id = j_message_get_8(message);
+
+			if ((cursor = jd_cursor_take(id)) != NULL)
+			{
+				jd_cursor_free(cursor);
+			}
+		}
+		break;
 		case J_MESSAGE_PING:
 		{
 			g_autoptr(JMessage) reply = NULL;
@@ -589,97 +1650,206 @@ jd_handle_message(JMessage* message, GSocketConnection* connection, JMemoryChunk
 
 			for (i = 0; i < operation_count; i++)
 			{
-				gpointer value;
+				gconstpointer value;
 				guint32 len;
+				GDestroyNotify value_free;
+				gboolean found;
 
 				key = j_message_get_string(message);
+				found = j_backend_kv_get_view(jd_kv_backend, batch, key, &value, &len, &value_free);
 
-				if (j_backend_kv_get(jd_kv_backend, batch, key, &value, &len))
+				if (found && len > 0)
 				{
-					j_message_add_operation(reply, 4 + len);
+					j_message_add_operation(reply, 4);
 					j_message_append_4(reply, &len);
-					j_message_append_n(reply, value, len);
 
-					g_free(value);
+					// The values are sent directly from the backend after the reply.
+					j_message_add_send_full(reply, value, len, value_free, (gpointer)value);
 				}
 				else
 				{
 					guint32 zero = 0;
 
+					if (found && value_free != NULL)
+					{
+						value_free((gpointer)value);
+					}
+
 					j_message_add_operation(reply, 4);
 					j_message_append_4(reply, &zero);
 				}
 			}
 
+			// Values borrowed from the backend are only valid until the batch is executed.
+			j_message_send(reply, connection);
+
 			j_backend_kv_batch_execute(jd_kv_backend, batch);
+		}
+		break;
+		case J_MESSAGE_KV_GET_ALL:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			gpointer iterator = NULL;
+			gboolean ret;
+
+			reply = j_message_new_reply(message);
+			namespace = j_message_get_string(message);
+
+			ret = j_backend_kv_get_all(jd_kv_backend, namespace, &iterator);
+
+			jd_cursor_reply(jd_cursor_new(J_BACKEND_TYPE_KV, namespace, (ret) ? iterator : NULL, FALSE), reply);
 
 			j_message_send(reply, connection);
 		}
 		break;
-		case J_MESSAGE_KV_GET_ALL:
+		case J_MESSAGE_KV_GET_BY_PREFIX:
 		{
 			g_autoptr(JMessage) reply = NULL;
-			gpointer iterator;
-			gconstpointer value;
-			guint32 len;
-			guint32 zero = 0;
+			gchar const* prefix;
+			gpointer iterator = NULL;
+			gboolean ret;
 
 			reply = j_message_new_reply(message);
 			namespace = j_message_get_string(message);
+			prefix = j_message_get_string(message);
 
-			j_backend_kv_get_all(jd_kv_backend, namespace, &iterator);
+			ret = j_backend_kv_get_by_prefix(jd_kv_backend, namespace, prefix, &iterator);
 
-			while (j_backend_kv_iterate(jd_kv_backend, iterator, &key, &value, &len))
-			{
-				gsize key_len;
+			jd_cursor_reply(jd_cursor_new(J_BACKEND_TYPE_KV, namespace, (ret) ? iterator : NULL, FALSE), reply);
+
+			j_message_send(reply, connection);
+		}
+		break;
+		case J_MESSAGE_KV_GET_RANGE:
+		{
+			g_autoptr(JMessage) reply = NULL;
+			gchar const* start = NULL;
+			gchar const* end = NULL;
+			gpointer iterator = NULL;
+			guint8 flags;
+			guint32 limit;
+			gboolean ret;
 
-				key_len = strlen(key) + 1;
+			reply = j_message_new_reply(message);
+			namespace = j_message_get_string(message);
+			flags = j_message_get_1(message);
+			limit = j_message_get_4(message);
+
+			if (flags & J_MESSAGE_KV_RANGE_START)
+			{
+				start = j_message_get_string(message);
+			}
 
-				j_message_add_operation(reply, 4 + len + key_len);
-				j_message_append_4(reply, &len);
-				j_message_append_n(reply, value, len);
-				j_message_append_string(reply, key);
+			if (flags & J_MESSAGE_KV_RANGE_END)
+			{
+				end = j_message_get_string(message);
 			}
 
-			j_message_add_operation(reply, 4);
-			j_message_append_4(reply, &zero);
+			ret = j_backend_kv_get_range(jd_kv_backend, namespace, start, end, limit, (flags & J_MESSAGE_KV_RANGE_REVERSE) != 0, &iterator);
+
+			jd_cursor_reply(jd_cursor_new(J_BACKEND_TYPE_KV, namespace, (ret) ? iterator : NULL, FALSE), reply);
 
 			j_message_send(reply, connection);
 		}
 		break;
-		case J_MESSAGE_KV_GET_BY_PREFIX:
+		case J_MESSAGE_KV_UPDATE:
 		{
 			g_autoptr(JMessage) reply = NULL;
-			gchar const* prefix;
-			gpointer iterator;
-			gconstpointer value;
-			guint32 len;
-			guint32 zero = 0;
+			gpointer batch;
 
+			// The reply is always sent, because it contains the results of the comparisons.
 			reply = j_message_new_reply(message);
-			namespace = j_message_get_string(message);
-			prefix = j_message_get_string(message);
 
-			j_backend_kv_get_by_prefix(jd_kv_backend, namespace, prefix, &iterator);
+			namespace = j_message_get_string(message);
+			j_backend_kv_batch_start(jd_kv_backend, namespace, semantics, &batch);
 
-			while (j_backend_kv_iterate(jd_kv_backend, iterator, &key, &value, &len))
+			for (i = 0; i < operation_count; i++)
 			{
-				gsize key_len;
+				gconstpointer expected = NULL;
+				gconstpointer data;
+				guint32 expected_len = 0;
+				guint32 len;
+				guint32 status;
+				gint64 delta;
+				gboolean ret = FALSE;
+
+				key = j_message_get_string(message);
 
-				key_len = strlen(key) + 1;
+				switch (j_message_get_1(message))
+				{
+					case J_MESSAGE_KV_UPDATE_COMPARE_AND_SWAP:
+						expected_len = j_message_get_4(message);
+						expected = j_message_get_n(message, expected_len);
+						// fallthrough
+					case J_MESSAGE_KV_UPDATE_CREATE:
+						len = j_message_get_4(message);
+						data = j_message_get_n(message, len);
+						ret = j_backend_kv_compare_and_swap(jd_kv_backend, batch, key, expected, expected_len, data, len);
+						break;
+					case J_MESSAGE_KV_UPDATE_ADD:
+						delta = j_message_get_8(message);
+						ret = j_backend_kv_add(jd_kv_backend, batch, key, delta);
+						break;
+					case J_MESSAGE_KV_UPDATE_APPEND:
+						len = j_message_get_4(message);
+						data = j_message_get_n(message, len);
+						ret = j_backend_kv_append(jd_kv_backend, batch, key, data, len);
+						break;
+					default:
+						g_warn_if_reached();
+				}
 
-				j_message_add_operation(reply, 4 + len + key_len);
-				j_message_append_4(reply, &len);
-				j_message_append_n(reply, value, len);
-				j_message_append_string(reply, key);
+				status = (ret) ? 1 : 0;
+				j_message_add_operation(reply, 4);
+				j_message_append_4(reply, &status);
 			}
 
-			j_message_add_operation(reply, 4);
-			j_message_append_4(reply, &zero);
+			j_backend_kv_batch_execute(jd_kv_backend, batch);
 
 			j_message_send(reply, connection);
 		}
 		break;
+		case J_MESSAGE_KV_DELETE_PREFIX:
+		{
+			g_autoptr(JMessage) reply = NULL;
+
+			if (persistency == J_SEMANTICS_PERSISTENCY_NETWORK || persistency == J_SEMANTICS_PERSISTENCY_STORAGE)
+			{
+				reply = j_message_new_reply(message);
+			}
+
+			for (i = 0; i < operation_count; i++)
+			{
+				gchar const* prefix;
+				gpointer batch;
+				gboolean ret = FALSE;
+
+				namespace = j_message_get_string(message);
+				prefix = j_message_get_string(message);
+
+				if (j_backend_kv_batch_start(jd_kv_backend, namespace, semantics, &batch))
+				{
+					// An empty prefix deletes the whole namespace.
+					ret = j_backend_kv_delete_by_prefix(jd_kv_backend, batch, namespace, (prefix[0] != '\0') ? prefix : NULL);
+					ret = j_backend_kv_batch_execute(jd_kv_backend, batch) && ret;
+				}
+
+				if (reply != NULL)
+				{
+					guint32 dummy;
+
+					dummy = (ret) ? 1 : 0;
+					j_message_add_operation(reply, 4);
+					j_message_append_4(reply, &dummy);
+				}
+			}
+
+			if (reply != NULL)
+			{
+				j_message_send(reply, connection);
+			}
+		}
+		break;
 		case J_MESSAGE_DB_SCHEMA_CREATE:
 			if (!message_matched)
 			{
@@ -36,12 +36,18 @@
 JStatistics* jd_statistics = NULL;
 GMutex jd_statistics_mutex[1] = { 0 };
 
+// Unlike jd_statistics, these are updated after every message and can be used to determine the server's current load.
+gint jd_operations_active = 0;
+guint64 jd_bytes_written = 0;
+
 JBackend* jd_object_backend = NULL;
 JBackend* jd_kv_backend = NULL;
 JBackend* jd_db_backend = NULL;
 
 JConfiguration* jd_configuration = NULL;
 
+gchar* jd_object_path = NULL;
+
 static gboolean
 jd_signal(gpointer data)
 {
@@ -77,11 +83,26 @@ jd_on_run(GThreadedSocketService* service, GSocketConnection* connection, GObjec
 	memory_chunk_size = j_configuration_get_max_operation_size(jd_configuration);
 	memory_chunk = j_memory_chunk_new(memory_chunk_size);
 
+	// All object data passes through the memory chunk, so the backend only has to map it once.
+	if (jd_object_backend != NULL)
+	{
+		j_backend_object_register_buffer(jd_object_backend, j_memory_chunk_get(memory_chunk, memory_chunk_size), memory_chunk_size);
+		j_memory_chunk_reset(memory_chunk);
+	}
+
 	message = j_message_new(J_MESSAGE_NONE, 0);
 
 	while (j_message_receive(message, connection))
 	{
+		guint64 bytes_written;
+
+		bytes_written = j_statistics_get(statistics, J_STATISTICS_BYTES_WRITTEN);
+
+		g_atomic_int_inc(&jd_operations_active);
 		jd_handle_message(message, connection, memory_chunk, memory_chunk_size, statistics);
+		g_atomic_int_add(&jd_operations_active, -1);
+
+		j_helper_atomic_add(&jd_bytes_written, j_statistics_get(statistics, J_STATISTICS_BYTES_WRITTEN) - bytes_written);
 	}
 
 	{
@@ -107,6 +128,12 @@ jd_on_run(GThreadedSocketService* service, GSocketConnection* connection, GObjec
 		g_mutex_unlock(jd_statistics_mutex);
 	}
 
+	// Threads are reused for other connections.
+	if (jd_object_backend != NULL)
+	{
+		j_backend_object_register_buffer(jd_object_backend, NULL, 0);
+	}
+
 	j_memory_chunk_free(memory_chunk);
 	j_statistics_free(statistics);
 
@@ -337,6 +364,9 @@ main(int argc, char** argv)
 			return 1;
 		}
 
+		// Used to report the free capacity.
+		jd_object_path = object_path;
+
 		g_debug("Initialized object backend %s.", object_backend);
 	}
 
@@ -380,6 +410,9 @@ main(int argc, char** argv)
 
 	g_socket_service_stop(socket_service);
 
+	// Cursors hold backend iterators, so they have to be freed before the backends.
+	jd_cursors_fini();
+
 	g_mutex_clear(jd_statistics_mutex);
 	j_statistics_free(jd_statistics);
 
@@ -31,12 +31,18 @@
 G_GNUC_INTERNAL extern JStatistics* jd_statistics;
 G_GNUC_INTERNAL extern GMutex jd_statistics_mutex[1];
 
+G_GNUC_INTERNAL extern gint jd_operations_active;
+G_GNUC_INTERNAL extern guint64 jd_bytes_written;
+
 G_GNUC_INTERNAL extern JBackend* jd_object_backend;
 G_GNUC_INTERNAL extern JBackend* jd_kv_backend;
 G_GNUC_INTERNAL extern JBackend* jd_db_backend;
 
 G_GNUC_INTERNAL extern JConfiguration* jd_configuration;
 
+G_GNUC_INTERNAL extern gchar* jd_object_path;
+
 G_GNUC_INTERNAL gboolean jd_handle_message(JMessage*, GSocketConnection*, JMemoryChunk*, guint64, JStatistics*);
+G_GNUC_INTERNAL void jd_cursors_fini(void);
 
 #endif
@@ -138,6 +138,89 @@ test_batch_execute_async(void)
 	J_TEST_TRAP_END;
 }
 
+static guint test_batch_first_count;
+static guint test_batch_second_count;
+static guint test_batch_compound_count;
+
+static gboolean
+test_batch_first_exec(JList* operations, JSemantics* semantics)
+{
+	(void)semantics;
+
+	test_batch_first_count += j_list_length(operations);
+
+	return TRUE;
+}
+
+static gboolean
+test_batch_second_exec(JList* operations, JSemantics* semantics)
+{
+	(void)semantics;
+
+	test_batch_second_count += j_list_length(operations);
+
+	return TRUE;
+}
+
+static gboolean
+test_batch_compound_exec(JList* operations, JSemantics* semantics)
+{
+	(void)operations;
+	(void)semantics;
+
+	test_batch_compound_count++;
+
+	return TRUE;
+}
+
+static void
+test_batch_add_operation(JBatch* batch, JOperationExecFunc exec_func, guint compound_position)
+{
+	JOperation* operation;
+
+	operation = j_operation_new();
+	operation->key = &test_batch_compound_count;
+	operation->exec_func = exec_func;
+	operation->compound_exec_func = test_batch_compound_exec;
+	operation->compound_position = compound_position;
+
+	j_batch_add(batch, operation);
+}
+
+static void
+test_batch_execute_compound(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	test_batch_first_count = 0;
+	test_batch_second_count = 0;
+	test_batch_compound_count = 0;
+
+	// Operations in the compound function's order are combined.
+	test_batch_add_operation(batch, test_batch_first_exec, 0);
+	test_batch_add_operation(batch, test_batch_second_exec, 1);
+	test_batch_add_operation(batch, test_batch_second_exec, 1);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(test_batch_compound_count, ==, 1);
+	g_assert_cmpuint(test_batch_first_count, ==, 0);
+	g_assert_cmpuint(test_batch_second_count, ==, 0);
+
+	// Operations in reversed order are executed separately.
+	test_batch_add_operation(batch, test_batch_second_exec, 1);
+	test_batch_add_operation(batch, test_batch_first_exec, 0);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(test_batch_compound_count, ==, 1);
+	g_assert_cmpuint(test_batch_first_count, ==, 1);
+	g_assert_cmpuint(test_batch_second_count, ==, 1);
+	J_TEST_TRAP_END;
+}
+
 void
 test_core_batch(void)
 {
@@ -146,4 +229,5 @@ test_core_batch(void)
 	g_test_add_func("/core/batch/execute_empty", test_batch_execute_empty);
 	g_test_add_func("/core/batch/execute", test_batch_execute);
 	g_test_add_func("/core/batch/execute_async", test_batch_execute_async);
+	g_test_add_func("/core/batch/execute_compound", test_batch_execute_compound);
 }
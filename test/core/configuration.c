@@ -126,10 +126,98 @@ test_configuration_get(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_configuration_virtual_nodes(void)
+{
+	JConfiguration* configuration;
+	GKeyFile* key_file;
+	gchar const* servers[] = { "localhost", "local.host", NULL };
+	gint const weights[] = { 1, 2048 };
+
+	J_TEST_TRAP_START;
+	key_file = g_key_file_new();
+	g_key_file_set_string(key_file, "clients", "placement", "ring");
+	g_key_file_set_integer(key_file, "clients", "virtual-nodes", 8192);
+	g_key_file_set_string_list(key_file, "servers", "object", servers, 2);
+	g_key_file_set_string_list(key_file, "servers", "kv", servers, 2);
+	g_key_file_set_string_list(key_file, "servers", "db", servers, 2);
+	g_key_file_set_integer_list(key_file, "servers", "kv-weights", (gint*)weights, 2);
+	g_key_file_set_string(key_file, "object", "backend", "null");
+	g_key_file_set_string(key_file, "object", "component", "server");
+	g_key_file_set_string(key_file, "object", "path", "");
+	g_key_file_set_string(key_file, "kv", "backend", "null");
+	g_key_file_set_string(key_file, "kv", "component", "server");
+	g_key_file_set_string(key_file, "kv", "path", "");
+	g_key_file_set_string(key_file, "db", "backend", "null");
+	g_key_file_set_string(key_file, "db", "component", "server");
+	g_key_file_set_string(key_file, "db", "path", "");
+
+	// Values that are too large are ignored, so that the hash ring's size stays bounded.
+	g_test_expect_message("JULEA", G_LOG_LEVEL_WARNING, "Ignoring virtual-nodes because it is larger than 4096.");
+	g_test_expect_message("JULEA", G_LOG_LEVEL_WARNING, "Ignoring kv-weights because it contains weights larger than 1024.");
+	configuration = j_configuration_new_for_data(key_file);
+	g_test_assert_expected_messages();
+	g_assert_true(configuration != NULL);
+
+	g_assert_cmpuint(j_configuration_get_virtual_nodes(configuration), ==, 128);
+	g_assert_cmpuint(j_configuration_get_server_weight(configuration, J_BACKEND_TYPE_KV, 1), ==, 1);
+
+	j_configuration_unref(configuration);
+
+	g_key_file_free(key_file);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_configuration_hedge_percentile(void)
+{
+	JConfiguration* configuration;
+	GKeyFile* key_file;
+	gchar const* servers[] = { "localhost", NULL };
+
+	J_TEST_TRAP_START;
+	key_file = g_key_file_new();
+	g_key_file_set_integer(key_file, "clients", "hedge-percentile", 95);
+	g_key_file_set_string_list(key_file, "servers", "object", servers, 1);
+	g_key_file_set_string_list(key_file, "servers", "kv", servers, 1);
+	g_key_file_set_string_list(key_file, "servers", "db", servers, 1);
+	g_key_file_set_string(key_file, "object", "backend", "null");
+	g_key_file_set_string(key_file, "object", "component", "server");
+	g_key_file_set_string(key_file, "object", "path", "");
+	g_key_file_set_string(key_file, "kv", "backend", "null");
+	g_key_file_set_string(key_file, "kv", "component", "server");
+	g_key_file_set_string(key_file, "kv", "path", "");
+	g_key_file_set_string(key_file, "db", "backend", "null");
+	g_key_file_set_string(key_file, "db", "component", "server");
+	g_key_file_set_string(key_file, "db", "path", "");
+
+	configuration = j_configuration_new_for_data(key_file);
+	g_assert_true(configuration != NULL);
+	g_assert_cmpuint(j_configuration_get_hedge_percentile(configuration), ==, 95);
+	j_configuration_unref(configuration);
+
+	g_key_file_set_integer(key_file, "clients", "hedge-percentile", -1);
+	g_test_expect_message("JULEA", G_LOG_LEVEL_WARNING, "Cannot use hedge-percentile -1 because it is not between 0 and 100.");
+	configuration = j_configuration_new_for_data(key_file);
+	g_test_assert_expected_messages();
+	g_assert_true(configuration == NULL);
+
+	g_key_file_set_integer(key_file, "clients", "hedge-percentile", 101);
+	g_test_expect_message("JULEA", G_LOG_LEVEL_WARNING, "Cannot use hedge-percentile 101 because it is not between 0 and 100.");
+	configuration = j_configuration_new_for_data(key_file);
+	g_test_assert_expected_messages();
+	g_assert_true(configuration == NULL);
+
+	g_key_file_free(key_file);
+	J_TEST_TRAP_END;
+}
+
 void
 test_core_configuration(void)
 {
 	g_test_add_func("/core/configuration/new_ref_unref", test_configuration_new_ref_unref);
 	g_test_add_func("/core/configuration/new_for_data", test_configuration_new_for_data);
 	g_test_add_func("/core/configuration/get", test_configuration_get);
+	g_test_add_func("/core/configuration/virtual_nodes", test_configuration_virtual_nodes);
+	g_test_add_func("/core/configuration/hedge_percentile", test_configuration_hedge_percentile);
 }
@@ -146,9 +146,40 @@ test_dir_iterator_next_get(gchar** path, gconstpointer data)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_dir_iterator_get_status(gchar** path, gconstpointer data)
+{
+	g_autoptr(JDirIterator) iterator = NULL;
+	guint files = 0;
+
+	(void)data;
+
+	J_TEST_TRAP_START;
+	iterator = j_dir_iterator_new(*path);
+	g_assert_true(iterator != NULL);
+
+	while (j_dir_iterator_next(iterator))
+	{
+		gint64 modification_time = 0;
+		guint64 size = 42;
+		gboolean ret;
+
+		ret = j_dir_iterator_get_status(iterator, &modification_time, &size);
+		g_assert_true(ret);
+		g_assert_cmpint(modification_time, >, 0);
+		g_assert_cmpuint(size, ==, 0);
+
+		files++;
+	}
+
+	g_assert_cmpuint(files, ==, G_N_ELEMENTS(test_dir_files));
+	J_TEST_TRAP_END;
+}
+
 void
 test_core_dir_iterator(void)
 {
 	g_test_add_func("/core/dir-iterator/new_free", test_dir_iterator_new_free);
 	g_test_add("/core/dir-iterator/next_get", gchar*, NULL, test_dir_iterator_fixture_setup, test_dir_iterator_next_get, test_dir_iterator_fixture_teardown);
+	g_test_add("/core/dir-iterator/get_status", gchar*, NULL, test_dir_iterator_fixture_setup, test_dir_iterator_get_status, test_dir_iterator_fixture_teardown);
 }
@@ -88,6 +88,7 @@ test_distribution_distribute(JDistributionType type, JConfiguration** configurat
 			j_distribution_set(distribution, "index", 1);
 			break;
 		case J_DISTRIBUTION_WEIGHTED:
+		case J_DISTRIBUTION_ADAPTIVE:
 			j_distribution_set2(distribution, "weight", 0, 1);
 			j_distribution_set2(distribution, "weight", 1, 2);
 			break;
@@ -98,7 +99,7 @@ test_distribution_distribute(JDistributionType type, JConfiguration** configurat
 	ret = j_distribution_distribute(distribution, &index, &length, &offset, &block_id);
 	g_assert_true(ret);
 
-	if (type == J_DISTRIBUTION_WEIGHTED)
+	if (type == J_DISTRIBUTION_WEIGHTED || type == J_DISTRIBUTION_ADAPTIVE)
 	{
 		g_assert_cmpuint(index, ==, 0);
 	}
@@ -126,7 +127,7 @@ test_distribution_distribute(JDistributionType type, JConfiguration** configurat
 		g_assert_cmpuint(index, ==, 1);
 		g_assert_cmpuint(offset, ==, block_size);
 	}
-	else if (type == J_DISTRIBUTION_WEIGHTED)
+	else if (type == J_DISTRIBUTION_WEIGHTED || type == J_DISTRIBUTION_ADAPTIVE)
 	{
 		g_assert_cmpuint(index, ==, 1);
 		g_assert_cmpuint(offset, ==, 0);
@@ -146,7 +147,7 @@ test_distribution_distribute(JDistributionType type, JConfiguration** configurat
 	{
 		g_assert_cmpuint(offset, ==, 2 * block_size);
 	}
-	else if (type == J_DISTRIBUTION_WEIGHTED)
+	else if (type == J_DISTRIBUTION_WEIGHTED || type == J_DISTRIBUTION_ADAPTIVE)
 	{
 		g_assert_cmpuint(offset, ==, block_size);
 	}
@@ -166,7 +167,7 @@ test_distribution_distribute(JDistributionType type, JConfiguration** configurat
 		g_assert_cmpuint(index, ==, 1);
 		g_assert_cmpuint(offset, ==, 3 * block_size);
 	}
-	else if (type == J_DISTRIBUTION_WEIGHTED)
+	else if (type == J_DISTRIBUTION_WEIGHTED || type == J_DISTRIBUTION_ADAPTIVE)
 	{
 		g_assert_cmpuint(index, ==, 0);
 		g_assert_cmpuint(offset, ==, block_size);
@@ -186,7 +187,7 @@ test_distribution_distribute(JDistributionType type, JConfiguration** configurat
 	{
 		g_assert_cmpuint(offset, ==, 4 * block_size);
 	}
-	else if (type == J_DISTRIBUTION_WEIGHTED)
+	else if (type == J_DISTRIBUTION_WEIGHTED || type == J_DISTRIBUTION_ADAPTIVE)
 	{
 		g_assert_cmpuint(offset, ==, 2 * block_size);
 	}
@@ -195,6 +196,100 @@ test_distribution_distribute(JDistributionType type, JConfiguration** configurat
 	g_assert_true(!ret);
 }
 
+static void
+test_distribution_distribute_range(JDistributionType type, JConfiguration** configuration)
+{
+	g_autoptr(JDistribution) distribution = NULL;
+	guint64 block_size;
+	guint64 const ranges[][2] = {
+		{ 0, 0 },
+		{ 1, 0 },
+		{ 42, 42 },
+		{ 1, 3 * 4096 - 1 },
+		{ 10 * 4096, 0 },
+		{ 10 * 4096 + 42, 4096 - 1 },
+		{ 123 * 4096 + 17, 7 * 4096 + 4000 },
+	};
+
+	block_size = 4096;
+
+	distribution = j_distribution_new_for_configuration(type, *configuration);
+	j_distribution_set_block_size(distribution, block_size);
+
+	switch (type)
+	{
+		case J_DISTRIBUTION_ROUND_ROBIN:
+			j_distribution_set(distribution, "start-index", 1);
+			break;
+		case J_DISTRIBUTION_SINGLE_SERVER:
+			j_distribution_set(distribution, "index", 1);
+			break;
+		case J_DISTRIBUTION_WEIGHTED:
+		case J_DISTRIBUTION_ADAPTIVE:
+			j_distribution_set2(distribution, "weight", 0, 1);
+			j_distribution_set2(distribution, "weight", 1, 2);
+			break;
+		case J_DISTRIBUTION_ERASURE:
+			j_distribution_set(distribution, "start-index", 1);
+			break;
+		default:
+			g_warn_if_reached();
+	}
+
+	// The range variant has to return exactly the same chunks as the iterator.
+	for (guint i = 0; i < G_N_ELEMENTS(ranges); i++)
+	{
+		g_autoptr(GArray) chunks = NULL;
+		guint64 range_offset = 0;
+		guint64 block_id;
+		guint64 length;
+		guint64 offset;
+		guint count;
+		guint index;
+		guint j = 0;
+
+		chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+		count = j_distribution_distribute_range(distribution, ranges[i][0], ranges[i][1], chunks);
+		g_assert_cmpuint(count, ==, chunks->len);
+
+		j_distribution_reset(distribution, ranges[i][0], ranges[i][1]);
+
+		while (j_distribution_distribute(distribution, &index, &length, &offset, &block_id))
+		{
+			JDistributionChunk* chunk;
+
+			g_assert_cmpuint(j, <, chunks->len);
+
+			chunk = &g_array_index(chunks, JDistributionChunk, j);
+			g_assert_cmpuint(chunk->index, ==, index);
+			g_assert_cmpuint(chunk->length, ==, length);
+			g_assert_cmpuint(chunk->offset, ==, offset);
+			g_assert_cmpuint(chunk->block_id, ==, block_id);
+			g_assert_cmpuint(chunk->range_offset, ==, range_offset);
+
+			range_offset += length;
+			j++;
+		}
+
+		g_assert_cmpuint(j, ==, chunks->len);
+		g_assert_cmpuint(range_offset, ==, ranges[i][0]);
+	}
+}
+
+static void
+test_distribution_range(JConfiguration** configuration, gconstpointer data)
+{
+	(void)data;
+
+	J_TEST_TRAP_START;
+	test_distribution_distribute_range(J_DISTRIBUTION_ROUND_ROBIN, configuration);
+	test_distribution_distribute_range(J_DISTRIBUTION_SINGLE_SERVER, configuration);
+	test_distribution_distribute_range(J_DISTRIBUTION_WEIGHTED, configuration);
+	test_distribution_distribute_range(J_DISTRIBUTION_ADAPTIVE, configuration);
+	test_distribution_distribute_range(J_DISTRIBUTION_ERASURE, configuration);
+	J_TEST_TRAP_END;
+}
+
 static void
 test_distribution_round_robin(JConfiguration** configuration, gconstpointer data)
 {
@@ -219,10 +314,242 @@ test_distribution_weighted(JConfiguration** configuration, gconstpointer data)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_distribution_adaptive(JConfiguration** configuration, gconstpointer data)
+{
+	J_TEST_TRAP_START;
+	test_distribution_distribute(J_DISTRIBUTION_ADAPTIVE, configuration, data);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_distribution_adaptive_serialize(JConfiguration** configuration, gconstpointer data)
+{
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistribution) new_distribution = NULL;
+	g_autoptr(GArray) chunks = NULL;
+	g_autoptr(GArray) new_chunks = NULL;
+	bson_t* b;
+
+	(void)data;
+
+	J_TEST_TRAP_START;
+	distribution = j_distribution_new_for_configuration(J_DISTRIBUTION_ADAPTIVE, *configuration);
+	j_distribution_set_block_size(distribution, 4096);
+	j_distribution_set2(distribution, "weight", 0, 3);
+	j_distribution_set2(distribution, "weight", 1, 1);
+
+	b = j_distribution_serialize(distribution);
+
+	// The weights have to be restored from the serialization, so that the data can still be found.
+	new_distribution = j_distribution_new_for_configuration(J_DISTRIBUTION_ADAPTIVE, *configuration);
+	j_distribution_deserialize(new_distribution, b);
+
+	bson_destroy(b);
+
+	chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+	new_chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+
+	j_distribution_distribute_range(distribution, 64 * 4096, 42, chunks);
+	j_distribution_distribute_range(new_distribution, 64 * 4096, 42, new_chunks);
+
+	g_assert_cmpuint(chunks->len, ==, new_chunks->len);
+
+	for (guint i = 0; i < chunks->len; i++)
+	{
+		JDistributionChunk* chunk = &g_array_index(chunks, JDistributionChunk, i);
+		JDistributionChunk* new_chunk = &g_array_index(new_chunks, JDistributionChunk, i);
+
+		g_assert_cmpuint(chunk->index, ==, new_chunk->index);
+		g_assert_cmpuint(chunk->length, ==, new_chunk->length);
+		g_assert_cmpuint(chunk->offset, ==, new_chunk->offset);
+	}
+	J_TEST_TRAP_END;
+}
+
+static void
+test_distribution_erasure(JConfiguration** configuration, gconstpointer data)
+{
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistribution) new_distribution = NULL;
+	bson_t* b;
+	gboolean ret;
+	guint64 block_id;
+	guint64 block_size;
+	guint64 length;
+	guint64 offset;
+	guint32 data_blocks;
+	guint32 parity_blocks;
+	guint index;
+
+	(void)data;
+
+	J_TEST_TRAP_START;
+	distribution = j_distribution_new_for_configuration(J_DISTRIBUTION_ERASURE, *configuration);
+	j_distribution_set_block_size(distribution, 4096);
+	j_distribution_set(distribution, "start-index", 0);
+	j_distribution_set(distribution, "parity", 1);
+	j_distribution_set(distribution, "data", 1);
+
+	ret = j_distribution_get_erasure(distribution, &data_blocks, &parity_blocks, &block_size);
+	g_assert_true(ret);
+	g_assert_cmpuint(data_blocks, ==, 1);
+	g_assert_cmpuint(parity_blocks, ==, 1);
+	g_assert_cmpuint(block_size, ==, 4096);
+
+	j_distribution_reset(distribution, 4 * 4096, 0);
+
+	// With one data block per group, each block forms its own group and the groups alternate between both servers.
+	for (guint64 i = 0; i < 4; i++)
+	{
+		ret = j_distribution_distribute(distribution, &index, &length, &offset, &block_id);
+		g_assert_true(ret);
+		g_assert_cmpuint(index, ==, i % 2);
+		g_assert_cmpuint(length, ==, 4096);
+		g_assert_cmpuint(offset, ==, i * 4096);
+		g_assert_cmpuint(block_id, ==, i);
+
+		g_assert_cmpuint(j_distribution_get_group_index(distribution, i, 0), ==, index);
+		g_assert_cmpuint(j_distribution_get_group_index(distribution, i, 1), ==, (i + 1) % 2);
+	}
+
+	b = j_distribution_serialize(distribution);
+
+	new_distribution = j_distribution_new_for_configuration(J_DISTRIBUTION_ROUND_ROBIN, *configuration);
+	j_distribution_deserialize(new_distribution, b);
+
+	bson_destroy(b);
+
+	ret = j_distribution_get_erasure(new_distribution, &data_blocks, &parity_blocks, &block_size);
+	g_assert_true(ret);
+	g_assert_cmpuint(data_blocks, ==, 1);
+	g_assert_cmpuint(parity_blocks, ==, 1);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_distribution_stripe_count(JConfiguration** configuration, gconstpointer data)
+{
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(GArray) chunks = NULL;
+
+	(void)data;
+
+	J_TEST_TRAP_START;
+	distribution = j_distribution_new_for_configuration(J_DISTRIBUTION_ROUND_ROBIN, *configuration);
+	j_distribution_set_block_size(distribution, 4096);
+	j_distribution_set(distribution, "start-index", 1);
+	j_distribution_set(distribution, "stripe-count", 1);
+
+	chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+	j_distribution_distribute_range(distribution, 4 * 4096, 0, chunks);
+	g_assert_cmpuint(chunks->len, ==, 4);
+
+	// All blocks are stored contiguously on the start server.
+	for (guint i = 0; i < chunks->len; i++)
+	{
+		JDistributionChunk* chunk = &g_array_index(chunks, JDistributionChunk, i);
+
+		g_assert_cmpuint(chunk->index, ==, 1);
+		g_assert_cmpuint(chunk->offset, ==, i * 4096);
+	}
+	J_TEST_TRAP_END;
+}
+
+static void
+test_distribution_hint(JConfiguration** configuration, gconstpointer data)
+{
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(GArray) chunks = NULL;
+	bson_t* b;
+	bson_iter_t iterator;
+	guint64 stripe_size;
+	guint server_count;
+
+	(void)configuration;
+	(void)data;
+
+	J_TEST_TRAP_START;
+	stripe_size = j_configuration_get_stripe_size(j_configuration());
+	server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+
+	// Small objects are stored on a single server.
+	distribution = j_distribution_new_for_hint(1024, J_DISTRIBUTION_ACCESS_UNKNOWN);
+	b = j_distribution_serialize(distribution);
+	g_assert_true(bson_iter_init_find(&iterator, b, "type"));
+	g_assert_cmpint(bson_iter_int32(&iterator), ==, J_DISTRIBUTION_SINGLE_SERVER);
+	bson_destroy(b);
+	j_distribution_unref(distribution);
+
+	// Objects only span as many servers as they have stripes.
+	distribution = j_distribution_new_for_hint(2 * stripe_size, J_DISTRIBUTION_ACCESS_RANDOM);
+	chunks = g_array_new(FALSE, FALSE, sizeof(JDistributionChunk));
+	j_distribution_distribute_range(distribution, 8 * stripe_size, 0, chunks);
+	g_assert_cmpuint(chunks->len, ==, 8);
+
+	for (guint i = 0; i < chunks->len; i++)
+	{
+		JDistributionChunk* chunk = &g_array_index(chunks, JDistributionChunk, i);
+		JDistributionChunk* first = &g_array_index(chunks, JDistributionChunk, i % MIN(server_count, 2));
+
+		g_assert_cmpuint(chunk->length, ==, stripe_size);
+		g_assert_cmpuint(chunk->index, ==, first->index);
+	}
+
+	j_distribution_unref(distribution);
+
+	// Sequentially accessed objects never use smaller stripes.
+	distribution = j_distribution_new_for_hint(1024 * stripe_size, J_DISTRIBUTION_ACCESS_SEQUENTIAL);
+	g_array_set_size(chunks, 0);
+	j_distribution_distribute_range(distribution, stripe_size, 0, chunks);
+	g_assert_cmpuint(chunks->len, ==, 1);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_distribution_replicas(JConfiguration** configuration, gconstpointer data)
+{
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistribution) new_distribution = NULL;
+	bson_t* b;
+
+	(void)data;
+
+	J_TEST_TRAP_START;
+	distribution = j_distribution_new_for_configuration(J_DISTRIBUTION_ROUND_ROBIN, *configuration);
+	g_assert_cmpuint(j_distribution_get_replicas(distribution), ==, 1);
+	g_assert_cmpuint(j_distribution_get_replica_index(distribution, 1, 0), ==, 1);
+
+	j_distribution_set(distribution, "replicas", 2);
+	g_assert_cmpuint(j_distribution_get_replicas(distribution), ==, 2);
+
+	// Each copy has to be stored on a different server.
+	g_assert_cmpuint(j_distribution_get_replica_index(distribution, 0, 0), ==, 0);
+	g_assert_cmpuint(j_distribution_get_replica_index(distribution, 0, 1), ==, 1);
+	g_assert_cmpuint(j_distribution_get_replica_index(distribution, 1, 0), ==, 1);
+	g_assert_cmpuint(j_distribution_get_replica_index(distribution, 1, 1), ==, 0);
+
+	b = j_distribution_serialize(distribution);
+
+	new_distribution = j_distribution_new_for_configuration(J_DISTRIBUTION_ROUND_ROBIN, *configuration);
+	j_distribution_deserialize(new_distribution, b);
+	g_assert_cmpuint(j_distribution_get_replicas(new_distribution), ==, 2);
+
+	bson_destroy(b);
+	J_TEST_TRAP_END;
+}
+
 void
 test_core_distribution(void)
 {
 	g_test_add("/core/distribution/round_robin", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_round_robin, test_distribution_fixture_teardown);
 	g_test_add("/core/distribution/single_server", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_single_server, test_distribution_fixture_teardown);
 	g_test_add("/core/distribution/weighted", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_weighted, test_distribution_fixture_teardown);
+	g_test_add("/core/distribution/adaptive", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_adaptive, test_distribution_fixture_teardown);
+	g_test_add("/core/distribution/adaptive_serialize", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_adaptive_serialize, test_distribution_fixture_teardown);
+	g_test_add("/core/distribution/range", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_range, test_distribution_fixture_teardown);
+	g_test_add("/core/distribution/erasure", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_erasure, test_distribution_fixture_teardown);
+	g_test_add("/core/distribution/stripe_count", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_stripe_count, test_distribution_fixture_teardown);
+	g_test_add("/core/distribution/hint", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_hint, test_distribution_fixture_teardown);
+	g_test_add("/core/distribution/replicas", JConfiguration*, NULL, test_distribution_fixture_setup, test_distribution_replicas, test_distribution_fixture_teardown);
 }
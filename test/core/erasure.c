@@ -0,0 +1,180 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <julea-config.h>
+
+#include <glib.h>
+
+#include <string.h>
+
+#include <julea.h>
+
+#include "test.h"
+
+static void
+test_erasure_new_ref_unref(void)
+{
+	JErasure* erasure;
+
+	J_TEST_TRAP_START;
+	erasure = j_erasure_new(4, 2);
+	g_assert_true(erasure != NULL);
+	j_erasure_ref(erasure);
+	j_erasure_unref(erasure);
+	j_erasure_unref(erasure);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_erasure_xor(void)
+{
+	g_autoptr(JErasure) erasure = NULL;
+	gchar data[3][100];
+	gchar parity[100];
+	gconstpointer data_blocks[3];
+	gpointer parity_blocks[1];
+
+	J_TEST_TRAP_START;
+	erasure = j_erasure_new(3, 1);
+
+	for (guint i = 0; i < 3; i++)
+	{
+		for (guint j = 0; j < 100; j++)
+		{
+			data[i][j] = g_random_int();
+		}
+
+		data_blocks[i] = data[i];
+	}
+
+	parity_blocks[0] = parity;
+	j_erasure_encode(erasure, data_blocks, parity_blocks, 100);
+
+	// A single parity block is the XOR of all data blocks.
+	for (guint j = 0; j < 100; j++)
+	{
+		g_assert_cmpint(parity[j], ==, data[0][j] ^ data[1][j] ^ data[2][j]);
+	}
+	J_TEST_TRAP_END;
+}
+
+static void
+test_erasure_decode(void)
+{
+	guint32 const data_count = 4;
+	guint32 const parity_count = 2;
+	// Not a multiple of the vector size to also cover the remainder.
+	gsize const length = 4099;
+
+	g_autoptr(JErasure) erasure = NULL;
+	gchar* blocks[6];
+	gchar* original[6];
+
+	J_TEST_TRAP_START;
+	erasure = j_erasure_new(data_count, parity_count);
+
+	for (guint i = 0; i < data_count + parity_count; i++)
+	{
+		blocks[i] = g_malloc(length);
+		original[i] = g_malloc(length);
+	}
+
+	for (guint i = 0; i < data_count; i++)
+	{
+		for (gsize j = 0; j < length; j++)
+		{
+			blocks[i][j] = g_random_int();
+		}
+	}
+
+	j_erasure_encode(erasure, (gconstpointer const*)blocks, (gpointer*)(blocks + data_count), length);
+
+	for (guint i = 0; i < data_count + parity_count; i++)
+	{
+		memcpy(original[i], blocks[i], length);
+	}
+
+	// Lose every combination of up to two blocks.
+	for (guint i = 0; i < data_count + parity_count; i++)
+	{
+		for (guint j = i; j < data_count + parity_count; j++)
+		{
+			gboolean present[6];
+			gboolean ret;
+
+			for (guint l = 0; l < data_count + parity_count; l++)
+			{
+				present[l] = (l != i && l != j);
+
+				if (!present[l])
+				{
+					memset(blocks[l], 0, length);
+				}
+			}
+
+			ret = j_erasure_decode(erasure, (gpointer*)blocks, present, length);
+			g_assert_true(ret);
+
+			for (guint l = 0; l < data_count + parity_count; l++)
+			{
+				g_assert_cmpmem(blocks[l], length, original[l], length);
+			}
+		}
+	}
+
+	for (guint i = 0; i < data_count + parity_count; i++)
+	{
+		g_free(blocks[i]);
+		g_free(original[i]);
+	}
+	J_TEST_TRAP_END;
+}
+
+static void
+test_erasure_decode_fail(void)
+{
+	g_autoptr(JErasure) erasure = NULL;
+	gchar blocks[4][16];
+	gpointer block_pointers[4];
+	gboolean present[4] = { FALSE, FALSE, TRUE, TRUE };
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	erasure = j_erasure_new(3, 1);
+
+	for (guint i = 0; i < 4; i++)
+	{
+		block_pointers[i] = blocks[i];
+	}
+
+	memset(blocks, 0, sizeof(blocks));
+
+	// Two blocks cannot be reconstructed with a single parity block.
+	ret = j_erasure_decode(erasure, block_pointers, present, 16);
+	g_assert_false(ret);
+	J_TEST_TRAP_END;
+}
+
+void
+test_core_erasure(void)
+{
+	g_test_add_func("/core/erasure/new_ref_unref", test_erasure_new_ref_unref);
+	g_test_add_func("/core/erasure/xor", test_erasure_xor);
+	g_test_add_func("/core/erasure/decode", test_erasure_decode);
+	g_test_add_func("/core/erasure/decode_fail", test_erasure_decode_fail);
+}
@@ -0,0 +1,203 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <julea-config.h>
+
+#include <glib.h>
+
+#include <julea.h>
+
+#include <jhash-ring.h>
+
+#include "test.h"
+
+static void
+test_hash_ring_new_ref_unref(void)
+{
+	JHashRing* ring;
+
+	J_TEST_TRAP_START;
+	ring = j_hash_ring_new(16);
+	g_assert_true(ring != NULL);
+	j_hash_ring_ref(ring);
+	j_hash_ring_unref(ring);
+	j_hash_ring_unref(ring);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_hash_ring_get(void)
+{
+	g_autoptr(JHashRing) ring = NULL;
+	guint counts[4] = { 0, 0, 0, 0 };
+
+	J_TEST_TRAP_START;
+	ring = j_hash_ring_new(128);
+	j_hash_ring_add(ring, "server0", 0, 1);
+	j_hash_ring_add(ring, "server1", 1, 1);
+	j_hash_ring_add(ring, "server2", 2, 1);
+	j_hash_ring_add(ring, "server3", 3, 1);
+
+	for (guint i = 0; i < 10000; i++)
+	{
+		g_autofree gchar* key = NULL;
+		guint32 index;
+
+		key = g_strdup_printf("key-%u", i);
+		index = j_hash_ring_get(ring, key);
+
+		g_assert_cmpuint(index, <, 4);
+		g_assert_cmpuint(index, ==, j_hash_ring_get(ring, key));
+
+		counts[index]++;
+	}
+
+	for (guint i = 0; i < 4; i++)
+	{
+		// Each server should get roughly a quarter of the keys.
+		g_assert_cmpuint(counts[i], >, 1500);
+		g_assert_cmpuint(counts[i], <, 3500);
+	}
+	J_TEST_TRAP_END;
+}
+
+static void
+test_hash_ring_add(void)
+{
+	g_autoptr(JHashRing) ring = NULL;
+	g_autoptr(JHashRing) new_ring = NULL;
+	guint moved = 0;
+
+	J_TEST_TRAP_START;
+	ring = j_hash_ring_new(128);
+	new_ring = j_hash_ring_new(128);
+
+	for (guint i = 0; i < 4; i++)
+	{
+		g_autofree gchar* name = NULL;
+
+		name = g_strdup_printf("server%u", i);
+		j_hash_ring_add(ring, name, i, 1);
+		j_hash_ring_add(new_ring, name, i, 1);
+	}
+
+	j_hash_ring_add(new_ring, "server4", 4, 1);
+
+	for (guint i = 0; i < 10000; i++)
+	{
+		g_autofree gchar* key = NULL;
+		guint32 index;
+		guint32 new_index;
+
+		key = g_strdup_printf("key-%u", i);
+		index = j_hash_ring_get(ring, key);
+		new_index = j_hash_ring_get(new_ring, key);
+
+		// Keys must only move to the new server.
+		if (index != new_index)
+		{
+			g_assert_cmpuint(new_index, ==, 4);
+			moved++;
+		}
+	}
+
+	// Roughly a fifth of the keys should have moved.
+	g_assert_cmpuint(moved, >, 1000);
+	g_assert_cmpuint(moved, <, 3000);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_hash_ring_weight(void)
+{
+	g_autoptr(JHashRing) ring = NULL;
+	guint counts[3] = { 0, 0, 0 };
+
+	J_TEST_TRAP_START;
+	ring = j_hash_ring_new(128);
+	j_hash_ring_add(ring, "server0", 0, 1);
+	j_hash_ring_add(ring, "server1", 1, 3);
+	j_hash_ring_add(ring, "server2", 2, 0);
+
+	for (guint i = 0; i < 10000; i++)
+	{
+		g_autofree gchar* key = NULL;
+
+		key = g_strdup_printf("key-%u", i);
+		counts[j_hash_ring_get(ring, key)]++;
+	}
+
+	g_assert_cmpuint(counts[0], <, counts[1]);
+	g_assert_cmpuint(counts[2], ==, 0);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_hash_ring_configuration(void)
+{
+	g_autoptr(JConfiguration) configuration = NULL;
+	g_autoptr(GKeyFile) key_file = NULL;
+	gchar const* servers[] = { "localhost", "localhost", "local.host", NULL };
+	gint const weights[] = { 1, 0, 1 };
+
+	J_TEST_TRAP_START;
+	key_file = g_key_file_new();
+	g_key_file_set_string(key_file, "clients", "placement", "ring");
+	g_key_file_set_integer(key_file, "clients", "virtual-nodes", 64);
+	g_key_file_set_string_list(key_file, "servers", "object", servers, 3);
+	g_key_file_set_string_list(key_file, "servers", "kv", servers, 3);
+	g_key_file_set_string_list(key_file, "servers", "db", servers, 3);
+	g_key_file_set_integer_list(key_file, "servers", "kv-weights", (gint*)weights, 3);
+	g_key_file_set_string(key_file, "object", "backend", "null");
+	g_key_file_set_string(key_file, "object", "component", "server");
+	g_key_file_set_string(key_file, "object", "path", "");
+	g_key_file_set_string(key_file, "kv", "backend", "null");
+	g_key_file_set_string(key_file, "kv", "component", "server");
+	g_key_file_set_string(key_file, "kv", "path", "");
+	g_key_file_set_string(key_file, "db", "backend", "null");
+	g_key_file_set_string(key_file, "db", "component", "server");
+	g_key_file_set_string(key_file, "db", "path", "");
+
+	configuration = j_configuration_new_for_data(key_file);
+	g_assert_true(configuration != NULL);
+
+	g_assert_cmpuint(j_configuration_get_virtual_nodes(configuration), ==, 64);
+	g_assert_cmpuint(j_configuration_get_server_weight(configuration, J_BACKEND_TYPE_KV, 1), ==, 0);
+	g_assert_cmpuint(j_configuration_get_server_weight(configuration, J_BACKEND_TYPE_OBJECT, 1), ==, 1);
+
+	for (guint i = 0; i < 1000; i++)
+	{
+		g_autofree gchar* key = NULL;
+
+		key = g_strdup_printf("key-%u", i);
+
+		g_assert_cmpuint(j_configuration_get_server_index(configuration, J_BACKEND_TYPE_OBJECT, key), <, 3);
+		g_assert_cmpuint(j_configuration_get_server_index(configuration, J_BACKEND_TYPE_KV, key), !=, 1);
+	}
+	J_TEST_TRAP_END;
+}
+
+void
+test_core_hash_ring(void)
+{
+	g_test_add_func("/core/hash-ring/new_ref_unref", test_hash_ring_new_ref_unref);
+	g_test_add_func("/core/hash-ring/get", test_hash_ring_get);
+	g_test_add_func("/core/hash-ring/add", test_hash_ring_add);
+	g_test_add_func("/core/hash-ring/weight", test_hash_ring_weight);
+	g_test_add_func("/core/hash-ring/configuration", test_hash_ring_configuration);
+}
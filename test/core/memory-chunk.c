@@ -86,10 +86,45 @@ test_memory_chunk_reset(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_memory_chunk_align(void)
+{
+	JMemoryChunk* memory_chunk;
+	gpointer ret;
+
+	J_TEST_TRAP_START;
+	memory_chunk = j_memory_chunk_new(3 * J_MEMORY_CHUNK_ALIGNMENT);
+
+	ret = j_memory_chunk_get(memory_chunk, 1);
+	g_assert_true(ret != NULL);
+	g_assert_cmpuint(GPOINTER_TO_SIZE(ret) % J_MEMORY_CHUNK_ALIGNMENT, ==, 0);
+
+	// Small segments are packed.
+	ret = j_memory_chunk_get(memory_chunk, 1);
+	g_assert_true(ret != NULL);
+	g_assert_cmpuint(GPOINTER_TO_SIZE(ret) % J_MEMORY_CHUNK_ALIGNMENT, ==, 1);
+
+	ret = j_memory_chunk_get(memory_chunk, J_MEMORY_CHUNK_ALIGNMENT);
+	g_assert_true(ret != NULL);
+	g_assert_cmpuint(GPOINTER_TO_SIZE(ret) % J_MEMORY_CHUNK_ALIGNMENT, ==, 0);
+
+	// The padding does not fit anymore.
+	ret = j_memory_chunk_get(memory_chunk, J_MEMORY_CHUNK_ALIGNMENT + 1);
+	g_assert_true(ret == NULL);
+
+	ret = j_memory_chunk_get(memory_chunk, J_MEMORY_CHUNK_ALIGNMENT);
+	g_assert_true(ret != NULL);
+	g_assert_cmpuint(GPOINTER_TO_SIZE(ret) % J_MEMORY_CHUNK_ALIGNMENT, ==, 0);
+
+	j_memory_chunk_free(memory_chunk);
+	J_TEST_TRAP_END;
+}
+
 void
 test_core_memory_chunk(void)
 {
 	g_test_add_func("/core/memory-chunk/new_free", test_memory_chunk_new_free);
 	g_test_add_func("/core/memory-chunk/get", test_memory_chunk_get);
 	g_test_add_func("/core/memory-chunk/reset", test_memory_chunk_reset);
+	g_test_add_func("/core/memory-chunk/align", test_memory_chunk_align);
 }
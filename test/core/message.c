@@ -176,6 +176,53 @@ test_message_write_read(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_message_send_full_free(gpointer data)
+{
+	guint* count = data;
+
+	(*count)++;
+}
+
+static void
+test_message_send_full(void)
+{
+	g_autoptr(GOutputStream) output = NULL;
+	JMessage* message;
+	gchar const* data = "mapped";
+	gchar const* written;
+	gsize written_len;
+	gboolean ret;
+	guint count = 0;
+	guint64 dummy = 42;
+
+	J_TEST_TRAP_START;
+	output = g_memory_output_stream_new(NULL, 0, g_realloc, g_free);
+
+	message = j_message_new(J_MESSAGE_NONE, sizeof(dummy));
+	g_assert_true(message != NULL);
+
+	ret = j_message_append_8(message, &dummy);
+	g_assert_true(ret);
+
+	j_message_add_send_full(message, data, strlen(data), test_message_send_full_free, &count);
+
+	ret = j_message_write(message, output);
+	g_assert_true(ret);
+
+	// The data is sent after the message itself.
+	written = g_memory_output_stream_get_data(G_MEMORY_OUTPUT_STREAM(output));
+	written_len = g_memory_output_stream_get_data_size(G_MEMORY_OUTPUT_STREAM(output));
+	g_assert_cmpuint(written_len, >, strlen(data) + sizeof(dummy));
+	g_assert_cmpmem(written + written_len - strlen(data), strlen(data), data, strlen(data));
+
+	// The data is only released together with the message.
+	g_assert_cmpuint(count, ==, 0);
+	j_message_unref(message);
+	g_assert_cmpuint(count, ==, 1);
+	J_TEST_TRAP_END;
+}
+
 static void
 test_message_semantics(void)
 {
@@ -208,5 +255,6 @@ test_core_message(void)
 	g_test_add_func("/core/message/header", test_message_header);
 	g_test_add_func("/core/message/append", test_message_append);
 	g_test_add_func("/core/message/write_read", test_message_write_read);
+	g_test_add_func("/core/message/send_full", test_message_send_full);
 	g_test_add_func("/core/message/semantics", test_message_semantics);
 }
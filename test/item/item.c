@@ -20,6 +20,8 @@
 
 #include <glib.h>
 
+#include <string.h>
+
 #include <julea.h>
 #include <julea-item.h>
 
@@ -111,10 +113,67 @@ test_item_modification_time(JItem** item, gconstpointer data)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_item_copy(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JCollection) collection = NULL;
+	JItem* item;
+	JItem* copy;
+	gchar data[42];
+	gchar buffer[42];
+	guint64 bytes_copied = 0;
+	guint64 nbytes = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	memset(data, 23, sizeof(data));
+
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	collection = j_collection_create("test-collection-copy", batch);
+	item = j_item_create(collection, "test-item", NULL, batch);
+	j_item_write(item, data, sizeof(data), 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	copy = j_item_copy(item, collection, "test-item-copy", &bytes_copied, batch);
+	g_assert_true(copy != NULL);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(bytes_copied, ==, sizeof(data));
+
+	// Both items have to own their distribution.
+	j_item_unref(item);
+
+	nbytes = 0;
+	memset(buffer, 0, sizeof(buffer));
+	j_item_read(copy, buffer, sizeof(buffer), 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, sizeof(buffer));
+	g_assert_cmpmem(buffer, sizeof(buffer), data, sizeof(data));
+
+	j_item_delete(copy, batch);
+	j_item_get(collection, &item, "test-item", batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_item_unref(copy);
+
+	j_item_delete(item, batch);
+	j_collection_delete(collection, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_item_unref(item);
+	J_TEST_TRAP_END;
+}
+
 void
 test_item_item(void)
 {
 	g_test_add_func("/item/item/new_free", test_item_new_free);
+	g_test_add_func("/item/item/copy", test_item_copy);
 	g_test_add("/item/item/ref_unref", JItem*, NULL, test_item_fixture_setup, test_item_ref_unref, test_item_fixture_teardown);
 	g_test_add("/item/item/name", JItem*, NULL, test_item_fixture_setup, test_item_name, test_item_fixture_teardown);
 	g_test_add("/item/item/size", JItem*, NULL, test_item_fixture_setup, test_item_size, test_item_fixture_teardown);
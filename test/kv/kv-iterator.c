@@ -184,9 +184,433 @@ test_kv_iterator_next_get(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_kv_iterator_delete_by_prefix(void)
+{
+	guint const n = 1000;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JKVIterator) kv_iterator = NULL;
+	g_autoptr(JKVIterator) kv_iterator_all = NULL;
+	gboolean ret;
+
+	guint kvs = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	for (guint i = 0; i < n; i++)
+	{
+		g_autoptr(JKV) kv = NULL;
+
+		g_autofree gchar* key = NULL;
+		gchar* value = NULL;
+
+		key = g_strdup_printf("test-key-delete-by-prefix-%d-%d", i % 2, i);
+		value = g_strdup_printf("test-value-%d", i);
+		kv = j_kv_new("test-ns-delete-by-prefix", key);
+		j_kv_put(kv, value, strlen(value) + 1, g_free, batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_kv_delete_by_prefix("test-ns-delete-by-prefix", "test-key-delete-by-prefix-1-", batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	kv_iterator = j_kv_iterator_new("test-ns-delete-by-prefix", NULL);
+
+	while (j_kv_iterator_next(kv_iterator))
+	{
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		key = j_kv_iterator_get(kv_iterator, &value, &len);
+		g_assert_true(g_str_has_prefix(key, "test-key-delete-by-prefix-0-"));
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, n / 2);
+
+	j_kv_delete_by_prefix("test-ns-delete-by-prefix", NULL, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	kv_iterator_all = j_kv_iterator_new("test-ns-delete-by-prefix", NULL);
+	g_assert_false(j_kv_iterator_next(kv_iterator_all));
+	J_TEST_TRAP_END;
+}
+
+static void
+test_kv_iterator_pages(void)
+{
+	guint const n = 5000;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JBatch) delete_batch = NULL;
+	g_autoptr(JKVIterator) kv_iterator = NULL;
+	gboolean ret;
+
+	guint kvs = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	delete_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	for (guint i = 0; i < n; i++)
+	{
+		g_autoptr(JKV) kv = NULL;
+
+		g_autofree gchar* key = NULL;
+		gchar* value = NULL;
+
+		key = g_strdup_printf("test-key-pages-%d", i);
+		value = g_strdup_printf("test-value-%d", i);
+		kv = j_kv_new("test-ns-pages", key);
+		j_kv_put(kv, value, strlen(value) + 1, g_free, batch);
+		j_kv_delete(kv, delete_batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	// Stop early, which releases the servers' cursors.
+	for (guint i = 0; i < 10; i++)
+	{
+		g_autoptr(JKVIterator) iterator = NULL;
+
+		iterator = j_kv_iterator_new("test-ns-pages", NULL);
+
+		for (guint j = 0; j < i * 100; j++)
+		{
+			ret = j_kv_iterator_next(iterator);
+			g_assert_true(ret);
+		}
+	}
+
+	kv_iterator = j_kv_iterator_new("test-ns-pages", NULL);
+
+	while (j_kv_iterator_next(kv_iterator))
+	{
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		key = j_kv_iterator_get(kv_iterator, &value, &len);
+		g_assert_true(g_str_has_prefix(key, "test-key-pages-"));
+		g_assert_true(g_str_has_prefix(value, "test-value-"));
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, n);
+
+	ret = j_batch_execute(delete_batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_kv_iterator_range(void)
+{
+	guint const n = 2000;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JBatch) delete_batch = NULL;
+	g_autoptr(JKVIterator) kv_iterator = NULL;
+	g_autoptr(JKVIterator) kv_iterator_reverse = NULL;
+	g_autoptr(JKVIterator) kv_iterator_all = NULL;
+	g_autofree gchar* last = NULL;
+	gboolean ret;
+
+	guint kvs = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	delete_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	for (guint i = 0; i < n; i++)
+	{
+		g_autoptr(JKV) kv = NULL;
+
+		g_autofree gchar* key = NULL;
+		gchar* value = NULL;
+
+		key = g_strdup_printf("test-key-range-%04d", i);
+		value = g_strdup_printf("test-value-%d", i);
+		kv = j_kv_new("test-ns-range", key);
+		j_kv_put(kv, value, strlen(value) + 1, g_free, batch);
+		j_kv_delete(kv, delete_batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	// The start is inclusive, the end is exclusive.
+	kv_iterator = j_kv_iterator_new_range("test-ns-range", "test-key-range-0500", "test-key-range-1500", 0, FALSE);
+
+	while (j_kv_iterator_next(kv_iterator))
+	{
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		key = j_kv_iterator_get(kv_iterator, &value, &len);
+		g_assert_cmpstr(key, >=, "test-key-range-0500");
+		g_assert_cmpstr(key, <, "test-key-range-1500");
+
+		if (last != NULL)
+		{
+			g_assert_cmpstr(last, <, key);
+		}
+
+		g_free(last);
+		last = g_strdup(key);
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, 1000);
+
+	kv_iterator_reverse = j_kv_iterator_new_range("test-ns-range", NULL, NULL, 10, TRUE);
+
+	for (guint i = 0; i < 10; i++)
+	{
+		g_autofree gchar* expected = NULL;
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		ret = j_kv_iterator_next(kv_iterator_reverse);
+		g_assert_true(ret);
+
+		expected = g_strdup_printf("test-key-range-%04d", n - 1 - i);
+		key = j_kv_iterator_get(kv_iterator_reverse, &value, &len);
+		g_assert_cmpstr(key, ==, expected);
+	}
+
+	g_assert_false(j_kv_iterator_next(kv_iterator_reverse));
+
+	kvs = 0;
+	kv_iterator_all = j_kv_iterator_new_range("test-ns-range", NULL, NULL, 0, FALSE);
+
+	while (j_kv_iterator_next(kv_iterator_all))
+	{
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, n);
+
+	ret = j_batch_execute(delete_batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_kv_iterator_range_bytewise(void)
+{
+	// Ordered bytewise, a collation would place the lowercase and non-ASCII keys differently.
+	gchar const* keys[] = { "A", "B", "Z-key", "a", "a-b", "a_b", "b", "\xc3\xa4" };
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JBatch) delete_batch = NULL;
+	g_autoptr(JKVIterator) kv_iterator = NULL;
+	g_autoptr(JKVIterator) kv_iterator_reverse = NULL;
+	g_autoptr(JKVIterator) kv_iterator_bounded = NULL;
+	gboolean ret;
+
+	guint kvs = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	delete_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	// The keys are spread across all servers, so the iterator has to merge their ranges.
+	for (guint i = 0; i < G_N_ELEMENTS(keys); i++)
+	{
+		g_autoptr(JKV) kv = NULL;
+
+		kv = j_kv_new("test-ns-range-bytewise", keys[i]);
+		j_kv_put(kv, g_strdup(keys[i]), strlen(keys[i]) + 1, g_free, batch);
+		j_kv_delete(kv, delete_batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	kv_iterator = j_kv_iterator_new_range("test-ns-range-bytewise", NULL, NULL, 0, FALSE);
+
+	while (j_kv_iterator_next(kv_iterator))
+	{
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		g_assert_cmpuint(kvs, <, G_N_ELEMENTS(keys));
+
+		key = j_kv_iterator_get(kv_iterator, &value, &len);
+		g_assert_cmpstr(key, ==, keys[kvs]);
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, G_N_ELEMENTS(keys));
+
+	kvs = 0;
+	kv_iterator_reverse = j_kv_iterator_new_range("test-ns-range-bytewise", NULL, NULL, 0, TRUE);
+
+	while (j_kv_iterator_next(kv_iterator_reverse))
+	{
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		g_assert_cmpuint(kvs, <, G_N_ELEMENTS(keys));
+
+		key = j_kv_iterator_get(kv_iterator_reverse, &value, &len);
+		g_assert_cmpstr(key, ==, keys[G_N_ELEMENTS(keys) - 1 - kvs]);
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, G_N_ELEMENTS(keys));
+
+	// The bounds are compared bytewise, too.
+	kvs = 0;
+	kv_iterator_bounded = j_kv_iterator_new_range("test-ns-range-bytewise", "Z", "b", 0, FALSE);
+
+	while (j_kv_iterator_next(kv_iterator_bounded))
+	{
+		gchar const* key;
+		gconstpointer value;
+		guint32 len;
+
+		g_assert_cmpuint(kvs, <, 4);
+
+		key = j_kv_iterator_get(kv_iterator_bounded, &value, &len);
+		g_assert_cmpstr(key, ==, keys[2 + kvs]);
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, 4);
+
+	ret = j_batch_execute(delete_batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_kv_iterator_updates(void)
+{
+	guint const n = 10;
+	guint const m = 64;
+	guint32 const value_len = 256 * 1024;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JBatch) delete_batch = NULL;
+	g_autoptr(JKVIterator) kv_iterator = NULL;
+	g_autoptr(JKV) kv_cas = NULL;
+	g_autoptr(JKV) kv_counter = NULL;
+	g_autoptr(JKV) kv_log = NULL;
+	g_autofree gpointer counter = NULL;
+	g_autofree gpointer log = NULL;
+	gint64 value;
+	guint32 len;
+	gboolean swapped = FALSE;
+	gboolean ret;
+
+	guint kvs = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	delete_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	for (guint i = 0; i < n; i++)
+	{
+		g_autoptr(JKV) kv = NULL;
+
+		g_autofree gchar* key = NULL;
+
+		key = g_strdup_printf("test-key-updates-%d", i);
+		kv = j_kv_new("test-ns-updates", key);
+		j_kv_put(kv, g_strdup(key), strlen(key) + 1, g_free, batch);
+		j_kv_delete(kv, delete_batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	kv_iterator = j_kv_iterator_new("test-ns-updates", NULL);
+	g_assert_true(j_kv_iterator_next(kv_iterator));
+	kvs++;
+
+	// Open iterators must not block modifications, even if they require the backend to grow its storage.
+	kv_cas = j_kv_new("test-ns-updates-modified", "test-key-cas");
+	kv_counter = j_kv_new("test-ns-updates-modified", "test-key-add");
+	kv_log = j_kv_new("test-ns-updates-modified", "test-key-append");
+
+	j_kv_compare_and_swap(kv_cas, NULL, 0, g_strdup("value"), 6, g_free, &swapped, batch);
+	j_kv_add(kv_counter, 42, batch);
+	j_kv_append(kv_log, (gpointer) "ab", 2, NULL, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_true(swapped);
+
+	for (guint i = 0; i < m; i++)
+	{
+		g_autoptr(JKV) kv = NULL;
+
+		g_autofree gchar* key = NULL;
+
+		key = g_strdup_printf("test-key-updates-large-%d", i);
+		kv = j_kv_new("test-ns-updates-modified", key);
+		j_kv_put(kv, g_malloc0(value_len), value_len, g_free, batch);
+		j_kv_delete(kv, delete_batch);
+
+		// Batches are kept small, so that they do not exceed the servers' operation size.
+		if (i % 8 == 7)
+		{
+			ret = j_batch_execute(batch);
+			g_assert_true(ret);
+		}
+	}
+
+	j_kv_get(kv_counter, &counter, &len, batch);
+	j_kv_get(kv_log, &log, &len, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	memcpy(&value, counter, sizeof(value));
+	g_assert_cmpint(GINT64_FROM_LE(value), ==, 42);
+	g_assert_cmpmem(log, len, "ab", 2);
+
+	while (j_kv_iterator_next(kv_iterator))
+	{
+		gchar const* key;
+		gconstpointer iterator_value;
+		guint32 iterator_len;
+
+		key = j_kv_iterator_get(kv_iterator, &iterator_value, &iterator_len);
+		g_assert_true(g_str_has_prefix(key, "test-key-updates-"));
+		kvs++;
+	}
+
+	g_assert_cmpuint(kvs, ==, n);
+
+	j_kv_delete(kv_cas, delete_batch);
+	j_kv_delete(kv_counter, delete_batch);
+	j_kv_delete(kv_log, delete_batch);
+	ret = j_batch_execute(delete_batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
 void
 test_kv_kv_iterator(void)
 {
 	g_test_add_func("/kv/kv-iterator/new_free", test_kv_iterator_new_free);
 	g_test_add_func("/kv/kv-iterator/next_get", test_kv_iterator_next_get);
+	g_test_add_func("/kv/kv-iterator/delete_by_prefix", test_kv_iterator_delete_by_prefix);
+	g_test_add_func("/kv/kv-iterator/pages", test_kv_iterator_pages);
+	g_test_add_func("/kv/kv-iterator/range", test_kv_iterator_range);
+	g_test_add_func("/kv/kv-iterator/range_bytewise", test_kv_iterator_range_bytewise);
+	g_test_add_func("/kv/kv-iterator/updates", test_kv_iterator_updates);
 }
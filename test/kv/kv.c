@@ -159,7 +159,7 @@ test_kv_get(void)
 	g_assert_false(ret);
 
 	g_assert_null(get_value);
-	g_assert_cmpuint(get_len, ==, 42);
+	g_assert_cmpuint(get_len, ==, 0);
 
 	j_kv_put(kv, value, strlen(value) + 1, NULL, batch);
 	ret = j_batch_execute(batch);
@@ -227,6 +227,224 @@ test_kv_get_callback(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_kv_get_view(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JKV) kv1 = NULL;
+	g_autoptr(JKV) kv2 = NULL;
+	g_autoptr(GBytes) view1 = NULL;
+	g_autoptr(GBytes) view2 = NULL;
+	g_autofree gchar* value1 = NULL;
+	g_autofree gchar* value2 = NULL;
+	gconstpointer data;
+	gsize len;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	value1 = g_strdup("first-value");
+	value2 = g_strdup("second-value");
+
+	kv1 = j_kv_new("test", "test-kv-get-view-1");
+	kv2 = j_kv_new("test", "test-kv-get-view-2");
+
+	j_kv_get_view(kv1, &view1, batch);
+	ret = j_batch_execute(batch);
+	g_assert_false(ret);
+	g_assert_null(view1);
+
+	j_kv_put(kv1, value1, strlen(value1) + 1, NULL, batch);
+	j_kv_put(kv2, value2, strlen(value2) + 1, NULL, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_kv_get_view(kv1, &view1, batch);
+	j_kv_get_view(kv2, &view2, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	data = g_bytes_get_data(view1, &len);
+	g_assert_cmpstr(data, ==, value1);
+	g_assert_cmpuint(len, ==, strlen(value1) + 1);
+
+	data = g_bytes_get_data(view2, &len);
+	g_assert_cmpstr(data, ==, value2);
+	g_assert_cmpuint(len, ==, strlen(value2) + 1);
+
+	j_kv_delete(kv1, batch);
+	j_kv_delete(kv2, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_kv_compare_and_swap(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JKV) kv = NULL;
+	g_autofree gchar* value = NULL;
+	guint32 len;
+	gboolean swapped;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	kv = j_kv_new("test", "test-kv-compare-and-swap");
+
+	// Without an expected value, the key-value pair is only created if it does not exist.
+	j_kv_compare_and_swap(kv, NULL, 0, g_strdup("first"), 6, g_free, &swapped, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_true(swapped);
+
+	j_kv_compare_and_swap(kv, NULL, 0, g_strdup("other"), 6, g_free, &swapped, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_false(swapped);
+
+	j_kv_compare_and_swap(kv, "wrong", 6, g_strdup("other"), 6, g_free, &swapped, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_false(swapped);
+
+	j_kv_compare_and_swap(kv, "first", 6, g_strdup("second"), 7, g_free, &swapped, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_true(swapped);
+
+	j_kv_get(kv, (gpointer*)&value, &len, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpstr(value, ==, "second");
+
+	j_kv_delete(kv, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_kv_add_append(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JKV) kv_counter = NULL;
+	g_autoptr(JKV) kv_log = NULL;
+	g_autofree gpointer counter = NULL;
+	g_autofree gpointer log = NULL;
+	gint64 value;
+	guint32 len;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	kv_counter = j_kv_new("test", "test-kv-add");
+	kv_log = j_kv_new("test", "test-kv-append");
+
+	for (guint i = 0; i < 10; i++)
+	{
+		j_kv_add(kv_counter, 5, batch);
+		j_kv_append(kv_log, (gpointer) "ab", 2, NULL, batch);
+	}
+
+	j_kv_add(kv_counter, -8, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_kv_get(kv_counter, &counter, &len, batch);
+	j_kv_get(kv_log, &log, &len, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	memcpy(&value, counter, sizeof(value));
+	g_assert_cmpint(GINT64_FROM_LE(value), ==, 42);
+
+	g_assert_cmpuint(len, ==, 20);
+	g_assert_cmpmem(log, len, "abababababababababab", 20);
+
+	j_kv_delete(kv_counter, batch);
+	j_kv_delete(kv_log, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_kv_persistency(void)
+{
+	guint const n = 100;
+
+	JSemanticsPersistency const persistencies[] = { J_SEMANTICS_PERSISTENCY_NONE, J_SEMANTICS_PERSISTENCY_NETWORK, J_SEMANTICS_PERSISTENCY_STORAGE };
+
+	J_TEST_TRAP_START;
+
+	// The persistency determines how the backend syncs a batch.
+	for (guint p = 0; p < G_N_ELEMENTS(persistencies); p++)
+	{
+		g_autoptr(JBatch) batch = NULL;
+		g_autoptr(JSemantics) semantics = NULL;
+		g_autoptr(GPtrArray) kvs = NULL;
+		g_autofree gpointer* values = NULL;
+		g_autofree guint32* lens = NULL;
+		g_autofree gchar* get_value = NULL;
+		guint32 get_len = 42;
+		gboolean ret;
+
+		semantics = j_semantics_new(J_SEMANTICS_TEMPLATE_DEFAULT);
+		j_semantics_set(semantics, J_SEMANTICS_PERSISTENCY, persistencies[p]);
+
+		batch = j_batch_new(semantics);
+		kvs = g_ptr_array_new_with_free_func((GDestroyNotify)j_kv_unref);
+		values = g_new0(gpointer, n);
+		lens = g_new0(guint32, n);
+
+		// Operations of a batch share a transaction, so they have to see each other's modifications.
+		for (guint i = 0; i < n; i++)
+		{
+			g_autofree gchar* key = NULL;
+			JKV* kv;
+
+			key = g_strdup_printf("test-kv-persistency-%u", i);
+			kv = j_kv_new("test", key);
+			g_ptr_array_add(kvs, kv);
+
+			j_kv_put(kv, g_strdup("first-value"), strlen("first-value") + 1, g_free, batch);
+			j_kv_put(kv, g_strdup(key), strlen(key) + 1, g_free, batch);
+			j_kv_get(kv, &(values[i]), &(lens[i]), batch);
+		}
+
+		ret = j_batch_execute(batch);
+		g_assert_true(ret);
+
+		for (guint i = 0; i < n; i++)
+		{
+			g_autofree gchar* key = NULL;
+
+			key = g_strdup_printf("test-kv-persistency-%u", i);
+			g_assert_cmpstr(values[i], ==, key);
+			g_assert_cmpuint(lens[i], ==, strlen(key) + 1);
+
+			g_free(values[i]);
+		}
+
+		for (guint i = 0; i < n; i++)
+		{
+			j_kv_delete(g_ptr_array_index(kvs, i), batch);
+		}
+
+		ret = j_batch_execute(batch);
+		g_assert_true(ret);
+
+		j_kv_get(g_ptr_array_index(kvs, 0), (gpointer)&get_value, &get_len, batch);
+		ret = j_batch_execute(batch);
+		g_assert_false(ret);
+		g_assert_null(get_value);
+	}
+
+	J_TEST_TRAP_END;
+}
+
 void
 test_kv_kv(void)
 {
@@ -236,4 +454,8 @@ test_kv_kv(void)
 	g_test_add_func("/kv/kv/put_update", test_kv_put_update);
 	g_test_add_func("/kv/kv/get", test_kv_get);
 	g_test_add_func("/kv/kv/get_callback", test_kv_get_callback);
+	g_test_add_func("/kv/kv/get_view", test_kv_get_view);
+	g_test_add_func("/kv/kv/compare_and_swap", test_kv_compare_and_swap);
+	g_test_add_func("/kv/kv/add_append", test_kv_add_append);
+	g_test_add_func("/kv/kv/persistency", test_kv_persistency);
 }
@@ -20,6 +20,8 @@
 
 #include <glib.h>
 
+#include <string.h>
+
 #include <julea.h>
 #include <julea-object.h>
 
@@ -229,6 +231,114 @@ test_object_status(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_object_status_sparse(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistributedObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	gint64 modification_time = 0;
+	guint64 nbytes = 0;
+	guint64 size = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(42);
+
+	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	object = j_distributed_object_new("test", "test-distributed-object-status-sparse", distribution);
+	g_assert_true(object != NULL);
+
+	j_distributed_object_create(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_distributed_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpint(modification_time, !=, 0);
+	g_assert_cmpuint(size, ==, 0);
+
+	// Skip the first stripes, the object's size has to be tracked nevertheless.
+	j_distributed_object_write(object, buffer, 42, 16 * 1024 * 1024, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 42);
+
+	j_distributed_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(size, ==, 16 * 1024 * 1024 + 42);
+
+	j_distributed_object_sync(object, batch);
+	j_distributed_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_status_legacy(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistributedObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	gint64 modification_time = 0;
+	guint64 nbytes = 0;
+	guint64 size = 0;
+	guint32 server_count;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(42);
+	server_count = j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT);
+
+	// Objects written before size markers were introduced only consist of stripes on all servers.
+	for (guint32 i = 0; i < server_count; i++)
+	{
+		g_autoptr(JObject) stripe = NULL;
+
+		stripe = j_object_new_for_index(i, "test", "test-distributed-object-status-legacy");
+		j_object_create(stripe, batch);
+
+		if (i == 0)
+		{
+			j_object_write(stripe, buffer, 42, 0, &nbytes, batch);
+		}
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 42);
+
+	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	object = j_distributed_object_new("test", "test-distributed-object-status-legacy", distribution);
+	g_assert_true(object != NULL);
+
+	j_distributed_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpint(modification_time, !=, 0);
+	g_assert_cmpuint(size, ==, 42);
+
+	j_distributed_object_sync(object, batch);
+	j_distributed_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	// All stripes have to be deleted.
+	j_distributed_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpint(modification_time, ==, 0);
+	g_assert_cmpuint(size, ==, 0);
+	J_TEST_TRAP_END;
+}
+
 static void
 test_object_sync(void)
 {
@@ -266,6 +376,222 @@ test_object_sync(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_object_append(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistributedObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	gint64 modification_time = 0;
+	guint64 nbytes[2] = { 0, 0 };
+	guint64 offset[2] = { 0, 0 };
+	guint64 size = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(42);
+
+	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	object = j_distributed_object_new("test", "test-distributed-object-append", distribution);
+	g_assert_true(object != NULL);
+
+	j_distributed_object_create(object, batch);
+	j_distributed_object_write(object, buffer, 42, 0, &(nbytes[0]), batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes[0], ==, 42);
+
+	// Appends must not overwrite data that has been written without appending.
+	j_distributed_object_append(object, buffer, 23, &(offset[0]), &(nbytes[0]), batch);
+	j_distributed_object_append(object, buffer, 42, &(offset[1]), &(nbytes[1]), batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes[0], ==, 23);
+	g_assert_cmpuint(nbytes[1], ==, 42);
+	g_assert_cmpuint(offset[0], ==, 42);
+	g_assert_cmpuint(offset[1], ==, 65);
+
+	j_distributed_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(size, ==, 107);
+
+	j_distributed_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_copy(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistributedObject) object = NULL;
+	g_autoptr(JDistributedObject) copy = NULL;
+	g_autofree gchar* buffer = NULL;
+	g_autofree gchar* copy_buffer = NULL;
+	guint64 nbytes = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(1024 * 1024);
+	copy_buffer = g_malloc0(1024 * 1024);
+
+	for (guint i = 0; i < 1024 * 1024; i++)
+	{
+		buffer[i] = i % 251;
+	}
+
+	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	object = j_distributed_object_new("test", "test-distributed-object-copy", distribution);
+	g_assert_true(object != NULL);
+	copy = j_distributed_object_new("test", "test-distributed-object-copy-destination", distribution);
+	g_assert_true(copy != NULL);
+
+	j_distributed_object_create(object, batch);
+	j_distributed_object_write(object, buffer, 1024 * 1024, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 1024 * 1024);
+
+	j_distributed_object_copy(object, copy, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 1024 * 1024);
+
+	j_distributed_object_read(copy, copy_buffer, 1024 * 1024, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 1024 * 1024);
+	g_assert_cmpmem(buffer, 1024 * 1024, copy_buffer, 1024 * 1024);
+
+	j_distributed_object_delete(object, batch);
+	j_distributed_object_delete(copy, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_replicas(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistributedObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	g_autofree gchar* read_buffer = NULL;
+	guint64 nbytes = 0;
+	gboolean ret;
+
+	if (j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT) < 2)
+	{
+		g_test_skip("Replication requires at least two object servers");
+		return;
+	}
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(1024 * 1024);
+	read_buffer = g_malloc0(1024 * 1024);
+
+	for (guint i = 0; i < 1024 * 1024; i++)
+	{
+		buffer[i] = i % 251;
+	}
+
+	distribution = j_distribution_new(J_DISTRIBUTION_ROUND_ROBIN);
+	j_distribution_set(distribution, "replicas", 2);
+	object = j_distributed_object_new("test", "test-distributed-object-replicas", distribution);
+	g_assert_true(object != NULL);
+
+	j_distributed_object_create(object, batch);
+	j_distributed_object_write(object, buffer, 1024 * 1024, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 1024 * 1024);
+
+	// Reads may be served by any copy.
+	for (guint i = 0; i < 4; i++)
+	{
+		nbytes = 0;
+		memset(read_buffer, 0, 1024 * 1024);
+
+		j_distributed_object_read(object, read_buffer, 1024 * 1024, 0, &nbytes, batch);
+		ret = j_batch_execute(batch);
+		g_assert_true(ret);
+		g_assert_cmpuint(nbytes, ==, 1024 * 1024);
+		g_assert_cmpmem(buffer, 1024 * 1024, read_buffer, 1024 * 1024);
+	}
+
+	j_distributed_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_erasure(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JDistribution) distribution = NULL;
+	g_autoptr(JDistributedObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	g_autofree gchar* read_buffer = NULL;
+	guint64 nbytes = 0;
+	gboolean ret;
+
+	if (j_configuration_get_server_count(j_configuration(), J_BACKEND_TYPE_OBJECT) < 2)
+	{
+		g_test_skip("Erasure coding requires at least two object servers");
+		return;
+	}
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(1024 * 1024);
+	read_buffer = g_malloc0(1024 * 1024);
+
+	for (guint i = 0; i < 1024 * 1024; i++)
+	{
+		buffer[i] = i % 251;
+	}
+
+	distribution = j_distribution_new(J_DISTRIBUTION_ERASURE);
+	j_distribution_set(distribution, "block-size", 4096);
+	object = j_distributed_object_new("test", "test-distributed-object-erasure", distribution);
+	g_assert_true(object != NULL);
+
+	j_distributed_object_create(object, batch);
+	j_distributed_object_write(object, buffer, 1024 * 1024, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 1024 * 1024);
+
+	// Partial writes update the parity of the groups they touch.
+	nbytes = 0;
+	memset(buffer + 1000, 42, 10000);
+	j_distributed_object_write(object, buffer + 1000, 10000, 1000, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 10000);
+
+	nbytes = 0;
+	j_distributed_object_read(object, read_buffer, 1024 * 1024, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 1024 * 1024);
+	g_assert_cmpmem(buffer, 1024 * 1024, read_buffer, 1024 * 1024);
+
+	j_distributed_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
 void
 test_object_distributed_object(void)
 {
@@ -273,5 +599,11 @@ test_object_distributed_object(void)
 	g_test_add_func("/object/distributed-object/create_delete", test_object_create_delete);
 	g_test_add_func("/object/distributed-object/read_write", test_object_read_write);
 	g_test_add_func("/object/distributed-object/status", test_object_status);
+	g_test_add_func("/object/distributed-object/status_sparse", test_object_status_sparse);
+	g_test_add_func("/object/distributed-object/status_legacy", test_object_status_legacy);
 	g_test_add_func("/object/distributed-object/sync", test_object_sync);
+	g_test_add_func("/object/distributed-object/append", test_object_append);
+	g_test_add_func("/object/distributed-object/copy", test_object_copy);
+	g_test_add_func("/object/distributed-object/replicas", test_object_replicas);
+	g_test_add_func("/object/distributed-object/erasure", test_object_erasure);
 }
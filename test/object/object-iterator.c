@@ -170,9 +170,200 @@ test_object_iterator_next_get(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_object_iterator_delete_by_prefix(void)
+{
+	guint const n = 1000;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JObjectIterator) object_iterator = NULL;
+	g_autoptr(JObjectIterator) object_iterator_all = NULL;
+	gboolean ret;
+
+	guint objects = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	for (guint i = 0; i < n; i++)
+	{
+		g_autoptr(JObject) object = NULL;
+
+		g_autofree gchar* key = NULL;
+
+		key = g_strdup_printf("test-key-delete-by-prefix-%d-%d", i % 2, i);
+		object = j_object_new("test-ns-delete-by-prefix", key);
+		j_object_create(object, batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_object_delete_by_prefix("test-ns-delete-by-prefix", "test-key-delete-by-prefix-1-", batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	object_iterator = j_object_iterator_new("test-ns-delete-by-prefix", NULL);
+
+	while (j_object_iterator_next(object_iterator))
+	{
+		gchar const* key;
+
+		key = j_object_iterator_get(object_iterator);
+		g_assert_true(g_str_has_prefix(key, "test-key-delete-by-prefix-0-"));
+		objects++;
+	}
+
+	g_assert_cmpuint(objects, ==, n / 2);
+
+	j_object_delete_by_prefix("test-ns-delete-by-prefix", NULL, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	object_iterator_all = j_object_iterator_new("test-ns-delete-by-prefix", NULL);
+	g_assert_false(j_object_iterator_next(object_iterator_all));
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_iterator_shard_names(void)
+{
+	// The names look like the directories that are used for sharding objects.
+	gchar const* names[] = { "00", "3f", "3f-object", "ff-object" };
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JObjectIterator) object_iterator = NULL;
+	g_autoptr(JObjectIterator) object_iterator_prefix = NULL;
+	g_autoptr(JObjectIterator) object_iterator_all = NULL;
+	gboolean ret;
+
+	guint objects = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	for (guint i = 0; i < G_N_ELEMENTS(names); i++)
+	{
+		g_autoptr(JObject) object = NULL;
+
+		object = j_object_new("test-ns-shard-names", names[i]);
+		j_object_create(object, batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	object_iterator = j_object_iterator_new("test-ns-shard-names", NULL);
+
+	while (j_object_iterator_next(object_iterator))
+	{
+		gchar const* key;
+		gboolean found = FALSE;
+
+		key = j_object_iterator_get(object_iterator);
+
+		for (guint i = 0; i < G_N_ELEMENTS(names); i++)
+		{
+			found = found || (g_strcmp0(key, names[i]) == 0);
+		}
+
+		g_assert_true(found);
+		objects++;
+	}
+
+	g_assert_cmpuint(objects, ==, G_N_ELEMENTS(names));
+
+	objects = 0;
+	object_iterator_prefix = j_object_iterator_new("test-ns-shard-names", "3f");
+
+	while (j_object_iterator_next(object_iterator_prefix))
+	{
+		gchar const* key;
+
+		key = j_object_iterator_get(object_iterator_prefix);
+		g_assert_true(g_str_has_prefix(key, "3f"));
+		objects++;
+	}
+
+	g_assert_cmpuint(objects, ==, 2);
+
+	j_object_delete_by_prefix("test-ns-shard-names", NULL, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	object_iterator_all = j_object_iterator_new("test-ns-shard-names", NULL);
+	g_assert_false(j_object_iterator_next(object_iterator_all));
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_iterator_status(void)
+{
+	guint const n = 100;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JBatch) delete_batch = NULL;
+	g_autoptr(JObjectIterator) object_iterator = NULL;
+	gchar data[100] = { 0 };
+	guint64 bytes_written = 0;
+	gboolean ret;
+
+	guint objects = 0;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	delete_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	for (guint i = 0; i < n; i++)
+	{
+		g_autoptr(JObject) object = NULL;
+
+		g_autofree gchar* key = NULL;
+
+		key = g_strdup_printf("test-key-status-%u", i);
+		object = j_object_new("test-ns-status", key);
+		j_object_create(object, batch);
+		j_object_write(object, data, i, 0, &bytes_written, batch);
+		j_object_delete(object, delete_batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	object_iterator = j_object_iterator_new_with_status("test-ns-status", NULL);
+
+	while (j_object_iterator_next(object_iterator))
+	{
+		gchar const* key;
+		gint64 modification_time = 0;
+		guint64 size = 0;
+		guint i;
+
+		key = j_object_iterator_get(object_iterator);
+		g_assert_true(g_str_has_prefix(key, "test-key-status-"));
+
+		ret = j_object_iterator_get_status(object_iterator, &modification_time, &size);
+		g_assert_true(ret);
+
+		i = g_ascii_strtoull(key + sizeof("test-key-status-") - 1, NULL, 10);
+		g_assert_cmpuint(size, ==, i);
+
+		objects++;
+	}
+
+	g_assert_cmpuint(objects, ==, n);
+
+	ret = j_batch_execute(delete_batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
 void
 test_object_object_iterator(void)
 {
 	g_test_add_func("/object/object-iterator/new_free", test_object_iterator_new_free);
 	g_test_add_func("/object/object-iterator/next_get", test_object_iterator_next_get);
+	g_test_add_func("/object/object-iterator/delete_by_prefix", test_object_iterator_delete_by_prefix);
+	g_test_add_func("/object/object-iterator/shard_names", test_object_iterator_shard_names);
+	g_test_add_func("/object/object-iterator/status", test_object_iterator_status);
 }
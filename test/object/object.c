@@ -181,6 +181,257 @@ test_object_read_write(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_object_batch(void)
+{
+	guint const n = 16;
+	guint64 const block_size = 4096;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JSemantics) semantics = NULL;
+	g_autoptr(JObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	g_autofree gchar* read_buffer = NULL;
+	guint64 nbytes = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	// Persisting to storage also syncs the object as part of the batch.
+	semantics = j_semantics_new(J_SEMANTICS_TEMPLATE_DEFAULT);
+	j_semantics_set(semantics, J_SEMANTICS_PERSISTENCY, J_SEMANTICS_PERSISTENCY_STORAGE);
+
+	batch = j_batch_new(semantics);
+	buffer = g_malloc(n * block_size);
+	read_buffer = g_malloc0(n * block_size);
+
+	for (guint i = 0; i < n; i++)
+	{
+		memset(buffer + (i * block_size), 'a' + i, block_size);
+	}
+
+	object = j_object_new("test", "test-object-batch");
+	g_assert_true(object != NULL);
+
+	j_object_create(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	// The blocks are written out of order and with gaps, so that they cannot be combined.
+	for (guint i = 0; i < n; i++)
+	{
+		guint j = (i * 7) % n;
+
+		j_object_write(object, buffer + (j * block_size), block_size, 2 * j * block_size, &nbytes, batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, n * block_size);
+
+	nbytes = 0;
+
+	for (guint i = 0; i < n; i++)
+	{
+		j_object_read(object, read_buffer + (i * block_size), block_size, 2 * i * block_size, &nbytes, batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, n * block_size);
+	g_assert_cmpmem(read_buffer, n * block_size, buffer, n * block_size);
+
+	j_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_overwrite(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JObject) object = NULL;
+	gchar buffer[42];
+	guint64 nbytes = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+	object = j_object_new("test", "test-object-overwrite");
+	g_assert_true(object != NULL);
+
+	j_object_create(object, batch);
+	j_object_write(object, "first", 6, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	nbytes = 0;
+	j_object_read(object, buffer, 6, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 6);
+	g_assert_cmpstr(buffer, ==, "first");
+
+	// Reads might be served from cached mappings, which have to reflect later modifications.
+	nbytes = 0;
+	j_object_write(object, "other", 6, 0, &nbytes, batch);
+	j_object_read(object, buffer, 6, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 12);
+	g_assert_cmpstr(buffer, ==, "other");
+
+	nbytes = 0;
+	j_object_write(object, "longer", 7, 6, &nbytes, batch);
+	j_object_read(object, buffer, 13, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 20);
+	g_assert_cmpmem(buffer, 13, "other\0longer", 13);
+
+	// A new object with the same name must not return the old data.
+	nbytes = 0;
+	j_object_delete(object, batch);
+	j_object_create(object, batch);
+	j_object_write(object, "new", 4, 0, &nbytes, batch);
+	j_object_read(object, buffer, 13, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 8);
+	g_assert_cmpstr(buffer, ==, "new");
+
+	j_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_vectored(void)
+{
+	guint const n = 8;
+	guint64 const block_size = 1024;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	g_autofree gchar* read_buffer = NULL;
+	gint64 modification_time = 0;
+	guint64 nbytes = 0;
+	guint64 size = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc(n * block_size);
+	read_buffer = g_malloc0(n * block_size);
+
+	for (guint i = 0; i < n * block_size; i++)
+	{
+		buffer[i] = i % 251;
+	}
+
+	object = j_object_new("test", "test-object-vectored");
+	g_assert_true(object != NULL);
+
+	j_object_create(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	// Adjacent ranges can be combined into a single vectored operation.
+	for (guint i = 0; i < n; i++)
+	{
+		j_object_write(object, buffer + (i * block_size), block_size, i * block_size, &nbytes, batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, n * block_size);
+
+	nbytes = 0;
+
+	// The last read extends beyond the end of the object.
+	for (guint i = 0; i < n; i++)
+	{
+		j_object_read(object, read_buffer + (i * block_size), (i == n - 1) ? 2 * block_size : block_size, i * block_size, &nbytes, batch);
+	}
+
+	j_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, n * block_size);
+	g_assert_cmpuint(size, ==, n * block_size);
+	g_assert_cmpmem(read_buffer, n * block_size, buffer, n * block_size);
+
+	j_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_create_delete_many(void)
+{
+	guint const n = 100;
+
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(GPtrArray) objects = NULL;
+	gint64 modification_time;
+	guint64 size;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	objects = g_ptr_array_new_with_free_func((GDestroyNotify)j_object_unref);
+
+	// The server creates and deletes all objects of a message at once.
+	for (guint i = 0; i < n; i++)
+	{
+		g_autofree gchar* name = NULL;
+		JObject* object;
+
+		name = g_strdup_printf("test-object-create-delete-many-%u", i);
+		object = j_object_new("test", name);
+		g_ptr_array_add(objects, object);
+
+		j_object_create(object, batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	for (guint i = 0; i < n; i++)
+	{
+		modification_time = 0;
+		size = 42;
+
+		j_object_status(g_ptr_array_index(objects, i), &modification_time, &size, batch);
+		ret = j_batch_execute(batch);
+		g_assert_true(ret);
+		g_assert_cmpint(modification_time, !=, 0);
+		g_assert_cmpuint(size, ==, 0);
+	}
+
+	for (guint i = 0; i < n; i++)
+	{
+		j_object_delete(g_ptr_array_index(objects, i), batch);
+	}
+
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	for (guint i = 0; i < n; i++)
+	{
+		j_object_delete(g_ptr_array_index(objects, i), batch);
+	}
+
+	// All objects have already been deleted.
+	ret = j_batch_execute(batch);
+	g_assert_false(ret);
+	J_TEST_TRAP_END;
+}
+
 static void
 test_object_status(void)
 {
@@ -255,12 +506,172 @@ test_object_sync(void)
 	J_TEST_TRAP_END;
 }
 
+static void
+test_object_append(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	gint64 modification_time = 0;
+	guint64 nbytes[2] = { 0, 0 };
+	guint64 offset[2] = { 0, 0 };
+	guint64 size = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(42);
+
+	object = j_object_new("test", "test-object-append");
+	g_assert_true(object != NULL);
+
+	j_object_create(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+
+	j_object_append(object, buffer, 42, &(offset[0]), &(nbytes[0]), batch);
+	j_object_append(object, buffer, 23, &(offset[1]), &(nbytes[1]), batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes[0], ==, 42);
+	g_assert_cmpuint(nbytes[1], ==, 23);
+	g_assert_cmpuint(offset[0], ==, 0);
+	g_assert_cmpuint(offset[1], ==, 42);
+
+	j_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(size, ==, 65);
+
+	j_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_compound(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JObject) object = NULL;
+	g_autofree gchar* buffer = NULL;
+	gint64 modification_time = 0;
+	guint64 nbytes = 0;
+	guint64 size = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(42);
+
+	object = j_object_new("test", "test-object-compound");
+	g_assert_true(object != NULL);
+
+	// Create, write and sync are combined into a single message
+	j_object_create(object, batch);
+	j_object_write(object, buffer, 42, 0, &nbytes, batch);
+	j_object_write(object, buffer, 42, 42, &nbytes, batch);
+	j_object_sync(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 84);
+
+	j_object_status(object, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(size, ==, 84);
+
+	j_object_delete(object, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
+static void
+test_object_copy(void)
+{
+	g_autoptr(JBatch) batch = NULL;
+	g_autoptr(JObject) object = NULL;
+	g_autoptr(JObject) copy = NULL;
+	g_autoptr(JObject) missing = NULL;
+	g_autofree gchar* buffer = NULL;
+	g_autofree gchar* copy_buffer = NULL;
+	gint64 modification_time = 0;
+	guint64 nbytes = 0;
+	guint64 size = 0;
+	gboolean ret;
+
+	J_TEST_TRAP_START;
+	batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+	buffer = g_malloc0(84);
+	copy_buffer = g_malloc0(42);
+
+	for (guint i = 0; i < 42; i++)
+	{
+		buffer[i] = i;
+	}
+
+	object = j_object_new("test", "test-object-copy");
+	g_assert_true(object != NULL);
+	copy = j_object_new("test", "test-object-copy-destination");
+	g_assert_true(copy != NULL);
+	missing = j_object_new("test", "test-object-copy-missing");
+	g_assert_true(missing != NULL);
+
+	j_object_create(object, batch);
+	j_object_write(object, buffer, 42, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 42);
+
+	// The destination is larger than the source, the copy must not keep its tail.
+	j_object_create(copy, batch);
+	j_object_write(copy, buffer, 84, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 84);
+
+	j_object_copy(object, copy, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 42);
+
+	j_object_status(copy, &modification_time, &size, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(size, ==, 42);
+
+	j_object_read(copy, copy_buffer, 42, 0, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	g_assert_cmpuint(nbytes, ==, 42);
+	g_assert_cmpmem(buffer, 42, copy_buffer, 42);
+
+	// Copying a missing object has to fail instead of reporting an empty copy.
+	j_object_copy(missing, copy, &nbytes, batch);
+	ret = j_batch_execute(batch);
+	g_assert_false(ret);
+
+	j_object_delete(object, batch);
+	j_object_delete(copy, batch);
+	ret = j_batch_execute(batch);
+	g_assert_true(ret);
+	J_TEST_TRAP_END;
+}
+
 void
 test_object_object(void)
 {
 	g_test_add_func("/object/object/new_free", test_object_new_free);
 	g_test_add_func("/object/object/create_delete", test_object_create_delete);
 	g_test_add_func("/object/object/read_write", test_object_read_write);
+	g_test_add_func("/object/object/batch", test_object_batch);
+	g_test_add_func("/object/object/overwrite", test_object_overwrite);
+	g_test_add_func("/object/object/vectored", test_object_vectored);
+	g_test_add_func("/object/object/create_delete_many", test_object_create_delete_many);
 	g_test_add_func("/object/object/status", test_object_status);
 	g_test_add_func("/object/object/sync", test_object_sync);
+	g_test_add_func("/object/object/append", test_object_append);
+	g_test_add_func("/object/object/compound", test_object_compound);
+	g_test_add_func("/object/object/copy", test_object_copy);
 }
@@ -48,6 +48,8 @@ main(int argc, char** argv)
 	test_core_credentials();
 	test_core_dir_iterator();
 	test_core_distribution();
+	test_core_erasure();
+	test_core_hash_ring();
 	test_core_list();
 	test_core_list_iterator();
 	test_core_memory_chunk();
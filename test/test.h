@@ -43,6 +43,8 @@ void test_core_configuration(void);
 void test_core_credentials(void);
 void test_core_dir_iterator(void);
 void test_core_distribution(void);
+void test_core_erasure(void);
+void test_core_hash_ring(void);
 void test_core_list(void);
 void test_core_list_iterator(void);
 void test_core_memory_chunk(void);
@@ -46,6 +46,12 @@ static gint64 opt_max_inject_size = 0;
 static gint opt_port = 0;
 static gint opt_max_connections = 0;
 static gint64 opt_stripe_size = 0;
+static gchar const* opt_placement = NULL;
+static gint opt_virtual_nodes = 0;
+static gint opt_hedge_percentile = 0;
+static gchar const* opt_weights_object = NULL;
+static gchar const* opt_weights_kv = NULL;
+static gchar const* opt_weights_db = NULL;
 
 static gchar**
 string_split(gchar const* string)
@@ -65,6 +71,30 @@ string_split(gchar const* string)
 	return arr;
 }
 
+static void
+set_weights(GKeyFile* key_file, gchar const* key, gchar const* weights)
+{
+	g_auto(GStrv) arr = NULL;
+	g_autofree gint* values = NULL;
+	guint len;
+
+	if (weights == NULL)
+	{
+		return;
+	}
+
+	arr = string_split(weights);
+	len = g_strv_length(arr);
+	values = g_new(gint, len);
+
+	for (guint i = 0; i < len; i++)
+	{
+		values[i] = g_ascii_strtoll(arr[i], NULL, 10);
+	}
+
+	g_key_file_set_integer_list(key_file, "servers", key, values, len);
+}
+
 static gboolean
 read_config(gchar* path)
 {
@@ -111,9 +141,20 @@ write_config(gchar* path)
 	g_key_file_set_integer(key_file, "core", "port", opt_port);
 	g_key_file_set_integer(key_file, "clients", "max-connections", opt_max_connections);
 	g_key_file_set_int64(key_file, "clients", "stripe-size", opt_stripe_size);
+
+	if (opt_placement != NULL)
+	{
+		g_key_file_set_string(key_file, "clients", "placement", opt_placement);
+	}
+
+	g_key_file_set_integer(key_file, "clients", "virtual-nodes", opt_virtual_nodes);
+	g_key_file_set_integer(key_file, "clients", "hedge-percentile", opt_hedge_percentile);
 	g_key_file_set_string_list(key_file, "servers", "object", (gchar const* const*)servers_object, g_strv_length(servers_object));
 	g_key_file_set_string_list(key_file, "servers", "kv", (gchar const* const*)servers_kv, g_strv_length(servers_kv));
 	g_key_file_set_string_list(key_file, "servers", "db", (gchar const* const*)servers_db, g_strv_length(servers_db));
+	set_weights(key_file, "object-weights", opt_weights_object);
+	set_weights(key_file, "kv-weights", opt_weights_kv);
+	set_weights(key_file, "db-weights", opt_weights_db);
 	g_key_file_set_string(key_file, "object", "backend", opt_object_backend);
 	g_key_file_set_string(key_file, "object", "component", opt_object_component);
 	g_key_file_set_string(key_file, "object", "path", opt_object_path);
@@ -159,6 +200,9 @@ main(gint argc, gchar** argv)
 		{ "object-servers", 0, 0, G_OPTION_ARG_STRING, &opt_servers_object, "Object servers to use", "host1,host2:port" },
 		{ "kv-servers", 0, 0, G_OPTION_ARG_STRING, &opt_servers_kv, "Key-value servers to use", "host1,host2:port" },
 		{ "db-servers", 0, 0, G_OPTION_ARG_STRING, &opt_servers_db, "Database servers to use", "host1,host2:port" },
+		{ "object-weights", 0, 0, G_OPTION_ARG_STRING, &opt_weights_object, "Object server weights", "1,2" },
+		{ "kv-weights", 0, 0, G_OPTION_ARG_STRING, &opt_weights_kv, "Key-value server weights", "1,2" },
+		{ "db-weights", 0, 0, G_OPTION_ARG_STRING, &opt_weights_db, "Database server weights", "1,2" },
 		{ "object-backend", 0, 0, G_OPTION_ARG_STRING, &opt_object_backend, "Object backend to use", "posix|null|gio|…" },
 		{ "object-component", 0, 0, G_OPTION_ARG_STRING, &opt_object_component, "Object component to use", "client|server" },
 		{ "object-path", 0, 0, G_OPTION_ARG_STRING, &opt_object_path, "Object path to use", "/path/to/storage" },
@@ -173,6 +217,9 @@ main(gint argc, gchar** argv)
 		{ "port", 0, 0, G_OPTION_ARG_INT, &opt_port, "Default network port", "0" },
 		{ "max-connections", 0, 0, G_OPTION_ARG_INT, &opt_max_connections, "Maximum number of connections", "0" },
 		{ "stripe-size", 0, 0, G_OPTION_ARG_INT64, &opt_stripe_size, "Default stripe size", "0" },
+		{ "placement", 0, 0, G_OPTION_ARG_STRING, &opt_placement, "Placement of keys and objects on servers", "modulo|ring" },
+		{ "virtual-nodes", 0, 0, G_OPTION_ARG_INT, &opt_virtual_nodes, "Virtual nodes per server when using the ring placement", "0" },
+		{ "hedge-percentile", 0, 0, G_OPTION_ARG_INT, &opt_hedge_percentile, "Latency percentile after which reads of replicated objects are hedged", "0" },
 		{ NULL, 0, 0, 0, NULL, NULL, NULL }
 	};
 
@@ -201,6 +248,9 @@ main(gint argc, gchar** argv)
 	    || opt_max_inject_size < 0
 	    || opt_max_connections < 0
 	    || opt_stripe_size < 0
+	    || opt_virtual_nodes < 0
+	    || opt_hedge_percentile < 0 || opt_hedge_percentile > 100
+	    || (opt_placement != NULL && g_strcmp0(opt_placement, "modulo") != 0 && g_strcmp0(opt_placement, "ring") != 0)
 	    || opt_port < 0 || opt_port > 65535)
 	{
 		g_autofree gchar* help = NULL;
@@ -0,0 +1,381 @@
+/*
+ * JULEA - Flexible storage framework
+ * Copyright (C) 2023 Michael Kuhn
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <julea-config.h>
+
+#include <glib.h>
+
+#include <locale.h>
+
+#include <julea.h>
+#include <julea-kv.h>
+#include <julea-object.h>
+
+/*
+ * Moves keys and objects to the servers they are placed on by the current configuration.
+ *
+ * After the server list, the placement or the servers' weights have been changed, all servers are scanned.
+ * Only the keys and objects that are not stored on their responsible server are moved, all others are left untouched.
+ * Servers that should be removed have to be given a weight of 0 first, so that their data can be moved away before they are removed from the configuration.
+ */
+
+static gchar** opt_kv = NULL;
+static gchar** opt_object = NULL;
+static gboolean opt_dry_run = FALSE;
+
+struct MigrateKV
+{
+	gchar* key;
+	gpointer value;
+	guint32 value_len;
+	guint32 index;
+};
+
+typedef struct MigrateKV MigrateKV;
+
+static void
+migrate_kv_free(gpointer data)
+{
+	MigrateKV* kv = data;
+
+	g_free(kv->key);
+	g_free(kv->value);
+
+	g_slice_free(MigrateKV, kv);
+}
+
+static gboolean
+migrate_kv(gchar const* namespace, guint64* moved)
+{
+	JConfiguration* configuration = j_configuration();
+	gboolean ret = TRUE;
+
+	for (guint32 i = 0; i < j_configuration_get_server_count(configuration, J_BACKEND_TYPE_KV); i++)
+	{
+		g_autoptr(JBatch) batch = NULL;
+		g_autoptr(JBatch) delete_batch = NULL;
+		g_autoptr(GPtrArray) kvs = NULL;
+		g_autofree gboolean* put = NULL;
+		JKVIterator* iterator;
+
+		batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+		kvs = g_ptr_array_new_with_free_func(migrate_kv_free);
+		iterator = j_kv_iterator_new_for_index(i, namespace, NULL);
+
+		// Collect the misplaced keys first, modifying them while iterating is not safe.
+		while (j_kv_iterator_next(iterator))
+		{
+			MigrateKV* kv;
+			gchar const* key;
+			gconstpointer value;
+			guint32 value_len;
+			guint32 index;
+
+			key = j_kv_iterator_get(iterator, &value, &value_len);
+			index = j_configuration_get_server_index(configuration, J_BACKEND_TYPE_KV, key);
+
+			if (index == i)
+			{
+				continue;
+			}
+
+			kv = g_slice_new(MigrateKV);
+			kv->key = g_strdup(key);
+#if GLIB_CHECK_VERSION(2, 68, 0)
+			kv->value = g_memdup2(value, value_len);
+#else
+			kv->value = g_memdup(value, value_len);
+#endif
+			kv->value_len = value_len;
+			kv->index = index;
+
+			g_ptr_array_add(kvs, kv);
+		}
+
+		j_kv_iterator_free(iterator);
+
+		if (opt_dry_run)
+		{
+			for (guint j = 0; j < kvs->len; j++)
+			{
+				MigrateKV* kv = g_ptr_array_index(kvs, j);
+
+				g_print("kv %s/%s: %u -> %u\n", namespace, kv->key, i, kv->index);
+			}
+
+			*moved += kvs->len;
+			continue;
+		}
+
+		if (kvs->len == 0)
+		{
+			continue;
+		}
+
+		// Sources are only deleted after their keys have been written to the new server, so a failed put does not lose data.
+		for (guint j = 0; j < kvs->len; j++)
+		{
+			g_autoptr(JKV) destination = NULL;
+			MigrateKV* kv = g_ptr_array_index(kvs, j);
+
+			destination = j_kv_new_for_index(kv->index, namespace, kv->key);
+			j_kv_put(destination, kv->value, kv->value_len, NULL, batch);
+		}
+
+		put = g_new0(gboolean, kvs->len);
+
+		if (j_batch_execute(batch))
+		{
+			for (guint j = 0; j < kvs->len; j++)
+			{
+				put[j] = TRUE;
+			}
+		}
+		else
+		{
+			// The batch does not tell which puts failed, retry them one by one.
+			for (guint j = 0; j < kvs->len; j++)
+			{
+				g_autoptr(JBatch) retry_batch = NULL;
+				g_autoptr(JKV) destination = NULL;
+				MigrateKV* kv = g_ptr_array_index(kvs, j);
+
+				retry_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+				destination = j_kv_new_for_index(kv->index, namespace, kv->key);
+				j_kv_put(destination, kv->value, kv->value_len, NULL, retry_batch);
+
+				put[j] = j_batch_execute(retry_batch);
+			}
+		}
+
+		delete_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+		for (guint j = 0; j < kvs->len; j++)
+		{
+			g_autoptr(JKV) source = NULL;
+			MigrateKV* kv = g_ptr_array_index(kvs, j);
+
+			if (!put[j])
+			{
+				g_printerr("kv %s/%s: %u -> %u failed\n", namespace, kv->key, i, kv->index);
+				ret = FALSE;
+				continue;
+			}
+
+			g_print("kv %s/%s: %u -> %u\n", namespace, kv->key, i, kv->index);
+
+			source = j_kv_new_for_index(i, namespace, kv->key);
+			j_kv_delete(source, delete_batch);
+
+			(*moved)++;
+		}
+
+		ret = j_batch_execute(delete_batch) && ret;
+	}
+
+	return ret;
+}
+
+static gboolean
+migrate_object(gchar const* namespace, guint64* moved)
+{
+	JConfiguration* configuration = j_configuration();
+	gboolean ret = TRUE;
+
+	for (guint32 i = 0; i < j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT); i++)
+	{
+		g_autoptr(JBatch) batch = NULL;
+		g_autoptr(JBatch) delete_batch = NULL;
+		g_autoptr(GPtrArray) names = NULL;
+		g_autofree guint64* bytes_copied = NULL;
+		g_autofree gboolean* copied = NULL;
+		JObjectIterator* iterator;
+
+		batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+		names = g_ptr_array_new_with_free_func(g_free);
+		iterator = j_object_iterator_new_for_index(i, namespace, NULL);
+
+		while (j_object_iterator_next(iterator))
+		{
+			gchar const* name;
+
+			name = j_object_iterator_get(iterator);
+
+			if (j_configuration_get_server_index(configuration, J_BACKEND_TYPE_OBJECT, name) != i)
+			{
+				g_ptr_array_add(names, g_strdup(name));
+			}
+		}
+
+		j_object_iterator_free(iterator);
+
+		if (opt_dry_run)
+		{
+			for (guint j = 0; j < names->len; j++)
+			{
+				gchar const* name = g_ptr_array_index(names, j);
+
+				g_print("object %s/%s: %u -> %u\n", namespace, name, i, j_configuration_get_server_index(configuration, J_BACKEND_TYPE_OBJECT, name));
+			}
+
+			*moved += names->len;
+			continue;
+		}
+
+		if (names->len == 0)
+		{
+			continue;
+		}
+
+		bytes_copied = g_new0(guint64, names->len);
+
+		// Sources are only deleted after they have been copied to the new server, so a failed copy does not lose data.
+		for (guint j = 0; j < names->len; j++)
+		{
+			g_autoptr(JObject) source = NULL;
+			g_autoptr(JObject) destination = NULL;
+			gchar const* name = g_ptr_array_index(names, j);
+
+			source = j_object_new_for_index(i, namespace, name);
+			destination = j_object_new_for_index(j_configuration_get_server_index(configuration, J_BACKEND_TYPE_OBJECT, name), namespace, name);
+
+			// The source server streams the object directly to its new server.
+			j_object_copy(source, destination, &(bytes_copied[j]), batch);
+		}
+
+		copied = g_new0(gboolean, names->len);
+
+		if (j_batch_execute(batch))
+		{
+			for (guint j = 0; j < names->len; j++)
+			{
+				copied[j] = TRUE;
+			}
+		}
+		else
+		{
+			// The batch does not tell which copies failed, retry them one by one.
+			for (guint j = 0; j < names->len; j++)
+			{
+				g_autoptr(JBatch) retry_batch = NULL;
+				g_autoptr(JObject) source = NULL;
+				g_autoptr(JObject) destination = NULL;
+				gchar const* name = g_ptr_array_index(names, j);
+
+				retry_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+				source = j_object_new_for_index(i, namespace, name);
+				destination = j_object_new_for_index(j_configuration_get_server_index(configuration, J_BACKEND_TYPE_OBJECT, name), namespace, name);
+
+				bytes_copied[j] = 0;
+				j_object_copy(source, destination, &(bytes_copied[j]), retry_batch);
+
+				copied[j] = j_batch_execute(retry_batch);
+			}
+		}
+
+		delete_batch = j_batch_new_for_template(J_SEMANTICS_TEMPLATE_DEFAULT);
+
+		for (guint j = 0; j < names->len; j++)
+		{
+			g_autoptr(JObject) source = NULL;
+			gchar const* name = g_ptr_array_index(names, j);
+			guint32 index;
+
+			index = j_configuration_get_server_index(configuration, J_BACKEND_TYPE_OBJECT, name);
+
+			if (!copied[j])
+			{
+				g_printerr("object %s/%s: %u -> %u failed\n", namespace, name, i, index);
+				ret = FALSE;
+				continue;
+			}
+
+			g_print("object %s/%s: %u -> %u\n", namespace, name, i, index);
+
+			source = j_object_new_for_index(i, namespace, name);
+			j_object_delete(source, delete_batch);
+
+			(*moved)++;
+		}
+
+		ret = j_batch_execute(delete_batch) && ret;
+	}
+
+	return ret;
+}
+
+int
+main(int argc, char** argv)
+{
+	GError* error = NULL;
+	g_autoptr(GOptionContext) context = NULL;
+	gboolean ret = TRUE;
+	guint64 moved = 0;
+
+	GOptionEntry entries[] = {
+		{ "kv", 0, 0, G_OPTION_ARG_STRING_ARRAY, &opt_kv, "Key-value namespace to migrate", "namespace" },
+		{ "object", 0, 0, G_OPTION_ARG_STRING_ARRAY, &opt_object, "Object namespace to migrate", "namespace" },
+		{ "dry-run", 0, 0, G_OPTION_ARG_NONE, &opt_dry_run, "Only print what would be moved", NULL },
+		{ NULL, 0, 0, 0, NULL, NULL, NULL }
+	};
+
+	// Explicitly enable UTF-8 since functions such as g_format_size might return UTF-8 characters.
+	setlocale(LC_ALL, "C.UTF-8");
+
+	context = g_option_context_new(NULL);
+	g_option_context_add_main_entries(context, entries, NULL);
+
+	if (!g_option_context_parse(context, &argc, &argv, &error))
+	{
+		if (error)
+		{
+			g_printerr("%s\n", error->message);
+			g_error_free(error);
+		}
+
+		return 1;
+	}
+
+	if (opt_kv == NULL && opt_object == NULL)
+	{
+		g_autofree gchar* help = NULL;
+
+		help = g_option_context_get_help(context, TRUE, NULL);
+
+		g_print("%s", help);
+
+		return 1;
+	}
+
+	for (guint i = 0; opt_kv != NULL && opt_kv[i] != NULL; i++)
+	{
+		ret = migrate_kv(opt_kv[i], &moved) && ret;
+	}
+
+	for (guint i = 0; opt_object != NULL && opt_object[i] != NULL; i++)
+	{
+		ret = migrate_object(opt_object[i], &moved) && ret;
+	}
+
+	g_print("%" G_GUINT64_FORMAT " %s\n", moved, (opt_dry_run) ? "misplaced" : "moved");
+
+	g_strfreev(opt_kv);
+	g_strfreev(opt_object);
+
+	return (ret) ? 0 : 1;
+}
@@ -128,6 +128,22 @@ main(int argc, char** argv)
 		g_print("Data server %d\n", i);
 		print_statistics(statistics);
 
+		// Newer servers also report their current load.
+		if (j_message_get_count(reply) >= 2)
+		{
+			g_autofree gchar* size_free = NULL;
+			g_autofree gchar* size_total = NULL;
+			guint64 operations;
+
+			size_free = g_format_size(j_message_get_8(reply));
+			size_total = g_format_size(j_message_get_8(reply));
+			j_message_get_8(reply);
+			operations = j_message_get_8(reply);
+
+			g_print("  %s of %s free\n", size_free, size_total);
+			g_print("  %" G_GUINT64_FORMAT " active operations\n", operations);
+		}
+
 		if (i != j_configuration_get_server_count(configuration, J_BACKEND_TYPE_OBJECT) - 1)
 		{
 			g_print("\n");